@@ -18,6 +18,7 @@
 #include "qgsalgorithmaggregate.h"
 #include "qgsprocessingparameteraggregate.h"
 #include "qgsexpressioncontextutils.h"
+#include "qgsparallelunion.h"
 
 ///@cond PRIVATE
 
@@ -229,7 +230,7 @@ QVariantMap QgsAggregateAlgorithm::processAlgorithm( const QVariantMap &paramete
 
     if ( !geometry.isNull() && !geometry.isEmpty() )
     {
-      geometry = QgsGeometry::unaryUnion( geometry.asGeometryCollection() );
+      geometry = QgsParallelUnion().unaryUnion( geometry.asGeometryCollection() );
       if ( geometry.isEmpty() )
       {
         QStringList keyString;
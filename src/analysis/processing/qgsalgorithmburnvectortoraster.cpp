@@ -0,0 +1,267 @@
+/***************************************************************************
+                         qgsalgorithmburnvectortoraster.cpp
+                         ---------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsalgorithmburnvectortoraster.h"
+#include "qgsrasterburner_p.h"
+#include "qgsraster.h"
+#include "qgsrasterfilewriter.h"
+#include "qgsprocessingfeedback.h"
+
+#include <cmath>
+
+///@cond PRIVATE
+
+QString QgsBurnVectorToRasterAlgorithm::name() const
+{
+  return QStringLiteral( "burnvectortoraster" );
+}
+
+QString QgsBurnVectorToRasterAlgorithm::displayName() const
+{
+  return QObject::tr( "Burn vector to raster" );
+}
+
+QStringList QgsBurnVectorToRasterAlgorithm::tags() const
+{
+  return QObject::tr( "rasterize,rasterise,burn,vector,raster,convert" ).split( ',' );
+}
+
+QString QgsBurnVectorToRasterAlgorithm::group() const
+{
+  return QObject::tr( "Vector conversion" );
+}
+
+QString QgsBurnVectorToRasterAlgorithm::groupId() const
+{
+  return QStringLiteral( "vectorconversion" );
+}
+
+QString QgsBurnVectorToRasterAlgorithm::shortHelpString() const
+{
+  return QObject::tr( "Burns the features of a vector layer into a new single band raster layer, "
+                      "with the value of a numeric field or a fixed value.\n"
+                      "Polygons burn the cells whose center they contain, or every cell they touch "
+                      "if \"All touched\" is checked. With \"Weight by covered fraction of cells\" polygons "
+                      "burn every cell they overlap with their value multiplied by the fraction of the "
+                      "cell area they cover. Lines burn every cell they cross and points "
+                      "burn the cell containing them. Cells burned by several features are combined "
+                      "with the merge rule, and cells burned by no feature are set to the nodata value.\n"
+                      "The raster is processed in tiles which are burned in parallel and written as soon "
+                      "as they are complete, so that the output raster is never held in memory as a whole. "
+                      "The geometries of the input features are held in memory while burning.\n"
+                      "The nodata value must be representable in the output data type, e.g. between "
+                      "0 and 255 for Byte outputs." );
+}
+
+QgsBurnVectorToRasterAlgorithm *QgsBurnVectorToRasterAlgorithm::createInstance() const
+{
+  return new QgsBurnVectorToRasterAlgorithm();
+}
+
+void QgsBurnVectorToRasterAlgorithm::initAlgorithm( const QVariantMap & )
+{
+  addParameter( new QgsProcessingParameterFeatureSource( QStringLiteral( "INPUT" ), QObject::tr( "Input layer" ),
+                QList< int >() << QgsProcessing::TypeVectorAnyGeometry ) );
+  addParameter( new QgsProcessingParameterField( QStringLiteral( "FIELD" ), QObject::tr( "Field to use for burn-in value" ), QVariant(),
+                QStringLiteral( "INPUT" ), QgsProcessingParameterField::Numeric, false, true ) );
+  addParameter( new QgsProcessingParameterNumber( QStringLiteral( "BURN" ), QObject::tr( "Fixed value to burn" ),
+                QgsProcessingParameterNumber::Double, 1 ) );
+  addParameter( new QgsProcessingParameterExtent( QStringLiteral( "EXTENT" ), QObject::tr( "Output extent" ), QVariant(), true ) );
+  addParameter( new QgsProcessingParameterNumber( QStringLiteral( "PIXEL_SIZE" ), QObject::tr( "Pixel size" ),
+                QgsProcessingParameterNumber::Double, 1, false, 0.00001 ) );
+
+  const QStringList mergeRules = QStringList() << QObject::tr( "Last feature" )
+                                 << QObject::tr( "Minimum" )
+                                 << QObject::tr( "Maximum" )
+                                 << QObject::tr( "Sum" );
+  addParameter( new QgsProcessingParameterEnum( QStringLiteral( "MERGE_RULE" ), QObject::tr( "Merge rule for overlapping features" ), mergeRules, false, 0 ) );
+  addParameter( new QgsProcessingParameterBoolean( QStringLiteral( "ALL_TOUCHED" ), QObject::tr( "All touched" ), false ) );
+  addParameter( new QgsProcessingParameterBoolean( QStringLiteral( "COVERAGE_FRACTION" ), QObject::tr( "Weight by covered fraction of cells" ), false ) );
+  addParameter( new QgsProcessingParameterNumber( QStringLiteral( "NODATA" ), QObject::tr( "Nodata value" ),
+                QgsProcessingParameterNumber::Double, -9999 ) );
+
+  QStringList rasterDataTypes;
+  rasterDataTypes << QStringLiteral( "Byte" )
+                  << QStringLiteral( "Integer16" )
+                  << QStringLiteral( "Unsigned Integer16" )
+                  << QStringLiteral( "Integer32" )
+                  << QStringLiteral( "Unsigned Integer32" )
+                  << QStringLiteral( "Float32" )
+                  << QStringLiteral( "Float64" );
+
+  std::unique_ptr< QgsProcessingParameterDefinition > rasterTypeParameter = std::make_unique< QgsProcessingParameterEnum >( QStringLiteral( "OUTPUT_TYPE" ), QObject::tr( "Output raster data type" ), rasterDataTypes, false, 5, false );
+  rasterTypeParameter->setFlags( QgsProcessingParameterDefinition::FlagAdvanced );
+  addParameter( rasterTypeParameter.release() );
+
+  addParameter( new QgsProcessingParameterRasterDestination( QStringLiteral( "OUTPUT" ), QObject::tr( "Rasterized" ) ) );
+}
+
+QVariantMap QgsBurnVectorToRasterAlgorithm::processAlgorithm( const QVariantMap &parameters, QgsProcessingContext &context, QgsProcessingFeedback *feedback )
+{
+  std::unique_ptr< QgsProcessingFeatureSource > source( parameterAsSource( parameters, QStringLiteral( "INPUT" ), context ) );
+  if ( !source )
+    throw QgsProcessingException( invalidSourceError( parameters, QStringLiteral( "INPUT" ) ) );
+
+  const QgsCoordinateReferenceSystem crs = source->sourceCrs();
+  QgsRectangle extent = parameterAsExtent( parameters, QStringLiteral( "EXTENT" ), context, crs );
+  if ( extent.isNull() )
+    extent = source->sourceExtent();
+  if ( extent.isEmpty() )
+    throw QgsProcessingException( QObject::tr( "The output extent is empty" ) );
+
+  const double pixelSize = parameterAsDouble( parameters, QStringLiteral( "PIXEL_SIZE" ), context );
+  const double burnValue = parameterAsDouble( parameters, QStringLiteral( "BURN" ), context );
+  const double noDataValue = parameterAsDouble( parameters, QStringLiteral( "NODATA" ), context );
+  const bool allTouched = parameterAsBoolean( parameters, QStringLiteral( "ALL_TOUCHED" ), context );
+  const bool coverageFraction = parameterAsBoolean( parameters, QStringLiteral( "COVERAGE_FRACTION" ), context );
+
+  int fieldIndex = -1;
+  const QString fieldName = parameterAsString( parameters, QStringLiteral( "FIELD" ), context );
+  if ( !fieldName.isEmpty() )
+  {
+    fieldIndex = source->fields().lookupField( fieldName );
+    if ( fieldIndex < 0 )
+      throw QgsProcessingException( QObject::tr( "Could not find field %1" ).arg( fieldName ) );
+  }
+
+  QgsRasterBurner::MergeRule mergeRule = QgsRasterBurner::MergeRule::Replace;
+  switch ( parameterAsEnum( parameters, QStringLiteral( "MERGE_RULE" ), context ) )
+  {
+    case 1:
+      mergeRule = QgsRasterBurner::MergeRule::Minimum;
+      break;
+    case 2:
+      mergeRule = QgsRasterBurner::MergeRule::Maximum;
+      break;
+    case 3:
+      mergeRule = QgsRasterBurner::MergeRule::Sum;
+      break;
+    default:
+      break;
+  }
+
+  Qgis::DataType dataType = Qgis::DataType::Float32;
+  switch ( parameterAsEnum( parameters, QStringLiteral( "OUTPUT_TYPE" ), context ) )
+  {
+    case 0:
+      dataType = Qgis::DataType::Byte;
+      break;
+    case 1:
+      dataType = Qgis::DataType::Int16;
+      break;
+    case 2:
+      dataType = Qgis::DataType::UInt16;
+      break;
+    case 3:
+      dataType = Qgis::DataType::Int32;
+      break;
+    case 4:
+      dataType = Qgis::DataType::UInt32;
+      break;
+    case 6:
+      dataType = Qgis::DataType::Float64;
+      break;
+    default:
+      break;
+  }
+
+  // an unrepresentable nodata value would be silently changed by the conversion to the output
+  // data type, and could then no longer be told apart from burned values
+  if ( !QgsRaster::isRepresentableValue( noDataValue, dataType )
+       || ( !std::isnan( noDataValue ) && QgsRaster::representableValue( noDataValue, dataType ) != noDataValue ) )
+  {
+    throw QgsProcessingException( QObject::tr( "The nodata value %1 cannot be represented in the selected output raster data type" ).arg( noDataValue ) );
+  }
+
+  const int rows = std::max( std::ceil( extent.height() / pixelSize ), 1.0 );
+  const int cols = std::max( std::ceil( extent.width() / pixelSize ), 1.0 );
+
+  // snap the extent to whole cells, keeping its top left corner
+  const QgsRectangle rasterExtent( extent.xMinimum(), extent.yMaximum() - rows * pixelSize, extent.xMinimum() + cols * pixelSize, extent.yMaximum() );
+
+  QgsRasterBurner burner( rasterExtent, cols, rows );
+  burner.setMergeRule( mergeRule );
+  burner.setAllTouched( allTouched );
+  burner.setCoverageFraction( coverageFraction );
+
+  QgsProcessingMultiStepFeedback multiStepFeedback( 2, feedback );
+
+  // features are only read for the extent, and their geometries converted to cell coordinates up front
+  QgsFeatureRequest request;
+  request.setFilterRect( rasterExtent );
+  if ( fieldIndex < 0 )
+    request.setNoAttributes();
+  else
+    request.setSubsetOfAttributes( QgsAttributeList() << fieldIndex );
+
+  const long count = source->featureCount();
+  const double step = count > 0 ? 100.0 / count : 1;
+  long current = 0;
+  QgsFeatureIterator it = source->getFeatures( request );
+  QgsFeature feature;
+  while ( it.nextFeature( feature ) )
+  {
+    if ( feedback->isCanceled() )
+      break;
+    multiStepFeedback.setProgress( current * step );
+    current++;
+
+    if ( !feature.hasGeometry() )
+      continue;
+
+    double value = burnValue;
+    if ( fieldIndex >= 0 )
+    {
+      const QVariant attribute = feature.attribute( fieldIndex );
+      if ( attribute.isNull() )
+        continue;
+      bool ok = false;
+      value = attribute.toDouble( &ok );
+      if ( !ok )
+        continue;
+    }
+    burner.addFeature( feature.geometry(), value );
+  }
+  if ( feedback->isCanceled() )
+    return QVariantMap();
+
+  multiStepFeedback.setCurrentStep( 1 );
+
+  const QString outputFile = parameterAsOutputLayer( parameters, QStringLiteral( "OUTPUT" ), context );
+  QFileInfo fi( outputFile );
+  QgsRasterFileWriter writer( outputFile );
+  writer.setOutputProviderKey( QStringLiteral( "gdal" ) );
+  writer.setOutputFormat( QgsRasterFileWriter::driverForExtension( fi.suffix() ) );
+  std::unique_ptr< QgsRasterDataProvider > provider( writer.createOneBandRaster( dataType, cols, rows, rasterExtent, crs ) );
+  if ( !provider )
+    throw QgsProcessingException( QObject::tr( "Could not create raster output: %1" ).arg( outputFile ) );
+  if ( !provider->isValid() )
+    throw QgsProcessingException( QObject::tr( "Could not create raster output %1: %2" ).arg( outputFile, provider->error().message( QgsErrorMessage::Text ) ) );
+  provider->setNoDataValue( 1, noDataValue );
+
+  const bool completed = burner.run( dataType, noDataValue, [&provider]( QgsRasterBlock * block, int left, int top )
+  {
+    return provider->writeBlock( block, 1, left, top );
+  }, &multiStepFeedback );
+  if ( !completed && !feedback->isCanceled() )
+    throw QgsProcessingException( QObject::tr( "Could not write raster output: %1" ).arg( outputFile ) );
+
+  QVariantMap outputs;
+  outputs.insert( QStringLiteral( "OUTPUT" ), outputFile );
+  return outputs;
+}
+
+///@endcond
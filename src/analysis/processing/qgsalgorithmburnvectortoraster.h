@@ -0,0 +1,54 @@
+/***************************************************************************
+                         qgsalgorithmburnvectortoraster.h
+                         ------------------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSALGORITHMBURNVECTORTORASTER_H
+#define QGSALGORITHMBURNVECTORTORASTER_H
+
+#define SIP_NO_FILE
+
+#include "qgis_sip.h"
+#include "qgsprocessingalgorithm.h"
+#include "qgsapplication.h"
+
+///@cond PRIVATE
+
+/**
+ * Native burn vector to raster algorithm.
+ */
+class QgsBurnVectorToRasterAlgorithm : public QgsProcessingAlgorithm
+{
+
+  public:
+
+    QgsBurnVectorToRasterAlgorithm() = default;
+    void initAlgorithm( const QVariantMap &configuration = QVariantMap() ) override;
+    QString name() const override;
+    QString displayName() const override;
+    QStringList tags() const override;
+    QString group() const override;
+    QString groupId() const override;
+    QString shortHelpString() const override;
+    QgsBurnVectorToRasterAlgorithm *createInstance() const override SIP_FACTORY;
+
+  protected:
+
+    QVariantMap processAlgorithm( const QVariantMap &parameters,
+                                  QgsProcessingContext &context, QgsProcessingFeedback *feedback ) override;
+};
+
+///@endcond PRIVATE
+
+#endif // QGSALGORITHMBURNVECTORTORASTER_H
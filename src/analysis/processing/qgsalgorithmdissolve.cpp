@@ -16,6 +16,7 @@
  ***************************************************************************/
 
 #include "qgsalgorithmdissolve.h"
+#include "qgsparallelunion.h"
 
 ///@cond PRIVATE
 
@@ -214,32 +215,21 @@ QgsDissolveAlgorithm *QgsDissolveAlgorithm::createInstance() const
 
 QVariantMap QgsDissolveAlgorithm::processAlgorithm( const QVariantMap &parameters, QgsProcessingContext &context, QgsProcessingFeedback *feedback )
 {
+  QgsParallelUnion unioner;
+  unioner.setFeedback( feedback );
   return processCollection( parameters, context, feedback, [ & ]( const QVector< QgsGeometry > &parts )->QgsGeometry
   {
-    QgsGeometry result( QgsGeometry::unaryUnion( parts ) );
+    QString error;
+    QgsGeometry result( unioner.unaryUnion( parts, &error ) );
+    if ( feedback->isCanceled() )
+      return result;
     if ( QgsWkbTypes::geometryType( result.wkbType() ) == QgsWkbTypes::LineGeometry )
       result = result.mergeLines();
-    // Geos may fail in some cases, let's try a slower but safer approach
-    // See: https://github.com/qgis/QGIS/issues/28411 - Dissolve tool failing to produce outputs
-    if ( ! result.lastError().isEmpty() && parts.count() >  2 )
+    // geometries which GEOS fails to union in bulk are already merged one at a time by the unioner,
+    // see https://github.com/qgis/QGIS/issues/28411 - Dissolve tool failing to produce outputs
+    if ( ! error.isEmpty() )
     {
-      if ( feedback->isCanceled() )
-        return result;
-
-      feedback->pushDebugInfo( QObject::tr( "GEOS exception: taking the slower route ..." ) );
-      result = QgsGeometry();
-      for ( const auto &p : parts )
-      {
-        result = QgsGeometry::unaryUnion( QVector< QgsGeometry >() << result << p );
-        if ( QgsWkbTypes::geometryType( result.wkbType() ) == QgsWkbTypes::LineGeometry )
-          result = result.mergeLines();
-        if ( feedback->isCanceled() )
-          return result;
-      }
-    }
-    if ( ! result.lastError().isEmpty() )
-    {
-      feedback->reportError( result.lastError(), true );
+      feedback->reportError( error, true );
       if ( result.isEmpty() )
         throw QgsProcessingException( QObject::tr( "The algorithm returned no output." ) );
     }
@@ -112,7 +112,8 @@ QVariantMap QgsIntersectionAlgorithm::processAlgorithm( const QVariantMap &param
   int count = 0;
   int total = sourceA->featureCount();
 
-  QgsOverlayUtils::intersection( *sourceA, *sourceB, *sink, context, feedback, count, total, fieldIndicesA, fieldIndicesB );
+  QgsOverlayUtils::intersection( *sourceA, *sourceB, *sink, context, feedback, count, total, fieldIndicesA, fieldIndicesB,
+                                 parameterAsVectorLayer( parameters, QStringLiteral( "OVERLAY" ), context ) );
 
   return outputs;
 }
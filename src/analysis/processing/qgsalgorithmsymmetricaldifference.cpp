@@ -95,9 +95,11 @@ QVariantMap QgsSymmetricalDifferenceAlgorithm::processAlgorithm( const QVariantM
   int count = 0;
   int total = sourceA->featureCount() + sourceB->featureCount();
 
-  QgsOverlayUtils::difference( *sourceA, *sourceB, *sink, context, feedback, count, total, QgsOverlayUtils::OutputAB );
+  QgsOverlayUtils::difference( *sourceA, *sourceB, *sink, context, feedback, count, total, QgsOverlayUtils::OutputAB,
+                               parameterAsVectorLayer( parameters, QStringLiteral( "OVERLAY" ), context ) );
 
-  QgsOverlayUtils::difference( *sourceB, *sourceA, *sink, context, feedback, count, total, QgsOverlayUtils::OutputBA );
+  QgsOverlayUtils::difference( *sourceB, *sourceA, *sink, context, feedback, count, total, QgsOverlayUtils::OutputBA,
+                               parameterAsVectorLayer( parameters, QStringLiteral( "INPUT" ), context ) );
 
   return outputs;
 }
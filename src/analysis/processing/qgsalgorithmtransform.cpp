@@ -109,7 +109,14 @@ QgsFeatureList QgsTransformAlgorithm::processFeature( const QgsFeature &f, QgsPr
     QgsGeometry g = feature.geometry();
     try
     {
-      if ( g.transform( mTransform ) == 0 )
+      // transform all parts and rings together, falling back to the part by part
+      // transform if some vertices could not be transformed
+      QVector< QgsGeometry > geometries { g };
+      if ( mTransform.transformGeometries( geometries ).isEmpty() )
+      {
+        feature.setGeometry( geometries.at( 0 ) );
+      }
+      else if ( g.transform( mTransform ) == 0 )
       {
         feature.setGeometry( g );
       }
@@ -16,6 +16,7 @@
  ***************************************************************************/
 
 #include "qgsalgorithmzonalstatisticsfeaturebased.h"
+#include "qgszonalsweep_p.h"
 
 ///@cond PRIVATE
 
@@ -156,23 +157,99 @@ bool QgsZonalStatisticsFeatureBasedAlgorithm::prepareAlgorithm( const QVariantMa
   return true;
 }
 
+QVariantMap QgsZonalStatisticsFeatureBasedAlgorithm::processAlgorithm( const QVariantMap &parameters, QgsProcessingContext &context, QgsProcessingFeedback *feedback )
+{
+  // the same flow as QgsProcessingFeatureBasedAlgorithm::processAlgorithm(), except that instead
+  // of reading the raster below each feature, the features are gathered in batches and the
+  // statistics of a whole batch are calculated in one sweep over the raster
+  std::unique_ptr< QgsProcessingFeatureSource > source( parameterAsSource( parameters, inputParameterName(), context ) );
+  if ( !source )
+    throw QgsProcessingException( invalidSourceError( parameters, inputParameterName() ) );
+
+  QString dest;
+  std::unique_ptr< QgsFeatureSink > sink( parameterAsSink( parameters, QStringLiteral( "OUTPUT" ), context, dest,
+                                          outputFields( source->fields() ),
+                                          outputWkbType( source->wkbType() ),
+                                          outputCrs( source->sourceCrs() ),
+                                          sinkFlags() ) );
+  if ( !sink )
+    throw QgsProcessingException( invalidSinkError( parameters, QStringLiteral( "OUTPUT" ) ) );
+
+  // prepare expression context for feature iteration
+  QgsExpressionContext prevContext = context.expressionContext();
+  QgsExpressionContext algContext = prevContext;
+
+  algContext.appendScopes( createExpressionContext( parameters, context, source.get() ).takeScopes() );
+  context.setExpressionContext( algContext );
+
+  const long count = source->featureCount();
+  const int batchCount = count > 0 ? static_cast< int >( ( count + ZONAL_STATISTICS_BATCH_FEATURES - 1 ) / ZONAL_STATISTICS_BATCH_FEATURES ) : 1;
+  QgsProcessingMultiStepFeedback multiStepFeedback( batchCount, feedback );
+  int currentBatch = 0;
+
+  QgsFeatureList features;
+  auto processBatch = [&]
+  {
+    multiStepFeedback.setCurrentStep( std::min( currentBatch++, batchCount - 1 ) );
+    const QgsFeatureList results = processFeatures( features, &multiStepFeedback );
+    if ( !feedback->isCanceled() )
+      sink->addFeatures( results, QgsFeatureSink::FastInsert );
+    features.clear();
+  };
+
+  QgsFeature feature;
+  QgsFeatureIterator it = source->getFeatures( request(), sourceFlags() );
+  while ( it.nextFeature( feature ) )
+  {
+    if ( feedback->isCanceled() )
+      break;
+
+    context.expressionContext().setFeature( feature );
+    features << feature;
+    if ( features.size() >= ZONAL_STATISTICS_BATCH_FEATURES )
+      processBatch();
+  }
+  if ( !features.empty() && !feedback->isCanceled() )
+    processBatch();
+
+  // probably not necessary - context's aren't usually recycled, but can't hurt
+  context.setExpressionContext( prevContext );
+
+  QVariantMap outputs;
+  outputs.insert( QStringLiteral( "OUTPUT" ), dest );
+  return outputs;
+}
+
 QgsFeatureList QgsZonalStatisticsFeatureBasedAlgorithm::processFeature( const QgsFeature &feature, QgsProcessingContext &context, QgsProcessingFeedback *feedback )
 {
   Q_UNUSED( context )
-  Q_UNUSED( feedback )
-  QgsAttributes attributes = feature.attributes();
-  attributes.resize( mOutputFields.size() );
+  return processFeatures( QgsFeatureList { feature }, feedback );
+}
 
-  QMap<QgsZonalStatistics::Statistic, QVariant> results = QgsZonalStatistics::calculateStatistics( mRaster.get(), feature.geometry(), mPixelSizeX, mPixelSizeY, mBand, mStats );
-  for ( auto result = results.constBegin(); result != results.constEnd(); ++result )
-  {
-    attributes.replace( mStatFieldsMapping.value( result.key() ), result.value() );
-  }
+QgsFeatureList QgsZonalStatisticsFeatureBasedAlgorithm::processFeatures( const QgsFeatureList &features, QgsFeedback *feedback ) const
+{
+  QVector< QgsGeometry > geometries;
+  geometries.reserve( features.size() );
+  for ( const QgsFeature &feature : features )
+    geometries << feature.geometry();
 
-  QgsFeature resultFeature = feature;
-  resultFeature.setAttributes( attributes );
+  const QList< QMap<QgsZonalStatistics::Statistic, QVariant> > results = QgsZonalStatistics::calculateStatistics( mRaster.get(), geometries, mPixelSizeX, mPixelSizeY, mBand, mStats, false, feedback );
+  if ( feedback && feedback->isCanceled() )
+    return QgsFeatureList();
 
-  return QgsFeatureList { resultFeature };
+  QgsFeatureList resultFeatures = features;
+  for ( int i = 0; i < resultFeatures.size(); ++i )
+  {
+    QgsAttributes attributes = resultFeatures.at( i ).attributes();
+    attributes.resize( mOutputFields.size() );
+    const QMap<QgsZonalStatistics::Statistic, QVariant> &featureResults = results.at( i );
+    for ( auto result = featureResults.constBegin(); result != featureResults.constEnd(); ++result )
+    {
+      attributes.replace( mStatFieldsMapping.value( result.key() ), result.value() );
+    }
+    resultFeatures[i].setAttributes( attributes );
+  }
+  return resultFeatures;
 }
 
 bool QgsZonalStatisticsFeatureBasedAlgorithm::supportInPlaceEdit( const QgsMapLayer *layer ) const
@@ -53,10 +53,17 @@ class QgsZonalStatisticsFeatureBasedAlgorithm : public QgsProcessingFeatureBased
     QgsFields outputFields( const QgsFields &inputFields ) const override;
 
     bool prepareAlgorithm( const QVariantMap &parameters, QgsProcessingContext &context, QgsProcessingFeedback *feedback ) override;
+    QVariantMap processAlgorithm( const QVariantMap &parameters, QgsProcessingContext &context, QgsProcessingFeedback *feedback ) override;
     QgsFeatureList processFeature( const QgsFeature &feature,  QgsProcessingContext &context, QgsProcessingFeedback *feedback ) override;
     bool supportInPlaceEdit( const QgsMapLayer *layer ) const override;
 
   private:
+
+    /**
+     * Returns the \a features with their statistics, calculated in one sweep over the raster.
+     */
+    QgsFeatureList processFeatures( const QgsFeatureList &features, QgsFeedback *feedback ) const;
+
     std::unique_ptr< QgsRasterInterface > mRaster;
     int mBand;
     QString mPrefix;
@@ -16,7 +16,18 @@
 #include "qgsoverlayutils.h"
 
 #include "qgsgeometryengine.h"
+#include "qgsparallelunion.h"
 #include "qgsprocessingalgorithm.h"
+#include "qgsproviderregistry.h"
+#include "qgsvectorlayer.h"
+
+#include <QFileInfo>
+
+#include <QMutex>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <functional>
 
 ///@cond PRIVATE
 
@@ -82,117 +93,259 @@ static bool sanitizeDifferenceResult( QgsGeometry &geom, QgsWkbTypes::GeometryTy
 }
 
 
-void QgsOverlayUtils::difference( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, QgsOverlayUtils::DifferenceOutput outputAttrs )
+//! Number of features from the first source which are overlaid concurrently before their results are written
+static const int OVERLAY_BATCH_SIZE = 1000;
+
+struct OverlayJob
+{
+  QgsFeature feature;
+  QList< QgsFeatureId > candidatesB;
+  QgsFeatureList output;
+};
+
+/**
+ * Reads features from \a iterator in batches and calls \a overlay for each feature of a batch
+ * on the global thread pool. Output features are written to \a sink in the order of the input
+ * features, so the result does not depend on how the work was scheduled.
+ *
+ * Before a batch is processed, the features of \a sourceB whose bounding boxes (as stored in \a indexB)
+ * intersect any feature of the batch are fetched with a single \a requestB restricted to their IDs,
+ * so only the part of the second source which is needed by the current batch is held in memory.
+ * \a overlay receives the sorted candidate IDs for the feature and the fetched features of the batch.
+ */
+static void overlayInBatches( QgsFeatureIterator &iterator, QgsFeatureSink &sink, QgsProcessingFeedback *feedback, int &count, int totalCount,
+                              const QgsSpatialIndex &indexB, const QgsFeatureSource &sourceB, const QgsFeatureRequest &requestB,
+                              const std::function< QgsFeatureList( const QgsFeature &, const QList< QgsFeatureId > &, const QHash< QgsFeatureId, QgsFeature > & ) > &overlay )
+{
+  std::vector< OverlayJob > jobs;
+  jobs.reserve( OVERLAY_BATCH_SIZE );
+  QHash< QgsFeatureId, QgsFeature > featuresB;
+
+  QString error;
+  QMutex errorMutex;
+  auto runJob = [&]( OverlayJob & job )
+  {
+    if ( feedback->isCanceled() )
+      return;
+
+    try
+    {
+      job.output = overlay( job.feature, job.candidatesB, featuresB );
+    }
+    catch ( QgsProcessingException &e )
+    {
+      QMutexLocker locker( &errorMutex );
+      if ( error.isEmpty() )
+        error = e.what();
+    }
+  };
+
+  QgsFeature f;
+  bool finished = false;
+  while ( !finished && !feedback->isCanceled() )
+  {
+    jobs.clear();
+    QgsFeatureIds batchIdsB;
+    while ( static_cast< int >( jobs.size() ) < OVERLAY_BATCH_SIZE )
+    {
+      if ( !iterator.nextFeature( f ) )
+      {
+        finished = true;
+        break;
+      }
+
+      QList< QgsFeatureId > candidates;
+      if ( f.hasGeometry() )
+      {
+        candidates = indexB.intersects( f.geometry().boundingBox() );
+        // keep the order of B features stable between runs
+        std::sort( candidates.begin(), candidates.end() );
+        for ( QgsFeatureId id : std::as_const( candidates ) )
+          batchIdsB.insert( id );
+      }
+      jobs.push_back( { f, candidates, QgsFeatureList() } );
+    }
+
+    featuresB.clear();
+    if ( !batchIdsB.isEmpty() )
+    {
+      QgsFeatureRequest batchRequestB( requestB );
+      batchRequestB.setFilterFids( batchIdsB );
+      QgsFeatureIterator fitB = sourceB.getFeatures( batchRequestB );
+      QgsFeature featB;
+      while ( fitB.nextFeature( featB ) )
+      {
+        if ( feedback->isCanceled() )
+          return;
+
+        featuresB.insert( featB.id(), featB );
+      }
+    }
+
+    QtConcurrent::blockingMap( jobs, runJob );
+    if ( !error.isEmpty() )
+      throw QgsProcessingException( error );
+    if ( feedback->isCanceled() )
+      break;
+
+    for ( OverlayJob &job : jobs )
+    {
+      sink.addFeatures( job.output, QgsFeatureSink::FastInsert );
+      ++count;
+    }
+    feedback->setProgress( count / ( double ) totalCount * 100. );
+  }
+}
+
+// Returns the file whose spatial index can be saved for layer, or an empty string if
+// the layer is not a plain file without a native spatial index, or if the index is
+// needed in another CRS than the layer's.
+static QString persistentIndexSourcePath( QgsVectorLayer *layer, const QgsCoordinateReferenceSystem &crs )
+{
+  if ( !layer || !layer->isValid() || layer->isEditable() || !layer->subsetString().isEmpty() )
+    return QString();
+
+  if ( crs.isValid() && crs != layer->crs() )
+    return QString();
+
+  if ( layer->hasSpatialIndex() == QgsFeatureSource::SpatialIndexPresent )
+    return QString();
+
+  // a single file holding a single layer, the index file is named after it
+  const QVariantMap parts = QgsProviderRegistry::instance()->decodeUri( layer->providerType(), layer->source() );
+  if ( !parts.value( QStringLiteral( "layerName" ) ).toString().isEmpty() || !parts.value( QStringLiteral( "layerId" ) ).toString().isEmpty() )
+    return QString();
+
+  const QString path = parts.value( QStringLiteral( "path" ) ).toString();
+  return !path.isEmpty() && QFileInfo( path ).isFile() ? path : QString();
+}
+
+/**
+ * Builds the static spatial index of \a sourceB, with bounding boxes in the destination CRS of \a request.
+ *
+ * If \a layerB is a file based layer without a native spatial index, the index is saved alongside
+ * the file and loaded again by later runs, until the file changes. That index covers every feature
+ * of the layer, which also serves sources restricted to selected or filtered features, since
+ * candidates found in the index are then fetched through \a sourceB.
+ */
+static QgsSpatialIndex overlayIndex( const QgsFeatureSource &sourceB, const QgsFeatureRequest &request, QgsVectorLayer *layerB, QgsProcessingFeedback *feedback )
+{
+  const QString sourcePath = persistentIndexSourcePath( layerB, request.destinationCrs() );
+  if ( sourcePath.isEmpty() )
+    return QgsSpatialIndex( sourceB.getFeatures( request ), feedback, QgsSpatialIndex::FlagStaticPackedTree );
+
+  const QString indexPath = QgsSpatialIndex::indexPathForSource( sourcePath );
+  QgsSpatialIndex index;
+  if ( index.readFromFile( indexPath, sourcePath ) )
+  {
+    feedback->pushDebugInfo( QObject::tr( "Using saved spatial index %1" ).arg( indexPath ) );
+    return index;
+  }
+
+  index = QgsSpatialIndex( layerB->getFeatures( QgsFeatureRequest().setNoAttributes() ), feedback, QgsSpatialIndex::FlagStaticPackedTree );
+  // the index is only a cache, e.g. the directory may not be writable
+  if ( !feedback->isCanceled() && !index.writeToFile( indexPath, sourcePath ) )
+    feedback->pushDebugInfo( QObject::tr( "Could not save spatial index %1" ).arg( indexPath ) );
+  return index;
+}
+
+void QgsOverlayUtils::difference( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, QgsOverlayUtils::DifferenceOutput outputAttrs, QgsVectorLayer *layerB )
 {
   QgsWkbTypes::GeometryType geometryType = QgsWkbTypes::geometryType( QgsWkbTypes::multiType( sourceA.wkbType() ) );
   QgsFeatureRequest requestB;
   requestB.setNoAttributes();
   if ( outputAttrs != OutputBA )
     requestB.setDestinationCrs( sourceA.sourceCrs(), context.transformContext() );
-  QgsSpatialIndex indexB( sourceB.getFeatures( requestB ), feedback );
+  // a static index can be queried from all worker threads at once, the geometries of B
+  // are fetched for each batch of A features
+  const QgsSpatialIndex indexB = overlayIndex( sourceB, requestB, layerB, feedback );
 
   int fieldsCountA = sourceA.fields().count();
   int fieldsCountB = sourceB.fields().count();
-  QgsAttributes attrs;
-  attrs.resize( outputAttrs == OutputA ? fieldsCountA : ( fieldsCountA + fieldsCountB ) );
+  const int attrCount = outputAttrs == OutputA ? fieldsCountA : ( fieldsCountA + fieldsCountB );
 
   if ( totalCount == 0 )
     totalCount = 1;  // avoid division by zero
 
-  QgsFeature featA;
   QgsFeatureRequest requestA;
   requestA.setInvalidGeometryCheck( context.invalidGeometryCheck() );
   if ( outputAttrs == OutputBA )
     requestA.setDestinationCrs( sourceB.sourceCrs(), context.transformContext() );
   QgsFeatureIterator fitA = sourceA.getFeatures( requestA );
-  while ( fitA.nextFeature( featA ) )
-  {
-    if ( feedback->isCanceled() )
-      break;
 
-    if ( featA.hasGeometry() )
+  overlayInBatches( fitA, sink, feedback, count, totalCount, indexB, sourceB, requestB,
+                    [&]( const QgsFeature & featA, const QList< QgsFeatureId > &intersects, const QHash< QgsFeatureId, QgsFeature > &featuresB ) -> QgsFeatureList
+  {
+    if ( !featA.hasGeometry() )
     {
-      QgsGeometry geom( featA.geometry() );
-      QgsFeatureIds intersects = qgis::listToSet( indexB.intersects( geom.boundingBox() ) );
-
-      QgsFeatureRequest request;
-      request.setFilterFids( intersects );
-      request.setNoAttributes();
-      if ( outputAttrs != OutputBA )
-        request.setDestinationCrs( sourceA.sourceCrs(), context.transformContext() );
+      // TODO: should we write out features that do not have geometry?
+      return QgsFeatureList() << featA;
+    }
 
-      std::unique_ptr< QgsGeometryEngine > engine;
-      if ( !intersects.isEmpty() )
-      {
-        // use prepared geometries for faster intersection tests
-        engine.reset( QgsGeometry::createGeometryEngine( geom.constGet() ) );
-        engine->prepareGeometry();
-      }
+    QgsGeometry geom( featA.geometry() );
+    if ( !intersects.isEmpty() )
+    {
+      // use prepared geometries for faster intersection tests
+      std::unique_ptr< QgsGeometryEngine > engine( QgsGeometry::createGeometryEngine( geom.constGet() ) );
+      engine->prepareGeometry();
 
       QVector<QgsGeometry> geometriesB;
-      QgsFeature featB;
-      QgsFeatureIterator fitB = sourceB.getFeatures( request );
-      while ( fitB.nextFeature( featB ) )
+      for ( QgsFeatureId id : std::as_const( intersects ) )
       {
         if ( feedback->isCanceled() )
-          break;
+          return QgsFeatureList();
 
-        if ( engine->intersects( featB.geometry().constGet() ) )
-          geometriesB << featB.geometry();
+        const QgsGeometry geomB = featuresB.value( id ).geometry();
+        if ( !geomB.isNull() && engine->intersects( geomB.constGet() ) )
+          geometriesB << geomB;
       }
 
       if ( !geometriesB.isEmpty() )
       {
-        QgsGeometry geomB = QgsGeometry::unaryUnion( geometriesB );
-        if ( !geomB.lastError().isEmpty() )
+        QString unionError;
+        QgsGeometry geomB = QgsParallelUnion().unaryUnion( geometriesB, &unionError );
+        if ( !unionError.isEmpty() )
         {
           // This may happen if input geometries from a layer do not line up well (for example polygons
           // that are nearly touching each other, but there is a very tiny overlap or gap at one of the edges).
           // It is possible to get rid of this issue in two steps:
           // 1. snap geometries with a small tolerance (e.g. 1cm) using QgsGeometrySnapperSingleSource
           // 2. fix geometries (removes polygons collapsed to lines etc.) using MakeValid
-          throw QgsProcessingException( QStringLiteral( "%1\n\n%2" ).arg( QObject::tr( "GEOS geoprocessing error: unary union failed." ), geomB.lastError() ) );
+          throw QgsProcessingException( QStringLiteral( "%1\n\n%2" ).arg( QObject::tr( "GEOS geoprocessing error: unary union failed." ), unionError ) );
         }
         geom = geom.difference( geomB );
       }
+    }
 
-      if ( !sanitizeDifferenceResult( geom, geometryType ) )
-        continue;
+    if ( !sanitizeDifferenceResult( geom, geometryType ) )
+      return QgsFeatureList();
 
-      const QgsAttributes attrsA( featA.attributes() );
-      switch ( outputAttrs )
-      {
-        case OutputA:
-          attrs = attrsA;
-          break;
-        case OutputAB:
-          for ( int i = 0; i < fieldsCountA; ++i )
-            attrs[i] = attrsA[i];
-          break;
-        case OutputBA:
-          for ( int i = 0; i < fieldsCountA; ++i )
-            attrs[i + fieldsCountB] = attrsA[i];
-          break;
-      }
-
-      QgsFeature outFeat;
-      outFeat.setGeometry( geom );
-      outFeat.setAttributes( attrs );
-      sink.addFeature( outFeat, QgsFeatureSink::FastInsert );
-    }
-    else
+    QgsAttributes attrs( attrCount );
+    const QgsAttributes attrsA( featA.attributes() );
+    switch ( outputAttrs )
     {
-      // TODO: should we write out features that do not have geometry?
-      sink.addFeature( featA, QgsFeatureSink::FastInsert );
+      case OutputA:
+        attrs = attrsA;
+        break;
+      case OutputAB:
+        for ( int i = 0; i < fieldsCountA; ++i )
+          attrs[i] = attrsA[i];
+        break;
+      case OutputBA:
+        for ( int i = 0; i < fieldsCountA; ++i )
+          attrs[i + fieldsCountB] = attrsA[i];
+        break;
     }
 
-    ++count;
-    feedback->setProgress( count / ( double ) totalCount * 100. );
-  }
+    QgsFeature outFeat;
+    outFeat.setGeometry( geom );
+    outFeat.setAttributes( attrs );
+    return QgsFeatureList() << outFeat;
+  } );
 }
 
 
-void QgsOverlayUtils::intersection( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, const QList<int> &fieldIndicesA, const QList<int> &fieldIndicesB )
+void QgsOverlayUtils::intersection( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, const QList<int> &fieldIndicesA, const QList<int> &fieldIndicesB, QgsVectorLayer *layerB )
 {
   QgsWkbTypes::GeometryType geometryType = QgsWkbTypes::geometryType( QgsWkbTypes::multiType( sourceA.wkbType() ) );
   int attrCount = fieldIndicesA.count() + fieldIndicesB.count();
@@ -201,52 +354,46 @@ void QgsOverlayUtils::intersection( const QgsFeatureSource &sourceA, const QgsFe
   request.setNoAttributes();
   request.setDestinationCrs( sourceA.sourceCrs(), context.transformContext() );
 
-  QgsFeature outFeat;
-  QgsSpatialIndex indexB( sourceB.getFeatures( request ), feedback );
+  // a static index can be queried from all worker threads at once, the geometries and
+  // attributes of B are fetched for each batch of A features
+  const QgsSpatialIndex indexB = overlayIndex( sourceB, request, layerB, feedback );
+  if ( feedback->isCanceled() )
+    return;
+
+  QgsFeatureRequest requestB;
+  requestB.setSubsetOfAttributes( fieldIndicesB );
+  requestB.setDestinationCrs( sourceA.sourceCrs(), context.transformContext() );
 
   if ( totalCount == 0 )
     totalCount = 1;  // avoid division by zero
 
-  QgsFeature featA;
   QgsFeatureIterator fitA = sourceA.getFeatures( QgsFeatureRequest().setSubsetOfAttributes( fieldIndicesA ) );
-  while ( fitA.nextFeature( featA ) )
+  overlayInBatches( fitA, sink, feedback, count, totalCount, indexB, sourceB, requestB,
+                    [&]( const QgsFeature & featA, const QList< QgsFeatureId > &intersects, const QHash< QgsFeatureId, QgsFeature > &featuresB ) -> QgsFeatureList
   {
-    if ( feedback->isCanceled() )
-      break;
-
-    if ( !featA.hasGeometry() )
-      continue;
+    QgsFeatureList output;
+    if ( !featA.hasGeometry() || intersects.isEmpty() )
+      return output;
 
     QgsGeometry geom( featA.geometry() );
-    QgsFeatureIds intersects = qgis::listToSet( indexB.intersects( geom.boundingBox() ) );
 
-    QgsFeatureRequest request;
-    request.setFilterFids( intersects );
-    request.setDestinationCrs( sourceA.sourceCrs(), context.transformContext() );
-    request.setSubsetOfAttributes( fieldIndicesB );
-
-    std::unique_ptr< QgsGeometryEngine > engine;
-    if ( !intersects.isEmpty() )
-    {
-      // use prepared geometries for faster intersection tests
-      engine.reset( QgsGeometry::createGeometryEngine( geom.constGet() ) );
-      engine->prepareGeometry();
-    }
+    // use prepared geometries for faster intersection tests
+    std::unique_ptr< QgsGeometryEngine > engine( QgsGeometry::createGeometryEngine( geom.constGet() ) );
+    engine->prepareGeometry();
 
     QgsAttributes outAttributes( attrCount );
     const QgsAttributes attrsA( featA.attributes() );
     for ( int i = 0; i < fieldIndicesA.count(); ++i )
       outAttributes[i] = attrsA[fieldIndicesA[i]];
 
-    QgsFeature featB;
-    QgsFeatureIterator fitB = sourceB.getFeatures( request );
-    while ( fitB.nextFeature( featB ) )
+    for ( QgsFeatureId id : std::as_const( intersects ) )
     {
       if ( feedback->isCanceled() )
         break;
 
+      const QgsFeature featB = featuresB.value( id );
       QgsGeometry tmpGeom( featB.geometry() );
-      if ( !engine->intersects( tmpGeom.constGet() ) )
+      if ( tmpGeom.isNull() || !engine->intersects( tmpGeom.constGet() ) )
         continue;
 
       QgsGeometry intGeom = geom.intersection( tmpGeom );
@@ -255,16 +402,15 @@ void QgsOverlayUtils::intersection( const QgsFeatureSource &sourceA, const QgsFe
 
       const QgsAttributes attrsB( featB.attributes() );
       for ( int i = 0; i < fieldIndicesB.count(); ++i )
-        outAttributes[fieldIndicesA.count() + i] = attrsB[fieldIndicesB[i]];
+        outAttributes[fieldIndicesA.count() + i] = attrsB.value( fieldIndicesB[i] );
 
+      QgsFeature outFeat;
       outFeat.setGeometry( intGeom );
       outFeat.setAttributes( outAttributes );
-      sink.addFeature( outFeat, QgsFeatureSink::FastInsert );
+      output << outFeat;
     }
-
-    ++count;
-    feedback->setProgress( count / ( double ) totalCount * 100. );
-  }
+    return output;
+  } );
 }
 
 void QgsOverlayUtils::resolveOverlaps( const QgsFeatureSource &source, QgsFeatureSink &sink, QgsProcessingFeedback *feedback )
@@ -29,6 +29,7 @@ class QgsFields;
 class QgsProcessingContext;
 class QgsProcessingFeedback;
 class QgsGeometry;
+class QgsVectorLayer;
 
 namespace QgsOverlayUtils
 {
@@ -41,9 +42,21 @@ namespace QgsOverlayUtils
     OutputBA,  //!< Write attributes of both layers, inverted (first attributes of B, then attributes of A)
   };
 
-  void difference( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, DifferenceOutput outputAttrs );
+  /**
+   * Writes the difference of \a sourceA and \a sourceB to \a sink.
+   *
+   * If \a layerB is the layer behind \a sourceB, the spatial index of a file based layer without
+   * a native spatial index is saved alongside its file and reused by later runs.
+   */
+  void difference( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, DifferenceOutput outputAttrs, QgsVectorLayer *layerB = nullptr );
 
-  void intersection( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, const QList<int> &fieldIndicesA, const QList<int> &fieldIndicesB );
+  /**
+   * Writes the intersection of \a sourceA and \a sourceB to \a sink.
+   *
+   * If \a layerB is the layer behind \a sourceB, the spatial index of a file based layer without
+   * a native spatial index is saved alongside its file and reused by later runs.
+   */
+  void intersection( const QgsFeatureSource &sourceA, const QgsFeatureSource &sourceB, QgsFeatureSink &sink, QgsProcessingContext &context, QgsProcessingFeedback *feedback, int &count, int totalCount, const QList<int> &fieldIndicesA, const QList<int> &fieldIndicesB, QgsVectorLayer *layerB = nullptr );
 
   //! Makes sure that what came out from intersection of two geometries is good to be used in the output
   bool sanitizeIntersectionResult( QgsGeometry &geom, QgsWkbTypes::GeometryType geometryType );
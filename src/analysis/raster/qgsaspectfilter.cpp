@@ -44,3 +44,7 @@ float QgsAspectFilter::processNineCellWindow(
   }
 }
 
+void QgsAspectFilter::processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize )
+{
+  processRowWith< QgsAspectFilter >( scanLine1, scanLine2, scanLine3, resultLine, xSize );
+}
@@ -36,6 +36,12 @@ class ANALYSIS_EXPORT QgsAspectFilter: public QgsDerivativeFilter
                                  float *x12, float *x22, float *x32,
                                  float *x13, float *x23, float *x33 ) override;
 
+#ifndef SIP_RUN
+  protected:
+    void processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize ) override;
+    bool supportsConcurrentRows() const override { return true; }
+#endif
+
 
 #ifdef HAVE_OPENCL
   private:
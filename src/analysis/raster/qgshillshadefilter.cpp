@@ -70,6 +70,11 @@ void QgsHillshadeFilter::setLightAngle( float angle )
   mSinZenithRad = std::sin( angle * static_cast<float>( M_PI ) / 180.0f );
 }
 
+void QgsHillshadeFilter::processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize )
+{
+  processRowWith< QgsHillshadeFilter >( scanLine1, scanLine2, scanLine3, resultLine, xSize );
+}
+
 #ifdef HAVE_OPENCL
 
 void QgsHillshadeFilter::addExtraRasterParams( std::vector<float> &params )
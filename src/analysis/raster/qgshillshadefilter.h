@@ -41,6 +41,12 @@ class ANALYSIS_EXPORT QgsHillshadeFilter: public QgsDerivativeFilter
     float lightAngle() const { return mLightAngle; }
     void setLightAngle( float angle );
 
+#ifndef SIP_RUN
+  protected:
+    void processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize ) override;
+    bool supportsConcurrentRows() const override { return true; }
+#endif
+
   private:
 
 #ifdef HAVE_OPENCL
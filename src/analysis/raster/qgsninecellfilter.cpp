@@ -30,7 +30,14 @@
 #include <QFile>
 #include <QDebug>
 #include <QFileInfo>
+#include <QtConcurrentMap>
+#include <algorithm>
 #include <iterator>
+#include <numeric>
+#include <vector>
+
+// number of rows read, calculated and written at a time by the CPU implementation
+constexpr int NINE_CELL_BLOCK_ROWS = 128;
 
 
 
@@ -84,6 +91,17 @@ int QgsNineCellFilter::processRaster( QgsFeedback *feedback )
 #endif
 }
 
+void QgsNineCellFilter::processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize )
+{
+  for ( int xIndex = 0; xIndex < xSize ; ++xIndex )
+  {
+    // cells(x, y) x11, x21, x31, x12, x22, x32, x13, x23, x33
+    resultLine[ xIndex ] = processNineCellWindow( &scanLine1[ xIndex ], &scanLine1[ xIndex + 1 ], &scanLine1[ xIndex + 2 ],
+                           &scanLine2[ xIndex ], &scanLine2[ xIndex + 1 ], &scanLine2[ xIndex + 2 ],
+                           &scanLine3[ xIndex ], &scanLine3[ xIndex + 1 ], &scanLine3[ xIndex + 2 ] );
+  }
+}
+
 gdal::dataset_unique_ptr QgsNineCellFilter::openInputFile( int &nCellsX, int &nCellsY )
 {
   gdal::dataset_unique_ptr inputDataset( GDALOpen( mInputFile.toUtf8().constData(), GA_ReadOnly ) );
@@ -401,16 +419,27 @@ int QgsNineCellFilter::processRasterCPU( QgsFeedback *feedback )
     return 6;
   }
 
-  //keep only three scanlines in memory at a time, make room for initial and final nodata
-  std::size_t bufferSize( sizeof( float ) * ( xSize + 2 ) );
-  float *scanLine1 = ( float * ) CPLMalloc( bufferSize );
-  float *scanLine2 = ( float * ) CPLMalloc( bufferSize );
-  float *scanLine3 = ( float * ) CPLMalloc( bufferSize );
+  // the raster is processed in blocks of rows, each read together with the row above and below
+  // it (the "halo", nodata beyond the raster border). The rows of a block are calculated concurrently
+  // by the filters which support it.
+  const int blockRows = std::min( ySize, NINE_CELL_BLOCK_ROWS );
+  const int lineSize = xSize + 2;
+  std::vector< float > inputBlock( static_cast< std::size_t >( blockRows + 2 ) * lineSize );
+  std::vector< float > outputBlock( static_cast< std::size_t >( blockRows ) * xSize );
+  std::vector< int > rows;
+
+  auto processRow = [this, &inputBlock, &outputBlock, lineSize, xSize, feedback]( int row )
+  {
+    if ( feedback && feedback->isCanceled() )
+      return;
 
-  float *resultLine = ( float * ) CPLMalloc( sizeof( float ) * xSize );
+    // row + 1 is the input row of the output row, the halo row is at 0
+    float *scanLine1 = &inputBlock[ static_cast< std::size_t >( row ) * lineSize ];
+    processNineCellRow( scanLine1, scanLine1 + lineSize, scanLine1 + 2 * lineSize,
+                        &outputBlock[ static_cast< std::size_t >( row ) * xSize ], xSize );
+  };
 
-  //values outside the layer extent (if the 3x3 window is on the border) are sent to the processing method as (input) nodata values
-  for ( int yIndex = 0; yIndex < ySize; ++yIndex )
+  for ( int blockStart = 0; blockStart < ySize; blockStart += blockRows )
   {
     if ( feedback && feedback->isCanceled() )
     {
@@ -419,74 +448,41 @@ int QgsNineCellFilter::processRasterCPU( QgsFeedback *feedback )
 
     if ( feedback )
     {
-      feedback->setProgress( 100.0 * static_cast< double >( yIndex ) / ySize );
+      feedback->setProgress( 100.0 * static_cast< double >( blockStart ) / ySize );
     }
 
-    if ( yIndex == 0 )
-    {
-      //fill scanline 1 with (input) nodata for the values above the first row and feed scanline2 with the first row
-      for ( int a = 0; a < xSize + 2 ; ++a )
-      {
-        scanLine1[a] = mInputNodataValue;
-      }
-      // Read scanline2
-      if ( GDALRasterIO( rasterBand, GF_Read, 0, 0, xSize, 1, &scanLine2[1], xSize, 1, GDT_Float32, 0, 0 ) != CE_None )
-      {
-        QgsDebugMsg( QStringLiteral( "Raster IO Error" ) );
-      }
-    }
-    else
+    const int rowCount = std::min( blockRows, ySize - blockStart );
+
+    //values outside the layer extent (if the 3x3 window is on the border) are sent to the processing method as (input) nodata values
+    std::fill( inputBlock.begin(), inputBlock.begin() + static_cast< std::size_t >( rowCount + 2 ) * lineSize, mInputNodataValue );
+
+    // read the block and its halo rows in one go, into the columns between the nodata borders
+    const int firstRow = std::max( blockStart - 1, 0 );
+    const int lastRow = std::min( blockStart + rowCount, ySize - 1 );
+    float *firstRowData = &inputBlock[ static_cast< std::size_t >( firstRow - blockStart + 1 ) * lineSize + 1 ];
+    if ( GDALRasterIO( rasterBand, GF_Read, 0, firstRow, xSize, lastRow - firstRow + 1, firstRowData, xSize, lastRow - firstRow + 1,
+                       GDT_Float32, 0, static_cast< int >( lineSize * sizeof( float ) ) ) != CE_None )
     {
-      //normally fetch only scanLine3 and release scanline 1 if we move forward one row
-      CPLFree( scanLine1 );
-      scanLine1 = scanLine2;
-      scanLine2 = scanLine3;
-      scanLine3 = ( float * ) CPLMalloc( bufferSize );
+      QgsDebugMsg( QStringLiteral( "Raster IO Error" ) );
     }
 
-    // Read scanline 3
-    if ( yIndex == ySize - 1 ) //fill the row below the bottom with nodata values
+    rows.resize( rowCount );
+    std::iota( rows.begin(), rows.end(), 0 );
+    if ( supportsConcurrentRows() )
     {
-      for ( int a = 0; a < xSize + 2; ++a )
-      {
-        scanLine3[a] = mInputNodataValue;
-      }
+      QtConcurrent::blockingMap( rows, processRow );
     }
     else
     {
-      if ( GDALRasterIO( rasterBand, GF_Read, 0, yIndex + 1, xSize, 1, &scanLine3[1], xSize, 1, GDT_Float32, 0, 0 ) != CE_None )
-      {
-        QgsDebugMsg( QStringLiteral( "Raster IO Error" ) );
-      }
-    }
-    // Set first and last extra columns to nodata
-    scanLine1[0] = scanLine1[xSize + 1] = mInputNodataValue;
-    scanLine2[0] = scanLine2[xSize + 1] = mInputNodataValue;
-    scanLine3[0] = scanLine3[xSize + 1] = mInputNodataValue;
-
-
-
-    // j is the x axis index, skip 0 and last cell that have been filled with nodata
-    for ( int xIndex = 0; xIndex < xSize ; ++xIndex )
-    {
-      // cells(x, y) x11, x21, x31, x12, x22, x32, x13, x23, x33
-      resultLine[ xIndex ] = processNineCellWindow( &scanLine1[ xIndex ], &scanLine1[ xIndex + 1 ], &scanLine1[ xIndex + 2 ],
-                             &scanLine2[ xIndex ], &scanLine2[ xIndex + 1 ], &scanLine2[ xIndex + 2 ],
-                             &scanLine3[ xIndex ], &scanLine3[ xIndex + 1 ], &scanLine3[ xIndex + 2 ] );
-
+      std::for_each( rows.begin(), rows.end(), processRow );
     }
 
-    if ( GDALRasterIO( outputRasterBand, GF_Write, 0, yIndex, xSize, 1, resultLine, xSize, 1, GDT_Float32, 0, 0 ) != CE_None )
+    if ( GDALRasterIO( outputRasterBand, GF_Write, 0, blockStart, xSize, rowCount, outputBlock.data(), xSize, rowCount, GDT_Float32, 0, 0 ) != CE_None )
     {
       QgsDebugMsg( QStringLiteral( "Raster IO Error" ) );
     }
   }
 
-  CPLFree( resultLine );
-  CPLFree( scanLine1 );
-  CPLFree( scanLine2 );
-  CPLFree( scanLine3 );
-
   if ( feedback && feedback->isCanceled() )
   {
     //delete the dataset without closing (because it is faster)
@@ -21,6 +21,7 @@
 #include <QString>
 #include "gdal.h"
 #include "qgis_analysis.h"
+#include "qgis_sip.h"
 #include "qgsogrutils.h"
 
 class QgsFeedback;
@@ -67,6 +68,8 @@ class ANALYSIS_EXPORT QgsNineCellFilter
      *
      * First index of the input cell is the row, second index is the column
      *
+     * \note Since QGIS 3.20 this is called concurrently for the cells of different rows if the subclass opts in to it.
+     *
      * \param x11 surrounding cell top left
      * \param x21 surrounding cell central left
      * \param x31 surrounding cell bottom left
@@ -137,6 +140,55 @@ class ANALYSIS_EXPORT QgsNineCellFilter
 
   protected:
 
+    /**
+     * Calculates the output values of a complete row of \a xSize cells into \a resultLine.
+     *
+     * \a scanLine1, \a scanLine2 and \a scanLine3 are the input rows above, at and below the
+     * output row. They contain xSize + 2 values, the first and last of which are the (input)
+     * nodata value.
+     *
+     * The default implementation calls processNineCellWindow() for every cell. Subclasses
+     * override it with processRowWith(), which calls their own processNineCellWindow()
+     * non-virtually and allows the compiler to inline the window calculation.
+     *
+     * This is called concurrently for different rows if supportsConcurrentRows() returns TRUE.
+     *
+     * \since QGIS 3.20
+     */
+    virtual void processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize ) SIP_SKIP;
+
+    /**
+     * Returns TRUE if processNineCellRow() is thread safe, so that the rows of the raster
+     * can be calculated concurrently.
+     *
+     * The default implementation returns FALSE, and the rows are calculated one after another.
+     *
+     * \since QGIS 3.20
+     */
+    virtual bool supportsConcurrentRows() const SIP_SKIP { return false; }
+
+#ifndef SIP_RUN
+
+    /**
+     * Calculates a row as processNineCellRow() does, with the processNineCellWindow() of the
+     * subclass \a Filter called non-virtually.
+     *
+     * \since QGIS 3.20
+     */
+    template<class Filter>
+    void processRowWith( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize )
+    {
+      Filter *filter = static_cast< Filter * >( this );
+      for ( int xIndex = 0; xIndex < xSize ; ++xIndex )
+      {
+        // cells(x, y) x11, x21, x31, x12, x22, x32, x13, x23, x33
+        resultLine[ xIndex ] = filter->Filter::processNineCellWindow( &scanLine1[ xIndex ], &scanLine1[ xIndex + 1 ], &scanLine1[ xIndex + 2 ],
+                               &scanLine2[ xIndex ], &scanLine2[ xIndex + 1 ], &scanLine2[ xIndex + 2 ],
+                               &scanLine3[ xIndex ], &scanLine3[ xIndex + 1 ], &scanLine3[ xIndex + 2 ] );
+      }
+    }
+#endif
+
     QString mInputFile;
     QString mOutputFile;
     QString mOutputFormat;
@@ -0,0 +1,612 @@
+/***************************************************************************
+    qgsrasterburner.cpp  -  Tiled burning of vector features into rasters
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsrasterburner_p.h"
+#include "qgsfeedback.h"
+#include "qgsrasterblock.h"
+#include "qgszonalsweep_p.h"
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <cmath>
+#include <limits>
+#include <memory>
+
+///@cond PRIVATE
+
+struct QgsRasterBurner::Tile
+{
+  int left = 0;
+  int top = 0;
+  int columns = 0;
+  int rows = 0;
+  std::vector< int > features;
+
+  std::vector< double > values;
+  //! Index of the last feature which burned each cell, or -1
+  std::vector< int > burnedBy;
+
+  std::unique_ptr< QgsRasterBlock > block;
+
+  bool contains( int row, int column ) const
+  {
+    return row >= top && row < top + rows && column >= left && column < left + columns;
+  }
+
+  //! Burns \a value into the cell at \a row and \a column of the grid, which must be in the tile
+  void burn( int row, int column, int featureIndex, double value, MergeRule rule )
+  {
+    const std::size_t i = static_cast< std::size_t >( row - top ) * columns + ( column - left );
+    int &last = burnedBy[i];
+    if ( last == featureIndex )
+      return;
+
+    double &cell = values[i];
+    if ( last < 0 )
+    {
+      cell = value;
+    }
+    else
+    {
+      switch ( rule )
+      {
+        case MergeRule::Replace:
+          cell = value;
+          break;
+        case MergeRule::Minimum:
+          cell = std::min( cell, value );
+          break;
+        case MergeRule::Maximum:
+          cell = std::max( cell, value );
+          break;
+        case MergeRule::Sum:
+          cell += value;
+          break;
+      }
+    }
+    last = featureIndex;
+  }
+};
+
+QgsRasterBurner::QgsRasterBurner( const QgsRectangle &extent, int width, int height )
+  : mExtent( extent )
+  , mWidth( width )
+  , mHeight( height )
+{
+  if ( width > 0 && height > 0 )
+  {
+    mCellSizeX = extent.width() / width;
+    mCellSizeY = extent.height() / height;
+  }
+}
+
+bool QgsRasterBurner::addFeature( const QgsGeometry &geometry, double value )
+{
+  if ( geometry.isEmpty() || mCellSizeX <= 0 || mCellSizeY <= 0 )
+    return false;
+
+  Feature feature;
+  feature.type = geometry.type();
+  feature.value = value;
+
+  // cell coordinates, with rows growing downwards
+  auto toCell = [this]( const QgsPointXY & point )
+  {
+    return QgsPointXY( ( point.x() - mExtent.xMinimum() ) / mCellSizeX, ( mExtent.yMaximum() - point.y() ) / mCellSizeY );
+  };
+  auto addPart = [&feature, &toCell]( const QVector< QgsPointXY > &points, bool closed )
+  {
+    std::vector< QgsPointXY > part;
+    part.reserve( static_cast< std::size_t >( points.size() ) );
+    for ( const QgsPointXY &point : points )
+      part.push_back( toCell( point ) );
+    // rings are handled as implicitly closed
+    if ( closed && part.size() > 1 && part.front() == part.back() )
+      part.pop_back();
+    if ( part.empty() )
+      return false;
+    feature.parts.emplace_back( std::move( part ) );
+    return true;
+  };
+
+  switch ( feature.type )
+  {
+    case QgsWkbTypes::PointGeometry:
+      addPart( geometry.isMultipart() ? geometry.asMultiPoint() : QgsMultiPointXY() << geometry.asPoint(), false );
+      break;
+
+    case QgsWkbTypes::LineGeometry:
+    {
+      const QgsMultiPolylineXY lines = geometry.isMultipart() ? geometry.asMultiPolyline() : QgsMultiPolylineXY() << geometry.asPolyline();
+      for ( const QgsPolylineXY &line : lines )
+        addPart( line, false );
+      break;
+    }
+
+    case QgsWkbTypes::PolygonGeometry:
+    {
+      const QgsMultiPolygonXY polygons = geometry.isMultipart() ? geometry.asMultiPolygon() : QgsMultiPolygonXY() << geometry.asPolygon();
+      for ( const QgsPolygonXY &polygon : polygons )
+      {
+        for ( int i = 0; i < polygon.size(); ++i )
+        {
+          if ( addPart( polygon.at( i ), true ) )
+            feature.holes.push_back( i > 0 );
+        }
+      }
+      break;
+    }
+
+    case QgsWkbTypes::UnknownGeometry:
+    case QgsWkbTypes::NullGeometry:
+      break;
+  }
+  if ( feature.parts.empty() )
+    return false;
+
+  double minX = std::numeric_limits< double >::max();
+  double minY = std::numeric_limits< double >::max();
+  double maxX = std::numeric_limits< double >::lowest();
+  double maxY = std::numeric_limits< double >::lowest();
+  for ( const std::vector< QgsPointXY > &part : feature.parts )
+  {
+    for ( const QgsPointXY &point : part )
+    {
+      minX = std::min( minX, point.x() );
+      minY = std::min( minY, point.y() );
+      maxX = std::max( maxX, point.x() );
+      maxY = std::max( maxY, point.y() );
+    }
+  }
+  if ( maxX < 0 || maxY < 0 || minX >= mWidth || minY >= mHeight )
+    return false;
+
+  // clamped before the conversion, features may extend far beyond the grid
+  feature.firstColumn = static_cast< int >( std::clamp( std::floor( minX ), 0.0, mWidth - 1.0 ) );
+  feature.lastColumn = static_cast< int >( std::clamp( std::floor( maxX ), 0.0, mWidth - 1.0 ) );
+  feature.firstRow = static_cast< int >( std::clamp( std::floor( minY ), 0.0, mHeight - 1.0 ) );
+  feature.lastRow = static_cast< int >( std::clamp( std::floor( maxY ), 0.0, mHeight - 1.0 ) );
+
+  mFeatures.emplace_back( std::move( feature ) );
+  return true;
+}
+
+bool QgsRasterBurner::run( Qgis::DataType dataType, double noDataValue, const Writer &writer, QgsFeedback *feedback ) const
+{
+  if ( mWidth <= 0 || mHeight <= 0 )
+    return true;
+
+  // assign the features to the tiles they overlap, in the order they were added
+  const int tileColumns = ( mWidth + mTileSize - 1 ) / mTileSize;
+  const int tileRows = ( mHeight + mTileSize - 1 ) / mTileSize;
+  std::vector< Tile > tiles( static_cast< std::size_t >( tileColumns ) * tileRows );
+  for ( int tileRow = 0; tileRow < tileRows; ++tileRow )
+  {
+    for ( int tileColumn = 0; tileColumn < tileColumns; ++tileColumn )
+    {
+      Tile &tile = tiles[ static_cast< std::size_t >( tileRow ) * tileColumns + tileColumn ];
+      tile.left = tileColumn * mTileSize;
+      tile.top = tileRow * mTileSize;
+      tile.columns = std::min( mTileSize, mWidth - tile.left );
+      tile.rows = std::min( mTileSize, mHeight - tile.top );
+    }
+  }
+  std::vector< std::vector< Band > > bands( mFeatures.size() );
+  for ( std::size_t i = 0; i < mFeatures.size(); ++i )
+  {
+    const Feature &feature = mFeatures[i];
+    if ( feature.type == QgsWkbTypes::PolygonGeometry )
+      bands[i] = polygonBands( feature );
+    for ( int tileRow = feature.firstRow / mTileSize; tileRow <= feature.lastRow / mTileSize; ++tileRow )
+    {
+      for ( int tileColumn = feature.firstColumn / mTileSize; tileColumn <= feature.lastColumn / mTileSize; ++tileColumn )
+        tiles[ static_cast< std::size_t >( tileRow ) * tileColumns + tileColumn ].features.push_back( static_cast< int >( i ) );
+    }
+  }
+
+  auto burnTile = [this, &bands, dataType, noDataValue]( Tile * tile )
+  {
+    const std::size_t count = static_cast< std::size_t >( tile->columns ) * tile->rows;
+    tile->values.assign( count, 0 );
+    tile->burnedBy.assign( count, -1 );
+    for ( int feature : tile->features )
+      burnFeature( feature, bands[ static_cast< std::size_t >( feature ) ], *tile );
+
+    tile->block = std::make_unique< QgsRasterBlock >( Qgis::DataType::Float64, tile->columns, tile->rows );
+    tile->block->setNoDataValue( noDataValue );
+    double *data = reinterpret_cast< double * >( tile->block->bits() );
+    for ( std::size_t i = 0; i < count; ++i )
+      data[i] = tile->burnedBy[i] < 0 ? noDataValue : tile->values[i];
+    if ( dataType != Qgis::DataType::Float64 )
+      tile->block->convert( dataType );
+
+    tile->values = std::vector< double >();
+    tile->burnedBy = std::vector< int >();
+  };
+
+  // the tiles of a batch are burned while the previous batch is written
+  const std::size_t batchSize = static_cast< std::size_t >( std::max( 1, QThread::idealThreadCount() ) );
+  std::vector< Tile * > batches[2];
+  std::size_t written = 0;
+  auto writeBatch = [&]( std::vector< Tile * > &batch )
+  {
+    for ( Tile *tile : batch )
+    {
+      if ( !writer( tile->block.get(), tile->left, tile->top ) )
+        return false;
+      tile->block.reset();
+      tile->features = std::vector< int >();
+      ++written;
+    }
+    batch.clear();
+    if ( feedback )
+      feedback->setProgress( 100.0 * static_cast< double >( written ) / static_cast< double >( tiles.size() ) );
+    return true;
+  };
+
+  int current = 0;
+  for ( std::size_t first = 0; first < tiles.size(); first += batchSize )
+  {
+    if ( feedback && feedback->isCanceled() )
+      return false;
+
+    std::vector< Tile * > &batch = batches[current];
+    for ( std::size_t i = first; i < std::min( first + batchSize, tiles.size() ); ++i )
+      batch.push_back( &tiles[i] );
+
+    QFuture< void > future = QtConcurrent::map( batch, burnTile );
+    const bool ok = writeBatch( batches[1 - current] );
+    future.waitForFinished();
+    if ( !ok )
+      return false;
+
+    current = 1 - current;
+  }
+
+  if ( feedback && feedback->isCanceled() )
+    return false;
+  return writeBatch( batches[1 - current] );
+}
+
+std::vector< QgsRasterBurner::Band > QgsRasterBurner::polygonBands( const Feature &feature ) const
+{
+  const int firstBand = feature.firstRow / mTileSize;
+  std::vector< Band > bands( static_cast< std::size_t >( feature.lastRow / mTileSize - firstBand + 1 ) );
+
+  // edges go to every band whose rows they overlap, including the band above when they start on its
+  // bottom limit so that the all touched rule still burns the cells they touch there
+  auto bandOf = [this]( double y ) { return static_cast< int >( std::clamp( y, 0.0, mHeight - 1.0 ) ) / mTileSize; };
+  for ( const std::vector< QgsPointXY > &ring : feature.parts )
+  {
+    const std::size_t count = ring.size();
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+      const QgsPointXY &a = ring[i];
+      const QgsPointXY &b = ring[( i + 1 ) % count];
+      const double minY = std::min( a.y(), b.y() );
+      const double maxY = std::max( a.y(), b.y() );
+      if ( maxY < 0 || minY > mHeight )
+        continue;
+
+      const int edgeFirstBand = std::max( firstBand, bandOf( std::ceil( minY ) - 1 ) );
+      const int edgeLastBand = std::min( feature.lastRow / mTileSize, bandOf( std::floor( maxY ) ) );
+      for ( int band = edgeFirstBand; band <= edgeLastBand; ++band )
+        bands[ static_cast< std::size_t >( band - firstBand ) ].edges.emplace_back( a, b );
+    }
+  }
+
+  if ( mCoverageFraction )
+  {
+    std::vector< QgsPointXY > scratch;
+    std::vector< QgsPointXY > clipped;
+    for ( std::size_t i = 0; i < bands.size(); ++i )
+    {
+      const double top = ( firstBand + static_cast< int >( i ) ) * static_cast< double >( mTileSize );
+      const double bottom = std::min( top + mTileSize, static_cast< double >( mHeight ) );
+      for ( std::size_t part = 0; part < feature.parts.size(); ++part )
+      {
+        QgsZonalSweep::clipRing( feature.parts[part], false, top, true, scratch );
+        QgsZonalSweep::clipRing( scratch, false, bottom, false, clipped );
+        if ( clipped.size() >= 3 )
+          bands[i].rings.emplace_back( clipped, feature.holes[part] );
+      }
+    }
+  }
+  return bands;
+}
+
+void QgsRasterBurner::burnFeature( int featureIndex, const std::vector< Band > &bands, Tile &tile ) const
+{
+  const Feature &feature = mFeatures[ static_cast< std::size_t >( featureIndex ) ];
+  switch ( feature.type )
+  {
+    case QgsWkbTypes::PointGeometry:
+      for ( const QgsPointXY &point : feature.parts.front() )
+        burnSegment( point, point, feature, featureIndex, tile );
+      break;
+
+    case QgsWkbTypes::LineGeometry:
+      for ( const std::vector< QgsPointXY > &line : feature.parts )
+      {
+        if ( line.size() == 1 )
+          burnSegment( line.front(), line.front(), feature, featureIndex, tile );
+        for ( std::size_t i = 1; i < line.size(); ++i )
+          burnSegment( line[i - 1], line[i], feature, featureIndex, tile );
+      }
+      break;
+
+    case QgsWkbTypes::PolygonGeometry:
+    {
+      const Band &band = bands[ static_cast< std::size_t >( tile.top / mTileSize - feature.firstRow / mTileSize ) ];
+      if ( mCoverageFraction )
+      {
+        burnCoverage( feature, featureIndex, band, tile );
+        break;
+      }
+
+      burnPolygon( feature, featureIndex, band, tile );
+      if ( mAllTouched )
+      {
+        for ( const std::pair< QgsPointXY, QgsPointXY > &edge : band.edges )
+          burnSegment( edge.first, edge.second, feature, featureIndex, tile );
+      }
+      break;
+    }
+
+    case QgsWkbTypes::UnknownGeometry:
+    case QgsWkbTypes::NullGeometry:
+      break;
+  }
+}
+
+void QgsRasterBurner::burnPolygon( const Feature &feature, int featureIndex, const Band &band, Tile &tile ) const
+{
+  const int firstRow = std::max( feature.firstRow, tile.top );
+  const int lastRow = std::min( feature.lastRow, tile.top + tile.rows - 1 );
+  const int firstColumn = std::max( feature.firstColumn, tile.left );
+  const int lastColumn = std::min( feature.lastColumn, tile.left + tile.columns - 1 );
+  if ( firstRow > lastRow || firstColumn > lastColumn )
+    return;
+
+  // crossings of the ring edges with the center lines of the rows, with the half open rule
+  // so that every row crosses the closed rings an even number of times
+  std::vector< std::pair< int, double > > crossings;
+  for ( const std::pair< QgsPointXY, QgsPointXY > &edge : band.edges )
+  {
+    const QgsPointXY &a = edge.first;
+    const QgsPointXY &b = edge.second;
+    if ( a.y() == b.y() )
+      continue;
+
+    const double minY = std::min( a.y(), b.y() );
+    const double maxY = std::max( a.y(), b.y() );
+    const int edgeFirstRow = static_cast< int >( std::max< double >( firstRow, std::ceil( minY - 0.5 ) ) );
+    const int edgeLastRow = static_cast< int >( std::min< double >( lastRow, std::ceil( maxY - 0.5 ) - 1 ) );
+    for ( int row = edgeFirstRow; row <= edgeLastRow; ++row )
+    {
+      const double y = row + 0.5;
+      crossings.emplace_back( row, a.x() + ( y - a.y() ) * ( b.x() - a.x() ) / ( b.y() - a.y() ) );
+    }
+  }
+  std::sort( crossings.begin(), crossings.end() );
+
+  // fill the cells whose center lies between pairs of crossings
+  for ( std::size_t i = 0; i + 1 < crossings.size(); i += 2 )
+  {
+    const int row = crossings[i].first;
+    const int spanFirstColumn = static_cast< int >( std::max< double >( firstColumn, std::ceil( crossings[i].second - 0.5 ) ) );
+    const int spanLastColumn = static_cast< int >( std::min< double >( lastColumn, std::ceil( crossings[i + 1].second - 0.5 ) - 1 ) );
+    for ( int column = spanFirstColumn; column <= spanLastColumn; ++column )
+      tile.burn( row, column, featureIndex, feature.value, mMergeRule );
+  }
+}
+
+void QgsRasterBurner::burnCoverage( const Feature &feature, int featureIndex, const Band &band, Tile &tile ) const
+{
+  const int firstRow = std::max( feature.firstRow, tile.top );
+  const int lastRow = std::min( feature.lastRow, tile.top + tile.rows - 1 );
+  const int firstColumn = std::max( feature.firstColumn, tile.left );
+  const int lastColumn = std::min( feature.lastColumn, tile.left + tile.columns - 1 );
+  if ( firstRow > lastRow || firstColumn > lastColumn )
+    return;
+
+  // the band rings are already clipped to the rows of the tile, clip them to its columns so rows only walk nearby vertices
+  std::vector< QgsPointXY > scratch;
+  std::vector< QgsPointXY > clipped;
+  std::vector< std::pair< std::vector< QgsPointXY >, bool > > windowRings;
+  for ( const std::pair< std::vector< QgsPointXY >, bool > &ring : band.rings )
+  {
+    QgsZonalSweep::clipRing( ring.first, true, firstColumn, true, scratch );
+    QgsZonalSweep::clipRing( scratch, true, lastColumn + 1, false, clipped );
+    if ( clipped.size() >= 3 )
+      windowRings.emplace_back( clipped, ring.second );
+  }
+  if ( windowRings.empty() )
+    return;
+
+  // cell coordinates, so the area of a cell is 1
+  std::vector< std::vector< QgsPointXY > > stripRings( windowRings.size() );
+  std::vector< char > boundary( static_cast< std::size_t >( lastColumn - firstColumn + 1 ) );
+  std::vector< double > crossings;
+  std::vector< QgsPointXY > cell;
+  for ( int row = firstRow; row <= lastRow; ++row )
+  {
+    const double stripTop = row;
+    const double stripBottom = row + 1;
+    const double y = row + 0.5;
+
+    std::fill( boundary.begin(), boundary.end(), 0 );
+    crossings.clear();
+    bool empty = true;
+    for ( std::size_t i = 0; i < windowRings.size(); ++i )
+    {
+      std::vector< QgsPointXY > &strip = stripRings[i];
+      QgsZonalSweep::clipRing( windowRings[i].first, false, stripTop, true, scratch );
+      QgsZonalSweep::clipRing( scratch, false, stripBottom, false, strip );
+      if ( strip.size() < 3 )
+      {
+        strip.clear();
+        continue;
+      }
+      empty = false;
+
+      // cells crossed by an edge are partially covered, except for edges along the strip limits
+      const std::size_t count = strip.size();
+      for ( std::size_t j = 0; j < count; ++j )
+      {
+        const QgsPointXY &a = strip[j];
+        const QgsPointXY &b = strip[( j + 1 ) % count];
+        if ( a.y() == b.y() && ( a.y() == stripTop || a.y() == stripBottom ) )
+          continue;
+
+        const int edgeFirstColumn = std::max( firstColumn, static_cast< int >( std::floor( std::min( a.x(), b.x() ) ) ) );
+        const int edgeLastColumn = std::min( lastColumn, static_cast< int >( std::floor( std::max( a.x(), b.x() ) ) ) );
+        for ( int column = edgeFirstColumn; column <= edgeLastColumn; ++column )
+          boundary[ static_cast< std::size_t >( column - firstColumn ) ] = 1;
+
+        // half open rule, as for the cell center fill
+        if ( ( a.y() > y ) != ( b.y() > y ) )
+          crossings.push_back( a.x() + ( y - a.y() ) * ( b.x() - a.x() ) / ( b.y() - a.y() ) );
+      }
+    }
+    if ( empty )
+      continue;
+
+    std::sort( crossings.begin(), crossings.end() );
+    std::size_t next = 0;
+    for ( int column = firstColumn; column <= lastColumn; ++column )
+    {
+      const double x = column + 0.5;
+      while ( next < crossings.size() && crossings[next] < x )
+        ++next;
+
+      // no edge touches the remaining cells, so their centers tell whether they are inside
+      const bool partial = boundary[ static_cast< std::size_t >( column - firstColumn ) ];
+      if ( !partial && next % 2 == 0 )
+        continue;
+
+      double weight = 1.0;
+      if ( partial )
+      {
+        double area = 0;
+        for ( std::size_t i = 0; i < stripRings.size(); ++i )
+        {
+          if ( stripRings[i].empty() )
+            continue;
+          QgsZonalSweep::clipRing( stripRings[i], true, column, true, scratch );
+          QgsZonalSweep::clipRing( scratch, true, column + 1, false, cell );
+          const double ringPartArea = cell.size() >= 3 ? QgsZonalSweep::ringArea( cell ) : 0.0;
+          area += windowRings[i].second ? -ringPartArea : ringPartArea;
+        }
+        weight = std::min( area, 1.0 );
+        if ( weight <= 0.0 )
+          continue;
+      }
+
+      tile.burn( row, column, featureIndex, feature.value * weight, mMergeRule );
+    }
+  }
+}
+
+void QgsRasterBurner::burnSegment( const QgsPointXY &start, const QgsPointXY &end, const Feature &feature, int featureIndex, Tile &tile ) const
+{
+  // points burn the cell containing them
+  if ( start == end )
+  {
+    const double column = std::floor( start.x() );
+    const double row = std::floor( start.y() );
+    if ( column >= tile.left && column < tile.left + tile.columns && row >= tile.top && row < tile.top + tile.rows )
+      tile.burn( static_cast< int >( row ), static_cast< int >( column ), featureIndex, feature.value, mMergeRule );
+    return;
+  }
+
+  // clip the segment to the tile (Liang-Barsky)
+  const double dx = end.x() - start.x();
+  const double dy = end.y() - start.y();
+  double t0 = 0;
+  double t1 = 1;
+  auto clip = [&t0, &t1]( double p, double q )
+  {
+    if ( p == 0 )
+      return q >= 0;
+    const double t = q / p;
+    if ( p < 0 )
+    {
+      if ( t > t1 )
+        return false;
+      t0 = std::max( t0, t );
+    }
+    else
+    {
+      if ( t < t0 )
+        return false;
+      t1 = std::min( t1, t );
+    }
+    return true;
+  };
+  if ( !clip( -dx, start.x() - tile.left ) || !clip( dx, tile.left + tile.columns - start.x() ) ||
+       !clip( -dy, start.y() - tile.top ) || !clip( dy, tile.top + tile.rows - start.y() ) )
+    return;
+
+  const double x0 = start.x() + t0 * dx;
+  const double y0 = start.y() + t0 * dy;
+  const double x1 = start.x() + t1 * dx;
+  const double y1 = start.y() + t1 * dy;
+
+  // segments running along the right or bottom edge of the tile belong to the next tile
+  if ( ( x0 == tile.left + tile.columns && x1 == x0 ) || ( y0 == tile.top + tile.rows && y1 == y0 ) )
+    return;
+
+  auto cellColumn = [&tile]( double x ) { return std::clamp( static_cast< int >( std::floor( x ) ), tile.left, tile.left + tile.columns - 1 ); };
+  auto cellRow = [&tile]( double y ) { return std::clamp( static_cast< int >( std::floor( y ) ), tile.top, tile.top + tile.rows - 1 ); };
+  int column = cellColumn( x0 );
+  int row = cellRow( y0 );
+  const int lastColumn = cellColumn( x1 );
+  const int lastRow = cellRow( y1 );
+
+  // walk the cells crossed by the segment (Amanatides-Woo)
+  const double clippedDx = x1 - x0;
+  const double clippedDy = y1 - y0;
+  const int stepColumn = clippedDx > 0 ? 1 : ( clippedDx < 0 ? -1 : 0 );
+  const int stepRow = clippedDy > 0 ? 1 : ( clippedDy < 0 ? -1 : 0 );
+  const double infinity = std::numeric_limits< double >::infinity();
+  double nextColumnT = stepColumn == 0 ? infinity : ( ( stepColumn > 0 ? column + 1 : column ) - x0 ) / clippedDx;
+  double nextRowT = stepRow == 0 ? infinity : ( ( stepRow > 0 ? row + 1 : row ) - y0 ) / clippedDy;
+  const double columnDeltaT = stepColumn == 0 ? infinity : 1.0 / std::fabs( clippedDx );
+  const double rowDeltaT = stepRow == 0 ? infinity : 1.0 / std::fabs( clippedDy );
+
+  for ( int steps = std::abs( lastColumn - column ) + std::abs( lastRow - row ); steps >= 0; --steps )
+  {
+    tile.burn( row, column, featureIndex, feature.value, mMergeRule );
+    if ( row == lastRow && column == lastColumn )
+      break;
+    if ( nextColumnT < nextRowT )
+    {
+      column += stepColumn;
+      nextColumnT += columnDeltaT;
+    }
+    else
+    {
+      row += stepRow;
+      nextRowT += rowDeltaT;
+    }
+    if ( !tile.contains( row, column ) )
+      break;
+  }
+}
+
+///@endcond
@@ -0,0 +1,171 @@
+/***************************************************************************
+    qgsrasterburner_p.h  -  Tiled burning of vector features into rasters
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSRASTERBURNER_P_H
+#define QGSRASTERBURNER_P_H
+
+#define SIP_NO_FILE
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QGIS API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+
+#include "qgis.h"
+#include "qgsgeometry.h"
+#include "qgspointxy.h"
+#include "qgsrectangle.h"
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+class QgsFeedback;
+class QgsRasterBlock;
+
+///@cond PRIVATE
+
+/**
+ * \ingroup analysis
+ * \brief Burns the values of vector features into the cells of a raster grid.
+ *
+ * Polygons are filled with a scanline fill of the cells whose center is inside them,
+ * lines burn every cell they cross and points burn the cell containing them. With
+ * the all touched rule polygons also burn every cell crossed by their boundary, and with
+ * the coverage fraction rule polygons burn every cell they overlap with their value
+ * weighted by the fraction of the cell area they cover, like the exact fraction
+ * coverage of QgsZonalSweep. A feature burns each cell at most once, and the values of
+ * features burning the same cell are combined with the merge rule.
+ *
+ * The grid is split into square tiles, which are burned concurrently. Finished tiles
+ * are passed to the writer on the calling thread in row order while the next tiles
+ * are burned, so the whole grid never needs to be held in memory. The edges of
+ * polygons are sorted into the rows of tiles they cross once before burning, so that
+ * a tile only walks the edges of the polygons near it.
+ */
+class QgsRasterBurner
+{
+  public:
+
+    //! Rule combining the values of features burning the same cell
+    enum class MergeRule
+    {
+      Replace, //!< The value of the last feature added
+      Minimum, //!< The smallest value
+      Maximum, //!< The largest value
+      Sum, //!< The sum of the values
+    };
+
+    /**
+     * Callback receiving a finished \a block, whose top left cell is at \a left, \a top in the grid.
+     * Returns FALSE to stop burning.
+     */
+    typedef std::function< bool( QgsRasterBlock *block, int left, int top ) > Writer;
+
+    //! Default width and height in cells of the tiles
+    static constexpr int DEFAULT_TILE_SIZE = 512;
+
+    /**
+     * Constructor for QgsRasterBurner, for a grid of \a width by \a height cells covering \a extent.
+     */
+    QgsRasterBurner( const QgsRectangle &extent, int width, int height );
+
+    //! Sets the rule combining the values of features burning the same cell
+    void setMergeRule( MergeRule rule ) { mMergeRule = rule; }
+
+    //! Sets whether polygons burn all the cells they touch, rather than the cells whose center they contain
+    void setAllTouched( bool allTouched ) { mAllTouched = allTouched; }
+
+    /**
+     * Sets whether polygons burn every cell they overlap with their value weighted by the
+     * fraction of the cell they cover. This takes precedence over the all touched rule.
+     */
+    void setCoverageFraction( bool coverageFraction ) { mCoverageFraction = coverageFraction; }
+
+    //! Sets the width and height in cells of the tiles
+    void setTileSize( int size ) { mTileSize = std::max( 1, size ); }
+
+    /**
+     * Adds a feature burning \a value, with the \a geometry in the grid CRS.
+     *
+     * Returns FALSE if the geometry does not overlap the grid, in which case the feature is ignored.
+     */
+    bool addFeature( const QgsGeometry &geometry, double value );
+
+    //! Returns the number of features which overlap the grid
+    int featureCount() const { return static_cast< int >( mFeatures.size() ); }
+
+    /**
+     * Burns the features, passing blocks of \a dataType to \a writer. Cells which no
+     * feature burns are set to \a noDataValue.
+     *
+     * Returns FALSE if burning was canceled through \a feedback or stopped by the writer.
+     */
+    bool run( Qgis::DataType dataType, double noDataValue, const Writer &writer, QgsFeedback *feedback = nullptr ) const;
+
+  private:
+
+    //! A feature, with the vertices of its parts in cell coordinates
+    struct Feature
+    {
+      QgsWkbTypes::GeometryType type = QgsWkbTypes::UnknownGeometry;
+      double value = 0;
+      //! Lines and polygon rings, or a single part holding all the points
+      std::vector< std::vector< QgsPointXY > > parts;
+      //! Whether each part of a polygon is a hole
+      std::vector< bool > holes;
+      int firstRow = 0;
+      int lastRow = -1;
+      int firstColumn = 0;
+      int lastColumn = -1;
+    };
+
+    //! The parts of a polygon within a row of tiles
+    struct Band
+    {
+      //! Ring edges overlapping the rows of the band
+      std::vector< std::pair< QgsPointXY, QgsPointXY > > edges;
+      //! Rings clipped to the rows of the band, with whether they are holes, only for the coverage fraction rule
+      std::vector< std::pair< std::vector< QgsPointXY >, bool > > rings;
+    };
+
+    struct Tile;
+
+    std::vector< Band > polygonBands( const Feature &feature ) const;
+    void burnFeature( int featureIndex, const std::vector< Band > &bands, Tile &tile ) const;
+    void burnPolygon( const Feature &feature, int featureIndex, const Band &band, Tile &tile ) const;
+    void burnCoverage( const Feature &feature, int featureIndex, const Band &band, Tile &tile ) const;
+    void burnSegment( const QgsPointXY &start, const QgsPointXY &end, const Feature &feature, int featureIndex, Tile &tile ) const;
+
+    QgsRectangle mExtent;
+    int mWidth = 0;
+    int mHeight = 0;
+    double mCellSizeX = 0;
+    double mCellSizeY = 0;
+    MergeRule mMergeRule = MergeRule::Replace;
+    bool mAllTouched = false;
+    bool mCoverageFraction = false;
+    int mTileSize = DEFAULT_TILE_SIZE;
+    std::vector< Feature > mFeatures;
+};
+
+///@endcond
+
+#endif // QGSRASTERBURNER_P_H
@@ -138,6 +138,7 @@ class ANALYSIS_EXPORT QgsRasterCalcNode
     QgsRasterMatrix *mMatrix = nullptr;
     Operator mOperator = opNONE;
 
+    friend class QgsRasterCalcProgram;
 };
 
 
@@ -0,0 +1,262 @@
+/***************************************************************************
+    qgsrastercalcprogram.cpp  -  Flattened raster calculator expression
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsrastercalcprogram_p.h"
+#include "qgslogger.h"
+
+#include <algorithm>
+#include <cmath>
+
+///@cond PRIVATE
+
+static bool isTwoArgumentOperator( QgsRasterCalcNode::Operator op )
+{
+  switch ( op )
+  {
+    case QgsRasterCalcNode::opPLUS:
+    case QgsRasterCalcNode::opMINUS:
+    case QgsRasterCalcNode::opMUL:
+    case QgsRasterCalcNode::opDIV:
+    case QgsRasterCalcNode::opPOW:
+    case QgsRasterCalcNode::opEQ:
+    case QgsRasterCalcNode::opNE:
+    case QgsRasterCalcNode::opGT:
+    case QgsRasterCalcNode::opLT:
+    case QgsRasterCalcNode::opGE:
+    case QgsRasterCalcNode::opLE:
+    case QgsRasterCalcNode::opAND:
+    case QgsRasterCalcNode::opOR:
+    case QgsRasterCalcNode::opMAX:
+    case QgsRasterCalcNode::opMIN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static bool isOneArgumentOperator( QgsRasterCalcNode::Operator op )
+{
+  switch ( op )
+  {
+    case QgsRasterCalcNode::opSQRT:
+    case QgsRasterCalcNode::opSIN:
+    case QgsRasterCalcNode::opCOS:
+    case QgsRasterCalcNode::opTAN:
+    case QgsRasterCalcNode::opASIN:
+    case QgsRasterCalcNode::opACOS:
+    case QgsRasterCalcNode::opATAN:
+    case QgsRasterCalcNode::opSIGN:
+    case QgsRasterCalcNode::opLOG:
+    case QgsRasterCalcNode::opLOG10:
+    case QgsRasterCalcNode::opABS:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// must match QgsRasterMatrix::oneArgumentOperation()
+static inline double oneArgumentOperation( QgsRasterCalcNode::Operator op, double value, double nodataValue )
+{
+  switch ( op )
+  {
+    case QgsRasterCalcNode::opSQRT:
+      return value < 0 ? nodataValue : std::sqrt( value );
+    case QgsRasterCalcNode::opSIN:
+      return std::sin( value );
+    case QgsRasterCalcNode::opCOS:
+      return std::cos( value );
+    case QgsRasterCalcNode::opTAN:
+      return std::tan( value );
+    case QgsRasterCalcNode::opASIN:
+      return std::asin( value );
+    case QgsRasterCalcNode::opACOS:
+      return std::acos( value );
+    case QgsRasterCalcNode::opATAN:
+      return std::atan( value );
+    case QgsRasterCalcNode::opSIGN:
+      return -value;
+    case QgsRasterCalcNode::opLOG:
+      return value <= 0 ? nodataValue : ::log( value );
+    case QgsRasterCalcNode::opLOG10:
+      return value <= 0 ? nodataValue : ::log10( value );
+    case QgsRasterCalcNode::opABS:
+      return ::fabs( value );
+    default:
+      return nodataValue;
+  }
+}
+
+// must match QgsRasterMatrix::calculateTwoArgumentOp()
+static inline double twoArgumentOperation( QgsRasterCalcNode::Operator op, double arg1, double arg2, double nodataValue )
+{
+  switch ( op )
+  {
+    case QgsRasterCalcNode::opPLUS:
+      return arg1 + arg2;
+    case QgsRasterCalcNode::opMINUS:
+      return arg1 - arg2;
+    case QgsRasterCalcNode::opMUL:
+      return arg1 * arg2;
+    case QgsRasterCalcNode::opDIV:
+      return arg2 == 0 ? nodataValue : arg1 / arg2;
+    case QgsRasterCalcNode::opPOW:
+      if ( ( arg1 == 0 && arg2 < 0 ) || ( arg1 < 0 && ( arg2 - std::floor( arg2 ) ) > 0 ) )
+        return nodataValue;
+      return std::pow( arg1, arg2 );
+    case QgsRasterCalcNode::opEQ:
+      return arg1 == arg2 ? 1.0 : 0.0;
+    case QgsRasterCalcNode::opNE:
+      return arg1 == arg2 ? 0.0 : 1.0;
+    case QgsRasterCalcNode::opGT:
+      return arg1 > arg2 ? 1.0 : 0.0;
+    case QgsRasterCalcNode::opLT:
+      return arg1 < arg2 ? 1.0 : 0.0;
+    case QgsRasterCalcNode::opGE:
+      return arg1 >= arg2 ? 1.0 : 0.0;
+    case QgsRasterCalcNode::opLE:
+      return arg1 <= arg2 ? 1.0 : 0.0;
+    case QgsRasterCalcNode::opAND:
+      return arg1 && arg2 ? 1.0 : 0.0;
+    case QgsRasterCalcNode::opOR:
+      return arg1 || arg2 ? 1.0 : 0.0;
+    case QgsRasterCalcNode::opMAX:
+      return std::max( arg1, arg2 );
+    case QgsRasterCalcNode::opMIN:
+      return std::min( arg1, arg2 );
+    default:
+      return nodataValue;
+  }
+}
+
+bool QgsRasterCalcProgram::compile( const QgsRasterCalcNode *node )
+{
+  mInstructions.clear();
+  mInputs.clear();
+  mStackSize = 0;
+
+  if ( !node || !append( node, 0 ) )
+  {
+    mInstructions.clear();
+    mInputs.clear();
+    return false;
+  }
+  return true;
+}
+
+bool QgsRasterCalcProgram::append( const QgsRasterCalcNode *node, int depth )
+{
+  // depth is the number of values already on the stack
+  mStackSize = std::max( mStackSize, depth + 1 );
+
+  Instruction instruction;
+  instruction.type = node->mType;
+  switch ( node->mType )
+  {
+    case QgsRasterCalcNode::tNumber:
+      instruction.number = node->mNumber;
+      break;
+
+    case QgsRasterCalcNode::tRasterRef:
+    {
+      instruction.input = mInputs.indexOf( node->mRasterName );
+      if ( instruction.input < 0 )
+      {
+        instruction.input = mInputs.size();
+        mInputs << node->mRasterName;
+      }
+      break;
+    }
+
+    case QgsRasterCalcNode::tOperator:
+    {
+      instruction.op = node->mOperator;
+      if ( isTwoArgumentOperator( node->mOperator ) )
+      {
+        if ( !node->mLeft || !node->mRight || !append( node->mLeft, depth ) || !append( node->mRight, depth + 1 ) )
+          return false;
+      }
+      else if ( isOneArgumentOperator( node->mOperator ) )
+      {
+        if ( !node->mLeft || !append( node->mLeft, depth ) )
+          return false;
+      }
+      else
+      {
+        QgsDebugMsg( QStringLiteral( "Cannot compile raster calculator operator %1" ).arg( node->mOperator ) );
+        return false;
+      }
+      break;
+    }
+
+    case QgsRasterCalcNode::tMatrix:
+      return false;
+  }
+
+  mInstructions.push_back( instruction );
+  return true;
+}
+
+void QgsRasterCalcProgram::evaluate( const double *const *inputs, int count, double nodataValue, float *result ) const
+{
+  std::vector< double > stack( static_cast< std::size_t >( mStackSize ) );
+  double *const stackBottom = stack.data();
+  const Instruction *const begin = mInstructions.data();
+  const Instruction *const end = begin + mInstructions.size();
+
+  for ( int i = 0; i < count; ++i )
+  {
+    // top points one past the topmost value
+    double *top = stackBottom;
+    for ( const Instruction *instruction = begin; instruction != end; ++instruction )
+    {
+      switch ( instruction->type )
+      {
+        case QgsRasterCalcNode::tNumber:
+          *top++ = instruction->number;
+          break;
+
+        case QgsRasterCalcNode::tRasterRef:
+          *top++ = inputs[ instruction->input ][ i ];
+          break;
+
+        case QgsRasterCalcNode::tOperator:
+          if ( isOneArgumentOperator( instruction->op ) )
+          {
+            double &value = top[-1];
+            if ( value != nodataValue )
+              value = oneArgumentOperation( instruction->op, value, nodataValue );
+          }
+          else
+          {
+            const double right = *--top;
+            double &left = top[-1];
+            if ( left == nodataValue || right == nodataValue )
+              left = nodataValue;
+            else
+              left = twoArgumentOperation( instruction->op, left, right, nodataValue );
+          }
+          break;
+
+        case QgsRasterCalcNode::tMatrix:
+          break;
+      }
+    }
+    result[i] = static_cast< float >( stackBottom[0] );
+  }
+}
+
+///@endcond
@@ -0,0 +1,101 @@
+/***************************************************************************
+    qgsrastercalcprogram_p.h  -  Flattened raster calculator expression
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSRASTERCALCPROGRAM_P_H
+#define QGSRASTERCALCPROGRAM_P_H
+
+#define SIP_NO_FILE
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QGIS API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+
+#include "qgsrastercalcnode.h"
+
+#include <QStringList>
+
+#include <vector>
+
+///@cond PRIVATE
+
+/**
+ * \ingroup analysis
+ * \brief A raster calculator expression flattened into a postfix program, which
+ * evaluates the whole expression cell by cell.
+ *
+ * QgsRasterCalcNode::calculate() evaluates every node over a complete QgsRasterMatrix
+ * before its parent node runs, which allocates and walks one temporary matrix per node.
+ * The program instead runs all operations for a cell on a small value stack, so the
+ * only per row storage is the input values and the result.
+ *
+ * The results are identical to QgsRasterCalcNode::calculate(): any operand equal to the
+ * nodata value gives nodata, as do the invalid operations (division by zero, invalid
+ * powers, square roots and logarithms outside their domain).
+ *
+ * Programs are immutable once compiled and can be evaluated from several threads at once.
+ */
+class QgsRasterCalcProgram
+{
+  public:
+
+    /**
+     * Compiles the expression with the root \a node.
+     *
+     * Returns FALSE if the expression cannot be compiled, i.e. if it contains matrix
+     * nodes or unknown operators.
+     */
+    bool compile( const QgsRasterCalcNode *node );
+
+    /**
+     * Returns the names of the rasters referenced by the expression. Input values
+     * are passed to evaluate() in this order.
+     */
+    QStringList inputs() const { return mInputs; }
+
+    /**
+     * Evaluates the expression for \a count cells.
+     *
+     * \a inputs holds one array of \a count values for each of the inputs(), where nodata
+     * has already been replaced by \a nodataValue. The results are written to \a result.
+     */
+    void evaluate( const double *const *inputs, int count, double nodataValue, float *result ) const;
+
+  private:
+
+    struct Instruction
+    {
+      QgsRasterCalcNode::Type type = QgsRasterCalcNode::tNumber;
+      QgsRasterCalcNode::Operator op = QgsRasterCalcNode::opNONE;
+      double number = 0;
+      int input = -1;
+    };
+
+    //! Appends the instructions for \a node, returns FALSE if it cannot be compiled
+    bool append( const QgsRasterCalcNode *node, int depth );
+
+    std::vector< Instruction > mInstructions;
+    QStringList mInputs;
+    int mStackSize = 0;
+};
+
+///@endcond
+
+#endif // QGSRASTERCALCPROGRAM_P_H
@@ -17,6 +17,7 @@
 
 #include "qgsgdalutils.h"
 #include "qgsrastercalculator.h"
+#include "qgsrastercalcprogram_p.h"
 #include "qgsrasterdataprovider.h"
 #include "qgsrasterinterface.h"
 #include "qgsrasterlayer.h"
@@ -27,6 +28,11 @@
 #include "qgsproject.h"
 
 #include <QFile>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
+#include <algorithm>
+#include <numeric>
 
 #include <cpl_string.h>
 #include <gdalwarper.h>
@@ -36,6 +42,9 @@
 #include "qgsgdalutils.h"
 #endif
 
+//! Number of cells calculated per block by the raster calculator
+constexpr int RASTER_CALC_BLOCK_CELLS = 1 << 20;
+
 QgsRasterCalculator::QgsRasterCalculator( const QString &formulaString, const QString &outputFile, const QString &outputFormat, const QgsRectangle &outputExtent, int nOutputColumns, int nOutputRows, const QVector<QgsRasterCalculatorEntry> &rasterEntries, const QgsCoordinateTransformContext &transformContext )
   : mFormulaString( formulaString )
   , mOutputFile( outputFile )
@@ -160,40 +169,52 @@ QgsRasterCalculator::Result QgsRasterCalculator::processCalculation( QgsFeedback
   GDALSetRasterNoDataValue( outputRasterBand, outputNodataValue );
 
 
-  // Take the fast route (process one line at a time) if we can
+  // Take the fast route (process blocks of rows, evaluating the expression cell by cell) if we can
   if ( ! requiresMatrix )
   {
-    // Map of raster names -> blocks
-    std::map<QString, std::unique_ptr<QgsRasterBlock>> inputBlocks;
-    std::map<QString, QgsRasterCalculatorEntry> uniqueRasterEntries;
-    const QList<const QgsRasterCalcNode *> rasterRefNodes = calcNode->findNodes( QgsRasterCalcNode::Type::tRasterRef );
-    for ( const QgsRasterCalcNode *r : rasterRefNodes )
+    QgsRasterCalcProgram program;
+    if ( !program.compile( calcNode.get() ) )
+    {
+      gdal::fast_delete_and_close( outputDataset, outputDriver, mOutputFile );
+      return CalculationError;
+    }
+
+    // Entries for the rasters referenced by the expression, in program input order
+    const QStringList inputNames = program.inputs();
+    std::vector< QgsRasterCalculatorEntry > inputEntries;
+    inputEntries.reserve( inputNames.size() );
+    for ( const QString &name : inputNames )
     {
-      QString layerRef( r->toString().remove( 0, 1 ) );
-      layerRef.chop( 1 );
-      if ( ! inputBlocks.count( layerRef ) )
+      const QgsRasterCalculatorEntry *entry = nullptr;
+      for ( const QgsRasterCalculatorEntry &ref : std::as_const( mRasterEntries ) )
       {
-        for ( const QgsRasterCalculatorEntry &ref : std::as_const( mRasterEntries ) )
-        {
-          if ( ref.ref == layerRef )
-          {
-            uniqueRasterEntries[layerRef] = ref;
-            inputBlocks[layerRef ] = std::make_unique<QgsRasterBlock>();
-          }
-        }
+        if ( ref.ref == name )
+          entry = &ref;
+      }
+      if ( !entry )
+      {
+        QgsDebugMsg( QStringLiteral( "Error: could not find raster data for \"%1\"" ).arg( name ) );
+        gdal::fast_delete_and_close( outputDataset, outputDriver, mOutputFile );
+        return CalculationError;
       }
+      inputEntries.push_back( *entry );
     }
 
-    //read / write line by line
-    QMap<QString, QgsRasterBlock * > _rasterData;
-    // Cast to float
-    std::vector<float> castedResult( static_cast<size_t>( mNumOutputColumns ), 0 );
-    auto rowHeight = mOutputRectangle.height() / mNumOutputRows;
-    for ( size_t row = 0; row < static_cast<size_t>( mNumOutputRows ); ++row )
+    const int blockRows = std::clamp( RASTER_CALC_BLOCK_CELLS / std::max( mNumOutputColumns, 1 ), 1, std::max( mNumOutputRows, 1 ) );
+    const double rowHeight = mOutputRectangle.height() / mNumOutputRows;
+    std::vector< std::unique_ptr< QgsRasterBlock > > inputBlocks( inputEntries.size() );
+
+    // The output of a block is written in the background while the next block is read and
+    // calculated, so two result buffers are used in turn
+    std::vector< float > results[2];
+    int resultIndex = 0;
+    QFuture< void > pendingWrite;
+
+    for ( int blockStart = 0; blockStart < mNumOutputRows; blockStart += blockRows )
     {
       if ( feedback )
       {
-        feedback->setProgress( 100.0 * static_cast< double >( row ) / mNumOutputRows );
+        feedback->setProgress( 100.0 * static_cast< double >( blockStart ) / mNumOutputRows );
       }
 
       if ( feedback && feedback->isCanceled() )
@@ -201,54 +222,76 @@ QgsRasterCalculator::Result QgsRasterCalculator::processCalculation( QgsFeedback
         break;
       }
 
-      // Calculates the rect for a single row read
+      const int rows = std::min( blockRows, mNumOutputRows - blockStart );
+
+      // Calculates the rect for the rows of the block
       QgsRectangle rect( mOutputRectangle );
-      rect.setYMaximum( rect.yMaximum() - rowHeight * row );
-      rect.setYMinimum( rect.yMaximum() - rowHeight );
+      rect.setYMaximum( rect.yMaximum() - rowHeight * blockStart );
+      rect.setYMinimum( rect.yMaximum() - rowHeight * rows );
 
-      // Read rows into input blocks
-      for ( auto &layerRef : inputBlocks )
+      // Read the block from every input. Data providers are not thread safe, so this
+      // happens on the calling thread.
+      for ( std::size_t i = 0; i < inputEntries.size(); ++i )
       {
-        QgsRasterCalculatorEntry ref = uniqueRasterEntries[layerRef.first];
+        const QgsRasterCalculatorEntry &ref = inputEntries[i];
         if ( ref.raster->crs() != mOutputCrs )
         {
           QgsRasterProjector proj;
           proj.setCrs( ref.raster->crs(), mOutputCrs, mTransformContext );
           proj.setInput( ref.raster->dataProvider() );
           proj.setPrecision( QgsRasterProjector::Exact );
-          layerRef.second.reset( proj.block( ref.bandNumber, rect, mNumOutputColumns, 1 ) );
+          inputBlocks[i].reset( proj.block( ref.bandNumber, rect, mNumOutputColumns, rows ) );
         }
         else
         {
-          layerRef.second.reset( ref.raster->dataProvider()->block( ref.bandNumber, rect, mNumOutputColumns, 1 ) );
+          inputBlocks[i].reset( ref.raster->dataProvider()->block( ref.bandNumber, rect, mNumOutputColumns, rows ) );
         }
       }
 
-      // 1 row X mNumOutputColumns matrix
-      QgsRasterMatrix resultMatrix( mNumOutputColumns, 1, nullptr, outputNodataValue );
+      std::vector< float > &result = results[ resultIndex ];
+      result.resize( static_cast< std::size_t >( mNumOutputColumns ) * rows );
 
-      _rasterData.clear();
-      for ( const auto &layerRef : inputBlocks )
+      // Rows are independent, so they are calculated concurrently
+      auto calculateRow = [&]( int row )
       {
-        _rasterData.insert( layerRef.first, layerRef.second.get() );
-      }
-
-      if ( calcNode->calculate( _rasterData, resultMatrix, 0 ) )
+        // convert input values to double, also convert input no data to result no data
+        std::vector< std::vector< double > > values( inputBlocks.size(), std::vector< double >( mNumOutputColumns ) );
+        std::vector< const double * > inputs( inputBlocks.size() );
+        for ( std::size_t i = 0; i < inputBlocks.size(); ++i )
+        {
+          const QgsRasterBlock *block = inputBlocks[i].get();
+          double *data = values[i].data();
+          bool isNoData = false;
+          for ( int col = 0; col < mNumOutputColumns; ++col )
+          {
+            const double value = block->valueAndNoData( row, col, isNoData );
+            data[col] = isNoData ? outputNodataValue : value;
+          }
+          inputs[i] = data;
+        }
+        program.evaluate( inputs.data(), mNumOutputColumns, outputNodataValue, result.data() + static_cast< std::size_t >( row ) * mNumOutputColumns );
+      };
+
+      std::vector< int > blockRowIndices( rows );
+      std::iota( blockRowIndices.begin(), blockRowIndices.end(), 0 );
+      QtConcurrent::blockingMap( blockRowIndices, calculateRow );
+
+      // Only one write may access the output dataset at a time
+      pendingWrite.waitForFinished();
+      const int columns = mNumOutputColumns;
+      float *resultData = result.data();
+      pendingWrite = QtConcurrent::run( [outputRasterBand, blockStart, rows, columns, resultData]
       {
-        std::copy( resultMatrix.data(), resultMatrix.data() + mNumOutputColumns, castedResult.begin() );
-        if ( GDALRasterIO( outputRasterBand, GF_Write, 0, row, mNumOutputColumns, 1, castedResult.data(), mNumOutputColumns, 1, GDT_Float32, 0, 0 ) != CE_None )
+        if ( GDALRasterIO( outputRasterBand, GF_Write, 0, blockStart, columns, rows, resultData, columns, rows, GDT_Float32, 0, 0 ) != CE_None )
         {
           QgsDebugMsg( QStringLiteral( "RasterIO error!" ) );
         }
-      }
-      else
-      {
-        //delete the dataset without closing (because it is faster)
-        gdal::fast_delete_and_close( outputDataset, outputDriver, mOutputFile );
-        return CalculationError;
-      }
+      } );
+      resultIndex = 1 - resultIndex;
     }
 
+    pendingWrite.waitForFinished();
+
     if ( feedback )
     {
       feedback->setProgress( 100.0 );
@@ -38,6 +38,14 @@ class ANALYSIS_EXPORT QgsRuggednessFilter: public QgsNineCellFilter
                                  float *x12, float *x22, float *x32,
                                  float *x13, float *x23, float *x33 ) override;
 
+    void processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize ) override SIP_SKIP;
+    bool supportsConcurrentRows() const override SIP_SKIP { return true; }
+
+#ifndef SIP_RUN
+    // processRowWith() calls the protected window calculation
+    friend class QgsNineCellFilter;
+#endif
+
 #ifdef HAVE_OPENCL
   private:
     QgsRuggednessFilter();
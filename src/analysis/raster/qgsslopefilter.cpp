@@ -40,3 +40,7 @@ float QgsSlopeFilter::processNineCellWindow(
   return std::atan( std::sqrt( derX * derX + derY * derY ) ) * 180.0 / M_PI;
 }
 
+void QgsSlopeFilter::processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize )
+{
+  processRowWith< QgsSlopeFilter >( scanLine1, scanLine2, scanLine3, resultLine, xSize );
+}
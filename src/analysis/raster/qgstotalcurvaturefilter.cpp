@@ -41,3 +41,8 @@ float QgsTotalCurvatureFilter::processNineCellWindow( float *x11, float *x21, fl
 
   return dxx * dxx + 2 * dxy * dxy + dyy * dyy;
 }
+
+void QgsTotalCurvatureFilter::processNineCellRow( float *scanLine1, float *scanLine2, float *scanLine3, float *resultLine, int xSize )
+{
+  processRowWith< QgsTotalCurvatureFilter >( scanLine1, scanLine2, scanLine3, resultLine, xSize );
+}
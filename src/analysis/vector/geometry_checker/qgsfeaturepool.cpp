@@ -22,6 +22,7 @@
 #include "qgsvectordataprovider.h"
 #include "qgsvectorlayerutils.h"
 #include "qgsreadwritelocker.h"
+#include "qgsgeometryengine.h"
 
 #include <QMutexLocker>
 #include <QThread>
@@ -78,6 +79,7 @@ QgsFeatureIds QgsFeaturePool::getFeatures( const QgsFeatureRequest &request, Qgs
 
   mFeatureCache.clear();
   mIndex = QgsSpatialIndex();
+  mPreparedGeometries.clear();
 
   QgsFeatureIds fids;
 
@@ -134,6 +136,7 @@ void QgsFeaturePool::refreshCache( const QgsFeature &feature )
   mFeatureCache.remove( feature.id() );
   mIndex.deleteFeature( feature );
   locker.unlock();
+  invalidatePreparedGeometries( feature.id() );
 
   QgsFeature tempFeature;
   getFeature( feature.id(), tempFeature );
@@ -150,6 +153,19 @@ void QgsFeaturePool::removeFeature( const QgsFeatureId featureId )
   }
   locker.changeMode( QgsReadWriteLocker::Write );
   mFeatureCache.remove( origFeature.id() );
+  locker.unlock();
+  invalidatePreparedGeometries( featureId );
+}
+
+std::shared_ptr<QgsGeometryEngine> QgsFeaturePool::preparedGeometryEngine( QgsFeatureId id, const QgsGeometry &geometry, bool mapCrs, double tolerance ) const
+{
+  return mPreparedGeometries.engine( mapCrs ? QStringLiteral( "map" ) : QStringLiteral( "layer" ), id, geometry, tolerance );
+}
+
+void QgsFeaturePool::invalidatePreparedGeometries( QgsFeatureId id )
+{
+  mPreparedGeometries.invalidate( QStringLiteral( "map" ), id );
+  mPreparedGeometries.invalidate( QStringLiteral( "layer" ), id );
 }
 
 void QgsFeaturePool::setFeatureIds( const QgsFeatureIds &ids )
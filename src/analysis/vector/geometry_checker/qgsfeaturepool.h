@@ -26,6 +26,9 @@
 #include "qgsspatialindex.h"
 #include "qgsfeaturesink.h"
 #include "qgsvectorlayerfeatureiterator.h"
+#include "qgspreparedgeometrycache.h"
+
+class QgsGeometryEngine;
 
 /**
  * \ingroup analysis
@@ -133,6 +136,20 @@ class ANALYSIS_EXPORT QgsFeaturePool : public QgsFeatureSink SIP_ABSTRACT
      */
     QString layerName() const;
 
+    /**
+     * Returns a prepared geometry engine for the feature with the specified \a id, created
+     * from \a geometry with the given \a tolerance. \a mapCrs must be TRUE if \a geometry
+     * has been transformed to the map CRS of the check context.
+     *
+     * Engines are cached per thread, so that features which are tested repeatedly,
+     * e.g. by several checks or while fixing errors, are only prepared once. Cached
+     * engines are discarded when the feature is updated or removed from the pool.
+     *
+     * \note not available in Python bindings
+     * \since QGIS 3.20
+     */
+    std::shared_ptr< QgsGeometryEngine > preparedGeometryEngine( QgsFeatureId id, const QgsGeometry &geometry, bool mapCrs, double tolerance ) const SIP_SKIP;
+
   protected:
 
     /**
@@ -171,6 +188,10 @@ class ANALYSIS_EXPORT QgsFeaturePool : public QgsFeatureSink SIP_ABSTRACT
     bool isFeatureCached( QgsFeatureId fid ) SIP_SKIP;
 
   private:
+
+    //! Discards the cached prepared geometries of the feature with matching \a id
+    void invalidatePreparedGeometries( QgsFeatureId id );
+
 #ifdef SIP_RUN
     QgsFeaturePool( const QgsFeaturePool &other )
     {}
@@ -185,6 +206,7 @@ class ANALYSIS_EXPORT QgsFeaturePool : public QgsFeatureSink SIP_ABSTRACT
     QgsWkbTypes::GeometryType mGeometryType;
     std::unique_ptr<QgsVectorLayerFeatureSource> mFeatureSource;
     QString mLayerName;
+    mutable QgsPreparedGeometryCache mPreparedGeometries;
 };
 
 #endif // QGS_FEATUREPOOL_H
@@ -72,6 +72,11 @@ QgsGeometry QgsGeometryCheckerUtils::LayerFeature::geometry() const
   return mGeometry;
 }
 
+std::shared_ptr<QgsGeometryEngine> QgsGeometryCheckerUtils::LayerFeature::preparedGeometryEngine( double tolerance ) const
+{
+  return mFeaturePool->preparedGeometryEngine( mFeature.id(), mGeometry, mMapCrs, tolerance );
+}
+
 QString QgsGeometryCheckerUtils::LayerFeature::id() const
 {
   return QStringLiteral( "%1:%2" ).arg( mFeaturePool->layerName() ).arg( mFeature.id() );
@@ -83,6 +83,17 @@ class ANALYSIS_EXPORT QgsGeometryCheckerUtils
          */
         QgsGeometry geometry() const;
 
+        /**
+         * Returns a prepared geometry engine for geometry(), using the given \a tolerance.
+         *
+         * The engine is cached by the feature pool, so repeated calls for the same feature
+         * from the same thread will not prepare the geometry again.
+         *
+         * \note not available in Python bindings
+         * \since QGIS 3.20
+         */
+        std::shared_ptr< QgsGeometryEngine > preparedGeometryEngine( double tolerance ) const SIP_SKIP;
+
         /**
          * Returns a combination of the layerId and the feature id.
          */
@@ -44,8 +44,7 @@ void QgsGeometryOverlapCheck::collectErrors( const QMap<QString, QgsFeaturePool
 
     const QgsGeometry geomA = layerFeatureA.geometry();
     QgsRectangle bboxA = geomA.boundingBox();
-    std::unique_ptr< QgsGeometryEngine > geomEngineA = QgsGeometryCheckerUtils::createGeomEngine( geomA.constGet(), mContext->tolerance );
-    geomEngineA->prepareGeometry();
+    const std::shared_ptr< QgsGeometryEngine > geomEngineA = layerFeatureA.preparedGeometryEngine( mContext->tolerance );
     if ( !geomEngineA->isValid() )
     {
       messages.append( tr( "Overlap check failed for (%1): the geometry is invalid" ).arg( layerFeatureA.id() ) );
@@ -112,8 +111,7 @@ void QgsGeometryOverlapCheck::fixError( const QMap<QString, QgsFeaturePool *> &f
   QgsGeometryCheckerUtils::LayerFeature layerFeatureA( featurePoolA, featureA, mContext, true );
   QgsGeometryCheckerUtils::LayerFeature layerFeatureB( featurePoolB, featureB, mContext, true );
   const QgsGeometry geometryA = layerFeatureA.geometry();
-  std::unique_ptr< QgsGeometryEngine > geomEngineA = QgsGeometryCheckerUtils::createGeomEngine( geometryA.constGet(), mContext->tolerance );
-  geomEngineA->prepareGeometry();
+  const std::shared_ptr< QgsGeometryEngine > geomEngineA = layerFeatureA.preparedGeometryEngine( mContext->tolerance );
 
   const QgsGeometry geometryB = layerFeatureB.geometry();
   if ( !geomEngineA->overlaps( geometryB.constGet() ) )
@@ -27,9 +27,12 @@
 #include "qgsrasterlayer.h"
 #include "qgslogger.h"
 #include "qgsproject.h"
+#include "qgszonalsweep_p.h"
 
 #include <QFile>
 
+#include <algorithm>
+
 QgsZonalStatistics::QgsZonalStatistics( QgsVectorLayer *polygonLayer, QgsRasterLayer *rasterLayer, const QString &attributePrefix, int rasterBand, QgsZonalStatistics::Statistics stats )
   : QgsZonalStatistics( polygonLayer,
                         rasterLayer ? rasterLayer->dataProvider() : nullptr,
@@ -110,8 +113,6 @@ QgsZonalStatistics::Result QgsZonalStatistics::calculateStatistics( QgsFeedback
 
   vectorProvider->addAttributes( newFieldList );
 
-  long featureCount = vectorProvider->featureCount();
-
   QgsFeatureRequest request;
   request.setNoAttributes();
 
@@ -119,39 +120,64 @@ QgsZonalStatistics::Result QgsZonalStatistics::calculateStatistics( QgsFeedback
   QgsFeatureIterator fi = vectorProvider->getFeatures( request );
   QgsFeature feature;
 
-  int featureCounter = 0;
+  // zones are gathered in batches, and the raster is read in a single sweep per batch
+  const long featureCount = vectorProvider->featureCount();
+  const int batchCount = featureCount > 0 ? static_cast< int >( ( featureCount + ZONAL_STATISTICS_BATCH_FEATURES - 1 ) / ZONAL_STATISTICS_BATCH_FEATURES ) : 1;
+  int currentBatch = 0;
 
-  QgsChangedAttributesMap changeMap;
-  while ( fi.nextFeature( feature ) )
+  // scales the progress of each sweep to its share of the whole calculation
+  QgsFeedback batchFeedback;
+  if ( feedback )
   {
-    ++featureCounter;
-    if ( feedback && feedback->isCanceled() )
+    QObject::connect( feedback, &QgsFeedback::canceled, &batchFeedback, &QgsFeedback::cancel, Qt::DirectConnection );
+    QObject::connect( &batchFeedback, &QgsFeedback::progressChanged, feedback, [feedback, &currentBatch, batchCount]( double progress )
     {
-      break;
-    }
+      feedback->setProgress( ( std::min( currentBatch, batchCount - 1 ) * 100.0 + progress ) / batchCount );
+    }, Qt::DirectConnection );
+  }
+
+  QVector< QgsFeatureId > featureIds;
+  QVector< QgsGeometry > geometries;
+  auto processBatch = [&]
+  {
+    const QList< QMap<QgsZonalStatistics::Statistic, QVariant> > results = calculateStatistics( mRasterInterface, geometries, mCellSizeX, mCellSizeY, mRasterBand, mStatistics, mExactCoverage, feedback ? &batchFeedback : nullptr );
+    currentBatch++;
 
-    if ( feedback )
+    QgsChangedAttributesMap changeMap;
+    for ( int i = 0; i < results.size(); ++i )
     {
-      feedback->setProgress( 100.0 * static_cast< double >( featureCounter ) / featureCount );
-    }
+      if ( results.at( i ).empty() )
+        continue;
 
-    QgsGeometry featureGeometry = feature.geometry();
+      QgsAttributeMap changeAttributeMap;
+      for ( auto result = results.at( i ).constBegin(); result != results.at( i ).constEnd(); ++result )
+      {
+        changeAttributeMap.insert( statFieldIndexes.value( result.key() ), result.value() );
+      }
 
-    QMap<QgsZonalStatistics::Statistic, QVariant> results = calculateStatistics( mRasterInterface, featureGeometry, mCellSizeX, mCellSizeY, mRasterBand, mStatistics );
+      changeMap.insert( featureIds.at( i ), changeAttributeMap );
+    }
+    vectorProvider->changeAttributeValues( changeMap );
 
-    if ( results.empty() )
-      continue;
+    featureIds.clear();
+    geometries.clear();
+  };
 
-    QgsAttributeMap changeAttributeMap;
-    for ( const auto &result : results.toStdMap() )
+  while ( fi.nextFeature( feature ) )
+  {
+    if ( feedback && feedback->isCanceled() )
     {
-      changeAttributeMap.insert( statFieldIndexes.value( result.first ), result.second );
+      break;
     }
 
-    changeMap.insert( feature.id(), changeAttributeMap );
+    featureIds << feature.id();
+    geometries << feature.geometry();
+    if ( geometries.size() >= ZONAL_STATISTICS_BATCH_FEATURES )
+      processBatch();
   }
+  if ( !geometries.empty() && !( feedback && feedback->isCanceled() ) )
+    processBatch();
 
-  vectorProvider->changeAttributeValues( changeMap );
   mPolygonLayer->updateFields();
 
   if ( feedback )
@@ -339,7 +365,69 @@ QMap<QgsZonalStatistics::Statistic, QVariant> QgsZonalStatistics::calculateStati
     QgsRasterAnalysisUtils::statisticsFromPreciseIntersection( rasterInterface, rasterBand, geometry, nCellsX, nCellsY, cellSizeX, cellSizeY, rasterBlockExtent, [ &featureStats ]( double value, double weight ) { featureStats.addValue( value, weight ); } );
   }
 
-  // calculate the statistics
+  return statisticsResults( featureStats, statistics );
+}
+
+QList< QMap<QgsZonalStatistics::Statistic, QVariant> > QgsZonalStatistics::calculateStatistics( QgsRasterInterface *rasterInterface, const QVector< QgsGeometry > &geometries, double cellSizeX, double cellSizeY, int rasterBand, QgsZonalStatistics::Statistics statistics, bool exactCoverage, QgsFeedback *feedback )
+{
+  QList< QMap<QgsZonalStatistics::Statistic, QVariant> > results;
+  if ( !rasterInterface )
+    return results;
+
+  QgsZonalSweep sweep( rasterInterface, rasterBand, cellSizeX, cellSizeY );
+  for ( const QgsGeometry &geometry : geometries )
+    sweep.addZone( geometry );
+
+  bool statsStoreValues = ( statistics & QgsZonalStatistics::Median ) ||
+                          ( statistics & QgsZonalStatistics::StDev ) ||
+                          ( statistics & QgsZonalStatistics::Variance );
+  bool statsStoreValueCount = ( statistics & QgsZonalStatistics::Minority ) ||
+                              ( statistics & QgsZonalStatistics::Majority );
+
+  std::vector< FeatureStats > featureStats( static_cast< std::size_t >( geometries.size() ), FeatureStats( statsStoreValues, statsStoreValueCount ) );
+  const QgsZonalSweep::Visitor addValue = [&featureStats]( int zone, double value, double weight )
+  {
+    featureStats[ static_cast< std::size_t >( zone ) ].addValue( value, weight );
+  };
+
+  if ( exactCoverage )
+  {
+    if ( !sweep.run( QgsZonalSweep::Coverage::ExactFraction, std::vector< int >(), addValue, feedback ) )
+      return results;
+  }
+  else
+  {
+    if ( !sweep.run( QgsZonalSweep::Coverage::CellCenter, std::vector< int >(), addValue, feedback ) )
+      return results;
+
+    // as for a single geometry, zones smaller than a cell switch to the precise pixel - polygon intersection
+    std::vector< int > smallZones;
+    for ( int zone = 0; zone < sweep.zoneCount(); ++zone )
+    {
+      if ( sweep.isValidZone( zone ) && featureStats[ static_cast< std::size_t >( zone ) ].count <= 1 )
+      {
+        featureStats[ static_cast< std::size_t >( zone ) ].reset();
+        smallZones.push_back( zone );
+      }
+    }
+    if ( !smallZones.empty() && !sweep.run( QgsZonalSweep::Coverage::ExactFraction, smallZones, addValue, feedback ) )
+      return results;
+  }
+
+  results.reserve( geometries.size() );
+  for ( int zone = 0; zone < sweep.zoneCount(); ++zone )
+  {
+    if ( sweep.isValidZone( zone ) )
+      results << statisticsResults( featureStats[ static_cast< std::size_t >( zone ) ], statistics );
+    else
+      results << QMap<QgsZonalStatistics::Statistic, QVariant>();
+  }
+  return results;
+}
+
+QMap<QgsZonalStatistics::Statistic, QVariant> QgsZonalStatistics::statisticsResults( FeatureStats &featureStats, QgsZonalStatistics::Statistics statistics )
+{
+  QMap<QgsZonalStatistics::Statistic, QVariant> results;
 
   if ( statistics & QgsZonalStatistics::Count )
     results.insert( QgsZonalStatistics::Count, QVariant( featureStats.count ) );
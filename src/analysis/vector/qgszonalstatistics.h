@@ -20,6 +20,7 @@
 
 #include <QString>
 #include <QMap>
+#include <QVector>
 
 #include <limits>
 #include <cfloat>
@@ -133,6 +134,27 @@ class ANALYSIS_EXPORT QgsZonalStatistics
      */
     QgsZonalStatistics::Result calculateStatistics( QgsFeedback *feedback );
 
+    /**
+     * Sets whether every pixel touching a zone is weighted by the exact fraction of its
+     * area covered by the zone.
+     *
+     * By default only pixels with their center inside a zone are counted, and the exact
+     * coverage is used for zones too small to contain more than one pixel center.
+     *
+     * \see exactCoverage()
+     * \since QGIS 3.20
+     */
+    void setExactCoverage( bool exact ) { mExactCoverage = exact; }
+
+    /**
+     * Returns TRUE if every pixel touching a zone is weighted by the exact fraction of its
+     * area covered by the zone.
+     *
+     * \see setExactCoverage()
+     * \since QGIS 3.20
+     */
+    bool exactCoverage() const { return mExactCoverage; }
+
     /**
      * Returns the friendly display name for a \a statistic.
      * \see shortName()
@@ -157,6 +179,25 @@ class ANALYSIS_EXPORT QgsZonalStatistics
      */
 #ifndef SIP_RUN
     static QMap<QgsZonalStatistics::Statistic, QVariant> calculateStatistics( QgsRasterInterface *rasterInterface, const QgsGeometry &geometry, double cellSizeX, double cellSizeY, int rasterBand, QgsZonalStatistics::Statistics statistics );
+
+    /**
+     * Calculates the specified \a statistics for the pixels of \a rasterBand
+     * in \a rasterInterface within each of the polygon \a geometries.
+     *
+     * Rather than reading the pixels below every polygon separately, all polygons are
+     * rasterized onto the pixel grid and the raster is read once, tile by tile, with the
+     * tiles processed concurrently. The results match calling calculateStatistics() for
+     * each geometry, unless \a exactCoverage is TRUE: then every pixel touching a polygon
+     * is weighted by the exact fraction of its area covered by the polygon.
+     *
+     * Returns a map of statistic to result value for each geometry, which is empty if the
+     * geometry does not overlap the raster. An empty list is returned if the calculation
+     * is canceled through \a feedback.
+     *
+     * \note Not available in Python bindings
+     * \since QGIS 3.20
+     */
+    static QList< QMap<QgsZonalStatistics::Statistic, QVariant> > calculateStatistics( QgsRasterInterface *rasterInterface, const QVector< QgsGeometry > &geometries, double cellSizeX, double cellSizeY, int rasterBand, QgsZonalStatistics::Statistics statistics, bool exactCoverage = false, QgsFeedback *feedback = nullptr );
 #endif
 
 ///@cond PRIVATE
@@ -226,6 +267,9 @@ class ANALYSIS_EXPORT QgsZonalStatistics
         bool mStoreValueCounts = false;
     };
 
+    //! Returns the requested \a statistics from the values gathered in \a featureStats
+    static QMap<QgsZonalStatistics::Statistic, QVariant> statisticsResults( FeatureStats &featureStats, QgsZonalStatistics::Statistics statistics );
+
     QString getUniqueFieldName( const QString &fieldName, const QList<QgsField> &newFields );
 
     QgsRasterInterface *mRasterInterface = nullptr;
@@ -239,6 +283,7 @@ class ANALYSIS_EXPORT QgsZonalStatistics
     QgsVectorLayer *mPolygonLayer = nullptr;
     QString mAttributePrefix;
     Statistics mStatistics = QgsZonalStatistics::All;
+    bool mExactCoverage = false;
 };
 
 Q_DECLARE_OPERATORS_FOR_FLAGS( QgsZonalStatistics::Statistics )
@@ -0,0 +1,502 @@
+/***************************************************************************
+    qgszonalsweep.cpp  -  Tile ordered sweep over raster zones
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgszonalsweep_p.h"
+#include "qgsfeedback.h"
+#include "qgsgeometryengine.h"
+#include "qgspoint.h"
+#include "qgsrasterblock.h"
+#include "qgsrasterinterface.h"
+#include "processing/qgsrasteranalysisutils.h"
+
+#include <QThread>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+///@cond PRIVATE
+
+//! Width and height in cells of the tiles the raster is swept in
+constexpr int ZONAL_SWEEP_TILE_SIZE = 512;
+
+//! Distance, relative to the cell size, below which a cell center is considered to be on a zone boundary
+constexpr double ZONAL_SWEEP_EPSILON = 1e-9;
+
+struct QgsZonalSweep::Tile
+{
+  std::vector< int > zones;
+
+  // the cells read for this tile, covering all its zones
+  int left = 0;
+  int top = 0;
+  int right = -1;
+  int bottom = -1;
+
+  std::unique_ptr< QgsRasterBlock > block;
+  std::vector< Contribution > contributions;
+
+  //! Returns the value of the cell at \a row and \a column, or FALSE if it is nodata or not a valid value
+  bool value( int row, int column, double &value ) const
+  {
+    bool isNoData = false;
+    value = block->valueAndNoData( row - top, column - left, isNoData );
+    return !isNoData && QgsRasterAnalysisUtils::validPixel( value );
+  }
+};
+
+void QgsZonalSweep::clipRing( const std::vector< QgsPointXY > &ring, bool clipX, double limit, bool keepAbove, std::vector< QgsPointXY > &result )
+{
+  result.clear();
+  if ( ring.empty() )
+    return;
+
+  auto coordinate = [clipX]( const QgsPointXY & point ) { return clipX ? point.x() : point.y(); };
+  auto inside = [&]( const QgsPointXY & point ) { return keepAbove ? coordinate( point ) >= limit : coordinate( point ) <= limit; };
+  auto intersection = [&]( const QgsPointXY & a, const QgsPointXY & b )
+  {
+    // the new vertex is placed exactly on the limit, which identifies edges created by clipping
+    const double t = ( limit - coordinate( a ) ) / ( coordinate( b ) - coordinate( a ) );
+    return clipX ? QgsPointXY( limit, a.y() + t * ( b.y() - a.y() ) ) : QgsPointXY( a.x() + t * ( b.x() - a.x() ), limit );
+  };
+
+  QgsPointXY previous = ring.back();
+  bool previousInside = inside( previous );
+  for ( const QgsPointXY &current : ring )
+  {
+    const bool currentInside = inside( current );
+    if ( currentInside != previousInside )
+      result.push_back( intersection( previous, current ) );
+    if ( currentInside )
+      result.push_back( current );
+    previous = current;
+    previousInside = currentInside;
+  }
+}
+
+double QgsZonalSweep::ringArea( const std::vector< QgsPointXY > &ring )
+{
+  double area = 0;
+  const std::size_t count = ring.size();
+  for ( std::size_t i = 0; i < count; ++i )
+  {
+    const QgsPointXY &a = ring[i];
+    const QgsPointXY &b = ring[( i + 1 ) % count];
+    area += a.x() * b.y() - b.x() * a.y();
+  }
+  return std::fabs( area ) / 2.0;
+}
+
+//! Appends the x coordinate where the edge from \a a to \a b crosses the horizontal line at \a y, with the half open rule of point in polygon tests
+static void addCrossing( const QgsPointXY &a, const QgsPointXY &b, double y, double epsilon, std::vector< double > &crossings, bool &vertexOnLine )
+{
+  if ( std::fabs( a.y() - y ) <= epsilon || std::fabs( b.y() - y ) <= epsilon )
+    vertexOnLine = true;
+  if ( ( a.y() > y ) != ( b.y() > y ) )
+    crossings.push_back( a.x() + ( y - a.y() ) * ( b.x() - a.x() ) / ( b.y() - a.y() ) );
+}
+
+QgsZonalSweep::QgsZonalSweep( QgsRasterInterface *rasterInterface, int rasterBand, double cellSizeX, double cellSizeY )
+  : mRasterInterface( rasterInterface )
+  , mRasterBand( rasterBand )
+  , mCellSizeX( std::fabs( cellSizeX ) )
+  , mCellSizeY( std::fabs( cellSizeY ) )
+{
+  if ( mRasterInterface )
+  {
+    mExtent = mRasterInterface->extent();
+    mWidth = mRasterInterface->xSize();
+    mHeight = mRasterInterface->ySize();
+  }
+}
+
+bool QgsZonalSweep::addZone( const QgsGeometry &geometry )
+{
+  Zone zone;
+  const QgsRectangle zoneExtent = geometry.isEmpty() ? QgsRectangle() : geometry.boundingBox().intersect( mExtent );
+  if ( !zoneExtent.isEmpty() && mWidth > 0 && mHeight > 0 && mCellSizeX > 0 && mCellSizeY > 0 )
+  {
+    // same cells as QgsRasterAnalysisUtils::cellInfoForBBox()
+    zone.firstColumn = std::clamp( static_cast< int >( std::floor( ( zoneExtent.xMinimum() - mExtent.xMinimum() ) / mCellSizeX ) ), 0, mWidth - 1 );
+    zone.lastColumn = std::clamp( static_cast< int >( std::floor( ( zoneExtent.xMaximum() - mExtent.xMinimum() ) / mCellSizeX ) ), 0, mWidth - 1 );
+    zone.firstRow = std::clamp( static_cast< int >( std::floor( ( mExtent.yMaximum() - zoneExtent.yMaximum() ) / mCellSizeY ) ), 0, mHeight - 1 );
+    zone.lastRow = std::clamp( static_cast< int >( std::floor( ( mExtent.yMaximum() - zoneExtent.yMinimum() ) / mCellSizeY ) ), 0, mHeight - 1 );
+
+    const QgsMultiPolygonXY polygons = geometry.isMultipart() ? geometry.asMultiPolygon() : QgsMultiPolygonXY() << geometry.asPolygon();
+    for ( const QgsPolygonXY &polygon : polygons )
+    {
+      for ( int i = 0; i < polygon.size(); ++i )
+      {
+        Ring ring;
+        ring.hole = i > 0;
+        ring.points.assign( polygon.at( i ).constBegin(), polygon.at( i ).constEnd() );
+        // rings are handled as implicitly closed
+        if ( ring.points.size() > 1 && ring.points.front() == ring.points.back() )
+          ring.points.pop_back();
+        if ( ring.points.size() >= 3 )
+          zone.rings.emplace_back( std::move( ring ) );
+      }
+    }
+
+    zone.geometry = geometry;
+    zone.valid = !zone.rings.empty();
+  }
+
+  mZones.emplace_back( std::move( zone ) );
+  return mZones.back().valid;
+}
+
+bool QgsZonalSweep::run( Coverage coverage, const std::vector< int > &zones, const Visitor &visitor, QgsFeedback *feedback ) const
+{
+  if ( !mRasterInterface || mWidth <= 0 || mHeight <= 0 )
+    return true;
+
+  // assign the zones to the tiles they overlap, growing the part of each tile to read
+  const int tileColumns = ( mWidth + ZONAL_SWEEP_TILE_SIZE - 1 ) / ZONAL_SWEEP_TILE_SIZE;
+  const int tileRows = ( mHeight + ZONAL_SWEEP_TILE_SIZE - 1 ) / ZONAL_SWEEP_TILE_SIZE;
+  std::vector< Tile > tiles( static_cast< std::size_t >( tileColumns ) * tileRows );
+  auto assignZone = [&]( int zoneIndex )
+  {
+    const Zone &zone = mZones[ static_cast< std::size_t >( zoneIndex ) ];
+    if ( !zone.valid )
+      return;
+
+    for ( int tileRow = zone.firstRow / ZONAL_SWEEP_TILE_SIZE; tileRow <= zone.lastRow / ZONAL_SWEEP_TILE_SIZE; ++tileRow )
+    {
+      for ( int tileColumn = zone.firstColumn / ZONAL_SWEEP_TILE_SIZE; tileColumn <= zone.lastColumn / ZONAL_SWEEP_TILE_SIZE; ++tileColumn )
+      {
+        Tile &tile = tiles[ static_cast< std::size_t >( tileRow ) * tileColumns + tileColumn ];
+        const int left = std::max( zone.firstColumn, tileColumn * ZONAL_SWEEP_TILE_SIZE );
+        const int right = std::min( zone.lastColumn, ( tileColumn + 1 ) * ZONAL_SWEEP_TILE_SIZE - 1 );
+        const int top = std::max( zone.firstRow, tileRow * ZONAL_SWEEP_TILE_SIZE );
+        const int bottom = std::min( zone.lastRow, ( tileRow + 1 ) * ZONAL_SWEEP_TILE_SIZE - 1 );
+        if ( tile.zones.empty() )
+        {
+          tile.left = left;
+          tile.right = right;
+          tile.top = top;
+          tile.bottom = bottom;
+        }
+        else
+        {
+          tile.left = std::min( tile.left, left );
+          tile.right = std::max( tile.right, right );
+          tile.top = std::min( tile.top, top );
+          tile.bottom = std::max( tile.bottom, bottom );
+        }
+        tile.zones.push_back( zoneIndex );
+      }
+    }
+  };
+
+  if ( zones.empty() )
+  {
+    for ( int zone = 0; zone < zoneCount(); ++zone )
+      assignZone( zone );
+  }
+  else
+  {
+    for ( int zone : zones )
+      assignZone( zone );
+  }
+
+  std::vector< Tile * > pending;
+  for ( Tile &tile : tiles )
+  {
+    if ( !tile.zones.empty() )
+      pending.push_back( &tile );
+  }
+
+  const std::size_t batchSize = static_cast< std::size_t >( std::max( 1, QThread::idealThreadCount() ) );
+  for ( std::size_t first = 0; first < pending.size(); first += batchSize )
+  {
+    if ( feedback && feedback->isCanceled() )
+      return false;
+
+    std::vector< Tile * > batch( pending.begin() + first, pending.begin() + std::min( first + batchSize, pending.size() ) );
+
+    // providers are not thread safe, so the blocks are read on this thread
+    for ( Tile *tile : batch )
+    {
+      const QgsRectangle extent( mExtent.xMinimum() + tile->left * mCellSizeX,
+                                 mExtent.yMaximum() - ( tile->bottom + 1 ) * mCellSizeY,
+                                 mExtent.xMinimum() + ( tile->right + 1 ) * mCellSizeX,
+                                 mExtent.yMaximum() - tile->top * mCellSizeY );
+      tile->block.reset( mRasterInterface->block( mRasterBand, extent, tile->right - tile->left + 1, tile->bottom - tile->top + 1, feedback ) );
+    }
+
+    QtConcurrent::blockingMap( batch, [this, coverage]( Tile * tile )
+    {
+      if ( !tile->block || tile->block->isEmpty() )
+        return;
+
+      for ( int zone : tile->zones )
+      {
+        switch ( coverage )
+        {
+          case Coverage::CellCenter:
+            rasterizeCellCenters( mZones[ static_cast< std::size_t >( zone ) ], zone, *tile );
+            break;
+          case Coverage::ExactFraction:
+            rasterizeExactFraction( mZones[ static_cast< std::size_t >( zone ) ], zone, *tile );
+            break;
+        }
+      }
+    } );
+
+    for ( Tile *tile : batch )
+    {
+      for ( const Contribution &contribution : tile->contributions )
+        visitor( contribution.zone, contribution.value, contribution.weight );
+
+      tile->block.reset();
+      tile->contributions = std::vector< Contribution >();
+    }
+
+    if ( feedback )
+      feedback->setProgress( 100.0 * static_cast< double >( first + batch.size() ) / static_cast< double >( pending.size() ) );
+  }
+
+  return !( feedback && feedback->isCanceled() );
+}
+
+void QgsZonalSweep::rasterizeCellCenters( const Zone &zone, int zoneIndex, Tile &tile ) const
+{
+  const int firstRow = std::max( zone.firstRow, tile.top );
+  const int lastRow = std::min( zone.lastRow, tile.bottom );
+  const int firstColumn = std::max( zone.firstColumn, tile.left );
+  const int lastColumn = std::min( zone.lastColumn, tile.right );
+  const int rowCount = lastRow - firstRow + 1;
+  if ( rowCount <= 0 || firstColumn > lastColumn )
+    return;
+
+  const double epsilonX = mCellSizeX * ZONAL_SWEEP_EPSILON;
+  const double epsilonY = mCellSizeY * ZONAL_SWEEP_EPSILON;
+
+  // bucket the edges by the rows whose center line they may cross or touch
+  std::vector< std::pair< QgsPointXY, QgsPointXY > > edges;
+  std::vector< int > edgeRows;
+  std::vector< int > rowOffsets( static_cast< std::size_t >( rowCount ) + 1, 0 );
+  for ( const Ring &ring : zone.rings )
+  {
+    const std::size_t count = ring.points.size();
+    for ( std::size_t i = 0; i < count; ++i )
+    {
+      const QgsPointXY &a = ring.points[i];
+      const QgsPointXY &b = ring.points[( i + 1 ) % count];
+      const double minY = std::min( a.y(), b.y() ) - epsilonY;
+      const double maxY = std::max( a.y(), b.y() ) + epsilonY;
+      // clamped before the conversion, zones may extend far beyond the raster
+      const int edgeFirstRow = static_cast< int >( std::max< double >( firstRow, std::ceil( ( mExtent.yMaximum() - maxY ) / mCellSizeY - 0.5 ) ) );
+      const int edgeLastRow = static_cast< int >( std::min< double >( lastRow, std::floor( ( mExtent.yMaximum() - minY ) / mCellSizeY - 0.5 ) ) );
+      if ( edgeFirstRow > edgeLastRow )
+        continue;
+
+      edges.emplace_back( a, b );
+      edgeRows.push_back( edgeFirstRow );
+      edgeRows.push_back( edgeLastRow );
+      for ( int row = edgeFirstRow; row <= edgeLastRow; ++row )
+        rowOffsets[ static_cast< std::size_t >( row - firstRow ) + 1 ]++;
+    }
+  }
+  if ( edges.empty() )
+    return;
+
+  for ( std::size_t row = 0; row < static_cast< std::size_t >( rowCount ); ++row )
+    rowOffsets[row + 1] += rowOffsets[row];
+  std::vector< int > rowEdges( static_cast< std::size_t >( rowOffsets.back() ) );
+  std::vector< int > rowFill( rowOffsets.begin(), rowOffsets.end() - 1 );
+  for ( std::size_t edge = 0; edge < edges.size(); ++edge )
+  {
+    for ( int row = edgeRows[ 2 * edge ]; row <= edgeRows[ 2 * edge + 1 ]; ++row )
+      rowEdges[ static_cast< std::size_t >( rowFill[ static_cast< std::size_t >( row - firstRow ) ]++ ) ] = static_cast< int >( edge );
+  }
+
+  // centers on or next to the boundary are left to GEOS, like in statisticsFromMiddlePointTest()
+  std::unique_ptr< QgsGeometryEngine > engine;
+  auto containsCenter = [&zone, &engine]( double x, double y )
+  {
+    if ( !engine )
+    {
+      engine.reset( QgsGeometry::createGeometryEngine( zone.geometry.constGet() ) );
+      if ( !engine )
+        return false;
+      engine->prepareGeometry();
+    }
+    const QgsPoint center( x, y );
+    return engine->contains( &center );
+  };
+
+  std::vector< double > crossings;
+  double value = 0;
+  for ( int row = firstRow; row <= lastRow; ++row )
+  {
+    const double y = mExtent.yMaximum() - ( row + 0.5 ) * mCellSizeY;
+    crossings.clear();
+    bool vertexOnRow = false;
+    for ( int i = rowOffsets[ static_cast< std::size_t >( row - firstRow ) ]; i < rowOffsets[ static_cast< std::size_t >( row - firstRow ) + 1 ]; ++i )
+    {
+      const std::pair< QgsPointXY, QgsPointXY > &edge = edges[ static_cast< std::size_t >( rowEdges[ static_cast< std::size_t >( i ) ] ) ];
+      addCrossing( edge.first, edge.second, y, epsilonY, crossings, vertexOnRow );
+    }
+    if ( crossings.empty() && !vertexOnRow )
+      continue;
+
+    std::sort( crossings.begin(), crossings.end() );
+    std::size_t next = 0;
+    for ( int column = firstColumn; column <= lastColumn; ++column )
+    {
+      const double x = mExtent.xMinimum() + ( column + 0.5 ) * mCellSizeX;
+      while ( next < crossings.size() && crossings[next] < x - epsilonX )
+        ++next;
+
+      const bool onBoundary = vertexOnRow || ( next < crossings.size() && crossings[next] <= x + epsilonX );
+      if ( !onBoundary && next % 2 == 0 )
+        continue;
+
+      if ( !tile.value( row, column, value ) )
+        continue;
+
+      if ( onBoundary && !containsCenter( x, y ) )
+        continue;
+
+      tile.contributions.push_back( { zoneIndex, value, 1.0 } );
+    }
+  }
+}
+
+void QgsZonalSweep::rasterizeExactFraction( const Zone &zone, int zoneIndex, Tile &tile ) const
+{
+  const int firstRow = std::max( zone.firstRow, tile.top );
+  const int lastRow = std::min( zone.lastRow, tile.bottom );
+  const int firstColumn = std::max( zone.firstColumn, tile.left );
+  const int lastColumn = std::min( zone.lastColumn, tile.right );
+  if ( firstRow > lastRow || firstColumn > lastColumn )
+    return;
+
+  const double left = mExtent.xMinimum() + firstColumn * mCellSizeX;
+  const double right = mExtent.xMinimum() + ( lastColumn + 1 ) * mCellSizeX;
+  const double top = mExtent.yMaximum() - firstRow * mCellSizeY;
+  const double bottom = mExtent.yMaximum() - ( lastRow + 1 ) * mCellSizeY;
+
+  // clip the rings to the cells of the zone in this tile first, so rows only walk nearby vertices
+  std::vector< QgsPointXY > scratch;
+  std::vector< QgsPointXY > clipped;
+  std::vector< Ring > windowRings;
+  for ( const Ring &ring : zone.rings )
+  {
+    clipRing( ring.points, true, left, true, scratch );
+    clipRing( scratch, true, right, false, clipped );
+    clipRing( clipped, false, bottom, true, scratch );
+    clipRing( scratch, false, top, false, clipped );
+    if ( clipped.size() >= 3 )
+      windowRings.push_back( { clipped, ring.hole } );
+  }
+  if ( windowRings.empty() )
+    return;
+
+  const double cellArea = mCellSizeX * mCellSizeY;
+  const double epsilonY = mCellSizeY * ZONAL_SWEEP_EPSILON;
+  std::vector< Ring > stripRings( windowRings.size() );
+  std::vector< char > boundary( static_cast< std::size_t >( lastColumn - firstColumn + 1 ) );
+  std::vector< double > crossings;
+  std::vector< QgsPointXY > cell;
+  double value = 0;
+  for ( int row = firstRow; row <= lastRow; ++row )
+  {
+    const double stripTop = mExtent.yMaximum() - row * mCellSizeY;
+    const double stripBottom = stripTop - mCellSizeY;
+    const double y = stripTop - 0.5 * mCellSizeY;
+
+    std::fill( boundary.begin(), boundary.end(), 0 );
+    crossings.clear();
+    bool vertexOnRow = false;
+    bool empty = true;
+    for ( std::size_t i = 0; i < windowRings.size(); ++i )
+    {
+      Ring &strip = stripRings[i];
+      strip.hole = windowRings[i].hole;
+      clipRing( windowRings[i].points, false, stripBottom, true, scratch );
+      clipRing( scratch, false, stripTop, false, strip.points );
+      if ( strip.points.size() < 3 )
+      {
+        strip.points.clear();
+        continue;
+      }
+      empty = false;
+
+      // cells crossed by an edge are partially covered, except for edges along the strip limits
+      const std::size_t count = strip.points.size();
+      for ( std::size_t j = 0; j < count; ++j )
+      {
+        const QgsPointXY &a = strip.points[j];
+        const QgsPointXY &b = strip.points[( j + 1 ) % count];
+        if ( a.y() == b.y() && ( a.y() == stripTop || a.y() == stripBottom ) )
+          continue;
+
+        const int edgeFirstColumn = std::max( firstColumn, static_cast< int >( std::floor( ( std::min( a.x(), b.x() ) - mExtent.xMinimum() ) / mCellSizeX ) ) );
+        const int edgeLastColumn = std::min( lastColumn, static_cast< int >( std::floor( ( std::max( a.x(), b.x() ) - mExtent.xMinimum() ) / mCellSizeX ) ) );
+        for ( int column = edgeFirstColumn; column <= edgeLastColumn; ++column )
+          boundary[ static_cast< std::size_t >( column - firstColumn ) ] = 1;
+
+        addCrossing( a, b, y, epsilonY, crossings, vertexOnRow );
+      }
+    }
+    if ( empty )
+      continue;
+
+    std::sort( crossings.begin(), crossings.end() );
+    std::size_t next = 0;
+    for ( int column = firstColumn; column <= lastColumn; ++column )
+    {
+      const double cellLeft = mExtent.xMinimum() + column * mCellSizeX;
+      const double x = cellLeft + 0.5 * mCellSizeX;
+      while ( next < crossings.size() && crossings[next] < x )
+        ++next;
+
+      // no edge touches the remaining cells, so their centers tell whether they are inside
+      const bool partial = boundary[ static_cast< std::size_t >( column - firstColumn ) ];
+      if ( !partial && next % 2 == 0 )
+        continue;
+
+      if ( !tile.value( row, column, value ) )
+        continue;
+
+      double weight = 1.0;
+      if ( partial )
+      {
+        double area = 0;
+        for ( const Ring &strip : stripRings )
+        {
+          if ( strip.points.empty() )
+            continue;
+          clipRing( strip.points, true, cellLeft, true, scratch );
+          clipRing( scratch, true, cellLeft + mCellSizeX, false, cell );
+          const double ringPartArea = cell.size() >= 3 ? ringArea( cell ) : 0.0;
+          area += strip.hole ? -ringPartArea : ringPartArea;
+        }
+        weight = area / cellArea;
+        if ( weight <= 0.0 )
+          continue;
+      }
+
+      tile.contributions.push_back( { zoneIndex, value, weight } );
+    }
+  }
+}
+
+///@endcond
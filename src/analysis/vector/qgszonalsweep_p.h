@@ -0,0 +1,168 @@
+/***************************************************************************
+    qgszonalsweep_p.h  -  Tile ordered sweep over raster zones
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSZONALSWEEP_P_H
+#define QGSZONALSWEEP_P_H
+
+#define SIP_NO_FILE
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QGIS API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+
+#include "qgsgeometry.h"
+#include "qgspointxy.h"
+#include "qgsrectangle.h"
+
+#include <functional>
+#include <vector>
+
+class QgsFeedback;
+class QgsRasterInterface;
+
+///@cond PRIVATE
+
+//! Number of features whose statistics are calculated in one sweep over the raster
+constexpr int ZONAL_STATISTICS_BATCH_FEATURES = 100000;
+
+/**
+ * \ingroup analysis
+ * \brief Rasterizes polygon zones onto the cell grid of a raster and visits the
+ * cells of all zones in a single sweep over the raster.
+ *
+ * The raster is split into square tiles. Each tile is read once, restricted to the
+ * cells covered by the zones overlapping it, and the zones of several tiles are
+ * rasterized concurrently with a scanline fill. Zones may overlap each other: a cell
+ * is visited once for every zone it belongs to.
+ *
+ * In CellCenter mode a cell belongs to a zone if its center is inside the zone, as
+ * tested by QgsRasterAnalysisUtils::statisticsFromMiddlePointTest(). Centers which lie
+ * on, or within rounding distance of, the zone boundary are resolved with GEOS, so the
+ * results match exactly. In ExactFraction mode every cell touching a zone is weighted
+ * by the fraction of its area covered by the zone, as in
+ * QgsRasterAnalysisUtils::statisticsFromPreciseIntersection().
+ */
+class QgsZonalSweep
+{
+  public:
+
+    //! Rule deciding which cells belong to a zone
+    enum class Coverage
+    {
+      CellCenter, //!< Cells with their center inside the zone, with weight 1
+      ExactFraction, //!< All cells intersecting the zone, weighted by the covered fraction of their area
+    };
+
+    /**
+     * Callback receiving the valid, non nodata cell values of a zone, with their weight.
+     */
+    typedef std::function< void( int zone, double value, double weight ) > Visitor;
+
+    /**
+     * Constructor for QgsZonalSweep, reading from band \a rasterBand of \a rasterInterface,
+     * which has cells of \a cellSizeX by \a cellSizeY map units.
+     *
+     * The raster interface must exist for the lifetime of the sweep.
+     */
+    QgsZonalSweep( QgsRasterInterface *rasterInterface, int rasterBand, double cellSizeX, double cellSizeY );
+
+    /**
+     * Adds a zone with the polygon \a geometry, in the raster CRS. Zones are numbered
+     * in the order in which they are added.
+     *
+     * Returns FALSE if the zone is empty or outside the raster, in which case it is
+     * never visited.
+     */
+    bool addZone( const QgsGeometry &geometry );
+
+    //! Returns the number of zones added
+    int zoneCount() const { return static_cast< int >( mZones.size() ); }
+
+    //! Returns TRUE if \a zone overlaps the raster
+    bool isValidZone( int zone ) const { return mZones[ static_cast< std::size_t >( zone ) ].valid; }
+
+    /**
+     * Sweeps the raster, passing the values of the cells of \a zones to \a visitor. All
+     * zones are visited if \a zones is empty.
+     *
+     * The visitor is called on the calling thread, tile by tile in row order, and always
+     * in the same order for the same input.
+     *
+     * Returns FALSE if the sweep was canceled through \a feedback.
+     */
+    bool run( Coverage coverage, const std::vector< int > &zones, const Visitor &visitor, QgsFeedback *feedback = nullptr ) const;
+
+    /**
+     * Clips \a ring to the half plane where the x (if \a clipX is TRUE) or y coordinate is at least
+     * (if \a keepAbove is TRUE) or at most \a limit, storing the clipped ring in \a result.
+     *
+     * The vertices created by clipping lie exactly on the limit.
+     */
+    static void clipRing( const std::vector< QgsPointXY > &ring, bool clipX, double limit, bool keepAbove, std::vector< QgsPointXY > &result );
+
+    //! Returns the area of the implicitly closed \a ring
+    static double ringArea( const std::vector< QgsPointXY > &ring );
+
+  private:
+
+    struct Ring
+    {
+      std::vector< QgsPointXY > points;
+      bool hole = false;
+    };
+
+    struct Zone
+    {
+      QgsGeometry geometry;
+      std::vector< Ring > rings;
+      int firstRow = 0;
+      int lastRow = -1;
+      int firstColumn = 0;
+      int lastColumn = -1;
+      bool valid = false;
+    };
+
+    struct Contribution
+    {
+      int zone;
+      double value;
+      double weight;
+    };
+
+    struct Tile;
+
+    //! Rasterizes \a zone on the cells of \a tile, appending the covered cell values to the tile
+    void rasterizeCellCenters( const Zone &zone, int zoneIndex, Tile &tile ) const;
+    void rasterizeExactFraction( const Zone &zone, int zoneIndex, Tile &tile ) const;
+
+    QgsRasterInterface *mRasterInterface = nullptr;
+    int mRasterBand = 1;
+    double mCellSizeX = 0;
+    double mCellSizeY = 0;
+    QgsRectangle mExtent;
+    int mWidth = 0;
+    int mHeight = 0;
+    std::vector< Zone > mZones;
+};
+
+///@endcond
+
+#endif // QGSZONALSWEEP_P_H
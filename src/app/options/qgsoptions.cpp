@@ -653,6 +653,7 @@ QgsOptions::QgsOptions( QWidget *parent, Qt::WindowFlags fl, const QList<QgsOpti
   //Changed to default to true as of QGIS 1.7
   chkAntiAliasing->setChecked( mSettings->value( QStringLiteral( "/qgis/enable_anti_aliasing" ), true ).toBool() );
   chkUseRenderCaching->setChecked( mSettings->value( QStringLiteral( "/qgis/enable_render_caching" ), true ).toBool() );
+  chkApproximateTransforms->setChecked( mSettings->value( QStringLiteral( "/qgis/approximate_vector_transforms" ), false ).toBool() );
   chkParallelRendering->setChecked( mSettings->value( QStringLiteral( "/qgis/parallel_rendering" ), true ).toBool() );
   spinMapUpdateInterval->setValue( mSettings->value( QStringLiteral( "/qgis/map_update_interval" ), 250 ).toInt() );
   spinMapUpdateInterval->setClearValue( 250 );
@@ -1599,6 +1600,7 @@ void QgsOptions::saveOptions()
   mSettings->setValue( QStringLiteral( "/qgis/new_layers_visible" ), chkAddedVisibility->isChecked() );
   mSettings->setValue( QStringLiteral( "/qgis/enable_anti_aliasing" ), chkAntiAliasing->isChecked() );
   mSettings->setValue( QStringLiteral( "/qgis/enable_render_caching" ), chkUseRenderCaching->isChecked() );
+  mSettings->setValue( QStringLiteral( "/qgis/approximate_vector_transforms" ), chkApproximateTransforms->isChecked() );
   mSettings->setValue( QStringLiteral( "/qgis/parallel_rendering" ), chkParallelRendering->isChecked() );
   int maxThreads = chkMaxThreads->isChecked() ? spinMaxThreads->value() : -1;
   QgsApplication::setMaxThreads( maxThreads );
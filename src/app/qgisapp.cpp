@@ -336,6 +336,7 @@ Q_GUI_EXPORT extern int qt_defaultDpiX();
 #include "qgsrasterrenderer.h"
 #include "qgsrasterlayersaveasdialog.h"
 #include "qgsrasterprojector.h"
+#include "qgsrasterpyramidbuildertask.h"
 #include "qgsreadwritecontext.h"
 #include "qgsrectangle.h"
 #include "qgsreport.h"
@@ -2450,6 +2451,10 @@ void QgisApp::applyDefaultSettingsToCanvas( QgsMapCanvas *canvas )
   canvas->setWheelFactor( zoomFactor );
   canvas->setCachingEnabled( settings.value( QStringLiteral( "qgis/enable_render_caching" ), true ).toBool() );
   canvas->setParallelRenderingEnabled( settings.value( QStringLiteral( "qgis/parallel_rendering" ), true ).toBool() );
+  QgsMapSettings::Flags flags = canvas->mapSettings().flags();
+  flags.setFlag( QgsMapSettings::ApproximateCoordinateTransforms, settings.value( QStringLiteral( "qgis/approximate_vector_transforms" ), false ).toBool() );
+  if ( flags != canvas->mapSettings().flags() )
+    canvas->setMapSettingsFlags( flags );
   canvas->setMapUpdateInterval( settings.value( QStringLiteral( "qgis/map_update_interval" ), 250 ).toInt() );
   canvas->setSegmentationTolerance( settings.value( QStringLiteral( "qgis/segmentationTolerance" ), "0.01745" ).toDouble() );
   canvas->setSegmentationToleranceType( QgsAbstractGeometry::SegmentationToleranceType( settings.enumValue( QStringLiteral( "qgis/segmentationToleranceType" ), QgsAbstractGeometry::MaximumAngle ) ) );
@@ -8843,7 +8848,11 @@ QString QgisApp::saveAsRasterFile( QgsRasterLayer *rasterLayer, const bool defau
   }
   fileWriter.setCreateOptions( d.createOptions() );
 
-  fileWriter.setBuildPyramidsFlag( d.buildPyramidsFlag() );
+  // pyramids of GDAL outputs are built by a separate task once written, so the save task does not
+  // block on them; COG outputs build their internal overviews while being written
+  const bool buildPyramidsInTask = d.buildPyramidsFlag() == QgsRaster::PyramidsFlagYes
+                                   && d.outputFormat().compare( QLatin1String( "COG" ), Qt::CaseInsensitive ) != 0;
+  fileWriter.setBuildPyramidsFlag( buildPyramidsInTask ? QgsRaster::PyramidsFlagNo : d.buildPyramidsFlag() );
   fileWriter.setPyramidsList( d.pyramidsList() );
   fileWriter.setPyramidsResampling( d.pyramidsResamplingMethod() );
   fileWriter.setPyramidsFormat( d.pyramidsFormat() );
@@ -8854,6 +8863,10 @@ QString QgisApp::saveAsRasterFile( QgsRasterLayer *rasterLayer, const bool defau
   QPointer< QgsRasterLayer > rlWeakPointer( rasterLayer );
   QString outputLayerName = d.outputLayerName();
   QString outputFormat = d.outputFormat();
+  const QList< int > pyramidsList = d.pyramidsList();
+  const QString pyramidsResampling = d.pyramidsResamplingMethod();
+  const QgsRaster::RasterPyramidsFormat pyramidsFormat = d.pyramidsFormat();
+  const QStringList pyramidsConfigOptions = d.pyramidsConfigOptions();
 
   QgsRasterFileWriterTask *writerTask = new QgsRasterFileWriterTask( fileWriter, pipe.release(), d.nColumns(), d.nRows(),
       d.outputRectangle(), d.outputCrs(), QgsProject::instance()->transformContext() );
@@ -8861,7 +8874,8 @@ QString QgisApp::saveAsRasterFile( QgsRasterLayer *rasterLayer, const bool defau
   // when writer is successful:
 
   connect( writerTask, &QgsRasterFileWriterTask::writeComplete, this,
-           [this, tileMode, addToCanvas, rlWeakPointer, outputLayerName, outputFormat]( const QString & newFilename )
+           [this, tileMode, addToCanvas, rlWeakPointer, outputLayerName, outputFormat, buildPyramidsInTask,
+                 pyramidsList, pyramidsResampling, pyramidsFormat, pyramidsConfigOptions]( const QString & newFilename )
   {
     QString fileName = newFilename;
     if ( tileMode )
@@ -8881,6 +8895,32 @@ QString QgisApp::saveAsRasterFile( QgsRasterLayer *rasterLayer, const bool defau
         addRasterLayers( QStringList( fileName ) );
       }
     }
+
+    if ( buildPyramidsInTask )
+    {
+      QgsRasterPyramidBuilderTask *pyramidsTask = new QgsRasterPyramidBuilderTask( QStringLiteral( "gdal" ), fileName,
+          QList< QgsRasterPyramid >(), pyramidsResampling, pyramidsFormat, pyramidsConfigOptions );
+      pyramidsTask->setOverviewLevels( pyramidsList );
+      // layers showing the saved raster meanwhile read the overviews once they are built
+      connect( pyramidsTask, &QgsRasterPyramidBuilderTask::pyramidsBuilt, this, []( const QString & uri )
+      {
+        const QList< QgsRasterLayer * > layers = QgsProject::instance()->layers< QgsRasterLayer * >();
+        for ( QgsRasterLayer *layer : layers )
+        {
+          if ( layer->providerType() == QLatin1String( "gdal" ) && layer->source() == uri )
+          {
+            layer->reload();
+            layer->triggerRepaint();
+          }
+        }
+      } );
+      connect( pyramidsTask, &QgsRasterPyramidBuilderTask::errorOccurred, this, [this]( const QString & error )
+      {
+        if ( error != QLatin1String( "CANCELED" ) )
+          visibleMessageBar()->pushWarning( tr( "Building Pyramids" ), tr( "Could not build the pyramid overviews of the saved raster (%1)." ).arg( error ) );
+      } );
+      QgsApplication::taskManager()->addTask( pyramidsTask );
+    }
     if ( rlWeakPointer )
       emit layerSavedAs( rlWeakPointer, fileName );
 
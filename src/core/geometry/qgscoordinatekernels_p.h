@@ -0,0 +1,238 @@
+/***************************************************************************
+    qgscoordinatekernels_p.h  -  Bulk operations on coordinate arrays
+    -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSCOORDINATEKERNELS_P_H
+#define QGSCOORDINATEKERNELS_P_H
+
+#define SIP_NO_FILE
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QGIS API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+
+#include <QTransform>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#define QGS_COORDINATE_KERNELS_SSE2
+#include <emmintrin.h>
+#endif
+
+///@cond PRIVATE
+
+/**
+ * Tight loops over the separate x/y coordinate arrays used by QgsLineString and over
+ * the interleaved points of QPolygonF.
+ *
+ * SSE2 is part of every x86-64 target, so these kernels process two coordinates per
+ * instruction there without needing any runtime dispatch. Other targets use plain
+ * loops which the compiler is free to vectorize.
+ */
+namespace QgsCoordinateKernels
+{
+
+  /**
+   * Calculates the bounds of the \a count coordinates in the \a x and \a y arrays.
+   * \a count must be at least 1.
+   */
+  inline void bounds( const double *x, const double *y, int count, double &xMin, double &yMin, double &xMax, double &yMax )
+  {
+    int i = 0;
+#ifdef QGS_COORDINATE_KERNELS_SSE2
+    if ( count >= 2 )
+    {
+      __m128d xMinV = _mm_loadu_pd( x );
+      __m128d xMaxV = xMinV;
+      __m128d yMinV = _mm_loadu_pd( y );
+      __m128d yMaxV = yMinV;
+      for ( i = 2; i + 1 < count; i += 2 )
+      {
+        const __m128d xv = _mm_loadu_pd( x + i );
+        const __m128d yv = _mm_loadu_pd( y + i );
+        xMinV = _mm_min_pd( xMinV, xv );
+        xMaxV = _mm_max_pd( xMaxV, xv );
+        yMinV = _mm_min_pd( yMinV, yv );
+        yMaxV = _mm_max_pd( yMaxV, yv );
+      }
+      double lanes[2];
+      _mm_storeu_pd( lanes, xMinV );
+      xMin = std::min( lanes[0], lanes[1] );
+      _mm_storeu_pd( lanes, xMaxV );
+      xMax = std::max( lanes[0], lanes[1] );
+      _mm_storeu_pd( lanes, yMinV );
+      yMin = std::min( lanes[0], lanes[1] );
+      _mm_storeu_pd( lanes, yMaxV );
+      yMax = std::max( lanes[0], lanes[1] );
+    }
+    else
+#endif
+    {
+      xMin = xMax = x[0];
+      yMin = yMax = y[0];
+      i = 1;
+    }
+
+    for ( ; i < count; ++i )
+    {
+      xMin = std::min( xMin, x[i] );
+      xMax = std::max( xMax, x[i] );
+      yMin = std::min( yMin, y[i] );
+      yMax = std::max( yMax, y[i] );
+    }
+  }
+
+  /**
+   * Returns the total length of the segments joining the \a count coordinates in the \a x and \a y arrays.
+   */
+  inline double length( const double *x, const double *y, int count )
+  {
+    if ( count < 2 )
+      return 0;
+
+    double total = 0;
+    int i = 1;
+#ifdef QGS_COORDINATE_KERNELS_SSE2
+    __m128d totalV = _mm_setzero_pd();
+    for ( ; i + 1 < count; i += 2 )
+    {
+      // segments ending at vertices i and i + 1
+      const __m128d dx = _mm_sub_pd( _mm_loadu_pd( x + i ), _mm_loadu_pd( x + i - 1 ) );
+      const __m128d dy = _mm_sub_pd( _mm_loadu_pd( y + i ), _mm_loadu_pd( y + i - 1 ) );
+      totalV = _mm_add_pd( totalV, _mm_sqrt_pd( _mm_add_pd( _mm_mul_pd( dx, dx ), _mm_mul_pd( dy, dy ) ) ) );
+    }
+    double lanes[2];
+    _mm_storeu_pd( lanes, totalV );
+    total = lanes[0] + lanes[1];
+#endif
+    for ( ; i < count; ++i )
+    {
+      const double dx = x[i] - x[i - 1];
+      const double dy = y[i] - y[i - 1];
+      total += std::sqrt( dx * dx + dy * dy );
+    }
+    return total;
+  }
+
+  /**
+   * Returns the sum of the cross products x[i] * y[i + 1] - y[i] * x[i + 1] for the
+   * \a count coordinates in the \a x and \a y arrays, i.e. twice the signed area of the ring.
+   */
+  inline double crossProductSum( const double *x, const double *y, int count )
+  {
+    double sum = 0;
+    int i = 0;
+#ifdef QGS_COORDINATE_KERNELS_SSE2
+    __m128d sumV = _mm_setzero_pd();
+    for ( ; i + 2 < count; i += 2 )
+    {
+      const __m128d x0 = _mm_loadu_pd( x + i );
+      const __m128d y0 = _mm_loadu_pd( y + i );
+      const __m128d x1 = _mm_loadu_pd( x + i + 1 );
+      const __m128d y1 = _mm_loadu_pd( y + i + 1 );
+      sumV = _mm_add_pd( sumV, _mm_sub_pd( _mm_mul_pd( x0, y1 ), _mm_mul_pd( y0, x1 ) ) );
+    }
+    double lanes[2];
+    _mm_storeu_pd( lanes, sumV );
+    sum = lanes[0] + lanes[1];
+#endif
+    for ( ; i + 1 < count; ++i )
+    {
+      sum += x[i] * y[i + 1] - y[i] * x[i + 1];
+    }
+    return sum;
+  }
+
+  /**
+   * Applies the affine part of \a transform to the \a count coordinates in the \a x and \a y arrays.
+   * \a transform must not be a projective transform.
+   */
+  inline void affineTransform( const QTransform &transform, double *x, double *y, int count )
+  {
+    const double m11 = transform.m11();
+    const double m12 = transform.m12();
+    const double m21 = transform.m21();
+    const double m22 = transform.m22();
+    const double dx = transform.dx();
+    const double dy = transform.dy();
+    int i = 0;
+#ifdef QGS_COORDINATE_KERNELS_SSE2
+    const __m128d m11V = _mm_set1_pd( m11 );
+    const __m128d m12V = _mm_set1_pd( m12 );
+    const __m128d m21V = _mm_set1_pd( m21 );
+    const __m128d m22V = _mm_set1_pd( m22 );
+    const __m128d dxV = _mm_set1_pd( dx );
+    const __m128d dyV = _mm_set1_pd( dy );
+    for ( ; i + 1 < count; i += 2 )
+    {
+      const __m128d xv = _mm_loadu_pd( x + i );
+      const __m128d yv = _mm_loadu_pd( y + i );
+      _mm_storeu_pd( x + i, _mm_add_pd( _mm_add_pd( _mm_mul_pd( m11V, xv ), _mm_mul_pd( m21V, yv ) ), dxV ) );
+      _mm_storeu_pd( y + i, _mm_add_pd( _mm_add_pd( _mm_mul_pd( m12V, xv ), _mm_mul_pd( m22V, yv ) ), dyV ) );
+    }
+#endif
+    for ( ; i < count; ++i )
+    {
+      const double xIn = x[i];
+      x[i] = m11 * xIn + m21 * y[i] + dx;
+      y[i] = m12 * xIn + m22 * y[i] + dy;
+    }
+  }
+
+  /**
+   * Applies the affine part of \a transform to the \a count interleaved x/y pairs in \a xy,
+   * e.g. the points of a QPolygonF. \a transform must not be a projective transform.
+   */
+  inline void affineTransformInterleaved( const QTransform &transform, double *xy, int count )
+  {
+#ifdef QGS_COORDINATE_KERNELS_SSE2
+    // a point is one register, so x' and y' are computed together
+    const __m128d xFactors = _mm_set_pd( transform.m12(), transform.m11() );
+    const __m128d yFactors = _mm_set_pd( transform.m22(), transform.m21() );
+    const __m128d translate = _mm_set_pd( transform.dy(), transform.dx() );
+    for ( int i = 0; i < count; ++i, xy += 2 )
+    {
+      const __m128d point = _mm_loadu_pd( xy );
+      const __m128d xx = _mm_unpacklo_pd( point, point );
+      const __m128d yy = _mm_unpackhi_pd( point, point );
+      _mm_storeu_pd( xy, _mm_add_pd( _mm_add_pd( _mm_mul_pd( xFactors, xx ), _mm_mul_pd( yFactors, yy ) ), translate ) );
+    }
+#else
+    const double m11 = transform.m11();
+    const double m12 = transform.m12();
+    const double m21 = transform.m21();
+    const double m22 = transform.m22();
+    const double dx = transform.dx();
+    const double dy = transform.dy();
+    for ( int i = 0; i < count; ++i, xy += 2 )
+    {
+      const double xIn = xy[0];
+      xy[0] = m11 * xIn + m21 * xy[1] + dx;
+      xy[1] = m12 * xIn + m22 * xy[1] + dy;
+    }
+#endif
+  }
+}
+
+///@endcond
+
+#endif // QGSCOORDINATEKERNELS_P_H
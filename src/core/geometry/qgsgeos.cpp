@@ -26,6 +26,8 @@ email                : marco.hugentobler at sourcepole dot com
 #include "qgspolygon.h"
 #include "qgsgeometryeditutils.h"
 #include <limits>
+#include <algorithm>
+#include <vector>
 #include <cstdio>
 
 #define DEFAULT_QUADRANT_SEGMENTS 8
@@ -1325,6 +1327,10 @@ std::unique_ptr<QgsLineString> QgsGeos::sequenceToLinestring( const GEOSGeometry
   double *y = yOut.data();
   double *z = zOut.data();
   double *m = mOut.data();
+#if GEOS_VERSION_MAJOR>3 || ( GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR>=10 )
+  // copy all ordinates in a single call, rather than fetching one vertex at a time
+  GEOSCoordSeq_copyToArrays_r( geosinit()->ctxt, cs, x, y, hasZ ? z : nullptr, hasM ? m : nullptr );
+#else
   for ( unsigned int i = 0; i < nPoints; ++i )
   {
 #if GEOS_VERSION_MAJOR>3 || GEOS_VERSION_MINOR>=8
@@ -1345,6 +1351,7 @@ std::unique_ptr<QgsLineString> QgsGeos::sequenceToLinestring( const GEOSGeometry
       GEOSCoordSeq_getOrdinate_r( geosinit()->ctxt, cs, i, 3, m++ );
     }
   }
+#endif
   std::unique_ptr< QgsLineString > line( new QgsLineString( xOut, yOut, zOut, mOut ) );
   return line;
 }
@@ -1915,6 +1922,60 @@ GEOSCoordSequence *QgsGeos::createCoordinateSequence( const QgsCurve *curve, dou
   }
 
   GEOSCoordSequence *coordSeq = nullptr;
+#if GEOS_VERSION_MAJOR>3 || ( GEOS_VERSION_MAJOR == 3 && GEOS_VERSION_MINOR>=10 )
+  try
+  {
+    if ( numOutPoints == numPoints && precision <= 0. )
+    {
+      // hand the line's ordinate arrays straight to GEOS
+      coordSeq = GEOSCoordSeq_copyFromArrays_r( geosinit()->ctxt, line->xData(), line->yData(),
+                 hasZ ? line->zData() : nullptr, hasM ? line->mData() : nullptr, numOutPoints );
+    }
+    else
+    {
+      // build the rounded and/or closed ordinates first, then copy them in a single call
+      std::vector< double > xOut( numOutPoints );
+      std::vector< double > yOut( numOutPoints );
+      std::vector< double > zOut( hasZ ? numOutPoints : 0 );
+      std::vector< double > mOut( hasM ? numOutPoints : 0 );
+      auto fill = [numPoints, numOutPoints, precision]( const double *in, std::vector< double > &out )
+      {
+        if ( precision > 0. )
+        {
+          for ( int i = 0; i < numPoints; ++i )
+            out[i] = std::round( in[i] / precision ) * precision;
+        }
+        else
+        {
+          std::copy( in, in + numPoints, out.begin() );
+        }
+        if ( numOutPoints > numPoints )
+          out[numPoints] = out[0];
+      };
+      fill( line->xData(), xOut );
+      fill( line->yData(), yOut );
+      if ( hasZ )
+        fill( line->zData(), zOut );
+      if ( hasM )
+      {
+        // measures are never rounded
+        std::copy( line->mData(), line->mData() + numPoints, mOut.begin() );
+        if ( numOutPoints > numPoints )
+          mOut[numPoints] = mOut[0];
+      }
+
+      coordSeq = GEOSCoordSeq_copyFromArrays_r( geosinit()->ctxt, xOut.data(), yOut.data(),
+                 hasZ ? zOut.data() : nullptr, hasM ? mOut.data() : nullptr, numOutPoints );
+    }
+
+    if ( !coordSeq )
+    {
+      QgsDebugMsg( QStringLiteral( "GEOS Exception: Could not create coordinate sequence for %1 points in %2 dimensions" ).arg( numPoints ).arg( coordDims ) );
+      return nullptr;
+    }
+  }
+  CATCH_GEOS( nullptr )
+#else
   try
   {
     coordSeq = GEOSCoordSeq_create_r( geosinit()->ctxt, numOutPoints, coordDims );
@@ -2001,6 +2062,7 @@ GEOSCoordSequence *QgsGeos::createCoordinateSequence( const QgsCurve *curve, dou
     }
   }
   CATCH_GEOS( nullptr )
+#endif
 
   return coordSeq;
 }
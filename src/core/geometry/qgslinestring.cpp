@@ -18,6 +18,7 @@
 #include "qgslinestring.h"
 #include "qgsapplication.h"
 #include "qgscompoundcurve.h"
+#include "qgscoordinatekernels_p.h"
 #include "qgscoordinatetransform.h"
 #include "qgsgeometryutils.h"
 #include "qgsmaptopixel.h"
@@ -572,12 +573,8 @@ QgsRectangle QgsLineString::calculateBoundingBox() const
   if ( mX.empty() )
     return QgsRectangle();
 
-  auto result = std::minmax_element( mX.begin(), mX.end() );
-  const double xmin = *result.first;
-  const double xmax = *result.second;
-  result = std::minmax_element( mY.begin(), mY.end() );
-  const double ymin = *result.first;
-  const double ymax = *result.second;
+  double xmin, ymin, xmax, ymax;
+  QgsCoordinateKernels::bounds( mX.constData(), mY.constData(), mX.size(), xmin, ymin, xmax, ymax );
   return QgsRectangle( xmin, ymin, xmax, ymax, false );
 }
 
@@ -796,28 +793,7 @@ QString QgsLineString::asKml( int precision ) const
 
 double QgsLineString::length() const
 {
-  double total = 0;
-  const int size = mX.size();
-  if ( size < 2 )
-    return 0;
-
-  const double *x = mX.constData();
-  const double *y = mY.constData();
-  double dx, dy;
-
-  double prevX = *x++;
-  double prevY = *y++;
-
-  for ( int i = 1; i < size; ++i )
-  {
-    dx = *x - prevX;
-    dy = *y - prevY;
-    total += std::sqrt( dx * dx + dy * dy );
-
-    prevX = *x++;
-    prevY = *y++;
-  }
-  return total;
+  return QgsCoordinateKernels::length( mX.constData(), mY.constData(), mX.size() );
 }
 
 std::tuple<std::unique_ptr<QgsCurve>, std::unique_ptr<QgsCurve> > QgsLineString::splitCurveAtVertex( int index ) const
@@ -1571,12 +1547,18 @@ void QgsLineString::transform( const QTransform &t, double zTranslate, double zS
   double *y = mY.data();
   double *z = hasZ ? mZ.data() : nullptr;
   double *m = hasM ? mM.data() : nullptr;
+  const bool affine = t.type() != QTransform::TxProject;
+  if ( affine )
+    QgsCoordinateKernels::affineTransform( t, x, y, nPoints );
   for ( int i = 0; i < nPoints; ++i )
   {
-    double xOut, yOut;
-    t.map( *x, *y, &xOut, &yOut );
-    *x++ = xOut;
-    *y++ = yOut;
+    if ( !affine )
+    {
+      double xOut, yOut;
+      t.map( *x, *y, &xOut, &yOut );
+      *x++ = xOut;
+      *y++ = yOut;
+    }
     if ( hasZ )
     {
       *z = *z * zScale + zTranslate;
@@ -1830,12 +1812,7 @@ QgsPoint QgsLineString::centroid() const
 
 void QgsLineString::sumUpArea( double &sum ) const
 {
-  int maxIndex = numPoints() - 1;
-
-  for ( int i = 0; i < maxIndex; ++i )
-  {
-    sum += 0.5 * ( mX.at( i ) * mY.at( i + 1 ) - mY.at( i ) * mX.at( i + 1 ) );
-  }
+  sum += 0.5 * QgsCoordinateKernels::crossProductSum( mX.constData(), mY.constData(), mX.size() );
 }
 
 void QgsLineString::importVerticesFromWkb( const QgsConstWkbPtr &wkb )
@@ -0,0 +1,205 @@
+/***************************************************************************
+    qgsparallelunion.cpp  -  Spatially partitioned parallel union
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsparallelunion.h"
+#include "qgsfeedback.h"
+#include "qgsrectangle.h"
+
+#include <QObject>
+#include <QStringList>
+#include <QtConcurrentMap>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+///@cond PRIVATE
+
+// number of partial results merged together at each level, the four
+// quadrants of a Z-order cell
+constexpr int MERGE_FAN_IN = 4;
+
+// interleaves the bits of x and y
+static quint32 mortonCode( quint32 x, quint32 y )
+{
+  auto spread = []( quint32 v )
+  {
+    v &= 0xFFFF;
+    v = ( v | ( v << 8 ) ) & 0x00FF00FF;
+    v = ( v | ( v << 4 ) ) & 0x0F0F0F0F;
+    v = ( v | ( v << 2 ) ) & 0x33333333;
+    v = ( v | ( v << 1 ) ) & 0x55555555;
+    return v;
+  };
+  return spread( x ) | ( spread( y ) << 1 );
+}
+
+// Returns the union of geometries. If GEOS fails to union the whole set, e.g. because
+// of an invalid input, the geometries are merged one at a time instead, so that only
+// the geometries which cannot be merged are left out. Failures are stored in error.
+static QgsGeometry unionGeometries( const QVector< QgsGeometry > &geometries, QString &error )
+{
+  QgsGeometry result = QgsGeometry::unaryUnion( geometries );
+  if ( !result.isNull() )
+  {
+    error = result.lastError();
+    return result;
+  }
+
+  QStringList errors;
+  if ( !result.lastError().isEmpty() )
+    errors << result.lastError();
+  for ( const QgsGeometry &geometry : geometries )
+  {
+    if ( geometry.isNull() )
+      continue;
+
+    const QgsGeometry combined = result.isNull() ? QgsGeometry::unaryUnion( QVector< QgsGeometry >() << geometry )
+                                 : result.combine( geometry );
+    if ( combined.isNull() )
+    {
+      errors << ( combined.lastError().isEmpty() ? QObject::tr( "Could not merge a geometry into the union" ) : combined.lastError() );
+      continue;
+    }
+    result = combined;
+  }
+  error = errors.join( '\n' );
+  return result;
+}
+
+struct UnionJob
+{
+  QVector< QgsGeometry > geometries;
+  QgsGeometry result;
+  QString error;
+  //! TRUE if the inputs are partial results from a previous level
+  bool merge = false;
+};
+
+///@endcond
+
+QgsParallelUnion::QgsParallelUnion( int maxPartitionSize )
+{
+  setMaxPartitionSize( maxPartitionSize );
+}
+
+void QgsParallelUnion::setMaxPartitionSize( int size )
+{
+  mMaxPartitionSize = std::max( size, 2 );
+}
+
+QgsGeometry QgsParallelUnion::unaryUnion( const QVector<QgsGeometry> &geometries, QString *error ) const
+{
+  std::vector< std::pair< quint32, int > > order;
+  order.reserve( geometries.size() );
+  QgsRectangle extent;
+  extent.setMinimal();
+  for ( int i = 0; i < geometries.size(); ++i )
+  {
+    if ( geometries.at( i ).isNull() )
+      continue;
+    extent.combineExtentWith( geometries.at( i ).boundingBox() );
+    order.emplace_back( 0, i );
+  }
+
+  if ( static_cast< int >( order.size() ) <= mMaxPartitionSize )
+  {
+    QString unionError;
+    QgsGeometry result = unionGeometries( geometries, unionError );
+    if ( error )
+      *error = unionError;
+    return result;
+  }
+
+  // order the geometries along a Z-order curve over a 65536 x 65536 grid, so that
+  // consecutive runs of geometries cover compact areas
+  const double xScale = extent.width() > 0 ? 65535.0 / extent.width() : 0;
+  const double yScale = extent.height() > 0 ? 65535.0 / extent.height() : 0;
+  for ( std::pair< quint32, int > &entry : order )
+  {
+    const QgsPointXY center = geometries.at( entry.second ).boundingBox().center();
+    const double x = std::clamp( ( center.x() - extent.xMinimum() ) * xScale, 0.0, 65535.0 );
+    const double y = std::clamp( ( center.y() - extent.yMinimum() ) * yScale, 0.0, 65535.0 );
+    entry.first = mortonCode( static_cast< quint32 >( x ), static_cast< quint32 >( y ) );
+  }
+  std::sort( order.begin(), order.end() );
+
+  std::vector< UnionJob > jobs( ( order.size() + mMaxPartitionSize - 1 ) / mMaxPartitionSize );
+  for ( std::size_t i = 0; i < order.size(); ++i )
+  {
+    QVector< QgsGeometry > &partition = jobs[ i / mMaxPartitionSize ].geometries;
+    if ( partition.isEmpty() )
+      partition.reserve( mMaxPartitionSize );
+    partition.append( geometries.at( order[i].second ) );
+  }
+  order.clear();
+  order.shrink_to_fit();
+
+  QgsFeedback *feedback = mFeedback;
+  auto unionJob = [feedback]( UnionJob & job )
+  {
+    if ( feedback && feedback->isCanceled() )
+      return;
+
+    if ( job.geometries.isEmpty() )
+      return;
+
+    if ( job.merge && job.geometries.size() == 1 )
+    {
+      // already the union of a previous level, nothing to merge it with
+      job.result = job.geometries.at( 0 );
+    }
+    else
+    {
+      job.result = unionGeometries( job.geometries, job.error );
+    }
+    // release the partial results of the previous level as soon as they are merged. The input
+    // geometries are shared with the caller, and only freed once the caller releases them too
+    job.geometries = QVector< QgsGeometry >();
+  };
+
+  QStringList errors;
+  while ( true )
+  {
+    QtConcurrent::blockingMap( jobs, unionJob );
+    if ( feedback && feedback->isCanceled() )
+      return QgsGeometry();
+
+    for ( const UnionJob &job : jobs )
+    {
+      if ( !job.error.isEmpty() )
+        errors << job.error;
+    }
+
+    if ( jobs.size() == 1 )
+      break;
+
+    // merge neighbouring partial results
+    std::vector< UnionJob > merged( ( jobs.size() + MERGE_FAN_IN - 1 ) / MERGE_FAN_IN );
+    for ( UnionJob &job : merged )
+      job.merge = true;
+    for ( std::size_t i = 0; i < jobs.size(); ++i )
+    {
+      if ( !jobs[i].result.isNull() )
+        merged[ i / MERGE_FAN_IN ].geometries.append( std::move( jobs[i].result ) );
+    }
+    jobs = std::move( merged );
+  }
+
+  if ( error )
+    *error = errors.join( '\n' );
+  return jobs.front().result;
+}
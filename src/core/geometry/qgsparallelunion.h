@@ -0,0 +1,94 @@
+/***************************************************************************
+    qgsparallelunion.h  -  Spatially partitioned parallel union
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSPARALLELUNION_H
+#define QGSPARALLELUNION_H
+
+#include "qgis_core.h"
+#include "qgis_sip.h"
+#include "qgsgeometry.h"
+
+#include <QString>
+#include <QVector>
+
+#define SIP_NO_FILE
+
+class QgsFeedback;
+
+/**
+ * \ingroup core
+ * \class QgsParallelUnion
+ * \brief Calculates the union of a large number of geometries using all available threads.
+ *
+ * The input geometries are ordered along a Z-order curve of their bounding box centers and
+ * split into partitions of at most maxPartitionSize() geometries, so that every partition
+ * covers a compact area. Partitions are unioned concurrently on the global thread pool, and
+ * the partial results are then merged in groups of neighbouring partitions, again concurrently,
+ * until a single geometry remains. Since only neighbouring partial results are ever merged,
+ * most shared boundaries are dissolved while the geometries involved are still small.
+ *
+ * The result is the same as QgsGeometry::unaryUnion(), which is used directly when the input
+ * fits in a single partition.
+ *
+ * The input geometries are implicitly shared with the caller's vector, so they stay in memory
+ * for the whole union. Only the partial results of each level are freed as soon as they are merged.
+ *
+ * \note Not available in Python bindings
+ * \since QGIS 3.20
+ */
+class CORE_EXPORT QgsParallelUnion
+{
+  public:
+
+    /**
+     * Constructor for QgsParallelUnion, with partitions containing at most \a maxPartitionSize geometries.
+     */
+    explicit QgsParallelUnion( int maxPartitionSize = 1000 );
+
+    /**
+     * Returns the maximum number of input geometries unioned in a single partition.
+     * \see setMaxPartitionSize()
+     */
+    int maxPartitionSize() const { return mMaxPartitionSize; }
+
+    /**
+     * Sets the maximum number of input geometries unioned in a single partition.
+     * \see maxPartitionSize()
+     */
+    void setMaxPartitionSize( int size );
+
+    /**
+     * Sets an optional \a feedback object used to cancel the union. Partitions which have not
+     * been started when the feedback is canceled are skipped, and a null geometry is returned.
+     */
+    void setFeedback( QgsFeedback *feedback ) { mFeedback = feedback; }
+
+    /**
+     * Returns the union of \a geometries. Null geometries are ignored.
+     *
+     * If the union of a partition fails, its geometries are merged one at a time instead, and
+     * only the geometries which still cannot be merged are left out of the result. Any failure
+     * is stored in \a error (if specified), in which case the returned geometry may be incomplete.
+     */
+    QgsGeometry unaryUnion( const QVector< QgsGeometry > &geometries, QString *error = nullptr ) const;
+
+  private:
+
+    int mMaxPartitionSize = 1000;
+    QgsFeedback *mFeedback = nullptr;
+};
+
+#endif // QGSPARALLELUNION_H
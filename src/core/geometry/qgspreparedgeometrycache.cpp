@@ -0,0 +1,143 @@
+/***************************************************************************
+    qgspreparedgeometrycache.cpp  -  Cache of prepared geometry engines
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgspreparedgeometrycache.h"
+#include "qgsgeometry.h"
+#include "qgsgeos.h"
+
+#include <QThread>
+
+struct QgsPreparedGeometryCache::Entry
+{
+  explicit Entry( const QgsGeometry &sourceGeometry, double precision )
+    : geometry( sourceGeometry )
+    , engine( geometry.constGet(), precision )
+  {}
+
+  // the engine only references the geometry, so the entry owns a copy of it
+  QgsGeometry geometry;
+  QgsGeos engine;
+};
+
+uint qHash( const QgsPreparedGeometryCache::Key &key, uint seed )
+{
+  return qHash( key.source, seed ) ^ qHash( key.id, seed ) ^ qHash( key.precision, seed );
+}
+
+QgsPreparedGeometryCache::QgsPreparedGeometryCache( int maxEntriesPerThread )
+  : mMaxEntriesPerThread( maxEntriesPerThread )
+{
+}
+
+QgsPreparedGeometryCache::~QgsPreparedGeometryCache()
+{
+  clear();
+}
+
+std::shared_ptr<QgsGeometryEngine> QgsPreparedGeometryCache::engine( const QString &source, QgsFeatureId id, const QgsGeometry &geometry, double precision )
+{
+  const Key key { source, id, precision };
+  QThread *thread = QThread::currentThread();
+  {
+    QMutexLocker locker( &mMutex );
+    if ( ThreadCache *cache = mThreadCaches.value( thread ) )
+    {
+      if ( std::shared_ptr< Entry > *entry = cache->engines.object( key ) )
+        return std::shared_ptr< QgsGeometryEngine >( *entry, &( *entry )->engine );
+    }
+  }
+
+  // prepare outside of the lock, this is the expensive part
+  std::shared_ptr< Entry > entry = std::make_shared< Entry >( geometry, precision );
+  entry->engine.prepareGeometry();
+
+  QMutexLocker locker( &mMutex );
+  ThreadCache *&cache = mThreadCaches[ thread ];
+  if ( !cache )
+  {
+    cache = new ThreadCache( mMaxEntriesPerThread );
+    cache->finishedConnection = QObject::connect( thread, &QThread::finished, thread, [this, thread]
+    {
+      removeThreadCache( thread );
+    }, Qt::DirectConnection );
+  }
+  cache->engines.insert( key, new std::shared_ptr< Entry >( entry ) );
+  // the returned engine shares the ownership of the entry, so it stays valid after eviction
+  return std::shared_ptr< QgsGeometryEngine >( entry, &entry->engine );
+}
+
+void QgsPreparedGeometryCache::removeThreadCache( QThread *thread )
+{
+  QMutexLocker locker( &mMutex );
+  if ( ThreadCache *cache = mThreadCaches.take( thread ) )
+  {
+    QObject::disconnect( cache->finishedConnection );
+    delete cache;
+  }
+}
+
+void QgsPreparedGeometryCache::invalidate( const QString &source )
+{
+  QMutexLocker locker( &mMutex );
+  for ( ThreadCache *cache : std::as_const( mThreadCaches ) )
+  {
+    const QList< Key > keys = cache->engines.keys();
+    for ( const Key &key : keys )
+    {
+      if ( key.source == source )
+        cache->engines.remove( key );
+    }
+  }
+}
+
+void QgsPreparedGeometryCache::invalidate( const QString &source, QgsFeatureId id )
+{
+  QMutexLocker locker( &mMutex );
+  for ( ThreadCache *cache : std::as_const( mThreadCaches ) )
+  {
+    const QList< Key > keys = cache->engines.keys();
+    for ( const Key &key : keys )
+    {
+      if ( key.id == id && key.source == source )
+        cache->engines.remove( key );
+    }
+  }
+}
+
+void QgsPreparedGeometryCache::clear()
+{
+  QMutexLocker locker( &mMutex );
+  for ( ThreadCache *cache : std::as_const( mThreadCaches ) )
+  {
+    QObject::disconnect( cache->finishedConnection );
+    delete cache;
+  }
+  mThreadCaches.clear();
+}
+
+int QgsPreparedGeometryCache::maxEntriesPerThread() const
+{
+  QMutexLocker locker( &mMutex );
+  return mMaxEntriesPerThread;
+}
+
+void QgsPreparedGeometryCache::setMaxEntriesPerThread( int entries )
+{
+  QMutexLocker locker( &mMutex );
+  mMaxEntriesPerThread = entries;
+  for ( ThreadCache *cache : std::as_const( mThreadCaches ) )
+    cache->engines.setMaxCost( entries );
+}
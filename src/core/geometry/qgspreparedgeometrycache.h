@@ -0,0 +1,154 @@
+/***************************************************************************
+    qgspreparedgeometrycache.h  -  Cache of prepared geometry engines
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSPREPAREDGEOMETRYCACHE_H
+#define QGSPREPAREDGEOMETRYCACHE_H
+
+#include "qgis_core.h"
+#include "qgis_sip.h"
+#include "qgsfeatureid.h"
+
+#include <QCache>
+#include <QHash>
+#include <QMetaObject>
+#include <QMutex>
+#include <QString>
+
+#include <memory>
+
+#define SIP_NO_FILE
+
+class QgsGeometry;
+class QgsGeometryEngine;
+class QThread;
+
+/**
+ * \ingroup core
+ * \class QgsPreparedGeometryCache
+ * \brief A bounded cache of prepared geometry engines, keyed by source and feature id.
+ *
+ * Preparing a geometry builds spatial indexes over its segments, which makes
+ * repeated predicate tests against the same geometry much cheaper but is itself
+ * expensive. This cache allows a geometry which is tested over and over (e.g.
+ * an overlay polygon) to be prepared once and the engine reused by later
+ * requests for the same feature.
+ *
+ * Prepared GEOS geometries build their indexes lazily and must not be used
+ * concurrently, so the cache keeps a separate set of engines for every thread
+ * requesting them. A single cache may therefore be shared freely between threads,
+ * with each thread preparing a feature at most once. The engines of a thread are
+ * released when the thread finishes.
+ *
+ * The cache has no way to detect that a feature geometry was changed, so owners
+ * must call invalidate() whenever the geometry of a cached feature is modified.
+ *
+ * \note Not available in Python bindings
+ * \since QGIS 3.20
+ */
+class CORE_EXPORT QgsPreparedGeometryCache
+{
+  public:
+
+    /**
+     * Constructor for QgsPreparedGeometryCache, holding at most \a maxEntriesPerThread
+     * engines for each thread.
+     */
+    explicit QgsPreparedGeometryCache( int maxEntriesPerThread = 1000 );
+
+    ~QgsPreparedGeometryCache();
+
+    //! QgsPreparedGeometryCache cannot be copied
+    QgsPreparedGeometryCache( const QgsPreparedGeometryCache &other ) = delete;
+    //! QgsPreparedGeometryCache cannot be copied
+    QgsPreparedGeometryCache &operator=( const QgsPreparedGeometryCache &other ) = delete;
+
+    /**
+     * Returns a prepared geometry engine for the feature with the specified \a source and \a id.
+     *
+     * If no engine is cached for the calling thread, a new engine is created for a copy of
+     * \a geometry using the specified \a precision, prepared and added to the cache.
+     *
+     * The returned engine must only be used from the calling thread. It remains valid
+     * even if it is later evicted from the cache.
+     */
+    std::shared_ptr< QgsGeometryEngine > engine( const QString &source, QgsFeatureId id, const QgsGeometry &geometry, double precision = 0 );
+
+    /**
+     * Removes all cached engines for the specified \a source.
+     */
+    void invalidate( const QString &source );
+
+    /**
+     * Removes all cached engines for the feature with matching \a source and \a id.
+     */
+    void invalidate( const QString &source, QgsFeatureId id );
+
+    /**
+     * Removes all cached engines.
+     */
+    void clear();
+
+    /**
+     * Returns the maximum number of engines cached for each thread.
+     * \see setMaxEntriesPerThread()
+     */
+    int maxEntriesPerThread() const;
+
+    /**
+     * Sets the maximum number of engines cached for each thread.
+     * \see maxEntriesPerThread()
+     */
+    void setMaxEntriesPerThread( int entries );
+
+  private:
+
+    struct Key
+    {
+      QString source;
+      QgsFeatureId id;
+      double precision;
+
+      bool operator==( const Key &other ) const
+      {
+        return id == other.id && precision == other.precision && source == other.source;
+      }
+    };
+    friend uint qHash( const Key &key, uint seed );
+
+    //! A prepared engine, with the copy of the geometry it references
+    struct Entry;
+
+    typedef QCache< Key, std::shared_ptr< Entry > > EngineCache;
+
+    //! The engines of a thread
+    struct ThreadCache
+    {
+      explicit ThreadCache( int maxEntries )
+        : engines( maxEntries )
+      {}
+
+      EngineCache engines;
+      QMetaObject::Connection finishedConnection;
+    };
+
+    void removeThreadCache( QThread *thread );
+
+    mutable QMutex mMutex;
+    int mMaxEntriesPerThread = 1000;
+    QHash< QThread *, ThreadCache * > mThreadCaches;
+};
+
+#endif // QGSPREPAREDGEOMETRYCACHE_H
@@ -0,0 +1,222 @@
+/***************************************************************************
+    qgswkbgeometry.cpp  -  Read-only geometry stored as WKB
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgswkbgeometry.h"
+#include "qgslogger.h"
+#include "qgswkbptr.h"
+
+#include <cmath>
+#include <limits>
+
+///@cond PRIVATE
+
+/**
+ * Walks the points and point arrays of the geometry at \a wkbPtr, handing each of them
+ * to \a visitor, which must consume them from the pointer.
+ *
+ * Returns FALSE if a curved geometry type is encountered, which cannot be walked this way.
+ */
+template< typename Visitor >
+static bool visitPointArrays( QgsConstWkbPtr &wkbPtr, Visitor &visitor )
+{
+  const QgsWkbTypes::Type type = wkbPtr.readHeader();
+  switch ( QgsWkbTypes::flatType( type ) )
+  {
+    case QgsWkbTypes::Point:
+      visitor.point( wkbPtr, type );
+      return true;
+
+    case QgsWkbTypes::LineString:
+      visitor.points( wkbPtr, type );
+      return true;
+
+    case QgsWkbTypes::Polygon:
+    case QgsWkbTypes::Triangle:
+    {
+      int numRings = 0;
+      wkbPtr >> numRings;
+      for ( int i = 0; i < numRings; ++i )
+        visitor.points( wkbPtr, type );
+      return true;
+    }
+
+    case QgsWkbTypes::MultiPoint:
+    case QgsWkbTypes::MultiLineString:
+    case QgsWkbTypes::MultiPolygon:
+    case QgsWkbTypes::GeometryCollection:
+    {
+      // every part has its own header
+      int numParts = 0;
+      wkbPtr >> numParts;
+      for ( int i = 0; i < numParts; ++i )
+      {
+        if ( !visitPointArrays( wkbPtr, visitor ) )
+          return false;
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+//! Size of the Z and M values following x and y in every point of \a type
+static int zmSize( QgsWkbTypes::Type type )
+{
+  return ( QgsWkbTypes::coordDimensions( type ) - 2 ) * static_cast< int >( sizeof( double ) );
+}
+
+struct BoundsVisitor
+{
+  double xMin = std::numeric_limits< double >::max();
+  double yMin = std::numeric_limits< double >::max();
+  double xMax = -std::numeric_limits< double >::max();
+  double yMax = -std::numeric_limits< double >::max();
+
+  void add( double x, double y )
+  {
+    // empty points are stored as NaN coordinates
+    if ( std::isnan( x ) || std::isnan( y ) )
+      return;
+
+    xMin = std::min( xMin, x );
+    yMin = std::min( yMin, y );
+    xMax = std::max( xMax, x );
+    yMax = std::max( yMax, y );
+  }
+
+  void point( QgsConstWkbPtr &wkbPtr, QgsWkbTypes::Type type )
+  {
+    double x = 0;
+    double y = 0;
+    wkbPtr >> x >> y;
+    wkbPtr += zmSize( type );
+    add( x, y );
+  }
+
+  void points( QgsConstWkbPtr &wkbPtr, QgsWkbTypes::Type type )
+  {
+    const int skip = zmSize( type );
+    int numPoints = 0;
+    wkbPtr >> numPoints;
+    for ( int i = 0; i < numPoints; ++i )
+    {
+      double x = 0;
+      double y = 0;
+      wkbPtr >> x >> y;
+      wkbPtr += skip;
+      add( x, y );
+    }
+  }
+};
+
+///@endcond
+
+QgsWkbGeometry::QgsWkbGeometry( const QByteArray &wkb )
+  : mWkb( wkb )
+{
+}
+
+QgsWkbGeometry QgsWkbGeometry::fromGeometry( const QgsGeometry &geometry )
+{
+  QgsWkbGeometry result;
+  if ( geometry.isNull() )
+    return result;
+
+  result.mWkb = geometry.asWkb();
+  result.mGeometry = geometry;
+  return result;
+}
+
+QgsWkbTypes::Type QgsWkbGeometry::wkbType() const
+{
+  if ( mWkb.isEmpty() )
+    return QgsWkbTypes::Unknown;
+
+  try
+  {
+    QgsConstWkbPtr wkbPtr( mWkb );
+    return wkbPtr.readHeader();
+  }
+  catch ( const QgsWkbException &e )
+  {
+    Q_UNUSED( e )
+    QgsDebugMsg( "WKB exception while reading header: " + e.what() );
+    return QgsWkbTypes::Unknown;
+  }
+}
+
+QgsRectangle QgsWkbGeometry::boundingBox() const
+{
+  if ( !mBoundingBox )
+  {
+    QgsRectangle bounds;
+    // empty geometries get an inverted rectangle, which intersects nothing
+    bounds.setMinimal();
+
+    bool scanned = false;
+    if ( !mWkb.isEmpty() && !mGeometry )
+    {
+      try
+      {
+        QgsConstWkbPtr wkbPtr( mWkb );
+        BoundsVisitor visitor;
+        scanned = visitPointArrays( wkbPtr, visitor );
+        if ( scanned )
+          bounds = QgsRectangle( visitor.xMin, visitor.yMin, visitor.xMax, visitor.yMax, false );
+      }
+      catch ( const QgsWkbException &e )
+      {
+        Q_UNUSED( e )
+        QgsDebugMsg( "WKB exception: " + e.what() );
+        scanned = true;
+      }
+    }
+
+    if ( !scanned && !mWkb.isEmpty() )
+    {
+      const QgsGeometry g = geometry();
+      if ( !g.isEmpty() )
+        bounds = g.boundingBox();
+    }
+
+    mBoundingBox = bounds;
+  }
+
+  if ( mBoundingBox->xMinimum() > mBoundingBox->xMaximum() )
+    return QgsRectangle();
+
+  return *mBoundingBox;
+}
+
+bool QgsWkbGeometry::boundingBoxIntersects( const QgsRectangle &rectangle ) const
+{
+  boundingBox();
+  return mBoundingBox->intersects( rectangle );
+}
+
+QgsGeometry QgsWkbGeometry::geometry() const
+{
+  if ( !mGeometry )
+  {
+    QgsGeometry g;
+    if ( !mWkb.isEmpty() )
+      g.fromWkb( mWkb );
+    mGeometry = g;
+  }
+  return *mGeometry;
+}
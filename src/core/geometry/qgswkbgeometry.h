@@ -0,0 +1,118 @@
+/***************************************************************************
+    qgswkbgeometry.h  -  Read-only geometry stored as WKB
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSWKBGEOMETRY_H
+#define QGSWKBGEOMETRY_H
+
+#include "qgis_core.h"
+#include "qgis_sip.h"
+#include "qgsgeometry.h"
+#include "qgsrectangle.h"
+#include "qgswkbtypes.h"
+
+#include <QByteArray>
+
+#include <optional>
+
+#define SIP_NO_FILE
+
+/**
+ * \ingroup core
+ * \class QgsWkbGeometry
+ * \brief A compact, read-only geometry which keeps its WKB representation.
+ *
+ * A QgsGeometry owns a tree of QgsAbstractGeometry objects, which costs several heap
+ * allocations even for a simple polygon. QgsWkbGeometry instead holds the (implicitly
+ * shared) WKB as read from a data source, and answers wkbType(), boundingBox() and
+ * boundingBoxIntersects() by scanning the WKB without allocating.
+ *
+ * The geometry object tree is only built when geometry() is called, e.g. for editing
+ * or for operations which need it, and is then kept for subsequent calls.
+ *
+ * The WKB scan handles points, linestrings, polygons and their multi and collection types.
+ * For curved types the queries fall back to the materialized geometry().
+ *
+ * \warning Instances cache results lazily and must not be shared between threads without
+ * calling geometry() first.
+ *
+ * \note Not available in Python bindings
+ * \since QGIS 3.20
+ */
+class CORE_EXPORT QgsWkbGeometry
+{
+  public:
+
+    /**
+     * Constructor for a null QgsWkbGeometry.
+     */
+    QgsWkbGeometry() = default;
+
+    /**
+     * Constructor for QgsWkbGeometry from a \a wkb representation. The WKB is not
+     * parsed until it is queried.
+     */
+    explicit QgsWkbGeometry( const QByteArray &wkb );
+
+    /**
+     * Creates a QgsWkbGeometry from an existing \a geometry, which is kept as the
+     * materialized geometry().
+     */
+    static QgsWkbGeometry fromGeometry( const QgsGeometry &geometry );
+
+    /**
+     * Returns TRUE if the geometry is null, i.e. has no WKB.
+     */
+    bool isNull() const { return mWkb.isEmpty(); }
+
+    /**
+     * Returns the WKB representation of the geometry.
+     */
+    QByteArray wkb() const { return mWkb; }
+
+    /**
+     * Returns the WKB type of the geometry, read from the WKB header.
+     */
+    QgsWkbTypes::Type wkbType() const;
+
+    /**
+     * Returns the bounding box of the geometry. Null geometries, empty geometries and
+     * invalid WKB result in a null rectangle.
+     */
+    QgsRectangle boundingBox() const;
+
+    /**
+     * Returns TRUE if the bounding box of the geometry intersects \a rectangle.
+     */
+    bool boundingBoxIntersects( const QgsRectangle &rectangle ) const;
+
+    /**
+     * Returns TRUE if the geometry object tree has already been built.
+     */
+    bool isMaterialized() const { return mGeometry.has_value(); }
+
+    /**
+     * Returns the geometry, building its object tree from the WKB on the first call.
+     */
+    QgsGeometry geometry() const;
+
+  private:
+
+    QByteArray mWkb;
+    mutable std::optional< QgsRectangle > mBoundingBox;
+    mutable std::optional< QgsGeometry > mGeometry;
+};
+
+#endif // QGSWKBGEOMETRY_H
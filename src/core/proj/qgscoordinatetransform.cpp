@@ -22,6 +22,8 @@
 #include "qgspointxy.h"
 #include "qgsrectangle.h"
 #include "qgsexception.h"
+#include "qgsgeometry.h"
+#include "qgsgeometrytransformer.h"
 #include "qgsproject.h"
 #include "qgsreadwritelocker.h"
 #include "qgsvector3d.h"
@@ -619,6 +621,11 @@ QgsRectangle QgsCoordinateTransform::transformBoundingBox( const QgsRectangle &r
 }
 
 void QgsCoordinateTransform::transformCoords( int numPoints, double *x, double *y, double *z, TransformDirection direction ) const
+{
+  transformCoordsInternal( numPoints, x, y, z, direction, true );
+}
+
+void QgsCoordinateTransform::transformCoordsInternal( int numPoints, double *x, double *y, double *z, TransformDirection direction, bool allowFallback ) const
 {
   if ( !d->mIsValid || d->mShortCircuit )
     return;
@@ -714,6 +721,7 @@ void QgsCoordinateTransform::transformCoords( int numPoints, double *x, double *
 
   mFallbackOperationOccurred = false;
   if ( actualRes != 0
+       && allowFallback
        && ( d->mAvailableOpCount > 1 || d->mAvailableOpCount == -1 ) // only use fallbacks if more than one operation is possible -- otherwise we've already tried it and it failed
        && ( d->mAllowFallbackTransforms || mBallparkTransformsAreAppropriate ) )
   {
@@ -813,6 +821,148 @@ void QgsCoordinateTransform::transformCoords( int numPoints, double *x, double *
 #endif
 }
 
+///@cond PRIVATE
+
+// Appends the vertices of geometries to a set of coordinate arrays
+class QgsCoordinateGatherer : public QgsAbstractGeometryTransformer
+{
+  public:
+
+    QgsCoordinateGatherer( bool transformZ )
+      : mTransformZ( transformZ )
+    {}
+
+    bool transformPoint( double &x, double &y, double &z, double & ) override
+    {
+      xs.push_back( x );
+      ys.push_back( y );
+      zs.push_back( mTransformZ ? z : 0 );
+      return true;
+    }
+
+    std::vector< double > xs;
+    std::vector< double > ys;
+    std::vector< double > zs;
+
+  private:
+    bool mTransformZ = false;
+};
+
+// Replaces the vertices of geometries with consecutive coordinates from a set of arrays
+class QgsCoordinateScatterer : public QgsAbstractGeometryTransformer
+{
+  public:
+
+    QgsCoordinateScatterer( const double *x, const double *y, const double *z, bool transformZ )
+      : mX( x )
+      , mY( y )
+      , mZ( z )
+      , mTransformZ( transformZ )
+    {}
+
+    bool transformPoint( double &x, double &y, double &z, double & ) override
+    {
+      x = *mX++;
+      y = *mY++;
+      if ( mTransformZ )
+        z = *mZ;
+      mZ++;
+      return true;
+    }
+
+  private:
+    const double *mX = nullptr;
+    const double *mY = nullptr;
+    const double *mZ = nullptr;
+    bool mTransformZ = false;
+};
+
+///@endcond
+
+QList< int > QgsCoordinateTransform::transformGeometries( QVector<QgsGeometry> &geometries, TransformDirection direction, bool transformZ ) const
+{
+  QList< int > failed;
+  if ( !d->mIsValid || d->mShortCircuit )
+    return failed;
+
+  // collect the vertices of all geometries, remembering where each geometry starts
+  QgsCoordinateGatherer gatherer( transformZ );
+  std::vector< std::size_t > offsets;
+  offsets.reserve( geometries.size() + 1 );
+  for ( QgsGeometry &geometry : geometries )
+  {
+    offsets.push_back( gatherer.xs.size() );
+    // detaches the geometry, which has to happen anyway before its vertices are replaced
+    if ( QgsAbstractGeometry *abstractGeometry = geometry.get() )
+      abstractGeometry->transform( &gatherer );
+  }
+  offsets.push_back( gatherer.xs.size() );
+
+  if ( gatherer.xs.empty() )
+    return failed;
+
+  // the batch is first transformed with the primary operation only, so that a vertex which needs
+  // a fallback operation does not change the operation used for the vertices of the other geometries
+  const std::vector< double > originalX = gatherer.xs;
+  const std::vector< double > originalY = gatherer.ys;
+  const std::vector< double > originalZ = gatherer.zs;
+  bool batchFailed = false;
+  try
+  {
+    transformCoordsInternal( static_cast< int >( gatherer.xs.size() ), gatherer.xs.data(), gatherer.ys.data(), gatherer.zs.data(), direction, false );
+  }
+  catch ( QgsCsException & )
+  {
+    // only thrown for a single vertex, i.e. a batch of a single point
+    batchFailed = true;
+  }
+
+  // like transformCoords, treat infinite results as a failure to transform the vertex
+  auto isInf = []( double v ) { return std::isinf( v ); };
+  auto hasFailedVertex = [&gatherer, &isInf]( std::size_t start, std::size_t end )
+  {
+    return std::any_of( gatherer.xs.begin() + start, gatherer.xs.begin() + end, isInf )
+           || std::any_of( gatherer.ys.begin() + start, gatherer.ys.begin() + end, isInf );
+  };
+
+  bool fallbackOperationOccurred = false;
+  for ( int i = 0; i < geometries.size(); ++i )
+  {
+    const std::size_t start = offsets[i];
+    const std::size_t end = offsets[i + 1];
+    if ( start == end )
+      continue;
+
+    if ( batchFailed || hasFailedVertex( start, end ) )
+    {
+      // transform only this geometry again, from its original coordinates, allowing a fallback operation
+      std::copy( originalX.begin() + start, originalX.begin() + end, gatherer.xs.begin() + start );
+      std::copy( originalY.begin() + start, originalY.begin() + end, gatherer.ys.begin() + start );
+      std::copy( originalZ.begin() + start, originalZ.begin() + end, gatherer.zs.begin() + start );
+      try
+      {
+        transformCoords( static_cast< int >( end - start ), gatherer.xs.data() + start, gatherer.ys.data() + start, gatherer.zs.data() + start, direction );
+        fallbackOperationOccurred |= mFallbackOperationOccurred;
+      }
+      catch ( QgsCsException & )
+      {
+        failed << i;
+        continue;
+      }
+      if ( hasFailedVertex( start, end ) )
+      {
+        failed << i;
+        continue;
+      }
+    }
+
+    QgsCoordinateScatterer scatterer( gatherer.xs.data() + start, gatherer.ys.data() + start, gatherer.zs.data() + start, transformZ );
+    geometries[i].get()->transform( &scatterer );
+  }
+  mFallbackOperationOccurred = fallbackOperationOccurred;
+  return failed;
+}
+
 bool QgsCoordinateTransform::isValid() const
 {
   return d->mIsValid;
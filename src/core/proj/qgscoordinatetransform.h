@@ -26,6 +26,7 @@
 #include "qgscoordinatetransformcontext.h"
 
 class QgsCoordinateTransformPrivate;
+class QgsGeometry;
 class QgsPointXY;
 class QgsRectangle;
 class QPolygonF;
@@ -351,6 +352,32 @@ class CORE_EXPORT QgsCoordinateTransform
      */
     void transformCoords( int numPoint, double *x, double *y, double *z, TransformDirection direction = ForwardTransform ) const SIP_THROW( QgsCsException );
 
+#ifndef SIP_RUN
+
+    /**
+     * Transforms all of the specified \a geometries in place.
+     *
+     * The vertices of all geometries, including all of their parts and rings, are transformed
+     * together in a single batch instead of one call per geometry part, which greatly reduces
+     * the overhead of transforming many small geometries.
+     *
+     * Z values are only transformed if \a transformZ is TRUE.
+     *
+     * The batch is transformed with the coordinate operation of the transform only. Geometries with
+     * vertices which this operation cannot transform are then transformed again one by one, allowing
+     * a fallback operation for that geometry alone, so that they never change the operation used for
+     * the other geometries of the batch.
+     *
+     * Returns the indices of any geometries containing vertices which could not be transformed.
+     * These geometries are left unchanged, so that callers can handle them individually (e.g. by
+     * calling QgsGeometry::transform() on them).
+     *
+     * \note Not available in Python bindings
+     * \since QGIS 3.20
+     */
+    QList< int > transformGeometries( QVector< QgsGeometry > &geometries, TransformDirection direction = ForwardTransform, bool transformZ = false ) const;
+#endif
+
     /**
      * Returns TRUE if the transform short circuits because the source and destination are equivalent.
      */
@@ -719,6 +746,11 @@ class CORE_EXPORT QgsCoordinateTransform
 
     void addToCache();
 
+#ifndef SIP_RUN
+    //! Transforms the coordinates, only trying a fallback operation if \a allowFallback is TRUE
+    void transformCoordsInternal( int numPoint, double *x, double *y, double *z, TransformDirection direction, bool allowFallback ) const;
+#endif
+
     // cache
     static QReadWriteLock sCacheLock;
 
@@ -0,0 +1,256 @@
+/***************************************************************************
+    qgscoordinatetransformgrid.cpp  -  Approximate transform by grid interpolation
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgscoordinatetransformgrid.h"
+#include "qgsexception.h"
+#include "qgslogger.h"
+
+#include <QPolygonF>
+
+#include <algorithm>
+#include <cmath>
+
+QgsCoordinateTransformGrid::QgsCoordinateTransformGrid( const QgsCoordinateTransform &transform, const QgsRectangle &extent, double maxError, int maxCells )
+  : mTransform( transform )
+  , mExtent( extent )
+  , mMaxError( maxError )
+{
+  if ( !mTransform.isValid() || mExtent.isEmpty() || !mExtent.isFinite() || maxError <= 0 )
+    return;
+
+  // refine the grid until it is accurate enough, like QgsRasterProjector does for its
+  // approximate mode
+  for ( mCells = 2; mCells <= maxCells; mCells *= 2 )
+  {
+    if ( build() )
+    {
+      mValid = true;
+      break;
+    }
+  }
+
+  QgsDebugMsgLevel( QStringLiteral( "Approximate transform grid: %1 cells, valid %2" ).arg( mCells ).arg( mValid ), 3 );
+  if ( !mValid )
+  {
+    mNodeX.clear();
+    mNodeY.clear();
+    mCellValid.clear();
+  }
+}
+
+bool QgsCoordinateTransformGrid::build()
+{
+  mCellWidth = mExtent.width() / mCells;
+  mCellHeight = mExtent.height() / mCells;
+  const int nodesPerRow = mCells + 1;
+  const std::size_t nodeCount = static_cast< std::size_t >( nodesPerRow ) * nodesPerRow;
+  const std::size_t cellCount = static_cast< std::size_t >( mCells ) * mCells;
+
+  // the error is checked at the center of every cell and at the midpoint of every cell edge.
+  // Each cell owns its bottom and left edges, cells of the last row also their top edge and
+  // cells of the last column their right edge, so that every edge is checked exactly once
+  struct Sample
+  {
+    int row;
+    int col;
+    //! position within the cell, from 0 to 1
+    double tx;
+    double ty;
+  };
+  std::vector< Sample > samples;
+  samples.reserve( 3 * cellCount + 2 * static_cast< std::size_t >( mCells ) );
+  for ( int row = 0; row < mCells; ++row )
+  {
+    for ( int col = 0; col < mCells; ++col )
+    {
+      samples.push_back( { row, col, 0.5, 0.5 } );
+      samples.push_back( { row, col, 0.5, 0 } );
+      samples.push_back( { row, col, 0, 0.5 } );
+      if ( row == mCells - 1 )
+        samples.push_back( { row, col, 0.5, 1 } );
+      if ( col == mCells - 1 )
+        samples.push_back( { row, col, 1, 0.5 } );
+    }
+  }
+
+  // nodes, row by row from the bottom left corner, followed by the samples
+  const std::size_t count = nodeCount + samples.size();
+  std::vector< double > x( count );
+  std::vector< double > y( count );
+  std::vector< double > z( count, 0.0 );
+
+  std::size_t i = 0;
+  for ( int row = 0; row < nodesPerRow; ++row )
+  {
+    for ( int col = 0; col < nodesPerRow; ++col, ++i )
+    {
+      x[i] = mExtent.xMinimum() + col * mCellWidth;
+      y[i] = mExtent.yMinimum() + row * mCellHeight;
+    }
+  }
+  for ( const Sample &sample : samples )
+  {
+    x[i] = mExtent.xMinimum() + ( sample.col + sample.tx ) * mCellWidth;
+    y[i++] = mExtent.yMinimum() + ( sample.row + sample.ty ) * mCellHeight;
+  }
+
+  try
+  {
+    mTransform.transformCoords( static_cast< int >( count ), x.data(), y.data(), z.data() );
+  }
+  catch ( QgsCsException & )
+  {
+    return false;
+  }
+
+  mNodeX.assign( x.begin(), x.begin() + nodeCount );
+  mNodeY.assign( y.begin(), y.begin() + nodeCount );
+
+  auto finiteNode = [this]( std::size_t index )
+  {
+    return std::isfinite( mNodeX[index] ) && std::isfinite( mNodeY[index] );
+  };
+
+  mCellValid.assign( cellCount, true );
+  for ( int row = 0; row < mCells; ++row )
+  {
+    for ( int col = 0; col < mCells; ++col )
+    {
+      const std::size_t node = static_cast< std::size_t >( row ) * nodesPerRow + col;
+      if ( !finiteNode( node ) || !finiteNode( node + 1 ) || !finiteNode( node + nodesPerRow ) || !finiteNode( node + nodesPerRow + 1 ) )
+      {
+        // these points will be transformed exactly
+        mCellValid[ static_cast< std::size_t >( row ) * mCells + col ] = false;
+      }
+    }
+  }
+
+  for ( std::size_t sample = 0; sample < samples.size(); ++sample )
+  {
+    const Sample &s = samples[sample];
+    const std::size_t cell = static_cast< std::size_t >( s.row ) * mCells + s.col;
+    if ( !mCellValid[cell] )
+      continue;
+
+    const double exactX = x[nodeCount + sample];
+    const double exactY = y[nodeCount + sample];
+    if ( !std::isfinite( exactX ) || !std::isfinite( exactY ) )
+    {
+      mCellValid[cell] = false;
+      continue;
+    }
+
+    double approxX = 0;
+    double approxY = 0;
+    interpolateInCell( s.row, s.col, s.tx, s.ty, approxX, approxY );
+    if ( std::fabs( approxX - exactX ) > mMaxError || std::fabs( approxY - exactY ) > mMaxError )
+      return false;
+  }
+
+  // a grid without any usable cell would only add overhead
+  return std::find( mCellValid.begin(), mCellValid.end(), true ) != mCellValid.end();
+}
+
+bool QgsCoordinateTransformGrid::interpolate( double x, double y, double &outX, double &outY ) const
+{
+  const double fx = ( x - mExtent.xMinimum() ) / mCellWidth;
+  const double fy = ( y - mExtent.yMinimum() ) / mCellHeight;
+  if ( !( fx >= 0 && fx <= mCells && fy >= 0 && fy <= mCells ) )
+    return false;
+
+  const int col = std::min( static_cast< int >( fx ), mCells - 1 );
+  const int row = std::min( static_cast< int >( fy ), mCells - 1 );
+  if ( !mCellValid[ static_cast< std::size_t >( row ) * mCells + col ] )
+    return false;
+
+  interpolateInCell( row, col, fx - col, fy - row, outX, outY );
+  return true;
+}
+
+void QgsCoordinateTransformGrid::interpolateInCell( int row, int col, double tx, double ty, double &outX, double &outY ) const
+{
+  const std::size_t nodesPerRow = static_cast< std::size_t >( mCells ) + 1;
+  const std::size_t bottomLeft = row * nodesPerRow + col;
+  const std::size_t topLeft = bottomLeft + nodesPerRow;
+
+  const double bottomX = mNodeX[bottomLeft] + ( mNodeX[bottomLeft + 1] - mNodeX[bottomLeft] ) * tx;
+  const double topX = mNodeX[topLeft] + ( mNodeX[topLeft + 1] - mNodeX[topLeft] ) * tx;
+  const double bottomY = mNodeY[bottomLeft] + ( mNodeY[bottomLeft + 1] - mNodeY[bottomLeft] ) * tx;
+  const double topY = mNodeY[topLeft] + ( mNodeY[topLeft + 1] - mNodeY[topLeft] ) * tx;
+  outX = bottomX + ( topX - bottomX ) * ty;
+  outY = bottomY + ( topY - bottomY ) * ty;
+}
+
+void QgsCoordinateTransformGrid::transformInPlace( double &x, double &y ) const
+{
+  if ( mValid && interpolate( x, y, x, y ) )
+    return;
+
+  double z = 0;
+  mTransform.transformInPlace( x, y, z );
+}
+
+void QgsCoordinateTransformGrid::transformPolygon( QPolygonF &polygon ) const
+{
+  if ( !mValid )
+  {
+    mTransform.transformPolygon( polygon );
+    return;
+  }
+
+  // points which cannot be interpolated are collected and transformed exactly in one go
+  std::vector< int > exactIndices;
+  QPointF *point = polygon.data();
+  for ( int i = 0; i < polygon.size(); ++i, ++point )
+  {
+    double x = 0;
+    double y = 0;
+    if ( interpolate( point->x(), point->y(), x, y ) )
+    {
+      point->rx() = x;
+      point->ry() = y;
+    }
+    else
+    {
+      exactIndices.push_back( i );
+    }
+  }
+
+  if ( exactIndices.empty() )
+    return;
+
+  QPolygonF exact;
+  exact.reserve( static_cast< int >( exactIndices.size() ) );
+  for ( int index : exactIndices )
+    exact << polygon.at( index );
+
+  QString error;
+  try
+  {
+    mTransform.transformPolygon( exact );
+  }
+  catch ( QgsCsException &e )
+  {
+    // like QgsCoordinateTransform::transformPolygon, store whatever could be transformed before rethrowing
+    error = e.what();
+  }
+
+  for ( std::size_t i = 0; i < exactIndices.size(); ++i )
+    polygon[ exactIndices[i] ] = exact.at( static_cast< int >( i ) );
+
+  if ( !error.isEmpty() )
+    throw QgsCsException( error );
+}
@@ -0,0 +1,120 @@
+/***************************************************************************
+    qgscoordinatetransformgrid.h  -  Approximate transform by grid interpolation
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSCOORDINATETRANSFORMGRID_H
+#define QGSCOORDINATETRANSFORMGRID_H
+
+#include "qgis_core.h"
+#include "qgis_sip.h"
+#include "qgscoordinatetransform.h"
+#include "qgsrectangle.h"
+
+#include <vector>
+
+#define SIP_NO_FILE
+
+class QPolygonF;
+
+/**
+ * \ingroup core
+ * \class QgsCoordinateTransformGrid
+ * \brief Approximates a coordinate transform over an extent by interpolating within a grid of exactly transformed points.
+ *
+ * The grid covers an extent in the source CRS of the transform. Its nodes are transformed exactly,
+ * and points within the grid are then transformed by bilinear interpolation between the four
+ * nodes of the cell containing them, which is far cheaper than an exact transform.
+ *
+ * On construction the grid is refined until the difference between interpolated and exact positions,
+ * measured at the center and at the midpoints of all four edges of every cell, is below a maximum error. If this cannot
+ * be achieved within the maximum number of cells the grid is not valid and must not be used.
+ *
+ * Points outside the grid extent, or within cells touching nodes which could not be transformed,
+ * are transformed exactly. This mirrors the approximate mode of QgsRasterProjector, for vector data.
+ *
+ * \note Not available in Python bindings
+ * \since QGIS 3.20
+ */
+class CORE_EXPORT QgsCoordinateTransformGrid
+{
+  public:
+
+    /**
+     * Constructor for QgsCoordinateTransformGrid, approximating \a transform over the specified
+     * \a extent (in the transform's source CRS).
+     *
+     * \a maxError is the maximum allowed error in destination CRS units, and \a maxCells the maximum
+     * number of grid cells in each direction.
+     */
+    QgsCoordinateTransformGrid( const QgsCoordinateTransform &transform, const QgsRectangle &extent, double maxError, int maxCells = 256 );
+
+    /**
+     * Returns TRUE if the grid approximates the transform within the maximum error.
+     */
+    bool isValid() const { return mValid; }
+
+    /**
+     * Returns the extent covered by the grid, in source CRS units.
+     */
+    QgsRectangle extent() const { return mExtent; }
+
+    /**
+     * Returns the number of grid cells in each direction.
+     */
+    int cellCount() const { return mCells; }
+
+    /**
+     * Transforms the point (\a x, \a y) from source to destination CRS in place.
+     * \throws QgsCsException if the point needed an exact transform which failed
+     */
+    void transformInPlace( double &x, double &y ) const SIP_THROW( QgsCsException );
+
+    /**
+     * Transforms all points of \a polygon from source to destination CRS in place.
+     * \throws QgsCsException if some of the points needed an exact transform which failed
+     */
+    void transformPolygon( QPolygonF &polygon ) const SIP_THROW( QgsCsException );
+
+  private:
+
+    /**
+     * Calculates the interpolated position of (\a x, \a y), returning FALSE if the
+     * point is outside the grid or in a cell which cannot be interpolated.
+     */
+    bool interpolate( double x, double y, double &outX, double &outY ) const;
+
+    //! Interpolates within the cell at \a row, \a col, at the relative position (\a tx, \a ty) from its bottom left corner
+    void interpolateInCell( int row, int col, double tx, double ty, double &outX, double &outY ) const;
+
+    //! Transforms the nodes for the current cell count and checks their error, returns FALSE on failure
+    bool build();
+
+    QgsCoordinateTransform mTransform;
+    QgsRectangle mExtent;
+    double mMaxError = 0;
+    int mCells = 2;
+    double mCellWidth = 0;
+    double mCellHeight = 0;
+    bool mValid = false;
+
+    //! Destination coordinates of the nodes, row by row from the bottom left corner
+    std::vector< double > mNodeX;
+    std::vector< double > mNodeY;
+
+    //! FALSE for cells touching a node which could not be transformed
+    std::vector< bool > mCellValid;
+};
+
+#endif // QGSCOORDINATETRANSFORMGRID_H
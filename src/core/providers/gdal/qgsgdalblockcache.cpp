@@ -0,0 +1,124 @@
+/***************************************************************************
+      qgsgdalblockcache.cpp  -  Cache of decoded GDAL provider blocks
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsgdalblockcache.h"
+#include "qgis.h"
+#include "qgssettings.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+///@cond PRIVATE
+
+// Separator which cannot appear in a data source URI, used to build cache keys
+static const QChar KEY_SEPARATOR( 0x1f );
+
+Q_GLOBAL_STATIC( QgsGdalBlockCache, sGdalBlockCache )
+
+QString QgsGdalBlockCache::Key::toString() const
+{
+  return dataset + KEY_SEPARATOR
+         + QString::number( band ) + KEY_SEPARATOR
+         + qgsDoubleToString( extent.xMinimum(), 17 ) + ','
+         + qgsDoubleToString( extent.yMinimum(), 17 ) + ','
+         + qgsDoubleToString( extent.xMaximum(), 17 ) + ','
+         + qgsDoubleToString( extent.yMaximum(), 17 ) + KEY_SEPARATOR
+         + QString::number( width ) + 'x' + QString::number( height ) + KEY_SEPARATOR
+         + options;
+}
+
+QgsGdalBlockCache *QgsGdalBlockCache::instance()
+{
+  return sGdalBlockCache();
+}
+
+QgsGdalBlockCache::QgsGdalBlockCache()
+{
+  const QgsSettings settings;
+  setMaxSize( settings.value( QStringLiteral( "cache/gdalBlockCacheSize" ), 0 ).toLongLong() );
+}
+
+bool QgsGdalBlockCache::isEnabled() const
+{
+  QMutexLocker locker( &mMutex );
+  return mMaxSize > 0;
+}
+
+qint64 QgsGdalBlockCache::maxSize() const
+{
+  QMutexLocker locker( &mMutex );
+  return mMaxSize;
+}
+
+void QgsGdalBlockCache::setMaxSize( qint64 bytes )
+{
+  QMutexLocker locker( &mMutex );
+  mMaxSize = std::max( static_cast< qint64 >( 0 ), bytes );
+  mCache.setMaxCost( static_cast< int >( std::min( mMaxSize / 1024, static_cast< qint64 >( std::numeric_limits< int >::max() ) ) ) );
+}
+
+bool QgsGdalBlockCache::fetch( const Key &key, void *data, qint64 size ) const
+{
+  QMutexLocker locker( &mMutex );
+  if ( mMaxSize <= 0 )
+    return false;
+
+  // QCache::object() also bumps the entry to the front of the LRU list
+  const QByteArray *cached = mCache.object( key.toString() );
+  if ( !cached || cached->size() != size )
+    return false;
+
+  std::memcpy( data, cached->constData(), static_cast< size_t >( size ) );
+  ++mHitCount;
+  return true;
+}
+
+void QgsGdalBlockCache::insert( const Key &key, const void *data, qint64 size )
+{
+  QMutexLocker locker( &mMutex );
+  if ( mMaxSize <= 0 || size <= 0 || size > mMaxSize || size > std::numeric_limits< int >::max() )
+    return;
+
+  QByteArray *block = new QByteArray( static_cast< const char * >( data ), static_cast< int >( size ) );
+  mCache.insert( key.toString(), block, std::max( 1, static_cast< int >( size / 1024 ) ) );
+}
+
+void QgsGdalBlockCache::invalidate( const QString &dataset )
+{
+  QMutexLocker locker( &mMutex );
+  const QString prefix = dataset + KEY_SEPARATOR;
+  const QList< QString > keys = mCache.keys();
+  for ( const QString &key : keys )
+  {
+    if ( key.startsWith( prefix ) )
+      mCache.remove( key );
+  }
+}
+
+void QgsGdalBlockCache::clear()
+{
+  QMutexLocker locker( &mMutex );
+  mCache.clear();
+}
+
+qint64 QgsGdalBlockCache::hitCount() const
+{
+  QMutexLocker locker( &mMutex );
+  return mHitCount;
+}
+
+///@endcond
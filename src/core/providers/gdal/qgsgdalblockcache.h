@@ -0,0 +1,114 @@
+/***************************************************************************
+      qgsgdalblockcache.h  -  Cache of decoded GDAL provider blocks
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSGDALBLOCKCACHE_H
+#define QGSGDALBLOCKCACHE_H
+
+#include "qgis_core.h"
+#include "qgis_sip.h"
+#include "qgsrectangle.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QString>
+#include <QByteArray>
+
+///@cond PRIVATE
+#define SIP_NO_FILE
+
+/**
+ * \brief Process wide cache of decoded and resampled blocks returned by the GDAL provider.
+ *
+ * Entries are keyed by the dataset, band, requested extent, output size and the
+ * resampling settings used to produce them, so that repeated requests for the same
+ * view from the map canvas, layouts or the server can be served without touching
+ * GDAL again.
+ *
+ * The cache is disabled unless a memory budget has been set, either through
+ * setMaxSize() or through the "cache/gdalBlockCacheSize" setting (in bytes).
+ */
+class CORE_EXPORT QgsGdalBlockCache
+{
+  public:
+
+    /**
+     * Key identifying a cached block.
+     */
+    struct Key
+    {
+      //! Dataset identifier (usually the provider's data source URI)
+      QString dataset;
+      //! Band number
+      int band = 0;
+      //! Requested extent, in layer CRS
+      QgsRectangle extent;
+      //! Output block width in pixels
+      int width = 0;
+      //! Output block height in pixels
+      int height = 0;
+      //! Any other state which affects the decoded result (e.g. resampling settings)
+      QString options;
+
+      //! Returns a string representation of the key, suitable for hashing
+      QString toString() const;
+    };
+
+    //! Returns the global cache instance
+    static QgsGdalBlockCache *instance();
+
+    QgsGdalBlockCache();
+
+    //! Returns TRUE if the cache has a non-zero memory budget
+    bool isEnabled() const;
+
+    //! Returns the maximum size of the cache, in bytes
+    qint64 maxSize() const;
+
+    //! Sets the maximum size of the cache, in bytes. A size of 0 disables the cache.
+    void setMaxSize( qint64 bytes );
+
+    /**
+     * Copies the cached block matching \a key into \a data, which must be at least
+     * \a size bytes large. Returns FALSE if no matching block is cached.
+     */
+    bool fetch( const Key &key, void *data, qint64 size ) const;
+
+    //! Stores a copy of the \a size bytes pointed to by \a data under \a key
+    void insert( const Key &key, const void *data, qint64 size );
+
+    //! Removes all cached blocks belonging to \a dataset
+    void invalidate( const QString &dataset );
+
+    //! Removes all cached blocks
+    void clear();
+
+    //! Returns the number of fetch() calls which were served from the cache
+    qint64 hitCount() const;
+
+  private:
+
+    mutable QMutex mMutex;
+
+    //! Cached blocks, with costs expressed in KiB so that budgets above 2 GiB fit into an int
+    mutable QCache< QString, QByteArray > mCache;
+
+    qint64 mMaxSize = 0;
+
+    mutable qint64 mHitCount = 0;
+};
+
+///@endcond
+#endif // QGSGDALBLOCKCACHE_H
@@ -25,6 +25,7 @@
 #include "qgsconfig.h"
 
 #include "qgsgdalutils.h"
+#include "qgsgdalblockcache.h"
 #include "qgsapplication.h"
 #include "qgsauthmanager.h"
 #include "qgscoordinatetransform.h"
@@ -50,6 +51,7 @@
 #include <QProcess>
 #include <QDir>
 #include <QFileInfo>
+#include <QDateTime>
 #include <QFile>
 #include <QHash>
 #include <QTime>
@@ -281,6 +283,9 @@ QgsGdalProvider::QgsGdalProvider( const QgsGdalProvider &other )
   mSubLayers = other.mSubLayers;
   mMaskBandExposedAsAlpha = other.mMaskBandExposedAsAlpha;
   mBandCount = other.mBandCount;
+  mIsRemoteDataset = other.mIsRemoteDataset;
+  mIsLocalFile = other.mIsLocalFile;
+  mBlockCacheSignature = other.mBlockCacheSignature;
   copyBaseSettings( other );
 }
 
@@ -511,6 +516,7 @@ void QgsGdalProvider::closeDataset()
 void QgsGdalProvider::reloadProviderData()
 {
   QMutexLocker locker( mpMutex );
+  QgsGdalBlockCache::instance()->invalidate( dataSourceUri( true ) );
   closeDataset();
 
   mHasInit = false;
@@ -654,6 +660,25 @@ QgsRasterBlock *QgsGdalProvider::block( int bandNo, const QgsRectangle &extent,
     QRect subRect = QgsRasterBlock::subRect( extent, width, height, mExtent );
     block->setIsNoDataExcept( subRect );
   }
+
+  // datasets opened in update mode may change under our feet, so never cache their blocks. Neither
+  // are blocks of datasets which are not plain files (/vsimem/, remote, databases...), as a changed
+  // dataset could not be told apart from the cached version
+  QgsGdalBlockCache *blockCache = QgsGdalBlockCache::instance();
+  const bool useBlockCache = !mUpdate && !mBlockCacheSignature.isEmpty() && blockCache->isEnabled();
+  const qint64 blockSize = static_cast< qint64 >( block->dataTypeSize() ) * width * height;
+  QgsGdalBlockCache::Key cacheKey;
+  if ( useBlockCache )
+  {
+    cacheKey = blockCacheKey( bandNo, extent, width, height );
+    if ( blockCache->fetch( cacheKey, block->bits(), blockSize ) )
+    {
+      block->applyScaleOffset( bandScale( bandNo ), bandOffset( bandNo ) );
+      block->applyNoDataValues( userNoDataValues( bandNo ) );
+      return block.release();
+    }
+  }
+
   if ( !readBlock( bandNo, extent, width, height, block->bits(), feedback ) )
   {
     block->setError( { tr( "Error occurred while reading block." ), QStringLiteral( "GDAL" ) } );
@@ -661,6 +686,10 @@ QgsRasterBlock *QgsGdalProvider::block( int bandNo, const QgsRectangle &extent,
     block->setValid( false );
     return block.release();
   }
+
+  if ( useBlockCache && !( feedback && feedback->isCanceled() ) )
+    blockCache->insert( cacheKey, block->bits(), blockSize );
+
   // apply scale and offset
   Q_ASSERT( block ); // to make cppcheck happy
   block->applyScaleOffset( bandScale( bandNo ), bandOffset( bandNo ) );
@@ -668,6 +697,25 @@ QgsRasterBlock *QgsGdalProvider::block( int bandNo, const QgsRectangle &extent,
   return block.release();
 }
 
+QgsGdalBlockCache::Key QgsGdalProvider::blockCacheKey( int bandNo, const QgsRectangle &extent, int width, int height ) const
+{
+  QgsGdalBlockCache::Key key;
+  key.dataset = dataSourceUri( true );
+  key.band = bandNo;
+  key.extent = extent;
+  key.width = width;
+  key.height = height;
+  // everything else which changes the bytes written by readBlock()
+  key.options = QStringLiteral( "%1:%2:%3:%4:%5:%6:%7" ).arg( mBlockCacheSignature )
+                .arg( mProviderResamplingEnabled ? 1 : 0 )
+                .arg( static_cast< int >( mZoomedInResamplingMethod ) )
+                .arg( static_cast< int >( mZoomedOutResamplingMethod ) )
+                .arg( qgsDoubleToString( mMaxOversampling ) )
+                .arg( sourceHasNoDataValue( bandNo ) && useSourceNoDataValue( bandNo ) ? 1 : 0 )
+                .arg( qgsDoubleToString( sourceNoDataValue( bandNo ) ) );
+  return key;
+}
+
 bool QgsGdalProvider::readBlock( int bandNo, int xBlock, int yBlock, void *data )
 {
   QMutexLocker locker( mpMutex );
@@ -693,6 +741,33 @@ bool QgsGdalProvider::readBlock( int bandNo, int xBlock, int yBlock, void *data
   return true;
 }
 
+void QgsGdalProvider::adviseRead( int srcLeft, int srcTop, int srcWidth, int srcHeight, int bufferWidth, int bufferHeight )
+{
+  const QRect window( srcLeft, srcTop, srcWidth, srcHeight );
+  const QSize bufferSize( bufferWidth, bufferHeight );
+  // the same window is requested once per band when rendering multiband rasters,
+  // but a single advise already covers all of them
+  if ( window == mLastAdvisedWindow && bufferSize == mLastAdvisedBufferSize )
+    return;
+
+  mLastAdvisedWindow = window;
+  mLastAdvisedBufferSize = bufferSize;
+
+  const int bandCount = GDALGetRasterCount( mGdalDataset );
+  if ( bandCount == 0 )
+    return;
+
+  // failures are harmless here, the actual reads will just fetch tiles on demand
+  CPLErrorReset();
+  if ( GDALDatasetAdviseRead( mGdalDataset, srcLeft, srcTop, srcWidth, srcHeight,
+                              bufferWidth, bufferHeight, mGdalDataType.value( 0, GDT_Byte ),
+                              bandCount, nullptr, nullptr ) != CE_None )
+  {
+    QgsDebugMsgLevel( QStringLiteral( "AdviseRead failed: %1" ).arg( QString::fromUtf8( CPLGetLastErrorMsg() ) ), 2 );
+    CPLErrorReset();
+  }
+}
+
 bool QgsGdalProvider::canDoResampling(
   int bandNo,
   const QgsRectangle &reqExtent,
@@ -876,6 +951,12 @@ bool QgsGdalProvider::readBlock( int bandNo, QgsRectangle  const &reqExtent, int
   const int srcWidth = srcRight - srcLeft + 1;
   const int srcHeight = srcBottom - srcTop + 1;
 
+  if ( mIsRemoteDataset )
+  {
+    adviseRead( srcLeft, srcTop, srcWidth, srcHeight,
+                tgtRightOri - tgtLeftOri + 1, tgtBottomOri - tgtTopOri + 1 );
+  }
+
   // Use GDAL resampling if asked and possible
   if ( mProviderResamplingEnabled &&
        canDoResampling( bandNo, reqExtent, bufferWidthPix, bufferHeightPix ) )
@@ -1634,9 +1715,13 @@ QString QgsGdalProvider::description() const
 
 QgsRasterDataProvider::ProviderCapabilities QgsGdalProvider::providerCapabilities() const
 {
-  return ProviderCapability::ProviderHintBenefitsFromResampling |
-         ProviderCapability::ProviderHintCanPerformProviderResampling |
-         ProviderCapability::ReloadData;
+  QgsRasterDataProvider::ProviderCapabilities capabilities = ProviderCapability::ProviderHintBenefitsFromResampling |
+      ProviderCapability::ProviderHintCanPerformProviderResampling |
+      ProviderCapability::ReloadData;
+  // remote sources would receive a request for every strip rendered concurrently
+  if ( mIsLocalFile )
+    capabilities |= ProviderCapability::ProviderHintConcurrentReading;
+  return capabilities;
 }
 
 // This is used also by global isValidRasterFileName
@@ -1950,6 +2035,9 @@ QString QgsGdalProvider::buildPyramids( const QList<QgsRasterPyramid> &rasterPyr
     return QStringLiteral( "ERROR_VIRTUAL" );
   }
 
+  // new overviews change the result of downsampled reads
+  QgsGdalBlockCache::instance()->invalidate( dataSourceUri( true ) );
+
   // check if building internally
   if ( format == QgsRaster::PyramidsInternal )
   {
@@ -1985,18 +2073,30 @@ QString QgsGdalProvider::buildPyramids( const QList<QgsRasterPyramid> &rasterPyr
     }
   }
 
+  // configuration options are only set for this thread, as other threads may be using GDAL
+  // concurrently (e.g. when pyramids are built in a background task), and restored afterwards
+  QMap< QByteArray, QByteArray > myConfigOptionsOld;
+  auto setConfigOption = [&myConfigOptionsOld]( const QByteArray & key, const QByteArray & value )
+  {
+    if ( !myConfigOptionsOld.contains( key ) )
+      myConfigOptionsOld.insert( key, QByteArray( CPLGetThreadLocalConfigOption( key.constData(), nullptr ) ) );
+    CPLSetThreadLocalConfigOption( key.constData(), value.constData() );
+  };
+  auto restoreConfigOptions = [&myConfigOptionsOld]
+  {
+    for ( auto it = myConfigOptionsOld.constBegin(); it != myConfigOptionsOld.constEnd(); ++it )
+      CPLSetThreadLocalConfigOption( it.key().constData(), it.value().isNull() ? nullptr : it.value().constData() );
+  };
+
   // are we using Erdas Imagine external overviews?
-  QgsStringMap myConfigOptionsOld;
-  myConfigOptionsOld[ QStringLiteral( "USE_RRD" )] = CPLGetConfigOption( "USE_RRD", "NO" );
-  myConfigOptionsOld[ QStringLiteral( "TIFF_USE_OVR" )] = CPLGetConfigOption( "TIFF_USE_OVR", "NO" );
   if ( format == QgsRaster::PyramidsErdas )
-    CPLSetConfigOption( "USE_RRD", "YES" );
+    setConfigOption( QByteArrayLiteral( "USE_RRD" ), QByteArrayLiteral( "YES" ) );
   else
   {
-    CPLSetConfigOption( "USE_RRD", "NO" );
+    setConfigOption( QByteArrayLiteral( "USE_RRD" ), QByteArrayLiteral( "NO" ) );
     if ( format == QgsRaster::PyramidsGTiff )
     {
-      CPLSetConfigOption( "TIFF_USE_OVR", "YES" );
+      setConfigOption( QByteArrayLiteral( "TIFF_USE_OVR" ), QByteArrayLiteral( "YES" ) );
     }
   }
 
@@ -2011,10 +2111,7 @@ QString QgsGdalProvider::buildPyramids( const QList<QgsRasterPyramid> &rasterPyr
       {
         QByteArray key = opt[0].toLocal8Bit();
         QByteArray value = opt[1].toLocal8Bit();
-        // save previous value
-        myConfigOptionsOld[ opt[0] ] = QString( CPLGetConfigOption( key.data(), nullptr ) );
-        // set temp. value
-        CPLSetConfigOption( key.data(), value.data() );
+        setConfigOption( key, value );
         QgsDebugMsgLevel( QStringLiteral( "set option %1=%2" ).arg( key.data(), value.data() ), 2 );
       }
       else
@@ -2091,13 +2188,7 @@ QString QgsGdalProvider::buildPyramids( const QList<QgsRasterPyramid> &rasterPyr
       mGdalDataset = mGdalBaseDataset;
 
       // restore former configOptions
-      for ( QgsStringMap::const_iterator it = myConfigOptionsOld.constBegin();
-            it != myConfigOptionsOld.constEnd(); ++it )
-      {
-        QByteArray key = it.key().toLocal8Bit();
-        QByteArray value = it.value().toLocal8Bit();
-        CPLSetConfigOption( key.data(), value.data() );
-      }
+      restoreConfigOptions();
 
       // TODO print exact error message
       if ( feedback && feedback->isCanceled() )
@@ -2118,13 +2209,7 @@ QString QgsGdalProvider::buildPyramids( const QList<QgsRasterPyramid> &rasterPyr
   }
 
   // restore former configOptions
-  for ( QgsStringMap::const_iterator it = myConfigOptionsOld.constBegin();
-        it != myConfigOptionsOld.constEnd(); ++it )
-  {
-    QByteArray key = it.key().toLocal8Bit();
-    QByteArray value = it.value().toLocal8Bit();
-    CPLSetConfigOption( key.data(), value.data() );
-  }
+  restoreConfigOptions();
 
   QgsDebugMsgLevel( QStringLiteral( "Pyramid overviews built" ), 2 );
 
@@ -2601,6 +2686,48 @@ bool QgsGdalProvider::isValidRasterFileName( QString const &fileNameQString, QSt
   }
 }
 
+//! Band metadata item flagging the cached GDAL statistics as exact, holding the statistics it applies to
+static const char *EXACT_STATISTICS_METADATA_ITEM = "STATISTICS_EXACT";
+
+//! Private metadata domain of the exact statistics flag, so that it is not reported with the band metadata
+static const char *EXACT_STATISTICS_METADATA_DOMAIN = "QGIS";
+
+//! Returns the cached GDAL statistics metadata of \a band, or an empty string if there are none
+static QString cachedStatisticsFingerprint( GDALRasterBandH band )
+{
+  QStringList values;
+  for ( const char *item : { "STATISTICS_MINIMUM", "STATISTICS_MAXIMUM", "STATISTICS_MEAN", "STATISTICS_STDDEV" } )
+  {
+    const char *value = GDALGetMetadataItem( band, item, nullptr );
+    if ( !value )
+      return QString();
+    values << QString::fromUtf8( value );
+  }
+  return values.join( ' ' );
+}
+
+/**
+ * Returns TRUE if the cached statistics of \a band were computed exactly by QGIS. The flag
+ * only holds while the cached values are unchanged, e.g. not replaced by approximate ones.
+ */
+static bool cachedStatisticsAreExact( GDALRasterBandH band )
+{
+  const char *exact = GDALGetMetadataItem( band, EXACT_STATISTICS_METADATA_ITEM, EXACT_STATISTICS_METADATA_DOMAIN );
+  if ( !exact )
+    return false;
+
+  const QString fingerprint = cachedStatisticsFingerprint( band );
+  return !fingerprint.isEmpty() && fingerprint == QString::fromUtf8( exact );
+}
+
+//! Flags the cached statistics of \a band as exact
+static void markCachedStatisticsExact( GDALRasterBandH band )
+{
+  const QString fingerprint = cachedStatisticsFingerprint( band );
+  if ( !fingerprint.isEmpty() )
+    GDALSetMetadataItem( band, EXACT_STATISTICS_METADATA_ITEM, fingerprint.toUtf8().constData(), EXACT_STATISTICS_METADATA_DOMAIN );
+}
+
 bool QgsGdalProvider::hasStatistics( int bandNo,
                                      int stats,
                                      const QgsRectangle &boundingBox,
@@ -2676,12 +2803,10 @@ bool QgsGdalProvider::hasStatistics( int bandNo,
   // (from all raster pixels) are not available/cached, it should return CE_Warning.
   // Instead, it is giving estimated (from sample) cached statistics and it returns CE_None.
   // see above and https://trac.osgeo.org/gdal/ticket/4857
-  // -> Cannot used cached GDAL stats for exact
-  if ( !bApproxOK ) return false;
-
-  CPLErr myerval = GDALGetRasterStatistics( myGdalBand, bApproxOK, true, pdfMin, pdfMax, pdfMean, pdfStdDev );
+  // -> Cannot used cached GDAL stats for exact, unless QGIS marked them as exact
+  CPLErr myerval = GDALGetRasterStatistics( myGdalBand, bApproxOK, false, pdfMin, pdfMax, pdfMean, pdfStdDev );
 
-  if ( CE_None == myerval ) // CE_Warning if cached not found
+  if ( CE_None == myerval && ( bApproxOK || cachedStatisticsAreExact( myGdalBand ) ) ) // CE_Warning if cached not found
   {
     QgsDebugMsgLevel( QStringLiteral( "GDAL has cached statistics" ), 2 );
     return true;
@@ -2770,21 +2895,26 @@ QgsRasterBandStats QgsGdalProvider::bandStatistics( int bandNo, int stats, const
   // try to fetch the cached stats (bForce=FALSE)
   // GDALGetRasterStatistics() do not work correctly with bApproxOK=false and bForce=false/true
   // see above and https://trac.osgeo.org/gdal/ticket/4857
-  // -> Cannot used cached GDAL stats for exact
+  // -> Cannot used cached GDAL stats for exact, unless QGIS marked them as exact
 
   CPLErr myerval =
-    GDALGetRasterStatistics( myGdalBand, bApproxOK, true, &pdfMin, &pdfMax, &pdfMean, &pdfStdDev );
+    GDALGetRasterStatistics( myGdalBand, bApproxOK, false, &pdfMin, &pdfMax, &pdfMean, &pdfStdDev );
 
   QgsDebugMsgLevel( QStringLiteral( "myerval = %1" ).arg( myerval ), 2 );
 
   // if cached stats are not found, compute them
-  if ( !bApproxOK || CE_None != myerval )
+  if ( CE_None != myerval || ( !bApproxOK && !cachedStatisticsAreExact( myGdalBand ) ) )
   {
     QgsDebugMsgLevel( QStringLiteral( "Calculating statistics by GDAL" ), 2 );
     myerval = GDALComputeRasterStatistics( myGdalBand, bApproxOK,
                                            &pdfMin, &pdfMax, &pdfMean, &pdfStdDev,
                                            progressCallback, &myProg );
     mStatisticsAreReliable = true;
+
+    // GDAL stores the statistics in the PAM (.aux.xml) file, flag them so that later
+    // loads can reuse them for exact statistics instead of scanning the raster again
+    if ( CE_None == myerval && !bApproxOK && !( feedback && feedback->isCanceled() ) )
+      markCachedStatisticsExact( myGdalBand );
   }
   else
   {
@@ -2901,6 +3031,13 @@ bool QgsGdalProvider::initIfNeeded()
 void QgsGdalProvider::initBaseDataset()
 {
   mDriverName = GDALGetDriverShortName( GDALGetDatasetDriver( mGdalBaseDataset ) );
+  mIsRemoteDataset = QgsGdalUtils::isRemotePath( dataSourceUri( true ) );
+  // blocks cached for an older version of a file which has since been overwritten must not be reused
+  const QFileInfo datasetFileInfo( decodeGdalUri( dataSourceUri( true ) ).value( QStringLiteral( "path" ) ).toString() );
+  mIsLocalFile = datasetFileInfo.isFile();
+  mBlockCacheSignature = mIsLocalFile ? QStringLiteral( "%1:%2" ).arg( datasetFileInfo.lastModified().toMSecsSinceEpoch() ).arg( datasetFileInfo.size() ) : QString();
+  mLastAdvisedWindow = QRect();
+  mLastAdvisedBufferSize = QSize();
   mHasInit = true;
   mValid = true;
 #if 0
@@ -3244,6 +3381,7 @@ bool QgsGdalProvider::write( void *data, int band, int width, int height, int xO
   {
     return false;
   }
+  QgsGdalBlockCache::instance()->invalidate( dataSourceUri( true ) );
   return gdalRasterIO( rasterBand, GF_Write, xOffset, yOffset, width, height, data, width, height, GDALGetRasterDataType( rasterBand ), 0, 0 ) == CE_None;
 }
 
@@ -3269,6 +3407,7 @@ bool QgsGdalProvider::setNoDataValue( int bandNo, double noDataValue )
   mSrcNoDataValue[bandNo - 1] = noDataValue;
   mSrcHasNoDataValue[bandNo - 1] = true;
   mUseSrcNoDataValue[bandNo - 1] = true;
+  QgsGdalBlockCache::instance()->invalidate( dataSourceUri( true ) );
   return true;
 }
 
@@ -22,6 +22,7 @@
 #include "qgscoordinatereferencesystem.h"
 #include "qgsrasterdataprovider.h"
 #include "qgsgdalproviderbase.h"
+#include "qgsgdalblockcache.h"
 #include "qgsrectangle.h"
 #include "qgscolorrampshader.h"
 #include "qgsrasterbandstats.h"
@@ -32,6 +33,8 @@
 #include <QDomElement>
 #include <QMap>
 #include <QVector>
+#include <QRect>
+#include <QSize>
 
 #include "qgis_sip.h"
 
@@ -347,9 +350,33 @@ class QgsGdalProvider final: public QgsRasterDataProvider, QgsGdalProviderBase
     */
     void reloadProviderData() override;
 
+    //! Whether the dataset is read over the network, in which case reads are announced to GDAL beforehand
+    bool mIsRemoteDataset = false;
+
+    //! Whether the dataset is a local file, which can be read concurrently by clones of the provider
+    bool mIsLocalFile = false;
+
+    //! Modification time and size of the dataset file when it was opened, part of the QgsGdalBlockCache keys. Empty, which disables the cache, if the dataset is not a file
+    QString mBlockCacheSignature;
+
+    //! Source window and buffer size of the last read announced through adviseRead()
+    QRect mLastAdvisedWindow;
+    QSize mLastAdvisedBufferSize;
+
+    /**
+     * Hints GDAL that the given source window of all bands is about to be read into
+     * a buffer of \a bufferWidth x \a bufferHeight pixels. For network datasets this lets
+     * drivers such as GTiff/COG fetch all the required tiles of the selected overview
+     * level with coalesced, parallel range requests instead of one request per tile.
+     */
+    void adviseRead( int srcLeft, int srcTop, int srcWidth, int srcHeight, int bufferWidth, int bufferHeight );
+
     //! Instance of GDAL transformer function used in transformCoordinates() for conversion between image and layer coordinates
     void *mGdalTransformerArg = nullptr;
 
+    //! Returns the key identifying a block read with the current provider settings in QgsGdalBlockCache
+    QgsGdalBlockCache::Key blockCacheKey( int bandNo, const QgsRectangle &extent, int width, int height ) const;
+
     bool canDoResampling(
       int bandNo,
       const QgsRectangle &reqExtent,
@@ -0,0 +1,690 @@
+/***************************************************************************
+    qgsmosaicrasterprovider.cpp  -  Virtual raster mosaic data provider
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsmosaicrasterprovider.h"
+#include "qgscoordinatetransform.h"
+#include "qgsexception.h"
+#include "qgsgdalutils.h"
+#include "qgslogger.h"
+#include "qgsproviderregistry.h"
+#include "qgsrasterblock.h"
+#include "qgsrasterprojector.h"
+
+#include <QDateTime>
+#include <QMutexLocker>
+#include <QUrl>
+
+#include <algorithm>
+#include <cstring>
+
+///@cond PRIVATE
+
+#define PROVIDER_KEY QStringLiteral( "mosaic" )
+#define PROVIDER_DESCRIPTION QStringLiteral( "Virtual raster mosaic data provider" )
+
+//! Maximum number of sources kept open by a provider instance
+constexpr int MOSAIC_MAX_OPEN_SOURCES = 64;
+
+//! Maximum size of the composed blocks cache, in KB
+constexpr int MOSAIC_BLOCK_CACHE_KB = 64 * 1024;
+
+//! Delay before a source which could not be opened is tried again, in ms
+constexpr qint64 MOSAIC_SOURCE_RETRY_MS = 30 * 1000;
+
+//! Joins \a items as a query string, percent encoding the values
+static QString encodeQuery( const QList< QPair< QString, QString > > &items )
+{
+  QStringList parts;
+  for ( const QPair< QString, QString > &item : items )
+    parts << item.first + '=' + QString::fromLatin1( QUrl::toPercentEncoding( item.second ) );
+  return parts.join( '&' );
+}
+
+//! Splits the query string \a query into its keys and decoded values
+static QList< QPair< QString, QString > > decodeQuery( const QString &query )
+{
+  QList< QPair< QString, QString > > items;
+  const QStringList parts = query.split( '&' );
+  for ( const QString &part : parts )
+  {
+    if ( part.isEmpty() )
+      continue;
+
+    const int separator = part.indexOf( '=' );
+    if ( separator < 0 )
+      items << qMakePair( part, QString() );
+    else
+      items << qMakePair( part.left( separator ), QUrl::fromPercentEncoding( part.mid( separator + 1 ).toLatin1() ) );
+  }
+  return items;
+}
+
+static QString rectangleToString( const QgsRectangle &rectangle )
+{
+  return QStringLiteral( "%1,%2,%3,%4" ).arg( qgsDoubleToString( rectangle.xMinimum() ),
+         qgsDoubleToString( rectangle.yMinimum() ),
+         qgsDoubleToString( rectangle.xMaximum() ),
+         qgsDoubleToString( rectangle.yMaximum() ) );
+}
+
+static QgsRectangle rectangleFromString( const QString &string )
+{
+  const QStringList values = string.split( ',' );
+  if ( values.size() != 4 )
+    return QgsRectangle();
+
+  return QgsRectangle( values.at( 0 ).toDouble(), values.at( 1 ).toDouble(), values.at( 2 ).toDouble(), values.at( 3 ).toDouble() );
+}
+
+QgsMosaicRasterProvider::BlockCache::BlockCache()
+{
+  mEntries.setMaxCost( MOSAIC_BLOCK_CACHE_KB );
+}
+
+QgsRasterBlock *QgsMosaicRasterProvider::BlockCache::block( const QString &key ) const
+{
+  QMutexLocker locker( &mMutex );
+  const Entry *entry = mEntries.object( key );
+  if ( !entry )
+    return nullptr;
+
+  std::unique_ptr< QgsRasterBlock > block = std::make_unique< QgsRasterBlock >( entry->dataType, entry->width, entry->height );
+  if ( entry->hasNoDataValue )
+    block->setNoDataValue( entry->noDataValue );
+  block->setData( entry->data );
+  for ( std::size_t i = 0; i < entry->noData.size(); ++i )
+  {
+    if ( entry->noData[i] )
+      block->setIsNoData( static_cast< qgssize >( i ) );
+  }
+  return block.release();
+}
+
+void QgsMosaicRasterProvider::BlockCache::insert( const QString &key, const QgsRasterBlock *block )
+{
+  std::unique_ptr< Entry > entry = std::make_unique< Entry >();
+  entry->dataType = block->dataType();
+  entry->width = block->width();
+  entry->height = block->height();
+  entry->hasNoDataValue = block->hasNoDataValue();
+  entry->noDataValue = block->noDataValue();
+  entry->data = block->data();
+  // blocks without a nodata value keep their nodata cells in a bitmap
+  if ( !block->hasNoDataValue() && block->hasNoData() )
+  {
+    const qgssize count = static_cast< qgssize >( block->width() ) * block->height();
+    entry->noData.resize( count );
+    for ( qgssize i = 0; i < count; ++i )
+      entry->noData[i] = block->isNoData( i );
+  }
+
+  const int cost = std::max( 1, static_cast< int >( ( entry->data.size() + entry->noData.size() / 8 ) / 1024 ) );
+  QMutexLocker locker( &mMutex );
+  mEntries.insert( key, entry.release(), cost );
+}
+
+void QgsMosaicRasterProvider::BlockCache::clear()
+{
+  QMutexLocker locker( &mMutex );
+  mEntries.clear();
+}
+
+QgsMosaicRasterProvider::QgsMosaicRasterProvider( const QString &uri, const ProviderOptions &options, QgsDataProvider::ReadFlags flags )
+  : QgsRasterDataProvider( uri, options, flags )
+  , mBlockCache( std::make_shared< BlockCache >() )
+{
+  mOpenSources.setMaxCost( MOSAIC_MAX_OPEN_SOURCES );
+  mValid = initialize( uri );
+}
+
+QgsMosaicRasterProvider::QgsMosaicRasterProvider( const QgsMosaicRasterProvider &other )
+  : QgsRasterDataProvider( other.dataSourceUri(), QgsDataProvider::ProviderOptions() )
+  , mMosaic( other.mMosaic )
+  , mBlockCache( other.mBlockCache )
+  , mValid( other.mValid )
+  , mError( other.mError )
+{
+  setTransformContext( other.transformContext() );
+  mOpenSources.setMaxCost( MOSAIC_MAX_OPEN_SOURCES );
+}
+
+QgsMosaicRasterProvider::~QgsMosaicRasterProvider() = default;
+
+bool QgsMosaicRasterProvider::initialize( const QString &uri )
+{
+  const QVariantMap parts = QgsMosaicRasterProviderMetadata().decodeUri( uri );
+  const QVariantList sources = parts.value( QStringLiteral( "sources" ) ).toList();
+  if ( sources.isEmpty() )
+  {
+    mError = tr( "The mosaic has no sources." );
+    return false;
+  }
+
+  std::shared_ptr< Mosaic > mosaic = std::make_shared< Mosaic >();
+  for ( const QVariant &sourceVariant : sources )
+  {
+    const QVariantMap sourceParts = sourceVariant.toMap();
+    Source source;
+    source.providerKey = sourceParts.value( QStringLiteral( "provider" ) ).toString();
+    source.uri = sourceParts.value( QStringLiteral( "uri" ) ).toString();
+    source.extent = sourceParts.value( QStringLiteral( "extent" ) ).value< QgsRectangle >();
+    mosaic->sources.push_back( source );
+  }
+
+  // strips rendered concurrently each compose their blocks, which is only cheap if no source is remote
+  mosaic->concurrentReading = std::all_of( mosaic->sources.cbegin(), mosaic->sources.cend(), []( const Source & source )
+  {
+    const QString path = QgsProviderRegistry::instance()->decodeUri( source.providerKey, source.uri ).value( QStringLiteral( "path" ) ).toString();
+    return !path.isEmpty() && !QgsGdalUtils::isRemotePath( path );
+  } );
+
+  // the first source defines the bands, and the default CRS and resolution
+  std::unique_ptr< QgsRasterDataProvider > first( createSourceProvider( mosaic->sources.front() ) );
+  if ( !first )
+  {
+    mError = tr( "The first source of the mosaic could not be opened: %1" ).arg( mosaic->sources.front().uri );
+    return false;
+  }
+
+  const QString crs = parts.value( QStringLiteral( "crs" ) ).toString();
+  if ( !crs.isEmpty() )
+    mosaic->crs.createFromUserInput( crs );
+  if ( !mosaic->crs.isValid() )
+    mosaic->crs = first->crs();
+
+  for ( int bandNo = 1; bandNo <= first->bandCount(); ++bandNo )
+  {
+    mosaic->dataTypes << first->dataType( bandNo );
+    mosaic->hasNoDataValue << first->sourceHasNoDataValue( bandNo );
+    mosaic->noDataValue << first->sourceNoDataValue( bandNo );
+  }
+
+  // sources without an explicit footprint are opened once to compute it
+  QgsRectangle fullExtent;
+  for ( std::size_t i = 0; i < mosaic->sources.size(); ++i )
+  {
+    Source &source = mosaic->sources[i];
+    if ( source.extent.isEmpty() )
+    {
+      std::unique_ptr< QgsRasterDataProvider > opened;
+      QgsRasterDataProvider *provider = first.get();
+      if ( i > 0 )
+      {
+        opened.reset( createSourceProvider( source ) );
+        provider = opened.get();
+      }
+      if ( !provider )
+        continue;
+
+      if ( provider->crs() != mosaic->crs )
+      {
+        QgsCoordinateTransform transform( provider->crs(), mosaic->crs, transformContext() );
+        try
+        {
+          source.extent = transform.transformBoundingBox( provider->extent() );
+        }
+        catch ( QgsCsException & )
+        {
+          QgsDebugMsg( QStringLiteral( "Could not transform the extent of mosaic source %1" ).arg( source.uri ) );
+          continue;
+        }
+      }
+      else
+      {
+        source.extent = provider->extent();
+      }
+    }
+
+    if ( source.extent.isEmpty() )
+      continue;
+
+    mosaic->index.addFeature( static_cast< QgsFeatureId >( i ), source.extent );
+    if ( fullExtent.isNull() )
+      fullExtent = source.extent;
+    else
+      fullExtent.combineExtentWith( source.extent );
+  }
+
+  mosaic->extent = parts.value( QStringLiteral( "extent" ) ).value< QgsRectangle >();
+  if ( mosaic->extent.isEmpty() )
+    mosaic->extent = fullExtent;
+  if ( mosaic->extent.isEmpty() )
+  {
+    mError = tr( "The extent of the mosaic could not be determined." );
+    return false;
+  }
+
+  double resolutionX = parts.value( QStringLiteral( "resolutionX" ) ).toDouble();
+  double resolutionY = parts.value( QStringLiteral( "resolutionY" ) ).toDouble();
+  if ( ( resolutionX <= 0 || resolutionY <= 0 ) && first->xSize() > 0 && first->ySize() > 0 )
+  {
+    // the footprint of the first source is already in the mosaic CRS
+    const QgsRectangle &firstExtent = mosaic->sources.front().extent;
+    resolutionX = firstExtent.width() / first->xSize();
+    resolutionY = firstExtent.height() / first->ySize();
+  }
+  if ( resolutionX <= 0 || resolutionY <= 0 )
+  {
+    mError = tr( "The resolution of the mosaic could not be determined." );
+    return false;
+  }
+
+  mosaic->width = std::max( 1, static_cast< int >( std::round( mosaic->extent.width() / resolutionX ) ) );
+  mosaic->height = std::max( 1, static_cast< int >( std::round( mosaic->extent.height() / resolutionY ) ) );
+
+  for ( int i = 0; i < mosaic->dataTypes.size(); ++i )
+  {
+    mSrcNoDataValue << mosaic->noDataValue.at( i );
+    mSrcHasNoDataValue << mosaic->hasNoDataValue.at( i );
+    mUseSrcNoDataValue << mosaic->hasNoDataValue.at( i );
+  }
+
+  mMosaic = mosaic;
+  return true;
+}
+
+QgsRasterDataProvider *QgsMosaicRasterProvider::createSourceProvider( const Source &source ) const
+{
+  QgsDataProvider::ProviderOptions options;
+  options.transformContext = transformContext();
+  std::unique_ptr< QgsDataProvider > provider( QgsProviderRegistry::instance()->createProvider( source.providerKey, source.uri, options ) );
+  QgsRasterDataProvider *rasterProvider = qobject_cast< QgsRasterDataProvider * >( provider.get() );
+  if ( !rasterProvider || !rasterProvider->isValid() )
+  {
+    QgsDebugMsg( QStringLiteral( "Could not open mosaic source %1 with provider %2" ).arg( source.uri, source.providerKey ) );
+    return nullptr;
+  }
+
+  provider.release();
+  return rasterProvider;
+}
+
+QgsRasterInterface *QgsMosaicRasterProvider::sourceInterface( int index )
+{
+  if ( OpenSource *open = mOpenSources.object( index ) )
+    return open->output;
+
+  // sources may be temporarily unavailable, e.g. network shares, so they are tried again later
+  const qint64 now = QDateTime::currentMSecsSinceEpoch();
+  const auto failed = mFailedSources.constFind( index );
+  if ( failed != mFailedSources.constEnd() && now - failed.value() < MOSAIC_SOURCE_RETRY_MS )
+    return nullptr;
+
+  std::unique_ptr< OpenSource > open = std::make_unique< OpenSource >();
+  open->provider.reset( createSourceProvider( mMosaic->sources[ static_cast< std::size_t >( index ) ] ) );
+  if ( !open->provider )
+  {
+    mFailedSources.insert( index, now );
+    return nullptr;
+  }
+  mFailedSources.remove( index );
+  applyResampling( open->provider.get() );
+
+  open->output = open->provider.get();
+  if ( open->provider->crs() != mMosaic->crs )
+  {
+    open->projector = std::make_unique< QgsRasterProjector >();
+    open->projector->setInput( open->provider.get() );
+    open->projector->setCrs( open->provider->crs(), mMosaic->crs, transformContext() );
+    open->output = open->projector.get();
+  }
+
+  QgsRasterInterface *output = open->output;
+  mOpenSources.insert( index, open.release() );
+  return output;
+}
+
+void QgsMosaicRasterProvider::applyResampling( QgsRasterDataProvider *provider ) const
+{
+  if ( !( provider->providerCapabilities() & QgsRasterDataProvider::ProviderHintCanPerformProviderResampling ) )
+    return;
+
+  provider->enableProviderResampling( mProviderResamplingEnabled );
+  provider->setZoomedInResamplingMethod( mZoomedInResamplingMethod );
+  provider->setZoomedOutResamplingMethod( mZoomedOutResamplingMethod );
+  provider->setMaxOversampling( mMaxOversampling );
+}
+
+void QgsMosaicRasterProvider::applyResamplingToOpenSources()
+{
+  const QList< int > indices = mOpenSources.keys();
+  for ( int index : indices )
+    applyResampling( mOpenSources.object( index )->provider.get() );
+}
+
+bool QgsMosaicRasterProvider::enableProviderResampling( bool enable )
+{
+  mProviderResamplingEnabled = enable;
+  applyResamplingToOpenSources();
+  return true;
+}
+
+bool QgsMosaicRasterProvider::setZoomedInResamplingMethod( ResamplingMethod method )
+{
+  mZoomedInResamplingMethod = method;
+  applyResamplingToOpenSources();
+  return true;
+}
+
+bool QgsMosaicRasterProvider::setZoomedOutResamplingMethod( ResamplingMethod method )
+{
+  mZoomedOutResamplingMethod = method;
+  applyResamplingToOpenSources();
+  return true;
+}
+
+bool QgsMosaicRasterProvider::setMaxOversampling( double factor )
+{
+  mMaxOversampling = factor;
+  applyResamplingToOpenSources();
+  return true;
+}
+
+void QgsMosaicRasterProvider::reloadProviderData()
+{
+  // sources are reopened, and blocks composed again, with the current data of the sources
+  mOpenSources.clear();
+  mFailedSources.clear();
+  mBlockCache->clear();
+}
+
+QgsMosaicRasterProvider *QgsMosaicRasterProvider::clone() const
+{
+  QgsMosaicRasterProvider *provider = new QgsMosaicRasterProvider( *this );
+  provider->copyBaseSettings( *this );
+  return provider;
+}
+
+QgsCoordinateReferenceSystem QgsMosaicRasterProvider::crs() const
+{
+  return mMosaic ? mMosaic->crs : QgsCoordinateReferenceSystem();
+}
+
+QgsRectangle QgsMosaicRasterProvider::extent() const
+{
+  return mMosaic ? mMosaic->extent : QgsRectangle();
+}
+
+bool QgsMosaicRasterProvider::isValid() const
+{
+  return mValid;
+}
+
+QString QgsMosaicRasterProvider::name() const
+{
+  return PROVIDER_KEY;
+}
+
+QString QgsMosaicRasterProvider::description() const
+{
+  return PROVIDER_DESCRIPTION;
+}
+
+QgsRasterDataProvider::ProviderCapabilities QgsMosaicRasterProvider::providerCapabilities() const
+{
+  QgsRasterDataProvider::ProviderCapabilities capabilities = QgsRasterDataProvider::ProviderHintBenefitsFromResampling |
+      QgsRasterDataProvider::ProviderHintCanPerformProviderResampling |
+      QgsRasterDataProvider::ReloadData;
+  if ( mMosaic && mMosaic->concurrentReading )
+    capabilities |= QgsRasterDataProvider::ProviderHintConcurrentReading;
+  return capabilities;
+}
+
+int QgsMosaicRasterProvider::capabilities() const
+{
+  return QgsRasterDataProvider::Size | QgsRasterDataProvider::IdentifyValue;
+}
+
+Qgis::DataType QgsMosaicRasterProvider::dataType( int bandNo ) const
+{
+  if ( !mMosaic || bandNo < 1 || bandNo > mMosaic->dataTypes.size() )
+    return Qgis::DataType::UnknownDataType;
+
+  return mMosaic->dataTypes.at( bandNo - 1 );
+}
+
+Qgis::DataType QgsMosaicRasterProvider::sourceDataType( int bandNo ) const
+{
+  return dataType( bandNo );
+}
+
+int QgsMosaicRasterProvider::bandCount() const
+{
+  return mMosaic ? mMosaic->dataTypes.size() : 0;
+}
+
+int QgsMosaicRasterProvider::xSize() const
+{
+  return mMosaic ? mMosaic->width : 0;
+}
+
+int QgsMosaicRasterProvider::ySize() const
+{
+  return mMosaic ? mMosaic->height : 0;
+}
+
+QString QgsMosaicRasterProvider::htmlMetadata()
+{
+  if ( !mMosaic )
+    return QString();
+
+  return QStringLiteral( "<tr><td class=\"highlight\">" ) + tr( "Sources" ) + QStringLiteral( "</td><td>%1</td></tr>\n" ).arg( mMosaic->sources.size() );
+}
+
+QString QgsMosaicRasterProvider::lastErrorTitle()
+{
+  return tr( "Mosaic provider error" );
+}
+
+QString QgsMosaicRasterProvider::lastError()
+{
+  return mError;
+}
+
+QgsRasterBlock *QgsMosaicRasterProvider::block( int bandNo, const QgsRectangle &extent, int width, int height, QgsRasterBlockFeedback *feedback )
+{
+  std::unique_ptr< QgsRasterBlock > block = std::make_unique< QgsRasterBlock >( dataType( bandNo ), width, height );
+  if ( sourceHasNoDataValue( bandNo ) && useSourceNoDataValue( bandNo ) )
+    block->setNoDataValue( sourceNoDataValue( bandNo ) );
+
+  if ( !mValid || block->isEmpty() || extent.isEmpty() )
+  {
+    QgsDebugMsg( QStringLiteral( "Couldn't create raster block" ) );
+    block->setError( { tr( "Couldn't create raster block." ), QStringLiteral( "Raster" ) } );
+    block->setValid( false );
+    return block.release();
+  }
+
+  const QString key = QStringLiteral( "%1|%2|%3|%4|%5|%6:%7:%8:%9" ).arg( bandNo ).arg( extent.toString( 17 ) ).arg( width ).arg( height ).arg( block->hasNoDataValue() )
+                      .arg( mProviderResamplingEnabled ).arg( static_cast< int >( mZoomedInResamplingMethod ) ).arg( static_cast< int >( mZoomedOutResamplingMethod ) )
+                      .arg( qgsDoubleToString( mMaxOversampling ) );
+  if ( QgsRasterBlock *cached = mBlockCache->block( key ) )
+  {
+    cached->applyNoDataValues( userNoDataValues( bandNo ) );
+    return cached;
+  }
+
+  block->setIsNoData();
+
+  const double xRes = extent.width() / width;
+  const double yRes = extent.height() / height;
+  const int pixelSize = QgsRasterBlock::typeSize( block->dataType() );
+  qgssize remaining = static_cast< qgssize >( width ) * height;
+
+  // a block missing the cells of a failed source must not be served from the cache once it is back
+  bool complete = true;
+
+  // later sources are drawn on top, so they are read first
+  QList< QgsFeatureId > ids = mMosaic->index.intersects( extent );
+  std::sort( ids.begin(), ids.end(), std::greater< QgsFeatureId >() );
+  for ( QgsFeatureId id : std::as_const( ids ) )
+  {
+    if ( remaining == 0 || ( feedback && feedback->isCanceled() ) )
+      break;
+
+    const int index = static_cast< int >( id );
+    const QgsRectangle footprint = mMosaic->sources[ static_cast< std::size_t >( index ) ].extent.intersect( extent );
+    if ( footprint.isEmpty() )
+      continue;
+
+    // only the cells of the request covered by the source footprint are read
+    const int left = static_cast< int >( std::clamp( std::floor( ( footprint.xMinimum() - extent.xMinimum() ) / xRes ), 0.0, width - 1.0 ) );
+    const int right = static_cast< int >( std::clamp( std::ceil( ( footprint.xMaximum() - extent.xMinimum() ) / xRes ) - 1, static_cast< double >( left ), width - 1.0 ) );
+    const int top = static_cast< int >( std::clamp( std::floor( ( extent.yMaximum() - footprint.yMaximum() ) / yRes ), 0.0, height - 1.0 ) );
+    const int bottom = static_cast< int >( std::clamp( std::ceil( ( extent.yMaximum() - footprint.yMinimum() ) / yRes ) - 1, static_cast< double >( top ), height - 1.0 ) );
+
+    QgsRasterInterface *input = sourceInterface( index );
+    if ( !input )
+    {
+      complete = false;
+      continue;
+    }
+    if ( bandNo > input->bandCount() )
+      continue;
+
+    const int partWidth = right - left + 1;
+    const int partHeight = bottom - top + 1;
+    const QgsRectangle partExtent( extent.xMinimum() + left * xRes, extent.yMaximum() - ( bottom + 1 ) * yRes,
+                                   extent.xMinimum() + ( right + 1 ) * xRes, extent.yMaximum() - top * yRes );
+    std::unique_ptr< QgsRasterBlock > part( input->block( bandNo, partExtent, partWidth, partHeight, feedback ) );
+    if ( !part || !part->isValid() || part->isEmpty() )
+    {
+      complete = false;
+      continue;
+    }
+
+    const bool sameType = part->dataType() == block->dataType();
+    for ( int row = 0; row < partHeight; ++row )
+    {
+      for ( int col = 0; col < partWidth; ++col )
+      {
+        const qgssize partIndex = static_cast< qgssize >( row ) * partWidth + col;
+        const qgssize blockIndex = static_cast< qgssize >( top + row ) * width + left + col;
+        if ( !block->isNoData( blockIndex ) || part->isNoData( partIndex ) )
+          continue;
+
+        if ( sameType )
+          std::memcpy( block->bits( blockIndex ), part->bits( partIndex ), pixelSize );
+        else
+          block->setValue( blockIndex, part->value( partIndex ) );
+        block->setIsData( blockIndex );
+        --remaining;
+      }
+    }
+  }
+
+  if ( complete && ( !feedback || !feedback->isCanceled() ) )
+    mBlockCache->insert( key, block.get() );
+
+  block->applyNoDataValues( userNoDataValues( bandNo ) );
+  return block.release();
+}
+
+QString QgsMosaicRasterProvider::providerKey()
+{
+  return PROVIDER_KEY;
+}
+
+QString QgsMosaicRasterProvider::providerDescription()
+{
+  return PROVIDER_DESCRIPTION;
+}
+
+QgsMosaicRasterProviderMetadata::QgsMosaicRasterProviderMetadata()
+  : QgsProviderMetadata( PROVIDER_KEY, PROVIDER_DESCRIPTION )
+{
+}
+
+QgsMosaicRasterProvider *QgsMosaicRasterProviderMetadata::createProvider( const QString &uri, const QgsDataProvider::ProviderOptions &options, QgsDataProvider::ReadFlags flags )
+{
+  return new QgsMosaicRasterProvider( uri, options, flags );
+}
+
+QVariantMap QgsMosaicRasterProviderMetadata::decodeUri( const QString &uri ) const
+{
+  QVariantMap parts;
+  QVariantList sources;
+  const QList< QPair< QString, QString > > items = decodeQuery( uri );
+  for ( const QPair< QString, QString > &item : items )
+  {
+    if ( item.first == QLatin1String( "source" ) )
+    {
+      QVariantMap source;
+      const QList< QPair< QString, QString > > sourceItems = decodeQuery( item.second );
+      for ( const QPair< QString, QString > &sourceItem : sourceItems )
+      {
+        if ( sourceItem.first == QLatin1String( "extent" ) )
+          source.insert( sourceItem.first, QVariant::fromValue( rectangleFromString( sourceItem.second ) ) );
+        else
+          source.insert( sourceItem.first, sourceItem.second );
+      }
+      sources << source;
+    }
+    else if ( item.first == QLatin1String( "crs" ) )
+    {
+      parts.insert( QStringLiteral( "crs" ), item.second );
+    }
+    else if ( item.first == QLatin1String( "extent" ) )
+    {
+      parts.insert( QStringLiteral( "extent" ), QVariant::fromValue( rectangleFromString( item.second ) ) );
+    }
+    else if ( item.first == QLatin1String( "resolution" ) )
+    {
+      const QStringList values = item.second.split( ',' );
+      if ( values.size() == 2 )
+      {
+        parts.insert( QStringLiteral( "resolutionX" ), values.at( 0 ).toDouble() );
+        parts.insert( QStringLiteral( "resolutionY" ), values.at( 1 ).toDouble() );
+      }
+    }
+  }
+  parts.insert( QStringLiteral( "sources" ), sources );
+  return parts;
+}
+
+QString QgsMosaicRasterProviderMetadata::encodeUri( const QVariantMap &parts ) const
+{
+  QList< QPair< QString, QString > > items;
+  const QVariantList sources = parts.value( QStringLiteral( "sources" ) ).toList();
+  for ( const QVariant &sourceVariant : sources )
+  {
+    const QVariantMap source = sourceVariant.toMap();
+    QList< QPair< QString, QString > > sourceItems;
+    sourceItems << qMakePair( QStringLiteral( "provider" ), source.value( QStringLiteral( "provider" ) ).toString() );
+    sourceItems << qMakePair( QStringLiteral( "uri" ), source.value( QStringLiteral( "uri" ) ).toString() );
+    const QgsRectangle extent = source.value( QStringLiteral( "extent" ) ).value< QgsRectangle >();
+    if ( !extent.isEmpty() )
+      sourceItems << qMakePair( QStringLiteral( "extent" ), rectangleToString( extent ) );
+    items << qMakePair( QStringLiteral( "source" ), encodeQuery( sourceItems ) );
+  }
+
+  const QString crs = parts.value( QStringLiteral( "crs" ) ).toString();
+  if ( !crs.isEmpty() )
+    items << qMakePair( QStringLiteral( "crs" ), crs );
+
+  const QgsRectangle extent = parts.value( QStringLiteral( "extent" ) ).value< QgsRectangle >();
+  if ( !extent.isEmpty() )
+    items << qMakePair( QStringLiteral( "extent" ), rectangleToString( extent ) );
+
+  const double resolutionX = parts.value( QStringLiteral( "resolutionX" ) ).toDouble();
+  const double resolutionY = parts.value( QStringLiteral( "resolutionY" ) ).toDouble();
+  if ( resolutionX > 0 && resolutionY > 0 )
+    items << qMakePair( QStringLiteral( "resolution" ), QStringLiteral( "%1,%2" ).arg( qgsDoubleToString( resolutionX ), qgsDoubleToString( resolutionY ) ) );
+
+  return encodeQuery( items );
+}
+
+///@endcond
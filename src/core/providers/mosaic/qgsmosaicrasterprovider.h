@@ -0,0 +1,191 @@
+/***************************************************************************
+    qgsmosaicrasterprovider.h  -  Virtual raster mosaic data provider
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSMOSAICRASTERPROVIDER_H
+#define QGSMOSAICRASTERPROVIDER_H
+
+#include "qgis_core.h"
+#include "qgsrasterdataprovider.h"
+#include "qgsprovidermetadata.h"
+#include "qgsspatialindex.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QHash>
+
+#include <memory>
+
+#include "qgis_sip.h"
+
+///@cond PRIVATE
+#define SIP_NO_FILE
+
+class QgsRasterProjector;
+
+/**
+ * \brief A virtual raster which mosaics a list of raster sources on a common pixel grid.
+ *
+ * Nothing is materialized: every requested block is composed from the sources overlapping
+ * it, which are resampled and reprojected on the fly. Later sources are drawn on top of
+ * earlier ones, and only fill the pixels left as nodata by the sources above them.
+ *
+ * Source footprints are held in a spatial index, so that only the sources overlapping a
+ * request are touched. Sources are opened on first use, and at most a fixed number of them
+ * is kept open by each provider instance. Sources which cannot be opened are retried after
+ * a delay, or when the provider data is reloaded. Composed blocks are cached and shared by
+ * all clones of a provider, e.g. the copies used by concurrent map render jobs. Blocks missing
+ * the data of a source which failed are not cached.
+ *
+ * The provider resampling settings are applied to every source provider which supports
+ * provider resampling, so each source is resampled from its own pixel grid. Sources whose
+ * CRS differs from the mosaic CRS are reprojected with nearest neighbour resampling.
+ *
+ * The URI is a query string as returned by QgsMosaicRasterProviderMetadata::encodeUri(),
+ * with the keys:
+ *
+ * - "source": repeated for each source, the percent encoded query string of its "provider"
+ *   and "uri", and optionally its "extent" in the mosaic CRS, which avoids opening the source
+ *   when the mosaic is loaded
+ * - "crs": the mosaic CRS, by default the CRS of the first source
+ * - "extent": the mosaic extent, by default the union of the source footprints
+ * - "resolution": the pixel width and height, by default those of the first source
+ *
+ * The band count, data types and nodata values are those of the first source.
+ */
+class QgsMosaicRasterProvider : public QgsRasterDataProvider
+{
+    Q_OBJECT
+
+  public:
+
+    //! Description of one source of the mosaic
+    struct Source
+    {
+      QString providerKey;
+      QString uri;
+      //! Footprint in the mosaic CRS
+      QgsRectangle extent;
+    };
+
+    QgsMosaicRasterProvider( const QString &uri, const QgsDataProvider::ProviderOptions &providerOptions, QgsDataProvider::ReadFlags flags = QgsDataProvider::ReadFlags() );
+    ~QgsMosaicRasterProvider() override;
+
+    QgsMosaicRasterProvider *clone() const override;
+    QgsCoordinateReferenceSystem crs() const override;
+    QgsRectangle extent() const override;
+    bool isValid() const override;
+    QString name() const override;
+    QString description() const override;
+    QgsRasterDataProvider::ProviderCapabilities providerCapabilities() const override;
+    int capabilities() const override;
+    Qgis::DataType dataType( int bandNo ) const override;
+    Qgis::DataType sourceDataType( int bandNo ) const override;
+    int bandCount() const override;
+    int xSize() const override;
+    int ySize() const override;
+    QString htmlMetadata() override;
+    QString lastErrorTitle() override;
+    QString lastError() override;
+    QgsRasterBlock *block( int bandNo, const QgsRectangle &extent, int width, int height, QgsRasterBlockFeedback *feedback = nullptr ) override;
+    bool enableProviderResampling( bool enable ) override;
+    bool setZoomedInResamplingMethod( ResamplingMethod method ) override;
+    bool setZoomedOutResamplingMethod( ResamplingMethod method ) override;
+    bool setMaxOversampling( double factor ) override;
+
+    static QString providerKey();
+    static QString providerDescription();
+
+  private:
+
+    //! Settings of the mosaic, shared by all clones
+    struct Mosaic
+    {
+      std::vector< Source > sources;
+      QgsSpatialIndex index;
+      QgsCoordinateReferenceSystem crs;
+      QgsRectangle extent;
+      int width = 0;
+      int height = 0;
+      QList< Qgis::DataType > dataTypes;
+      QList< bool > hasNoDataValue;
+      QList< double > noDataValue;
+      //! TRUE if all the sources are local, so blocks are cheap to compose concurrently
+      bool concurrentReading = false;
+    };
+
+    //! Composed blocks, shared by all clones
+    class BlockCache
+    {
+      public:
+        BlockCache();
+        QgsRasterBlock *block( const QString &key ) const;
+        void insert( const QString &key, const QgsRasterBlock *block );
+        void clear();
+
+      private:
+        struct Entry
+        {
+          Qgis::DataType dataType = Qgis::DataType::UnknownDataType;
+          int width = 0;
+          int height = 0;
+          bool hasNoDataValue = false;
+          double noDataValue = 0;
+          QByteArray data;
+          std::vector< bool > noData;
+        };
+        mutable QMutex mMutex;
+        QCache< QString, Entry > mEntries;
+    };
+
+    //! A source opened by this provider instance
+    struct OpenSource
+    {
+      std::unique_ptr< QgsRasterDataProvider > provider;
+      std::unique_ptr< QgsRasterProjector > projector;
+      QgsRasterInterface *output = nullptr;
+    };
+
+    QgsMosaicRasterProvider( const QgsMosaicRasterProvider &other );
+
+    bool initialize( const QString &uri );
+    QgsRasterDataProvider *createSourceProvider( const Source &source ) const;
+    //! Returns the source \a index in the mosaic CRS, opening it if needed
+    QgsRasterInterface *sourceInterface( int index );
+    //! Applies the provider resampling settings to the source \a provider
+    void applyResampling( QgsRasterDataProvider *provider ) const;
+    void applyResamplingToOpenSources();
+    void reloadProviderData() override;
+
+    std::shared_ptr< const Mosaic > mMosaic;
+    std::shared_ptr< BlockCache > mBlockCache;
+    QCache< int, OpenSource > mOpenSources;
+    //! Sources which could not be opened, with the time of the last attempt in ms since epoch
+    QHash< int, qint64 > mFailedSources;
+    bool mValid = false;
+    QString mError;
+};
+
+class QgsMosaicRasterProviderMetadata : public QgsProviderMetadata
+{
+  public:
+    QgsMosaicRasterProviderMetadata();
+    QgsMosaicRasterProvider *createProvider( const QString &uri, const QgsDataProvider::ProviderOptions &options, QgsDataProvider::ReadFlags flags = QgsDataProvider::ReadFlags() ) override;
+    QVariantMap decodeUri( const QString &uri ) const override;
+    QString encodeUri( const QVariantMap &parts ) const override;
+};
+
+///@endcond
+#endif // QGSMOSAICRASTERPROVIDER_H
@@ -171,6 +171,8 @@ QgsOgrFeatureIterator::QgsOgrFeatureIterator( QgsOgrFeatureSource *source, bool
     mFetchGeometry = true;
   }
 
+  prepareAttributesToFetch( attrs );
+
   // make sure we fetch just relevant fields
   // unless it's a VRT data source filtered by geometry as we don't know which
   // attributes make up the geometry and OGR won't fetch them to evaluate the
@@ -486,21 +488,27 @@ bool QgsOgrFeatureIterator::close()
 }
 
 
-void QgsOgrFeatureIterator::getFeatureAttribute( OGRFeatureH ogrFet, QgsFeature &f, int attindex ) const
+void QgsOgrFeatureIterator::prepareAttributesToFetch( const QgsAttributeList &attributes )
 {
-  if ( mFirstFieldIsFid && attindex == 0 )
+  mAttributesToFetch.clear();
+  mAttributesToFetch.reserve( attributes.size() );
+  for ( int attindex : attributes )
   {
-    f.setAttribute( 0, static_cast<qint64>( OGR_F_GetFID( ogrFet ) ) );
-    return;
-  }
+    AttributeToFetch attribute;
+    attribute.index = attindex;
+    if ( mFirstFieldIsFid && attindex == 0 )
+    {
+      mAttributesToFetch.append( attribute );
+      continue;
+    }
 
-  int attindexWithoutFid = ( mFirstFieldIsFid ) ? attindex - 1 : attindex;
-  bool ok = false;
-  QVariant value = QgsOgrUtils::getOgrFeatureAttribute( ogrFet, mFieldsWithoutFid, attindexWithoutFid, mSource->mEncoding, &ok );
-  if ( !ok )
-    return;
+    attribute.ogrIndex = ( mFirstFieldIsFid ) ? attindex - 1 : attindex;
+    if ( attribute.ogrIndex < 0 || attribute.ogrIndex >= mFieldsWithoutFid.count() )
+      continue;
 
-  f.setAttribute( attindex, value );
+    attribute.field = mFieldsWithoutFid.at( attribute.ogrIndex );
+    mAttributesToFetch.append( attribute );
+  }
 }
 
 bool QgsOgrFeatureIterator::readFeature( const gdal::ogr_feature_unique_ptr &fet, QgsFeature &feature ) const
@@ -552,22 +560,18 @@ bool QgsOgrFeatureIterator::readFeature( const gdal::ogr_feature_unique_ptr &fet
   }
 
   // fetch attributes
-  if ( mRequest.flags() & QgsFeatureRequest::SubsetOfAttributes )
+  for ( const AttributeToFetch &attribute : mAttributesToFetch )
   {
-    QgsAttributeList attrs = mRequest.subsetOfAttributes();
-    for ( QgsAttributeList::const_iterator it = attrs.constBegin(); it != attrs.constEnd(); ++it )
+    if ( attribute.ogrIndex < 0 )
     {
-      getFeatureAttribute( fet.get(), feature, *it );
-    }
-  }
-  else
-  {
-    // all attributes
-    const auto fieldCount = mSource->mFields.count();
-    for ( int idx = 0; idx < fieldCount; ++idx )
-    {
-      getFeatureAttribute( fet.get(), feature, idx );
+      feature.setAttribute( attribute.index, static_cast<qint64>( OGR_F_GetFID( fet.get() ) ) );
+      continue;
     }
+
+    bool ok = false;
+    const QVariant value = QgsOgrUtils::getOgrFeatureAttribute( fet.get(), attribute.field, attribute.ogrIndex, mSource->mEncoding, &ok );
+    if ( ok )
+      feature.setAttribute( attribute.index, value );
   }
 
   if ( mRequest.flags() & QgsFeatureRequest::EmbeddedSymbols )
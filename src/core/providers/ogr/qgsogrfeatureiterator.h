@@ -84,8 +84,22 @@ class QgsOgrFeatureIterator final: public QgsAbstractFeatureIteratorFromSource<Q
 
     bool readFeature( const gdal::ogr_feature_unique_ptr &fet, QgsFeature &feature ) const;
 
-    //! Gets an attribute associated with a feature
-    void getFeatureAttribute( OGRFeatureH ogrFet, QgsFeature &f, int attindex ) const;
+    //! An attribute to read from each OGR feature
+    struct AttributeToFetch
+    {
+      //! Index of the attribute in the provider fields
+      int index = -1;
+      //! Index of the matching OGR field, or -1 if the attribute is the FID
+      int ogrIndex = -1;
+      //! Provider field, which determines how the OGR value is converted
+      QgsField field;
+    };
+
+    //! Resolves the attributes in \a attributes to OGR fields, once for the whole iteration
+    void prepareAttributesToFetch( const QgsAttributeList &attributes );
+
+    //! Attributes read for each feature, with their OGR field indexes
+    QVector< AttributeToFetch > mAttributesToFetch;
 
     QgsOgrConn *mConn = nullptr;
     OGRLayerH mOgrLayer = nullptr; // when mOgrLayerUnfiltered != null and mOgrLayer != mOgrLayerUnfiltered, this is a SQL layer
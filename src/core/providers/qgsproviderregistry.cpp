@@ -36,6 +36,7 @@
 #include "providers/gdal/qgsgdalprovider.h"
 #include "providers/ogr/qgsogrprovider.h"
 #include "providers/meshmemory/qgsmeshmemorydataprovider.h"
+#include "providers/mosaic/qgsmosaicrasterprovider.h"
 
 #ifdef HAVE_EPT
 #include "providers/ept/qgseptprovider.h"
@@ -175,6 +176,11 @@ void QgsProviderRegistry::init()
     QgsProviderMetadata *vt = new QgsVectorTileProviderMetadata();
     mProviders[ vt->key() ] = vt;
   }
+  {
+    QgsScopedRuntimeProfile profile( QObject::tr( "Create mosaic raster provider" ) );
+    QgsProviderMetadata *mosaic = new QgsMosaicRasterProviderMetadata();
+    mProviders[ mosaic->key() ] = mosaic;
+  }
 #ifdef HAVE_EPT
   {
     QgsScopedRuntimeProfile profile( QObject::tr( "Create EPT point cloud provider" ) );
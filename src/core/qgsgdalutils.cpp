@@ -25,6 +25,7 @@
 
 #include <QNetworkProxy>
 #include <QString>
+#include <QStringList>
 #include <QImage>
 
 bool QgsGdalUtils::supportsRasterCreate( GDALDriverH driver )
@@ -466,6 +467,38 @@ void *QgsGdalUtils::rpcAwareCreateTransformer( GDALDatasetH hSrcDS, GDALDatasetH
   return transformer;
 }
 
+bool QgsGdalUtils::isRemotePath( const QString &path )
+{
+  static const QStringList sRemotePrefixes
+  {
+    QStringLiteral( "/vsicurl/" ),
+    QStringLiteral( "/vsicurl_streaming/" ),
+    QStringLiteral( "/vsis3/" ),
+    QStringLiteral( "/vsis3_streaming/" ),
+    QStringLiteral( "/vsigs/" ),
+    QStringLiteral( "/vsigs_streaming/" ),
+    QStringLiteral( "/vsiaz/" ),
+    QStringLiteral( "/vsiaz_streaming/" ),
+    QStringLiteral( "/vsiadls/" ),
+    QStringLiteral( "/vsioss/" ),
+    QStringLiteral( "/vsioss_streaming/" ),
+    QStringLiteral( "/vsiswift/" ),
+    QStringLiteral( "/vsiswift_streaming/" ),
+    QStringLiteral( "/vsiwebhdfs/" ),
+    QStringLiteral( "http://" ),
+    QStringLiteral( "https://" ),
+    QStringLiteral( "ftp://" ),
+  };
+
+  // remote files may also be nested inside archives, e.g. /vsizip//vsicurl/...
+  for ( const QString &prefix : sRemotePrefixes )
+  {
+    if ( path.contains( prefix, Qt::CaseInsensitive ) )
+      return true;
+  }
+  return false;
+}
+
 #ifndef QT_NO_NETWORKPROXY
 void QgsGdalUtils::setupProxy()
 {
@@ -127,6 +127,18 @@ class CORE_EXPORT QgsGdalUtils
      */
     static void *rpcAwareCreateTransformer( GDALDatasetH hSrcDS, GDALDatasetH hDstDS = nullptr, char **papszOptions = nullptr );
 
+    /**
+     * Returns TRUE if \a path refers to a dataset accessed over the network, either
+     * through one of GDAL's network virtual file systems (/vsicurl/, /vsis3/, ...)
+     * or as a plain http(s)/ftp URL.
+     *
+     * Reads from such datasets benefit from hinting GDAL about the blocks which
+     * are about to be read, so that requests can be coalesced.
+     *
+     * \since QGIS 3.20
+     */
+    static bool isRemotePath( const QString &path );
+
 #ifndef QT_NO_NETWORKPROXY
     //! Sets the gdal proxy variables
     static void setupProxy();
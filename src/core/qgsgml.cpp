@@ -1315,75 +1315,129 @@ bool QgsGmlStreamingParser::createBBoxFromCoordinateString( QgsRectangle &r, con
   return true;
 }
 
-int QgsGmlStreamingParser::pointsFromCoordinateString( QList<QgsPointXY> &points, const QString &coordString ) const
-{
-  //tuples are separated by space, x/y by ','
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-  QStringList tuples = coordString.split( mTupleSeparator, QString::SkipEmptyParts );
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 2)
+typedef QStringRef GmlStringView;
 #else
-  QStringList tuples = coordString.split( mTupleSeparator, Qt::SkipEmptyParts );
+typedef QStringView GmlStringView;
 #endif
-  QStringList tuples_coordinates;
-  double x, y;
-  bool conversionSuccess;
 
-  QStringList::const_iterator tupleIterator;
-  for ( tupleIterator = tuples.constBegin(); tupleIterator != tuples.constEnd(); ++tupleIterator )
-  {
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-    tuples_coordinates = tupleIterator->split( mCoordinateSeparator, QString::SkipEmptyParts );
+/**
+ * Calls \a func with a view of each non-empty part of \a string delimited by \a separator.
+ * Unlike QString::split() this does not allocate, which matters as coordinate strings
+ * are by far the largest part of typical GML documents.
+ */
+template <typename Func>
+static void forEachToken( const QString &string, const QString &separator, Func &&func )
+{
+#if QT_VERSION < QT_VERSION_CHECK(5, 15, 2)
+  const GmlStringView view( &string );
 #else
-    tuples_coordinates = tupleIterator->split( mCoordinateSeparator, Qt::SkipEmptyParts );
+  const GmlStringView view( string );
 #endif
-    if ( tuples_coordinates.size() < 2 )
+  const int sepLength = separator.length();
+  if ( sepLength == 0 )
+  {
+    if ( !view.isEmpty() )
+      func( view );
+    return;
+  }
+
+  int start = 0;
+  while ( start <= view.size() )
+  {
+    int end = string.indexOf( separator, start );
+    if ( end < 0 )
+      end = view.size();
+    if ( end > start )
+      func( view.mid( start, end - start ) );
+    start = end + sepLength;
+  }
+}
+
+int QgsGmlStreamingParser::pointsFromCoordinateString( QList<QgsPointXY> &points, const QString &coordString ) const
+{
+  //tuples are separated by space, x/y by ','
+  forEachToken( coordString, mTupleSeparator, [this, &points]( GmlStringView tuple )
+  {
+    // only the first two coordinates of the tuple are used
+    GmlStringView coordinates[2];
+    int coordinateCount = 0;
+    const int sepLength = mCoordinateSeparator.length();
+    int start = 0;
+    while ( coordinateCount < 2 && start <= tuple.size() )
     {
-      continue;
+      int end = sepLength > 0 ? tuple.indexOf( mCoordinateSeparator, start ) : -1;
+      if ( end < 0 )
+        end = tuple.size();
+      if ( end > start )
+        coordinates[coordinateCount++] = tuple.mid( start, end - start );
+      if ( sepLength == 0 )
+        break;
+      start = end + sepLength;
     }
-    x = tuples_coordinates.at( 0 ).toDouble( &conversionSuccess );
+    if ( coordinateCount < 2 )
+    {
+      return;
+    }
+
+    bool conversionSuccess;
+    const double x = coordinates[0].toDouble( &conversionSuccess );
     if ( !conversionSuccess )
     {
-      continue;
+      return;
     }
-    y = tuples_coordinates.at( 1 ).toDouble( &conversionSuccess );
+    const double y = coordinates[1].toDouble( &conversionSuccess );
     if ( !conversionSuccess )
     {
-      continue;
+      return;
     }
     points.push_back( ( mInvertAxisOrientation ) ? QgsPointXY( y, x ) : QgsPointXY( x, y ) );
-  }
+  } );
   return 0;
 }
 
 int QgsGmlStreamingParser::pointsFromPosListString( QList<QgsPointXY> &points, const QString &coordString, int dimension ) const
 {
   // coordinates separated by spaces
-#if QT_VERSION < QT_VERSION_CHECK(5, 15, 0)
-  QStringList coordinates = coordString.split( ' ', QString::SkipEmptyParts );
-#else
-  QStringList coordinates = coordString.split( ' ', Qt::SkipEmptyParts );
-#endif
+  int coordinateCount = 0;
+  forEachToken( coordString, QStringLiteral( " " ), [&coordinateCount]( GmlStringView )
+  {
+    coordinateCount++;
+  } );
 
-  if ( coordinates.size() % dimension != 0 )
+  if ( coordinateCount % dimension != 0 )
   {
     QgsDebugMsg( QStringLiteral( "Wrong number of coordinates" ) );
   }
 
-  int ncoor = coordinates.size() / dimension;
-  for ( int i = 0; i < ncoor; i++ )
+  const int ncoor = coordinateCount / dimension;
+  points.reserve( points.size() + ncoor );
+
+  // only the first two ordinates of each position are used, and a position
+  // is skipped altogether if any of them cannot be parsed
+  int index = 0;
+  double x = 0;
+  bool xOk = false;
+  forEachToken( coordString, QStringLiteral( " " ), [&]( GmlStringView coordinate )
   {
+    const int position = index / dimension;
+    const int ordinate = index % dimension;
+    index++;
+    if ( position >= ncoor || ordinate > 1 )
+      return;
+
     bool conversionSuccess;
-    double x = coordinates.value( i * dimension ).toDouble( &conversionSuccess );
-    if ( !conversionSuccess )
+    const double value = coordinate.toDouble( &conversionSuccess );
+    if ( ordinate == 0 )
     {
-      continue;
+      x = value;
+      xOk = conversionSuccess;
     }
-    double y = coordinates.value( i * dimension + 1 ).toDouble( &conversionSuccess );
-    if ( !conversionSuccess )
+    else if ( xOk && conversionSuccess )
     {
-      continue;
+      points.append( ( mInvertAxisOrientation ) ? QgsPointXY( value, x ) : QgsPointXY( x, value ) );
     }
-    points.append( ( mInvertAxisOrientation ) ? QgsPointXY( y, x ) : QgsPointXY( x, y ) );
-  }
+  } );
   return 0;
 }
 
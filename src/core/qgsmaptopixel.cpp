@@ -23,6 +23,9 @@
 
 #include "qgslogger.h"
 #include "qgspointxy.h"
+#include "qgscoordinatekernels_p.h"
+
+#include <type_traits>
 
 
 QgsMapToPixel::QgsMapToPixel( double mapUnitsPerPixel,
@@ -178,6 +181,20 @@ QString QgsMapToPixel::showParameters() const
   return rep;
 }
 
+void QgsMapToPixel::transformInPlace( QPolygonF &polygon ) const
+{
+  // QPointF is a pair of doubles, unless Qt was built with qreal as float
+  if ( std::is_same< qreal, double >::value && mMatrix.type() != QTransform::TxProject )
+  {
+    QgsCoordinateKernels::affineTransformInterleaved( mMatrix, reinterpret_cast< double * >( polygon.data() ), polygon.size() );
+    return;
+  }
+
+  QPointF *ptr = polygon.data();
+  for ( int i = 0; i < polygon.size(); ++i, ++ptr )
+    transformInPlace( ptr->rx(), ptr->ry() );
+}
+
 QTransform QgsMapToPixel::transform() const
 {
   // NOTE: operations are done in the reverse order in which
@@ -19,6 +19,7 @@
 
 #include "qgis_core.h"
 #include "qgis_sip.h"
+#include <QPolygonF>
 #include <QTransform>
 #include <vector>
 #include "qgsunittypes.h"
@@ -153,6 +154,14 @@ class CORE_EXPORT QgsMapToPixel
       for ( int i = 0; i < x.size(); ++i )
         transformInPlace( x[i], y[i] );
     }
+
+    /**
+     * Transforms all points of \a polygon from map (world) coordinates to device coordinates in place.
+     * This is considerably faster than transforming the points one by one.
+     * \note not available in Python bindings
+     * \since QGIS 3.20
+     */
+    void transformInPlace( QPolygonF &polygon ) const SIP_SKIP;
 #endif
 
     //! Transform device coordinates to map (world) coordinates
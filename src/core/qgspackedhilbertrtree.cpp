@@ -0,0 +1,483 @@
+/***************************************************************************
+    qgspackedhilbertrtree.cpp  -  Static bulk loaded Hilbert R-tree
+    -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgspackedhilbertrtree_p.h"
+#include "qgslogger.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <queue>
+
+///@cond PRIVATE
+
+// Maps a position on a 2^16 x 2^16 grid to its distance along the Hilbert curve
+// (see "Fast Hilbert curve generation, sorting, and range queries" by rawrunprotected)
+static quint32 hilbertValue( quint32 x, quint32 y )
+{
+  quint32 a = x ^ y;
+  quint32 b = 0xFFFF ^ a;
+  quint32 c = 0xFFFF ^ ( x | y );
+  quint32 d = x & ( y ^ 0xFFFF );
+
+  quint32 A = a | ( b >> 1 );
+  quint32 B = ( a >> 1 ) ^ a;
+  quint32 C = ( ( c >> 1 ) ^ ( b & ( d >> 1 ) ) ) ^ c;
+  quint32 D = ( ( a & ( c >> 1 ) ) ^ ( d >> 1 ) ) ^ d;
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ( ( a & ( a >> 2 ) ) ^ ( b & ( b >> 2 ) ) );
+  B = ( ( a & ( b >> 2 ) ) ^ ( b & ( ( a ^ b ) >> 2 ) ) );
+  C ^= ( ( a & ( c >> 2 ) ) ^ ( b & ( d >> 2 ) ) );
+  D ^= ( ( b & ( c >> 2 ) ) ^ ( ( a ^ b ) & ( d >> 2 ) ) );
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  A = ( ( a & ( a >> 4 ) ) ^ ( b & ( b >> 4 ) ) );
+  B = ( ( a & ( b >> 4 ) ) ^ ( b & ( ( a ^ b ) >> 4 ) ) );
+  C ^= ( ( a & ( c >> 4 ) ) ^ ( b & ( d >> 4 ) ) );
+  D ^= ( ( b & ( c >> 4 ) ) ^ ( ( a ^ b ) & ( d >> 4 ) ) );
+
+  a = A;
+  b = B;
+  c = C;
+  d = D;
+  C ^= ( ( a & ( c >> 8 ) ) ^ ( b & ( d >> 8 ) ) );
+  D ^= ( ( b & ( c >> 8 ) ) ^ ( ( a ^ b ) & ( d >> 8 ) ) );
+
+  a = C ^ ( C >> 1 );
+  b = D ^ ( D >> 1 );
+
+  quint32 i0 = x ^ y;
+  quint32 i1 = b | ( 0xFFFF ^ ( i0 | a ) );
+
+  i0 = ( i0 | ( i0 << 8 ) ) & 0x00FF00FF;
+  i0 = ( i0 | ( i0 << 4 ) ) & 0x0F0F0F0F;
+  i0 = ( i0 | ( i0 << 2 ) ) & 0x33333333;
+  i0 = ( i0 | ( i0 << 1 ) ) & 0x55555555;
+
+  i1 = ( i1 | ( i1 << 8 ) ) & 0x00FF00FF;
+  i1 = ( i1 | ( i1 << 4 ) ) & 0x0F0F0F0F;
+  i1 = ( i1 | ( i1 << 2 ) ) & 0x33333333;
+  i1 = ( i1 | ( i1 << 1 ) ) & 0x55555555;
+
+  return ( i1 << 1 ) | i0;
+}
+
+// Layout of the header of index files. All sections following it are 8 byte aligned:
+// level bounds (quint64 x levelCount), node boxes (double x 4 x nodeCount),
+// node indices (quint64 x nodeCount) and feature ids (qint64 x count).
+struct QgsPackedHilbertRTreeFileHeader
+{
+  char magic[8];
+  quint32 version;
+  quint32 byteOrderMark;
+  quint32 nodeSize;
+  quint32 levelCount;
+  quint64 count;
+  quint64 nodeCount;
+  double extent[4];
+  qint64 sourceModified;
+  qint64 sourceSize;
+};
+static_assert( sizeof( QgsPackedHilbertRTreeFileHeader ) == 88, "Unexpected index file header size" );
+
+static const char PACKED_TREE_MAGIC[8] = { 'Q', 'G', 'S', 'P', 'H', 'R', 'T', '\0' };
+static constexpr quint32 PACKED_TREE_VERSION = 1;
+static constexpr quint32 PACKED_TREE_BYTE_ORDER_MARK = 0x01020304;
+
+static void sourceFileStamp( const QString &sourcePath, qint64 &modified, qint64 &size )
+{
+  modified = -1;
+  size = -1;
+  if ( sourcePath.isEmpty() )
+    return;
+
+  const QFileInfo info( sourcePath );
+  if ( !info.exists() )
+    return;
+
+  modified = info.lastModified().toMSecsSinceEpoch();
+  size = info.size();
+}
+
+QgsPackedHilbertRTree::QgsPackedHilbertRTree( int nodeSize )
+  : mNodeSize( std::max( 2, nodeSize ) )
+{
+}
+
+QgsPackedHilbertRTree::~QgsPackedHilbertRTree() = default;
+
+std::unique_ptr<QgsPackedHilbertRTree> QgsPackedHilbertRTree::fromFile( const QString &path, const QString &sourcePath )
+{
+  std::unique_ptr< QFile > file = std::make_unique< QFile >( path );
+  if ( !file->open( QIODevice::ReadOnly ) )
+    return nullptr;
+
+  const qint64 fileSize = file->size();
+  if ( fileSize < static_cast< qint64 >( sizeof( QgsPackedHilbertRTreeFileHeader ) ) )
+    return nullptr;
+
+  uchar *data = file->map( 0, fileSize );
+  if ( !data )
+    return nullptr;
+
+  QgsPackedHilbertRTreeFileHeader header;
+  std::memcpy( &header, data, sizeof( header ) );
+  if ( std::memcmp( header.magic, PACKED_TREE_MAGIC, sizeof( PACKED_TREE_MAGIC ) ) != 0
+       || header.version != PACKED_TREE_VERSION
+       || header.byteOrderMark != PACKED_TREE_BYTE_ORDER_MARK
+       || header.nodeSize < 2
+       || header.levelCount < 1
+       || header.nodeCount < header.count
+       || header.nodeCount > static_cast< quint64 >( fileSize ) )
+  {
+    QgsDebugMsg( QStringLiteral( "%1 is not a valid spatial index file" ).arg( path ) );
+    return nullptr;
+  }
+
+  if ( !sourcePath.isEmpty() )
+  {
+    qint64 modified = -1;
+    qint64 size = -1;
+    sourceFileStamp( sourcePath, modified, size );
+    if ( modified < 0 || modified != header.sourceModified || size != header.sourceSize )
+    {
+      QgsDebugMsgLevel( QStringLiteral( "Spatial index %1 is out of date" ).arg( path ), 2 );
+      return nullptr;
+    }
+  }
+
+  const quint64 expectedSize = sizeof( QgsPackedHilbertRTreeFileHeader )
+                               + header.levelCount * sizeof( quint64 )
+                               + header.nodeCount * 4 * sizeof( double )
+                               + header.nodeCount * sizeof( quint64 )
+                               + header.count * sizeof( QgsFeatureId );
+  if ( expectedSize != static_cast< quint64 >( fileSize ) )
+  {
+    QgsDebugMsg( QStringLiteral( "%1 is truncated" ).arg( path ) );
+    return nullptr;
+  }
+
+  std::unique_ptr< QgsPackedHilbertRTree > tree( new QgsPackedHilbertRTree( static_cast< int >( header.nodeSize ) ) );
+  const uchar *pos = data + sizeof( QgsPackedHilbertRTreeFileHeader );
+
+  tree->mLevelBounds.resize( header.levelCount );
+  std::memcpy( tree->mLevelBounds.data(), pos, header.levelCount * sizeof( quint64 ) );
+  pos += header.levelCount * sizeof( quint64 );
+
+  tree->mBoxData = reinterpret_cast< const double * >( pos );
+  pos += header.nodeCount * 4 * sizeof( double );
+  tree->mIndexData = reinterpret_cast< const quint64 * >( pos );
+  pos += header.nodeCount * sizeof( quint64 );
+  tree->mIdData = reinterpret_cast< const QgsFeatureId * >( pos );
+
+  tree->mCount = header.count;
+  tree->mNodeCount = header.nodeCount;
+  tree->mXMin = header.extent[0];
+  tree->mYMin = header.extent[1];
+  tree->mXMax = header.extent[2];
+  tree->mYMax = header.extent[3];
+
+  // make sure a damaged file cannot send queries outside of the mapped arrays
+  if ( tree->mLevelBounds.front() != header.count || tree->mLevelBounds.back() != header.nodeCount
+       || ( header.count > 0 && header.nodeCount == header.count )
+       || !std::is_sorted( tree->mLevelBounds.begin(), tree->mLevelBounds.end() ) )
+    return nullptr;
+  for ( std::size_t i = 0; i < tree->mNodeCount; ++i )
+  {
+    const quint64 index = tree->mIndexData[i];
+    if ( ( i < tree->mCount && index >= tree->mCount ) || ( i >= tree->mCount && index >= i ) )
+      return nullptr;
+  }
+
+  tree->mMappedFile = std::move( file );
+  tree->mFinished = true;
+  return tree;
+}
+
+bool QgsPackedHilbertRTree::writeToFile( const QString &path, const QString &sourcePath ) const
+{
+  Q_ASSERT( mFinished );
+
+  QgsPackedHilbertRTreeFileHeader header;
+  std::memset( &header, 0, sizeof( header ) );
+  std::memcpy( header.magic, PACKED_TREE_MAGIC, sizeof( PACKED_TREE_MAGIC ) );
+  header.version = PACKED_TREE_VERSION;
+  header.byteOrderMark = PACKED_TREE_BYTE_ORDER_MARK;
+  header.nodeSize = static_cast< quint32 >( mNodeSize );
+  header.levelCount = static_cast< quint32 >( mLevelBounds.size() );
+  header.count = mCount;
+  header.nodeCount = mNodeCount;
+  header.extent[0] = mXMin;
+  header.extent[1] = mYMin;
+  header.extent[2] = mXMax;
+  header.extent[3] = mYMax;
+  sourceFileStamp( sourcePath, header.sourceModified, header.sourceSize );
+
+  QSaveFile file( path );
+  if ( !file.open( QIODevice::WriteOnly ) )
+    return false;
+
+  auto writeBlock = [&file]( const void *data, quint64 size ) -> bool
+  {
+    return size == 0 || file.write( reinterpret_cast< const char * >( data ), static_cast< qint64 >( size ) ) == static_cast< qint64 >( size );
+  };
+
+  if ( !writeBlock( &header, sizeof( header ) )
+       || !writeBlock( mLevelBounds.data(), mLevelBounds.size() * sizeof( quint64 ) )
+       || !writeBlock( mBoxData, mNodeCount * 4 * sizeof( double ) )
+       || !writeBlock( mIndexData, mNodeCount * sizeof( quint64 ) )
+       || !writeBlock( mIdData, mCount * sizeof( QgsFeatureId ) ) )
+  {
+    file.cancelWriting();
+    return false;
+  }
+
+  return file.commit();
+}
+
+void QgsPackedHilbertRTree::reserve( std::size_t count )
+{
+  mIds.reserve( count );
+  // leaves plus (approximately) all parent levels
+  const std::size_t nodes = count + count / ( mNodeSize - 1 ) + 1;
+  mBoxes.reserve( nodes * 4 );
+  mIndices.reserve( nodes );
+}
+
+void QgsPackedHilbertRTree::add( QgsFeatureId id, const QgsRectangle &bounds )
+{
+  Q_ASSERT( !mFinished );
+
+  mIndices.push_back( mIds.size() );
+  mIds.push_back( id );
+  mCount = mIds.size();
+  mBoxes.push_back( bounds.xMinimum() );
+  mBoxes.push_back( bounds.yMinimum() );
+  mBoxes.push_back( bounds.xMaximum() );
+  mBoxes.push_back( bounds.yMaximum() );
+
+  mXMin = std::min( mXMin, bounds.xMinimum() );
+  mYMin = std::min( mYMin, bounds.yMinimum() );
+  mXMax = std::max( mXMax, bounds.xMaximum() );
+  mYMax = std::max( mYMax, bounds.yMaximum() );
+}
+
+void QgsPackedHilbertRTree::finish()
+{
+  Q_ASSERT( !mFinished );
+  mFinished = true;
+
+  const std::size_t count = mIds.size();
+  mLevelBounds.clear();
+  mLevelBounds.push_back( count );
+  if ( count == 0 )
+  {
+    mNodeCount = 0;
+    return;
+  }
+
+  // sort leaves along the Hilbert curve through their centers
+  const double width = mXMax - mXMin;
+  const double height = mYMax - mYMin;
+  std::vector< quint32 > hilbertValues( count );
+  for ( std::size_t i = 0; i < count; ++i )
+  {
+    const double *box = mBoxes.data() + i * 4;
+    const quint32 x = width > 0 ? static_cast< quint32 >( 0xFFFF * ( ( box[0] + box[2] ) / 2 - mXMin ) / width ) : 0;
+    const quint32 y = height > 0 ? static_cast< quint32 >( 0xFFFF * ( ( box[1] + box[3] ) / 2 - mYMin ) / height ) : 0;
+    hilbertValues[i] = hilbertValue( x, y );
+  }
+
+  std::vector< std::size_t > order( count );
+  std::iota( order.begin(), order.end(), 0 );
+  std::sort( order.begin(), order.end(), [&hilbertValues]( std::size_t a, std::size_t b )
+  {
+    return hilbertValues[a] < hilbertValues[b];
+  } );
+
+  std::vector< double > sortedBoxes( count * 4 );
+  for ( std::size_t i = 0; i < count; ++i )
+  {
+    std::copy_n( mBoxes.data() + order[i] * 4, 4, sortedBoxes.data() + i * 4 );
+    mIndices[i] = order[i];
+  }
+  std::copy( sortedBoxes.begin(), sortedBoxes.end(), mBoxes.begin() );
+
+  // pack each level into parent nodes of mNodeSize children, up to a single root
+  std::size_t levelStart = 0;
+  std::size_t levelEndIndex = count;
+  do
+  {
+    for ( std::size_t i = levelStart; i < levelEndIndex; i += mNodeSize )
+    {
+      const std::size_t childEnd = std::min( i + mNodeSize, levelEndIndex );
+      double xMin = std::numeric_limits< double >::max();
+      double yMin = std::numeric_limits< double >::max();
+      double xMax = std::numeric_limits< double >::lowest();
+      double yMax = std::numeric_limits< double >::lowest();
+      for ( std::size_t child = i; child < childEnd; ++child )
+      {
+        const double *box = mBoxes.data() + child * 4;
+        xMin = std::min( xMin, box[0] );
+        yMin = std::min( yMin, box[1] );
+        xMax = std::max( xMax, box[2] );
+        yMax = std::max( yMax, box[3] );
+      }
+      mBoxes.push_back( xMin );
+      mBoxes.push_back( yMin );
+      mBoxes.push_back( xMax );
+      mBoxes.push_back( yMax );
+      mIndices.push_back( i );
+    }
+    levelStart = levelEndIndex;
+    levelEndIndex = mIndices.size();
+    mLevelBounds.push_back( levelEndIndex );
+  }
+  while ( levelEndIndex - levelStart > 1 );
+
+  mBoxes.shrink_to_fit();
+  mIndices.shrink_to_fit();
+
+  mBoxData = mBoxes.data();
+  mIndexData = mIndices.data();
+  mIdData = mIds.data();
+  mNodeCount = mIndices.size();
+}
+
+QgsRectangle QgsPackedHilbertRTree::extent() const
+{
+  if ( mCount == 0 )
+    return QgsRectangle();
+  return QgsRectangle( mXMin, mYMin, mXMax, mYMax, false );
+}
+
+std::size_t QgsPackedHilbertRTree::levelEnd( std::size_t nodeIndex ) const
+{
+  return *std::upper_bound( mLevelBounds.begin(), mLevelBounds.end(), nodeIndex );
+}
+
+void QgsPackedHilbertRTree::intersects( const QgsRectangle &rectangle, const std::function<void ( QgsFeatureId )> &visitor ) const
+{
+  Q_ASSERT( mFinished );
+  if ( mCount == 0 )
+    return;
+
+  const std::size_t count = mCount;
+  const double minX = rectangle.xMinimum();
+  const double minY = rectangle.yMinimum();
+  const double maxX = rectangle.xMaximum();
+  const double maxY = rectangle.yMaximum();
+
+  std::vector< std::size_t > stack;
+  stack.reserve( 64 );
+  stack.push_back( mNodeCount - 1 );
+
+  while ( !stack.empty() )
+  {
+    const std::size_t node = stack.back();
+    stack.pop_back();
+
+    const std::size_t childStart = mIndexData[node];
+    const std::size_t childEnd = std::min( childStart + mNodeSize, levelEnd( childStart ) );
+    for ( std::size_t child = childStart; child < childEnd; ++child )
+    {
+      const double *box = mBoxData + child * 4;
+      if ( box[0] > maxX || box[1] > maxY || box[2] < minX || box[3] < minY )
+        continue;
+
+      if ( child < count )
+        visitor( mIdData[ mIndexData[child] ] );
+      else
+        stack.push_back( child );
+    }
+  }
+}
+
+void QgsPackedHilbertRTree::nearest( const std::function<double ( double, double, double, double )> &nodeDistance,
+                                     const std::function<double ( QgsFeatureId, double )> &entryDistance,
+                                     const std::function<bool ( QgsFeatureId, double )> &visitor,
+                                     double maxDistance ) const
+{
+  Q_ASSERT( mFinished );
+  if ( mCount == 0 )
+    return;
+
+  struct QueueItem
+  {
+    double distance;
+    std::size_t index;
+    bool isEntry;
+
+    bool operator>( const QueueItem &other ) const
+    {
+      return distance > other.distance;
+    }
+  };
+
+  const std::size_t count = mCount;
+  std::priority_queue< QueueItem, std::vector< QueueItem >, std::greater< QueueItem > > queue;
+  queue.push( { 0, mNodeCount - 1, false } );
+
+  while ( !queue.empty() )
+  {
+    const QueueItem item = queue.top();
+    queue.pop();
+
+    if ( item.isEntry )
+    {
+      if ( !visitor( mIdData[ item.index ], item.distance ) )
+        return;
+      continue;
+    }
+
+    const std::size_t childStart = mIndexData[item.index];
+    const std::size_t childEnd = std::min( childStart + mNodeSize, levelEnd( childStart ) );
+    for ( std::size_t child = childStart; child < childEnd; ++child )
+    {
+      const double *box = mBoxData + child * 4;
+      double distance = nodeDistance( box[0], box[1], box[2], box[3] );
+      if ( maxDistance > 0 && distance > maxDistance )
+        continue;
+
+      if ( child < count )
+      {
+        const std::size_t entry = mIndexData[child];
+        distance = entryDistance( mIdData[entry], distance );
+        if ( maxDistance > 0 && distance > maxDistance )
+          continue;
+        queue.push( { distance, entry, true } );
+      }
+      else
+      {
+        queue.push( { distance, child, false } );
+      }
+    }
+  }
+}
+
+///@endcond
@@ -0,0 +1,178 @@
+/***************************************************************************
+    qgspackedhilbertrtree_p.h  -  Static bulk loaded Hilbert R-tree
+    -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSPACKEDHILBERTRTREE_P_H
+#define QGSPACKEDHILBERTRTREE_P_H
+
+#define SIP_NO_FILE
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QGIS API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+
+#include "qgis_core.h"
+#include "qgsfeatureid.h"
+#include "qgsrectangle.h"
+
+#include <QString>
+
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+class QFile;
+
+///@cond PRIVATE
+
+/**
+ * \ingroup core
+ * \class QgsPackedHilbertRTree
+ * \brief A static R-tree which is bulk loaded in a single pass and stored in flat arrays.
+ *
+ * Entries are sorted by the Hilbert value of their bounding box centers and packed
+ * into full nodes bottom-up, so the tree has no slack and construction is a sort
+ * followed by a linear scan. Once built the tree is never modified, which means
+ * queries need no locking and may be run from any number of threads at once.
+ *
+ * A finished tree can be written to disk with writeToFile() and later memory-mapped
+ * back with fromFile(), so that it does not need to be rebuilt.
+ *
+ * \note not available in Python bindings
+ */
+class CORE_EXPORT QgsPackedHilbertRTree
+{
+  public:
+
+    //! Default number of children per node
+    static constexpr int DEFAULT_NODE_SIZE = 16;
+
+    /**
+     * Constructor for QgsPackedHilbertRTree.
+     *
+     * Entries must be added with add() and the tree built with finish() before it can be queried.
+     */
+    explicit QgsPackedHilbertRTree( int nodeSize = DEFAULT_NODE_SIZE );
+
+    ~QgsPackedHilbertRTree();
+
+    /**
+     * Memory-maps a tree previously written with writeToFile().
+     *
+     * If \a sourcePath is not empty, the modification time and size of that file must match
+     * those recorded when the tree was written, otherwise the file is considered stale.
+     *
+     * Returns NULLPTR if the file does not exist, is not a valid tree or is stale.
+     */
+    static std::unique_ptr< QgsPackedHilbertRTree > fromFile( const QString &path, const QString &sourcePath = QString() );
+
+    /**
+     * Writes the finished tree to the file at \a path, recording the modification time and size
+     * of \a sourcePath (if set) so that fromFile() can detect when the tree is out of date.
+     *
+     * Returns FALSE if the file could not be written.
+     */
+    bool writeToFile( const QString &path, const QString &sourcePath = QString() ) const;
+
+    /**
+     * Reserves space for \a count entries.
+     */
+    void reserve( std::size_t count );
+
+    /**
+     * Adds an entry with the specified \a id and \a bounds. Must be called before finish().
+     */
+    void add( QgsFeatureId id, const QgsRectangle &bounds );
+
+    /**
+     * Sorts the entries and builds the tree levels. After this call no further entries may be added.
+     */
+    void finish();
+
+    /**
+     * Returns the number of entries in the tree.
+     */
+    std::size_t size() const { return mCount; }
+
+    /**
+     * Returns the bounding box of all entries in the tree.
+     */
+    QgsRectangle extent() const;
+
+    /**
+     * Calls \a visitor for every entry with a bounding box intersecting \a rectangle.
+     */
+    void intersects( const QgsRectangle &rectangle, const std::function< void( QgsFeatureId ) > &visitor ) const;
+
+    /**
+     * Visits entries in order of increasing distance.
+     *
+     * \a nodeDistance must return the minimum distance from the query to a bounding box, and
+     * \a entryDistance the distance to an entry given its id and bounding box distance
+     * (it may simply return the box distance). \a visitor is called for each entry in
+     * order of increasing distance, and the search stops once it returns FALSE.
+     *
+     * Entries further than \a maxDistance are skipped if \a maxDistance is greater than 0.
+     */
+    void nearest( const std::function< double( double xMin, double yMin, double xMax, double yMax ) > &nodeDistance,
+                  const std::function< double( QgsFeatureId id, double boxDistance ) > &entryDistance,
+                  const std::function< bool( QgsFeatureId id, double distance ) > &visitor,
+                  double maxDistance = 0 ) const;
+
+  private:
+
+    //! Returns the index one past the last node of the level containing \a nodeIndex
+    std::size_t levelEnd( std::size_t nodeIndex ) const;
+
+    int mNodeSize = DEFAULT_NODE_SIZE;
+
+    //! Node boxes, four doubles (xmin, ymin, xmax, ymax) per node. Leaf entries come first.
+    std::vector< double > mBoxes;
+
+    //! For leaf entries the position into mIds, for parent nodes the index of their first child
+    std::vector< quint64 > mIndices;
+
+    //! Feature ids of the leaf entries, in insertion order
+    std::vector< QgsFeatureId > mIds;
+
+    //! End node index of every level, from the leaves up to the root
+    std::vector< quint64 > mLevelBounds;
+
+    // Views used by the queries, pointing either into the vectors above or into a mapped file
+    const double *mBoxData = nullptr;
+    const quint64 *mIndexData = nullptr;
+    const QgsFeatureId *mIdData = nullptr;
+    std::size_t mCount = 0;
+    std::size_t mNodeCount = 0;
+
+    std::unique_ptr< QFile > mMappedFile;
+
+    double mXMin = std::numeric_limits< double >::max();
+    double mYMin = std::numeric_limits< double >::max();
+    double mXMax = std::numeric_limits< double >::lowest();
+    double mYMax = std::numeric_limits< double >::lowest();
+
+    bool mFinished = false;
+};
+
+///@endcond
+
+#endif // QGSPACKEDHILBERTRTREE_P_H
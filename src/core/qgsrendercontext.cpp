@@ -24,6 +24,7 @@
 #include "qgsfeaturefilterprovider.h"
 #include "qgslogger.h"
 #include "qgspoint.h"
+#include "qgscoordinatetransformgrid.h"
 
 #define POINTS_TO_MM 2.83464567
 #define INCH_TO_MM 25.4
@@ -45,6 +46,7 @@ QgsRenderContext::QgsRenderContext( const QgsRenderContext &rh )
   , mPainter( rh.mPainter )
   , mMaskPainter( rh.mMaskPainter )
   , mCoordTransform( rh.mCoordTransform )
+  , mCoordinateTransformGrid( rh.mCoordinateTransformGrid )
   , mDistanceArea( rh.mDistanceArea )
   , mExtent( rh.mExtent )
   , mOriginalMapExtent( rh.mOriginalMapExtent )
@@ -84,6 +86,7 @@ QgsRenderContext &QgsRenderContext::operator=( const QgsRenderContext &rh )
   mPainter = rh.mPainter;
   mMaskPainter = rh.mMaskPainter;
   mCoordTransform = rh.mCoordTransform;
+  mCoordinateTransformGrid = rh.mCoordinateTransformGrid;
   mExtent = rh.mExtent;
   mOriginalMapExtent = rh.mOriginalMapExtent;
   mMapToPixel = rh.mMapToPixel;
@@ -221,6 +224,7 @@ QgsRenderContext QgsRenderContext::fromMapSettings( const QgsMapSettings &mapSet
   ctx.setFlag( RenderBlocking, mapSettings.testFlag( QgsMapSettings::RenderBlocking ) );
   ctx.setFlag( LosslessImageRendering, mapSettings.testFlag( QgsMapSettings::LosslessImageRendering ) );
   ctx.setFlag( Render3DMap, mapSettings.testFlag( QgsMapSettings::Render3DMap ) );
+  ctx.setFlag( ApproximateCoordinateTransforms, mapSettings.testFlag( QgsMapSettings::ApproximateCoordinateTransforms ) );
   ctx.setScaleFactor( mapSettings.outputDpi() / 25.4 ); // = pixels per mm
   ctx.setDpiTarget( mapSettings.dpiTarget() >= 0.0 ? mapSettings.dpiTarget() : -1.0 );
   ctx.setRendererScale( mapSettings.scale() );
@@ -278,6 +282,8 @@ bool QgsRenderContext::showSelection() const
 void QgsRenderContext::setCoordinateTransform( const QgsCoordinateTransform &t )
 {
   mCoordTransform = t;
+  // a grid built for the previous transform no longer applies
+  mCoordinateTransformGrid.reset();
 }
 
 void QgsRenderContext::setDrawEditingInformation( bool b )
@@ -44,6 +44,7 @@ class QgsRenderedFeatureHandlerInterface;
 class QgsSymbolLayer;
 class QgsMaskIdProvider;
 class QgsMapClippingRegion;
+class QgsCoordinateTransformGrid;
 
 
 /**
@@ -85,6 +86,7 @@ class CORE_EXPORT QgsRenderContext : public QgsTemporalRangeObject
       ApplyScalingWorkaroundForTextRendering = 0x2000, //!< Whether a scaling workaround designed to stablise the rendering of small font sizes (or for painters scaled out by a large amount) when rendering text. Generally this is recommended, but it may incur some performance cost.
       Render3DMap              = 0x4000, //!< Render is for a 3D map
       ApplyClipAfterReprojection = 0x8000, //!< Feature geometry clipping to mapExtent() must be performed after the geometries are transformed using coordinateTransform(). Usually feature geometry clipping occurs using the extent() in the layer's CRS prior to geometry transformation, but in some cases when extent() could not be accurately calculated it is necessary to clip geometries to mapExtent() AFTER transforming them using coordinateTransform().
+      ApproximateCoordinateTransforms = 0x10000, //!< Vector geometries may be reprojected by interpolating within a grid of exactly transformed points, with an error kept below a fraction of a pixel. Faster for complex geometries, but must not be used when exact coordinates are required (since QGIS 3.20)
     };
     Q_DECLARE_FLAGS( Flags, Flag )
 
@@ -244,6 +246,16 @@ class CORE_EXPORT QgsRenderContext : public QgsTemporalRangeObject
      */
     QgsCoordinateTransform coordinateTransform() const {return mCoordTransform;}
 
+    /**
+     * Returns the approximate coordinate transform grid to use when rendering, or NULLPTR
+     * if geometries should be transformed exactly using coordinateTransform().
+     *
+     * \see setCoordinateTransformGrid()
+     * \note Not available in Python bindings
+     * \since QGIS 3.20
+     */
+    const QgsCoordinateTransformGrid *coordinateTransformGrid() const { return mCoordinateTransformGrid.get(); } SIP_SKIP
+
     /**
      * A general purpose distance and area calculator, capable of performing ellipsoid based calculations.
      * \since QGIS 3.0
@@ -420,6 +432,18 @@ class CORE_EXPORT QgsRenderContext : public QgsTemporalRangeObject
      */
     void setCoordinateTransform( const QgsCoordinateTransform &t );
 
+    /**
+     * Sets an approximate coordinate transform \a grid, which must approximate coordinateTransform()
+     * over at least the extent() of the context. Set to NULLPTR to transform geometries exactly.
+     *
+     * This is only set by map layer renderers when the ApproximateCoordinateTransforms flag is set.
+     *
+     * \see coordinateTransformGrid()
+     * \note Not available in Python bindings
+     * \since QGIS 3.20
+     */
+    void setCoordinateTransformGrid( std::shared_ptr< const QgsCoordinateTransformGrid > grid ) { mCoordinateTransformGrid = std::move( grid ); } SIP_SKIP
+
     /**
      * Sets the context's map to pixel transform, which transforms between map coordinates and device coordinates.
      *
@@ -925,6 +949,9 @@ class CORE_EXPORT QgsRenderContext : public QgsTemporalRangeObject
     //! For transformation between coordinate systems. Can be invalid if on-the-fly reprojection is not used
     QgsCoordinateTransform mCoordTransform;
 
+    //! Optional grid approximating mCoordTransform over the rendered extent
+    std::shared_ptr< const QgsCoordinateTransformGrid > mCoordinateTransformGrid;
+
     /**
      * A general purpose distance and area calculator, capable of performing ellipsoid based calculations.
      * Will be used to convert meter distances to active MapUnit values for QgsUnitTypes::RenderMetersInMapUnits
@@ -23,8 +23,12 @@
 #include "qgsfeaturesource.h"
 #include "qgsfeedback.h"
 #include "qgsspatialindexutils.h"
+#include "qgspackedhilbertrtree_p.h"
 
 #include <spatialindex/SpatialIndex.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
 #include <QMutex>
 #include <QMutexLocker>
 
@@ -269,17 +273,37 @@ class QgsSpatialIndexData : public QSharedData
                                   const std::function< bool( const QgsFeature & ) > *callback = nullptr )
       : mFlags( flags )
     {
+      if ( flags & QgsSpatialIndex::FlagStaticPackedTree )
+      {
+        initPackedTree( fi, feedback, callback );
+        return;
+      }
+
       QgsFeatureIteratorDataStream fids( fi, feedback, mFlags, callback );
       initTree( &fids );
       if ( flags & QgsSpatialIndex::FlagStoreFeatureGeometries )
         mGeometries = fids.geometries;
     }
 
+    /**
+     * Constructor for QgsSpatialIndexData which wraps an existing static packed \a tree.
+     */
+    explicit QgsSpatialIndexData( std::unique_ptr< QgsPackedHilbertRTree > tree )
+      : mFlags( QgsSpatialIndex::FlagStaticPackedTree )
+      , mPackedTree( std::move( tree ) )
+    {
+    }
+
     QgsSpatialIndexData( const QgsSpatialIndexData &other )
       : QSharedData( other )
       , mFlags( other.mFlags )
       , mGeometries( other.mGeometries )
+      , mPackedTree( other.mPackedTree )
     {
+      // packed trees are immutable, so can be shared between copies
+      if ( mPackedTree )
+        return;
+
       QMutexLocker locker( &other.mMutex );
 
       initTree();
@@ -323,12 +347,73 @@ class QgsSpatialIndexData : public QSharedData
                                         leafCapacity, dimension, variant, indexId );
     }
 
+    void initPackedTree( const QgsFeatureIterator &fi, QgsFeedback *feedback, const std::function< bool( const QgsFeature & ) > *callback )
+    {
+      std::unique_ptr< QgsPackedHilbertRTree > tree = std::make_unique< QgsPackedHilbertRTree >();
+
+      QgsFeatureIterator it( fi );
+      QgsFeature f;
+      QgsRectangle rect;
+      QgsFeatureId id;
+      while ( it.nextFeature( f ) )
+      {
+        if ( feedback && feedback->isCanceled() )
+          break;
+
+        if ( callback && !( *callback )( f ) )
+          break;
+
+        if ( QgsSpatialIndex::featureInfo( f, rect, id ) )
+        {
+          tree->add( id, rect );
+          if ( mFlags & QgsSpatialIndex::FlagStoreFeatureGeometries )
+            mGeometries.insert( id, f.geometry() );
+        }
+      }
+
+      tree->finish();
+      mPackedTree = std::move( tree );
+    }
+
+    QList<QgsFeatureId> packedNearestNeighbor( const QgsGeometry &geometry, int neighbors, double maxDistance ) const
+    {
+      QList<QgsFeatureId> list;
+      const QgsRectangle bounds = geometry.boundingBox();
+      const bool exact = mFlags & QgsSpatialIndex::FlagStoreFeatureGeometries;
+      double lastDistance = 0;
+
+      mPackedTree->nearest( [&bounds]( double xMin, double yMin, double xMax, double yMax )
+      {
+        const double dx = std::max( { xMin - bounds.xMaximum(), 0.0, bounds.xMinimum() - xMax } );
+        const double dy = std::max( { yMin - bounds.yMaximum(), 0.0, bounds.yMinimum() - yMax } );
+        return std::sqrt( dx * dx + dy * dy );
+      },
+      [this, exact, &geometry]( QgsFeatureId id, double boxDistance )
+      {
+        return exact ? mGeometries.value( id ).distance( geometry ) : boxDistance;
+      },
+      [&list, &lastDistance, neighbors]( QgsFeatureId id, double distance )
+      {
+        // keep collecting features which are equidistant to the last neighbor
+        if ( list.size() >= neighbors && distance > lastDistance )
+          return false;
+        list.append( id );
+        lastDistance = distance;
+        return true;
+      }, maxDistance );
+
+      return list;
+    }
+
     //! Storage manager
     SpatialIndex::IStorageManager *mStorage = nullptr;
 
     //! R-tree containing spatial index
     SpatialIndex::ISpatialIndex *mRTree = nullptr;
 
+    //! Static packed tree, used instead of mRTree when built with FlagStaticPackedTree
+    std::shared_ptr< const QgsPackedHilbertRTree > mPackedTree;
+
 #if QT_VERSION < QT_VERSION_CHECK(5, 14, 0)
     mutable QMutex mMutex;
 #else
@@ -447,6 +532,12 @@ bool QgsSpatialIndex::insertFeature( QgsFeatureId id, const QgsRectangle &bounds
 
 bool QgsSpatialIndex::addFeature( QgsFeatureId id, const QgsRectangle &bounds )
 {
+  if ( d->mPackedTree )
+  {
+    QgsDebugMsg( QStringLiteral( "Features cannot be added to a static packed spatial index" ) );
+    return false;
+  }
+
   SpatialIndex::Region r( QgsSpatialIndexUtils::rectangleToRegion( bounds ) );
 
   QMutexLocker locker( &d->mMutex );
@@ -482,6 +573,12 @@ bool QgsSpatialIndex::deleteFeature( const QgsFeature &f )
   if ( !featureInfo( f, r, id ) )
     return false;
 
+  if ( d->mPackedTree )
+  {
+    QgsDebugMsg( QStringLiteral( "Features cannot be removed from a static packed spatial index" ) );
+    return false;
+  }
+
   QMutexLocker locker( &d->mMutex );
   // TODO: handle exceptions
   if ( d->mFlags & QgsSpatialIndex::FlagStoreFeatureGeometries )
@@ -492,6 +589,12 @@ bool QgsSpatialIndex::deleteFeature( const QgsFeature &f )
 QList<QgsFeatureId> QgsSpatialIndex::intersects( const QgsRectangle &rect ) const
 {
   QList<QgsFeatureId> list;
+  if ( d->mPackedTree )
+  {
+    d->mPackedTree->intersects( rect, [&list]( QgsFeatureId id ) { list.append( id ); } );
+    return list;
+  }
+
   QgisVisitor visitor( list );
 
   SpatialIndex::Region r = QgsSpatialIndexUtils::rectangleToRegion( rect );
@@ -504,6 +607,9 @@ QList<QgsFeatureId> QgsSpatialIndex::intersects( const QgsRectangle &rect ) cons
 
 QList<QgsFeatureId> QgsSpatialIndex::nearestNeighbor( const QgsPointXY &point, const int neighbors, const double maxDistance ) const
 {
+  if ( d->mPackedTree )
+    return d->packedNearestNeighbor( QgsGeometry::fromPointXY( point ), neighbors, maxDistance );
+
   QList<QgsFeatureId> list;
   QgisVisitor visitor( list );
 
@@ -530,6 +636,9 @@ QList<QgsFeatureId> QgsSpatialIndex::nearestNeighbor( const QgsPointXY &point, c
 
 QList<QgsFeatureId> QgsSpatialIndex::nearestNeighbor( const QgsGeometry &geometry, int neighbors, double maxDistance ) const
 {
+  if ( d->mPackedTree )
+    return d->packedNearestNeighbor( geometry, neighbors, maxDistance );
+
   QList<QgsFeatureId> list;
   QgisVisitor visitor( list );
 
@@ -555,10 +664,40 @@ QList<QgsFeatureId> QgsSpatialIndex::nearestNeighbor( const QgsGeometry &geometr
 
 QgsGeometry QgsSpatialIndex::geometry( QgsFeatureId id ) const
 {
+  // geometries of packed indexes are never modified after construction
+  if ( d->mPackedTree )
+    return d->mGeometries.value( id );
+
   QMutexLocker locker( &d->mMutex );
   return d->mGeometries.value( id );
 }
 
+bool QgsSpatialIndex::writeToFile( const QString &path, const QString &sourcePath ) const
+{
+  if ( !d->mPackedTree )
+  {
+    QgsDebugMsg( QStringLiteral( "Only static packed spatial indexes can be written to a file" ) );
+    return false;
+  }
+
+  return d->mPackedTree->writeToFile( path, sourcePath );
+}
+
+bool QgsSpatialIndex::readFromFile( const QString &path, const QString &sourcePath )
+{
+  std::unique_ptr< QgsPackedHilbertRTree > tree = QgsPackedHilbertRTree::fromFile( path, sourcePath );
+  if ( !tree )
+    return false;
+
+  d = new QgsSpatialIndexData( std::move( tree ) );
+  return true;
+}
+
+QString QgsSpatialIndex::indexPathForSource( const QString &sourcePath )
+{
+  return sourcePath + QStringLiteral( ".qgsidx" );
+}
+
 QAtomicInt QgsSpatialIndex::refs() const
 {
   return d->ref;
@@ -61,6 +61,10 @@ class QgsFeatureSource;
  * class implements its own locks and accordingly, a single QgsSpatialIndex object can safely
  * be used across multiple threads.
  *
+ * Indexes which are bulk loaded with the FlagStaticPackedTree flag do not use libspatialindex. They
+ * are stored in flat arrays sorted along a Hilbert curve, and since they are immutable their queries
+ * do not need to take any lock.
+ *
  * \see QgsSpatialIndexKDBush, which is an optimised non-mutable index for point geometries only.
  * \see QgsMeshSpatialIndex, which is for mesh faces
  */
@@ -75,6 +79,7 @@ class CORE_EXPORT QgsSpatialIndex : public QgsFeatureSink
     enum Flag
     {
       FlagStoreFeatureGeometries = 1 << 0, //!< Indicates that the spatial index should also store feature geometries. This requires more memory, but can speed up operations by avoiding additional requests to data providers to fetch matching feature geometries. Additionally, it is required for non-bounding box nearest neighbor searches.
+      FlagStaticPackedTree = 1 << 1, //!< Indicates that indexes bulk loaded from a feature iterator or source should be built as a static, packed Hilbert R-tree. These are much faster to build and can be queried from multiple threads without locking, but features cannot be added to or removed from them afterwards. Ignored when constructing an empty index. (Since QGIS 3.20)
     };
     Q_DECLARE_FLAGS( Flags, Flag )
 
@@ -170,12 +175,16 @@ class CORE_EXPORT QgsSpatialIndex : public QgsFeatureSink
     /**
      * Add a feature \a id to the index with a specified bounding box.
      * \returns TRUE if feature was successfully added to index.
+     *
+     * Always returns FALSE for indexes built with the FlagStaticPackedTree flag.
      * \since QGIS 3.4
     */
     bool addFeature( QgsFeatureId id, const QgsRectangle &bounds );
 
     /**
      * Removes a \a feature from the index.
+     *
+     * Always returns FALSE for indexes built with the FlagStaticPackedTree flag.
      */
     bool deleteFeature( const QgsFeature &feature );
 
@@ -265,6 +274,49 @@ class CORE_EXPORT QgsSpatialIndex : public QgsFeatureSink
     % End
 #endif
 
+    /**
+     * Writes the index to the file at \a path, so that it can later be restored with readFromFile()
+     * instead of being rebuilt.
+     *
+     * Only indexes built with the FlagStaticPackedTree flag can be written. Stored feature geometries
+     * are not written to the file.
+     *
+     * If \a sourcePath is set, the modification time and size of that file are recorded alongside the
+     * index, and readFromFile() will refuse to load the index once the source file has changed.
+     *
+     * \returns TRUE if the index was successfully written
+     * \see readFromFile()
+     * \see indexPathForSource()
+     * \since QGIS 3.20
+     */
+    bool writeToFile( const QString &path, const QString &sourcePath = QString() ) const;
+
+    /**
+     * Replaces the contents of this index with a static packed index previously written by writeToFile().
+     *
+     * The file is memory-mapped rather than read, so even very large indexes are available immediately
+     * and are paged in on demand by the operating system. The loaded index behaves as one built with
+     * the FlagStaticPackedTree flag.
+     *
+     * If \a sourcePath is set, the index is only loaded if that file has not been modified since the
+     * index was written.
+     *
+     * \returns TRUE if the index was loaded, or FALSE if the file does not exist, is not a valid index
+     * or is out of date. In this case the index is left unchanged and should be rebuilt from the source.
+     *
+     * \see writeToFile()
+     * \since QGIS 3.20
+     */
+    bool readFromFile( const QString &path, const QString &sourcePath = QString() );
+
+    /**
+     * Returns the path of the file used to store a persistent index for the file at \a sourcePath,
+     * which is located alongside the source file.
+     *
+     * \since QGIS 3.20
+     */
+    static QString indexPathForSource( const QString &sourcePath );
+
     /* debugging */
 
     //! Gets reference count - just for debugging!
@@ -294,6 +346,7 @@ class CORE_EXPORT QgsSpatialIndex : public QgsFeatureSink
     static bool featureInfo( const QgsFeature &f, QgsRectangle &rect, QgsFeatureId &id );
 
     friend class QgsFeatureIteratorDataStream; // for access to featureInfo()
+    friend class QgsSpatialIndexData; // for access to featureInfo()
 
   private:
 
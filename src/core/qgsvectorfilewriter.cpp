@@ -3270,8 +3270,62 @@ QgsVectorFileWriter::WriterError QgsVectorFileWriter::writeAsVectorFormatV2( Pre
   // write all features
   long saved = 0;
   int initialProgress = lastProgressReport;
-  while ( details.sourceFeatureIterator.nextFeature( fet ) )
+
+  // features are read in batches, so that the geometries of a whole batch can be reprojected together
+  const int batchSize = details.shallTransform ? 1000 : 1;
+  QgsFeatureList batch;
+  QVector< QgsGeometry > batchGeometries;
+  QList< int > batchIndices;
+  QSet< int > untransformedIndices;
+  int batchPosition = 0;
+  while ( true )
   {
+    if ( batchPosition == batch.size() )
+    {
+      batch.clear();
+      while ( batch.size() < batchSize && details.sourceFeatureIterator.nextFeature( fet ) )
+        batch << fet;
+      if ( batch.isEmpty() )
+        break;
+      batchPosition = 0;
+
+      untransformedIndices.clear();
+      if ( details.shallTransform )
+      {
+        batchGeometries.clear();
+        batchIndices.clear();
+        for ( int i = 0; i < batch.size(); ++i )
+        {
+          if ( batch.at( i ).hasGeometry() )
+          {
+            batchGeometries << batch.at( i ).geometry();
+            batchIndices << i;
+          }
+        }
+
+        try
+        {
+          const QList< int > failed = options.ct.transformGeometries( batchGeometries );
+          for ( int failedIndex : failed )
+            untransformedIndices.insert( batchIndices.at( failedIndex ) );
+          for ( int i = 0; i < batchGeometries.size(); ++i )
+          {
+            if ( !untransformedIndices.contains( batchIndices.at( i ) ) )
+              batch[ batchIndices.at( i ) ].setGeometry( batchGeometries.at( i ) );
+          }
+        }
+        catch ( QgsCsException & )
+        {
+          // transform the features one by one, to find the one which failed
+          for ( int index : std::as_const( batchIndices ) )
+            untransformedIndices.insert( index );
+        }
+      }
+    }
+
+    const bool transformFeature = untransformedIndices.contains( batchPosition );
+    fet = batch.at( batchPosition++ );
+
     if ( options.feedback && options.feedback->isCanceled() )
     {
       return Canceled;
@@ -3289,7 +3343,7 @@ QgsVectorFileWriter::WriterError QgsVectorFileWriter::writeAsVectorFormatV2( Pre
       }
     }
 
-    if ( details.shallTransform )
+    if ( transformFeature )
     {
       try
       {
@@ -21,6 +21,7 @@
 #include "qgsrasterviewport.h"
 #include "qgslayertreemodellegendnode.h"
 #include "qgssymbol.h"
+#include "qgsrasterlookuptable_p.h"
 
 #include <QDomDocument>
 #include <QDomElement>
@@ -264,7 +265,65 @@ QgsRasterBlock *QgsMultiBandColorRenderer::block( int bandNo, QgsRectangle  cons
   }
 
   qgssize count = ( qgssize )width * height;
-  for ( qgssize i = 0; i < count; i++ )
+
+  // without transparency the color only depends on the band values, so integer data
+  // can be enhanced once per distinct value of each band
+  bool lookupDraw = false;
+  if ( !fastDraw && !usesTransparency() && redBlock && greenBlock && blueBlock )
+  {
+    const QgsRasterLookupTable redTable( redBlock );
+    const QgsRasterLookupTable greenTable( greenBlock );
+    const QgsRasterLookupTable blueTable( blueBlock );
+    lookupDraw = redTable.isValid() && greenTable.isValid() && blueTable.isValid();
+    if ( lookupDraw )
+    {
+      // as in the generic loop below, the displayable range of all bands is tested with the red value
+      std::vector< int > redValues( static_cast< std::size_t >( redTable.size() ) );
+      std::vector< bool > displayable( static_cast< std::size_t >( redTable.size() ) );
+      for ( int index = 0; index < redTable.size(); ++index )
+      {
+        const double redVal = redTable.value( index );
+        displayable[ static_cast< std::size_t >( index ) ] = ( !mRedContrastEnhancement || mRedContrastEnhancement->isValueInDisplayableRange( redVal ) )
+            && ( !mGreenContrastEnhancement || mGreenContrastEnhancement->isValueInDisplayableRange( redVal ) )
+            && ( !mBlueContrastEnhancement || mBlueContrastEnhancement->isValueInDisplayableRange( redVal ) );
+        redValues[ static_cast< std::size_t >( index ) ] = mRedContrastEnhancement ? mRedContrastEnhancement->enhanceContrast( redVal ) : static_cast< int >( redVal );
+      }
+      const auto enhancedValues = []( const QgsRasterLookupTable & table, QgsContrastEnhancement * enhancement )
+      {
+        std::vector< int > values( static_cast< std::size_t >( table.size() ) );
+        for ( int index = 0; index < table.size(); ++index )
+          values[ static_cast< std::size_t >( index ) ] = enhancement ? enhancement->enhanceContrast( table.value( index ) ) : static_cast< int >( table.value( index ) );
+        return values;
+      };
+      const std::vector< int > greenValues = enhancedValues( greenTable, mGreenContrastEnhancement );
+      const std::vector< int > blueValues = enhancedValues( blueTable, mBlueContrastEnhancement );
+
+      std::vector< int > redIndices( count );
+      std::vector< int > greenIndices( count );
+      std::vector< int > blueIndices( count );
+      redTable.mapIndices( redIndices.data() );
+      greenTable.mapIndices( greenIndices.data() );
+      blueTable.mapIndices( blueIndices.data() );
+
+      for ( qgssize i = 0; i < count; i++ )
+      {
+        const int red = redIndices[i];
+        const int green = greenIndices[i];
+        const int blue = blueIndices[i];
+        if ( red < 0 || green < 0 || blue < 0 || !displayable[ static_cast< std::size_t >( red ) ] )
+        {
+          outputBlockColorData[i] = myDefaultColor;
+          continue;
+        }
+
+        outputBlockColorData[i] = qRgba( redValues[ static_cast< std::size_t >( red ) ],
+                                         greenValues[ static_cast< std::size_t >( green ) ],
+                                         blueValues[ static_cast< std::size_t >( blue ) ], 255 );
+      }
+    }
+  }
+
+  for ( qgssize i = 0; i < count && !lookupDraw; i++ )
   {
     if ( fastDraw ) //fast rendering if no transparency, stretching, color inversion, etc.
     {
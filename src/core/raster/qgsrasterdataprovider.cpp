@@ -30,6 +30,8 @@
 #include <QByteArray>
 #include <QVariant>
 
+#include <algorithm>
+
 #define ERR(message) QgsError(message, "Raster provider")
 
 void QgsRasterDataProvider::setUseSourceNoDataValue( int bandNo, bool use )
@@ -392,20 +394,9 @@ void QgsRasterDataProvider::setUserNoDataValue( int bandNo, const QgsRasterRange
 
   if ( mUserNoDataValue[bandNo - 1] != noData )
   {
-    // Clear statistics
-    int i = 0;
-    while ( i < mStatistics.size() )
-    {
-      if ( mStatistics.value( i ).bandNumber == bandNo )
-      {
-        mStatistics.removeAt( i );
-        mHistograms.removeAt( i );
-      }
-      else
-      {
-        i++;
-      }
-    }
+    // Clear statistics and histograms, which are not necessarily cached together
+    mStatistics.erase( std::remove_if( mStatistics.begin(), mStatistics.end(), [bandNo]( const QgsRasterBandStats & stats ) { return stats.bandNumber == bandNo; } ), mStatistics.end() );
+    mHistograms.erase( std::remove_if( mHistograms.begin(), mHistograms.end(), [bandNo]( const QgsRasterHistogram & histogram ) { return histogram.bandNumber == bandNo; } ), mHistograms.end() );
     mUserNoDataValue[bandNo - 1] = noData;
   }
 }
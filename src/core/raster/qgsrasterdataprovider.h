@@ -104,6 +104,7 @@ class CORE_EXPORT QgsRasterDataProvider : public QgsDataProvider, public QgsRast
       ProviderHintCanPerformProviderResampling = 1 << 4, //!< Provider can perform resampling (to be opposed to post rendering resampling) (since QGIS 3.16)
       ReloadData = 1 << 5, //!< Is able to force reload data / clear local caches. Since QGIS 3.18, see QgsDataProvider::reloadProviderData()
       DpiDependentData = 1 << 6, //! Provider's rendering is dependent on requested pixel size of the viewport (since QGIS 3.20)
+      ProviderHintConcurrentReading = 1 << 7, //!< Blocks are cheap to read concurrently from clones of the provider, such as from local files, so layers are rendered in parallel strips (since QGIS 3.20)
     };
 
     //! Provider capabilities
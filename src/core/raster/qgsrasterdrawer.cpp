@@ -20,15 +20,110 @@
 #include "qgsrasterdrawer.h"
 #include "qgsrasterinterface.h"
 #include "qgsrasteriterator.h"
+#include "qgsrasterprojector.h"
 #include "qgsrasterviewport.h"
 #include "qgsmaptopixel.h"
 #include "qgsrendercontext.h"
 #include <QImage>
+#include <QMutex>
 #include <QPainter>
+#include <QThreadPool>
+#include <QWaitCondition>
+#include <QtConcurrentRun>
 #ifndef QT_NO_PRINTER
 #include <QPrinter>
 #endif
 
+#include <deque>
+
+///@cond PRIVATE
+
+//! Number of tiles rendered ahead of the painted one by each thread
+constexpr int PARALLEL_RENDER_TILES_PER_THREAD = 2;
+
+//! Position and extent of a tile of the raster iterator
+struct QgsRasterDrawerTile
+{
+  int columns = 0;
+  int rows = 0;
+  int topLeftColumn = 0;
+  int topLeftRow = 0;
+  QgsRectangle extent;
+};
+
+//! Clone of the iterated raster interfaces, used by one thread at a time
+struct QgsRasterDrawerPipe
+{
+  std::vector< std::unique_ptr< QgsRasterInterface > > interfaces;
+  QgsRasterInterface *output = nullptr;
+  std::unique_ptr< QgsRasterBlockFeedback > feedback;
+};
+
+//! Clones \a output and all of its inputs, or returns NULLPTR if any of them cannot be cloned
+static std::unique_ptr< QgsRasterDrawerPipe > cloneRasterPipe( const QgsRasterInterface *output, QgsRasterBlockFeedback *feedback )
+{
+  std::vector< const QgsRasterInterface * > interfaces;
+  for ( const QgsRasterInterface *interface = output; interface; interface = interface->input() )
+    interfaces.insert( interfaces.begin(), interface );
+
+  std::unique_ptr< QgsRasterDrawerPipe > pipe = std::make_unique< QgsRasterDrawerPipe >();
+  for ( const QgsRasterInterface *interface : interfaces )
+  {
+    std::unique_ptr< QgsRasterInterface > clone( interface->clone() );
+    if ( !clone || ( pipe->output && !clone->setInput( pipe->output ) ) )
+      return nullptr;
+
+    // the tiles are already rendered on all cores, so don't let the warp kernel spawn threads of its own
+    if ( QgsRasterProjector *projector = dynamic_cast< QgsRasterProjector * >( clone.get() ) )
+      projector->setWarpThreadCount( 1 );
+
+    pipe->output = clone.get();
+    pipe->interfaces.emplace_back( std::move( clone ) );
+  }
+  if ( !pipe->output )
+    return nullptr;
+
+  pipe->feedback = std::make_unique< QgsRasterBlockFeedback >();
+  if ( feedback )
+  {
+    // providers check these flags on the feedback they are given
+    pipe->feedback->setPreviewOnly( feedback->isPreviewOnly() );
+    pipe->feedback->setRenderPartialOutput( feedback->renderPartialOutput() );
+    QObject::connect( feedback, &QgsFeedback::canceled, pipe->feedback.get(), &QgsFeedback::cancel, Qt::DirectConnection );
+  }
+  return pipe;
+}
+
+//! Converts the rendered \a block to the image painted on the output device
+static QImage rasterBlockImage( const QgsRasterBlock *block, bool pdfOutput )
+{
+  QImage img = block->image();
+
+  // Because of bug in Acrobat Reader we must use "white" transparent color instead
+  // of "black" for PDF. See #9101.
+  if ( pdfOutput )
+  {
+    QgsDebugMsgLevel( QStringLiteral( "PdfFormat" ), 4 );
+
+    img = img.convertToFormat( QImage::Format_ARGB32 );
+    QRgb transparentBlack = qRgba( 0, 0, 0, 0 );
+    QRgb transparentWhite = qRgba( 255, 255, 255, 0 );
+    for ( int x = 0; x < img.width(); x++ )
+    {
+      for ( int y = 0; y < img.height(); y++ )
+      {
+        if ( img.pixel( x, y ) == transparentBlack )
+        {
+          img.setPixel( x, y, transparentWhite );
+        }
+      }
+    }
+  }
+  return img;
+}
+
+///@endcond
+
 QgsRasterDrawer::QgsRasterDrawer( QgsRasterIterator *iterator, double dpiTarget )
   : mIterator( iterator )
   , mDpiTarget( dpiTarget )
@@ -47,6 +142,43 @@ void QgsRasterDrawer::draw( QPainter *p, QgsRasterViewPort *viewPort, const QgsM
   int bandNumber = 1;
   mIterator->startRasterRead( bandNumber, viewPort->mWidth, viewPort->mHeight, viewPort->mDrawnExtent, feedback );
 
+  bool pdfOutput = false;
+#ifndef QT_NO_PRINTER
+  QPrinter *printer = dynamic_cast<QPrinter *>( p->device() );
+  pdfOutput = printer && printer->outputFormat() == QPrinter::PdfFormat;
+#endif
+
+  if ( mParallelRendering && ( !feedback || !feedback->isPreviewOnly() ) )
+  {
+    std::vector< QgsRasterDrawerTile > tiles;
+    QgsRasterDrawerTile tile;
+    while ( mIterator->next( bandNumber, tile.columns, tile.rows, tile.topLeftColumn, tile.topLeftRow, tile.extent ) )
+      tiles.push_back( tile );
+
+    const int threadCount = std::min( QThreadPool::globalInstance()->maxThreadCount(), static_cast< int >( tiles.size() ) );
+    if ( threadCount > 1 )
+    {
+      // the clones are created on this thread, and handed to one rendering task at a time
+      std::vector< std::unique_ptr< QgsRasterDrawerPipe > > pipes;
+      for ( int i = 0; i < threadCount; ++i )
+      {
+        std::unique_ptr< QgsRasterDrawerPipe > pipe = cloneRasterPipe( mIterator->input(), feedback );
+        if ( !pipe )
+          break;
+        pipes.emplace_back( std::move( pipe ) );
+      }
+
+      if ( pipes.size() > 1 )
+      {
+        drawParallel( p, viewPort, qgsMapToPixel, feedback, tiles, pipes, pdfOutput );
+        return;
+      }
+    }
+
+    QgsDebugMsgLevel( QStringLiteral( "Rendering raster tiles sequentially" ), 4 );
+    mIterator->startRasterRead( bandNumber, viewPort->mWidth, viewPort->mHeight, viewPort->mDrawnExtent, feedback );
+  }
+
   //number of cols/rows in output pixels
   int nCols = 0;
   int nRows = 0;
@@ -68,52 +200,106 @@ void QgsRasterDrawer::draw( QPainter *p, QgsRasterViewPort *viewPort, const QgsM
       continue;
     }
 
-    QImage img = block->image();
+    paintImage( p, viewPort, rasterBlockImage( block.get(), pdfOutput ), topLeftCol, topLeftRow, qgsMapToPixel, feedback );
 
-#ifndef QT_NO_PRINTER
-    // Because of bug in Acrobat Reader we must use "white" transparent color instead
-    // of "black" for PDF. See #9101.
-    QPrinter *printer = dynamic_cast<QPrinter *>( p->device() );
-    if ( printer && printer->outputFormat() == QPrinter::PdfFormat )
-    {
-      QgsDebugMsgLevel( QStringLiteral( "PdfFormat" ), 4 );
+    // OK this does not matter much anyway as the tile size quite big so most of the time
+    // there would be just one tile for the whole display area, but it won't hurt...
+    if ( feedback && feedback->isCanceled() )
+      break;
+  }
+}
 
-      img = img.convertToFormat( QImage::Format_ARGB32 );
-      QRgb transparentBlack = qRgba( 0, 0, 0, 0 );
-      QRgb transparentWhite = qRgba( 255, 255, 255, 0 );
-      for ( int x = 0; x < img.width(); x++ )
-      {
-        for ( int y = 0; y < img.height(); y++ )
-        {
-          if ( img.pixel( x, y ) == transparentBlack )
-          {
-            img.setPixel( x, y, transparentWhite );
-          }
-        }
-      }
-    }
-#endif
+void QgsRasterDrawer::drawParallel( QPainter *p, QgsRasterViewPort *viewPort, const QgsMapToPixel *qgsMapToPixel, QgsRasterBlockFeedback *feedback,
+                                    const std::vector< QgsRasterDrawerTile > &tiles, std::vector< std::unique_ptr< QgsRasterDrawerPipe > > &pipes, bool pdfOutput )
+{
+  QMutex pipesMutex;
+  QWaitCondition pipeReleased;
+  std::vector< QgsRasterDrawerPipe * > idlePipes;
+  for ( const std::unique_ptr< QgsRasterDrawerPipe > &pipe : pipes )
+    idlePipes.push_back( pipe.get() );
 
-    if ( feedback && feedback->renderPartialOutput() )
+  auto renderTile = [feedback, pdfOutput, &pipesMutex, &pipeReleased, &idlePipes]( const QgsRasterDrawerTile & tile ) -> QImage
+  {
+    if ( feedback && feedback->isCanceled() )
+      return QImage();
+
+    QgsRasterDrawerPipe *pipe = nullptr;
     {
-      // there could have been partial preview written before
-      // so overwrite anything with the resulting image.
-      // (we are guaranteed to have a temporary image for this layer, see QgsMapRendererJob::needTemporaryImage)
-      p->setCompositionMode( QPainter::CompositionMode_Source );
+      // a waiting thread may run a queued task itself, so there can be more tasks than pipes
+      QMutexLocker locker( &pipesMutex );
+      while ( idlePipes.empty() )
+        pipeReleased.wait( &pipesMutex );
+      pipe = idlePipes.back();
+      idlePipes.pop_back();
     }
 
-    drawImage( p, viewPort, img, topLeftCol, topLeftRow, qgsMapToPixel );
+    std::unique_ptr< QgsRasterBlock > block( pipe->output->block( 1, tile.extent, tile.columns, tile.rows, pipe->feedback.get() ) );
+    QImage image;
+    if ( block )
+      image = rasterBlockImage( block.get(), pdfOutput );
+    else
+      QgsDebugMsg( QStringLiteral( "Cannot get block" ) );
+
+    {
+      QMutexLocker locker( &pipesMutex );
+      idlePipes.push_back( pipe );
+    }
+    pipeReleased.wakeOne();
+    return image;
+  };
 
-    if ( feedback && feedback->renderPartialOutput() )
+  // tiles are rendered ahead of the painted one, so that reads and rendering overlap with painting
+  const std::size_t window = pipes.size() * PARALLEL_RENDER_TILES_PER_THREAD;
+  std::deque< QFuture< QImage > > pending;
+  std::size_t nextTile = 0;
+  for ( std::size_t i = 0; i < tiles.size(); ++i )
+  {
+    while ( nextTile < tiles.size() && nextTile < i + window )
     {
-      // go back to the default composition mode
-      p->setCompositionMode( QPainter::CompositionMode_SourceOver );
+      const QgsRasterDrawerTile &tile = tiles[ nextTile ];
+      pending.push_back( QtConcurrent::run( [renderTile, tile] { return renderTile( tile ); } ) );
+      ++nextTile;
     }
 
-    // OK this does not matter much anyway as the tile size quite big so most of the time
-    // there would be just one tile for the whole display area, but it won't hurt...
+    const QImage image = pending.front().result();
+    pending.pop_front();
     if ( feedback && feedback->isCanceled() )
       break;
+
+    if ( !image.isNull() )
+      paintImage( p, viewPort, image, tiles[i].topLeftColumn, tiles[i].topLeftRow, qgsMapToPixel, feedback );
+  }
+
+  for ( QFuture< QImage > &future : pending )
+    future.waitForFinished();
+
+  if ( feedback )
+  {
+    for ( const std::unique_ptr< QgsRasterDrawerPipe > &pipe : pipes )
+    {
+      const QStringList errors = pipe->feedback->errors();
+      for ( const QString &error : errors )
+        feedback->appendError( error );
+    }
+  }
+}
+
+void QgsRasterDrawer::paintImage( QPainter *p, QgsRasterViewPort *viewPort, const QImage &img, int topLeftCol, int topLeftRow, const QgsMapToPixel *qgsMapToPixel, QgsRasterBlockFeedback *feedback ) const
+{
+  if ( feedback && feedback->renderPartialOutput() )
+  {
+    // there could have been partial preview written before
+    // so overwrite anything with the resulting image.
+    // (we are guaranteed to have a temporary image for this layer, see QgsMapRendererJob::needTemporaryImage)
+    p->setCompositionMode( QPainter::CompositionMode_Source );
+  }
+
+  drawImage( p, viewPort, img, topLeftCol, topLeftRow, qgsMapToPixel );
+
+  if ( feedback && feedback->renderPartialOutput() )
+  {
+    // go back to the default composition mode
+    p->setCompositionMode( QPainter::CompositionMode_SourceOver );
   }
 }
 
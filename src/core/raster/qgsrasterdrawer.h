@@ -22,6 +22,9 @@
 #include "qgis_sip.h"
 #include <QMap>
 
+#include <memory>
+#include <vector>
+
 class QPainter;
 class QImage;
 class QgsMapToPixel;
@@ -29,6 +32,8 @@ class QgsRenderContext;
 struct QgsRasterViewPort;
 class QgsRasterBlockFeedback;
 class QgsRasterIterator;
+struct QgsRasterDrawerTile;
+struct QgsRasterDrawerPipe;
 
 /**
  * \ingroup core
@@ -54,6 +59,26 @@ class CORE_EXPORT QgsRasterDrawer
      */
     void draw( QPainter *p, QgsRasterViewPort *viewPort, const QgsMapToPixel *qgsMapToPixel, QgsRasterBlockFeedback *feedback = nullptr );
 
+    /**
+     * Sets whether the tiles of the iterator are fetched and rendered concurrently.
+     *
+     * Each thread renders tiles through its own clone of the iterated interfaces, so
+     * providers need not be thread safe. Tiles are still painted in order on the calling
+     * thread, and preview requests are always rendered sequentially.
+     *
+     * \see parallelRendering()
+     * \since QGIS 3.20
+     */
+    void setParallelRendering( bool enabled ) { mParallelRendering = enabled; }
+
+    /**
+     * Returns TRUE if the tiles of the iterator are fetched and rendered concurrently.
+     *
+     * \see setParallelRendering()
+     * \since QGIS 3.20
+     */
+    bool parallelRendering() const { return mParallelRendering; }
+
   protected:
 
     /**
@@ -69,8 +94,17 @@ class CORE_EXPORT QgsRasterDrawer
     void drawImage( QPainter *p, QgsRasterViewPort *viewPort, const QImage &img, int topLeftCol, int topLeftRow, const QgsMapToPixel *mapToPixel = nullptr ) const SIP_SKIP;
 
   private:
+
+    //! Renders \a tiles concurrently on the cloned \a pipes, and paints them in order
+    void drawParallel( QPainter *p, QgsRasterViewPort *viewPort, const QgsMapToPixel *qgsMapToPixel, QgsRasterBlockFeedback *feedback,
+                       const std::vector< QgsRasterDrawerTile > &tiles, std::vector< std::unique_ptr< QgsRasterDrawerPipe > > &pipes, bool pdfOutput );
+
+    //! Paints a rendered tile, replacing any partial preview
+    void paintImage( QPainter *p, QgsRasterViewPort *viewPort, const QImage &img, int topLeftCol, int topLeftRow, const QgsMapToPixel *qgsMapToPixel, QgsRasterBlockFeedback *feedback ) const;
+
     QgsRasterIterator *mIterator = nullptr;
     double mDpiTarget = -1.0;
+    bool mParallelRendering = false;
 };
 
 #endif // QGSRASTERDRAWER_H
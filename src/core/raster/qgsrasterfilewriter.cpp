@@ -32,6 +32,7 @@
 #include <QMessageBox>
 #include <QRegularExpression>
 
+#include <algorithm>
 #include <cmath>
 
 #include <gdal.h>
@@ -91,6 +92,14 @@ QgsRasterFileWriter::WriterError QgsRasterFileWriter::writeRaster( const QgsRast
   {
     return SourceProviderError;
   }
+
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3,1,0)
+  if ( mOutputProviderKey == QLatin1String( "gdal" ) && mOutputFormat.compare( QLatin1String( "COG" ), Qt::CaseInsensitive ) == 0 )
+  {
+    return writeCloudOptimizedGeoTiff( pipe, nCols, nRows, outputExtent, crs, transformContext, feedback );
+  }
+#endif
+
   mPipe = pipe;
 
   //const QgsRasterInterface* iface = iter->input();
@@ -161,6 +170,97 @@ QgsRasterFileWriter::WriterError QgsRasterFileWriter::writeRaster( const QgsRast
   }
 }
 
+#if GDAL_VERSION_NUM >= GDAL_COMPUTE_VERSION(3,1,0)
+///@cond PRIVATE
+static int CPL_STDCALL cogCopyProgress( double complete, const char *, void *data )
+{
+  QgsRasterBlockFeedback *feedback = static_cast< QgsRasterBlockFeedback * >( data );
+  if ( !feedback )
+    return TRUE;
+  // the second half of the progress, after writing the temporary GeoTIFF
+  feedback->setProgress( 50.0 + 50.0 * complete );
+  return !feedback->isCanceled();
+}
+///@endcond
+
+QgsRasterFileWriter::WriterError QgsRasterFileWriter::writeCloudOptimizedGeoTiff( const QgsRasterPipe *pipe, int nCols, int nRows, const QgsRectangle &outputExtent,
+    const QgsCoordinateReferenceSystem &crs, const QgsCoordinateTransformContext &transformContext, QgsRasterBlockFeedback *feedback )
+{
+  GDALDriverH cogDriver = GDALGetDriverByName( "COG" );
+  GDALDriverH tiffDriver = GDALGetDriverByName( "GTiff" );
+  if ( !cogDriver || !tiffDriver )
+  {
+    QgsDebugMsg( QStringLiteral( "COG driver not available" ) );
+    return CreateDatasourceError;
+  }
+
+  // The COG driver can only copy complete datasets: the pipe is written to a tiled GeoTIFF first,
+  // whose internal overviews are reused by the copy
+  const QString outputUrl = mOutputUrl;
+  const QString outputFormat = mOutputFormat;
+  const QStringList createOptions = mCreateOptions;
+  const bool tiledMode = mTiledMode;
+  const QgsRaster::RasterPyramidsFormat pyramidsFormat = mPyramidsFormat;
+  const QString tempUrl = outputUrl + QStringLiteral( ".tmp.tif" );
+
+  mOutputUrl = tempUrl;
+  mOutputFormat = QStringLiteral( "GTiff" );
+  mCreateOptions = QStringList() << QStringLiteral( "TILED=YES" ) << QStringLiteral( "BIGTIFF=IF_SAFER" );
+  mTiledMode = false;
+  mPyramidsFormat = QgsRaster::PyramidsInternal;
+
+  // the first half of the progress is spent writing the temporary GeoTIFF
+  std::unique_ptr< QgsRasterBlockFeedback > writeFeedback;
+  if ( feedback )
+  {
+    writeFeedback = std::make_unique< QgsRasterBlockFeedback >();
+    QObject::connect( writeFeedback.get(), &QgsFeedback::progressChanged, feedback, [feedback]( double progress ) { feedback->setProgress( progress / 2 ); } );
+    // canceled may be emitted from another thread, while this thread has no event loop
+    QObject::connect( feedback, &QgsFeedback::canceled, writeFeedback.get(), &QgsFeedback::cancel, Qt::DirectConnection );
+  }
+
+  WriterError error = writeRaster( pipe, nCols, nRows, outputExtent, crs, transformContext, writeFeedback.get() );
+
+  mOutputUrl = outputUrl;
+  mOutputFormat = outputFormat;
+  mCreateOptions = createOptions;
+  mTiledMode = tiledMode;
+  mPyramidsFormat = pyramidsFormat;
+
+  if ( error == NoError )
+  {
+    gdal::dataset_unique_ptr tempDS( GDALOpen( tempUrl.toUtf8().constData(), GA_ReadOnly ) );
+    if ( !tempDS )
+    {
+      error = DestProviderError;
+    }
+    else
+    {
+      QStringList options = mCreateOptions;
+      const bool hasThreadOption = std::any_of( options.constBegin(), options.constEnd(), []( const QString & option )
+      {
+        return option.startsWith( QLatin1String( "NUM_THREADS=" ), Qt::CaseInsensitive );
+      } );
+      if ( !hasThreadOption )
+        options << QStringLiteral( "NUM_THREADS=ALL_CPUS" );
+
+      char **papszOptions = QgsGdalUtils::papszFromStringList( options );
+      gdal::dataset_unique_ptr cogDS( GDALCreateCopy( cogDriver, outputUrl.toUtf8().constData(), tempDS.get(), FALSE, papszOptions, cogCopyProgress, feedback ) );
+      CSLDestroy( papszOptions );
+      if ( !cogDS )
+      {
+        QgsDebugMsg( QStringLiteral( "Cannot copy to COG: %1" ).arg( CPLGetLastErrorMsg() ) );
+        error = ( feedback && feedback->isCanceled() ) ? WriteCanceled : WriteError;
+      }
+    }
+  }
+
+  if ( QFile::exists( tempUrl ) )
+    GDALDeleteDataset( tiffDriver, tempUrl.toUtf8().constData() );
+  return error;
+}
+#endif
+
 QgsRasterFileWriter::WriterError QgsRasterFileWriter::writeDataRaster( const QgsRasterPipe *pipe, QgsRasterIterator *iter, int nCols, int nRows, const QgsRectangle &outputExtent,
     const QgsCoordinateReferenceSystem &crs, const QgsCoordinateTransformContext &transformContext, QgsRasterBlockFeedback *feedback )
 {
@@ -1158,7 +1258,8 @@ QList< QgsRasterFileWriter::FilterFormatDetails > QgsRasterFileWriter::supported
     GDALDriverH drv = GDALGetDriver( i );
     if ( drv )
     {
-      if ( QgsGdalUtils::supportsRasterCreate( drv ) )
+      // COG datasets are written through a temporary GeoTIFF, see writeCloudOptimizedGeoTiff()
+      if ( QgsGdalUtils::supportsRasterCreate( drv ) || QLatin1String( GDALGetDriverShortName( drv ) ) == QLatin1String( "COG" ) )
       {
         QString drvName = GDALGetDriverShortName( drv );
         QString filterString = filterForDriver( drvName );
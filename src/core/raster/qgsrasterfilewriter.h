@@ -117,6 +117,12 @@ class CORE_EXPORT QgsRasterFileWriter
      * \param crs crs to reproject to
      * \param transformContext coordinate transform context
      * \param feedback optional feedback object for progress reports
+     *
+     * If the output format is "COG", the raster is written as a Cloud Optimized GeoTIFF
+     * with internal overviews. The pipe is written to a temporary tiled GeoTIFF next to the output,
+     * which is then copied with the create options. The tiled mode is ignored for this format.
+     * Writing COG requires GDAL 3.1 or later.
+     *
      * \since QGIS 3.8
     */
     WriterError writeRaster( const QgsRasterPipe *pipe, int nCols, int nRows, const QgsRectangle &outputExtent,
@@ -249,6 +255,14 @@ class CORE_EXPORT QgsRasterFileWriter
                                   const QgsCoordinateReferenceSystem &crs,
                                   QgsRasterBlockFeedback *feedback = nullptr );
 
+    /**
+     * Writes a temporary GeoTIFF with internal overviews and copies it as a Cloud Optimized GeoTIFF.
+     * Only available with GDAL 3.1 or later, which added the COG driver.
+     */
+    WriterError writeCloudOptimizedGeoTiff( const QgsRasterPipe *pipe, int nCols, int nRows, const QgsRectangle &outputExtent,
+                                            const QgsCoordinateReferenceSystem &crs, const QgsCoordinateTransformContext &transformContext,
+                                            QgsRasterBlockFeedback *feedback = nullptr );
+
     /**
      * \brief Initialize vrt member variables
      *  \param xSize width of vrt
@@ -26,6 +26,7 @@
 #include "qgsrasterbandstats.h"
 #include "qgsrasterhistogram.h"
 #include "qgsrasterinterface.h"
+#include "qgsrasterstatisticsaccumulator.h"
 #include "qgsrectangle.h"
 
 QgsRasterInterface::QgsRasterInterface( QgsRasterInterface *input )
@@ -159,12 +160,21 @@ QgsRasterBandStats QgsRasterInterface::bandStatistics( int bandNo,
   double myYRes = myExtent.height() / myHeight;
   // TODO: progress signals
 
-  // used by single pass stdev
-  double myMean = 0;
-  double mySumOfSquares = 0;
+  QgsRasterStatisticsAccumulator accumulator;
+
+  // The default histogram of byte sources does not depend on the statistics, so it is
+  // collected in the same pass (typically it is requested right after the statistics)
+  QgsRasterHistogram byteHistogram;
+  bool collectHistogram = false;
+  if ( !mInput && sourceDataType( bandNo ) == Qgis::DataType::Byte )
+  {
+    initHistogram( byteHistogram, bandNo, 0, std::numeric_limits<double>::quiet_NaN(), std::numeric_limits<double>::quiet_NaN(), extent, sampleSize, false );
+    collectHistogram = byteHistogram.extent == myExtent && byteHistogram.width == myWidth && byteHistogram.height == myHeight
+                       && !mHistograms.contains( byteHistogram );
+    if ( collectHistogram )
+      accumulator.setHistogram( byteHistogram.minimum, byteHistogram.maximum, byteHistogram.binCount );
+  }
 
-  bool myFirstIterationFlag = true;
-  bool isNoData = false;
   for ( int myYBlock = 0; myYBlock < myNYBlocks; myYBlock++ )
   {
     for ( int myXBlock = 0; myXBlock < myNXBlocks; myXBlock++ )
@@ -185,53 +195,18 @@ QgsRasterBandStats QgsRasterInterface::bandStatistics( int bandNo,
 
       std::unique_ptr< QgsRasterBlock > blk( block( bandNo, myPartExtent, myBlockWidth, myBlockHeight, feedback ) );
 
-      // Collect the histogram counts.
-      for ( qgssize i = 0; i < ( static_cast< qgssize >( myBlockHeight ) ) * myBlockWidth; i++ )
-      {
-        double myValue = blk->valueAndNoData( i, isNoData );
-        if ( isNoData )
-          continue; // NULL
-
-        myRasterBandStats.sum += myValue;
-        myRasterBandStats.elementCount++;
-
-        if ( !std::isfinite( myValue ) ) continue; // inf
-
-        if ( myFirstIterationFlag )
-        {
-          myFirstIterationFlag = false;
-          myRasterBandStats.minimumValue = myValue;
-          myRasterBandStats.maximumValue = myValue;
-        }
-        else
-        {
-          if ( myValue < myRasterBandStats.minimumValue )
-          {
-            myRasterBandStats.minimumValue = myValue;
-          }
-          if ( myValue > myRasterBandStats.maximumValue )
-          {
-            myRasterBandStats.maximumValue = myValue;
-          }
-        }
-
-        // Single pass stdev
-        double myDelta = myValue - myMean;
-        myMean += myDelta / myRasterBandStats.elementCount;
-        mySumOfSquares += myDelta * ( myValue - myMean );
-      }
+      // Reading blocks is left to the calling thread, the values are reduced concurrently
+      accumulator.addBlock( blk.get() );
     }
   }
 
-  myRasterBandStats.range = myRasterBandStats.maximumValue - myRasterBandStats.minimumValue;
-  myRasterBandStats.mean = myRasterBandStats.sum / myRasterBandStats.elementCount;
+  accumulator.updateStatistics( myRasterBandStats );
 
-  myRasterBandStats.sumOfSquares = mySumOfSquares; // OK with single pass?
-
-  // stdDev may differ  from GDAL stats, because GDAL is using naive single pass
-  // algorithm which is more error prone (because of rounding errors)
-  // Divide result by sample size - 1 and get square root to get stdev
-  myRasterBandStats.stdDev = std::sqrt( mySumOfSquares / ( myRasterBandStats.elementCount - 1 ) );
+  if ( collectHistogram )
+  {
+    accumulator.updateHistogram( byteHistogram );
+    mHistograms.append( byteHistogram );
+  }
 
   QgsDebugMsgLevel( QStringLiteral( "************ STATS **************" ), 4 );
   QgsDebugMsgLevel( QStringLiteral( "MIN %1" ).arg( myRasterBandStats.minimumValue ), 4 );
@@ -240,7 +215,6 @@ QgsRasterBandStats QgsRasterInterface::bandStatistics( int bandNo,
   QgsDebugMsgLevel( QStringLiteral( "MEAN %1" ).arg( myRasterBandStats.mean ), 4 );
   QgsDebugMsgLevel( QStringLiteral( "STDDEV %1" ).arg( myRasterBandStats.stdDev ), 4 );
 
-  myRasterBandStats.statsGathered = QgsRasterBandStats::All;
   mStatistics.append( myRasterBandStats );
 
   return myRasterBandStats;
@@ -447,21 +421,26 @@ QgsRasterHistogram QgsRasterInterface::histogram( int bandNo,
   double myXRes = myExtent.width() / myWidth;
   double myYRes = myExtent.height() / myHeight;
 
-  double myMinimum = myHistogram.minimum;
-  double myMaximum = myHistogram.maximum;
+  QgsRasterStatisticsAccumulator accumulator;
+  accumulator.setHistogram( myHistogram.minimum, myHistogram.maximum, myBinCount, includeOutOfRange );
 
-  // To avoid rounding errors
-  // TODO: check this
-  double myerval = ( myMaximum - myMinimum ) / myHistogram.binCount;
-  myMinimum -= 0.1 * myerval;
-  myMaximum += 0.1 * myerval;
-
-  QgsDebugMsgLevel( QStringLiteral( "binCount = %1 myMinimum = %2 myMaximum = %3" ).arg( myHistogram.binCount ).arg( myMinimum ).arg( myMaximum ), 4 );
-
-  double myBinSize = ( myMaximum - myMinimum ) / myBinCount;
+  // The statistics come for free with the histogram, cache them if they cover the same cells
+  QgsRasterBandStats myRasterBandStats;
+  initStatistics( myRasterBandStats, bandNo, QgsRasterBandStats::All, extent, sampleSize );
+  bool collectStatistics = myRasterBandStats.extent == myExtent && myRasterBandStats.width == myWidth && myRasterBandStats.height == myHeight;
+  if ( collectStatistics )
+  {
+    for ( const QgsRasterBandStats &stats : std::as_const( mStatistics ) )
+    {
+      if ( stats.contains( myRasterBandStats ) )
+      {
+        collectStatistics = false;
+        break;
+      }
+    }
+  }
 
   // TODO: progress signals
-  bool isNoData = false;
   for ( int myYBlock = 0; myYBlock < myNYBlocks; myYBlock++ )
   {
     for ( int myXBlock = 0; myXBlock < myNXBlocks; myXBlock++ )
@@ -482,30 +461,18 @@ QgsRasterHistogram QgsRasterInterface::histogram( int bandNo,
       std::unique_ptr< QgsRasterBlock > blk( block( bandNo, myPartExtent, myBlockWidth, myBlockHeight, feedback ) );
 
       // Collect the histogram counts.
-      for ( qgssize i = 0; i < ( static_cast< qgssize >( myBlockHeight ) ) * myBlockWidth; i++ )
-      {
-        double myValue = blk->valueAndNoData( i, isNoData );
-        if ( isNoData )
-        {
-          continue; // NULL
-        }
-
-        int myBinIndex = static_cast <int>( std::floor( ( myValue - myMinimum ) /  myBinSize ) );
-
-        if ( ( myBinIndex < 0 || myBinIndex > ( myBinCount - 1 ) ) && !includeOutOfRange )
-        {
-          continue;
-        }
-        if ( myBinIndex < 0 ) myBinIndex = 0;
-        if ( myBinIndex > ( myBinCount - 1 ) ) myBinIndex = myBinCount - 1;
-
-        myHistogram.histogramVector[myBinIndex] += 1;
-        myHistogram.nonNullCount++;
-      }
+      accumulator.addBlock( blk.get() );
     }
   }
 
-  myHistogram.valid = true;
+  accumulator.updateHistogram( myHistogram );
+
+  if ( collectStatistics )
+  {
+    accumulator.updateStatistics( myRasterBandStats );
+    mStatistics.append( myRasterBandStats );
+  }
+
   mHistograms.append( myHistogram );
 
 #ifdef QGISDEBUG
@@ -21,6 +21,7 @@
 #include "qgsrasteriterator.h"
 #include "qgsrasterlayer.h"
 #include "qgsrasterprojector.h"
+#include "qgsrasterrenderer.h"
 #include "qgsrendercontext.h"
 #include "qgsproject.h"
 #include "qgsexception.h"
@@ -29,6 +30,37 @@
 
 #include <QElapsedTimer>
 #include <QPointer>
+#include <QThreadPool>
+
+//! Minimum height of the row strips rendered concurrently
+constexpr int PARALLEL_RENDER_MIN_TILE_ROWS = 256;
+
+/**
+ * Returns TRUE if the view port renders \a provider at a finer resolution than the source.
+ *
+ * The warp kernel only sees the source cells read at about the rendered resolution, so zoomed
+ * out an averaging resampling method would average already decimated cells. Zoomed out the
+ * resampling is left to the provider, which reads the source at its native or overview resolution.
+ */
+static bool isZoomedIn( const QgsRasterDataProvider *provider, const QgsRasterViewPort *viewPort )
+{
+  if ( !( provider->capabilities() & QgsRasterInterface::Size ) || provider->xSize() <= 0 || viewPort->mWidth == 0 )
+    return false;
+
+  try
+  {
+    QgsCoordinateTransform ct( viewPort->mSrcCRS, viewPort->mDestCRS, viewPort->mTransformContext );
+    ct.setBallparkTransformsAreAppropriate( true );
+    const QgsRectangle sourceExtent = ct.transformBoundingBox( viewPort->mDrawnExtent, QgsCoordinateTransform::ReverseTransform );
+    const double sourceResolution = provider->extent().width() / provider->xSize();
+    const double renderedResolution = sourceExtent.width() / viewPort->mWidth;
+    return renderedResolution < sourceResolution;
+  }
+  catch ( QgsCsException & )
+  {
+    return false;
+  }
+}
 
 ///@cond PRIVATE
 
@@ -73,6 +105,8 @@ QgsRasterLayerRenderer::QgsRasterLayerRenderer( QgsRasterLayer *layer, QgsRender
   , mFeedback( new QgsRasterLayerRendererFeedback( this ) )
 {
   mReadyToCompose = false;
+
+  mParallelRendering = layer->dataProvider()->providerCapabilities().testFlag( QgsRasterDataProvider::ProviderHintConcurrentReading );
   QgsMapToPixel mapToPixel = rendererContext.mapToPixel();
   if ( rendererContext.mapToPixel().mapRotation() )
   {
@@ -317,15 +351,32 @@ bool QgsRasterLayerRenderer::render()
   QgsRasterProjector *projector = mPipe->projector();
   bool restoreOldResamplingStage = false;
   QgsRasterPipe::ResamplingStage oldResamplingState = mPipe->resamplingStage();
+  bool restoreProviderResampling = false;
+  const QgsRasterProjector::Precision oldPrecision = projector ? projector->precision() : QgsRasterProjector::Approximate;
 
   // TODO add a method to interface to get provider and get provider
   // params in QgsRasterProjector
   if ( projector )
   {
+    QgsRasterDataProvider *provider = mPipe->provider();
+    const bool reprojecting = mRasterViewPort->mSrcCRS != mRasterViewPort->mDestCRS;
+    QgsRasterDataProvider::ResamplingMethod warpMethod = QgsRasterDataProvider::ResamplingMethod::Nearest;
+    if ( reprojecting && oldResamplingState == QgsRasterPipe::ResamplingStage::Provider && provider->isProviderResamplingEnabled()
+         && isZoomedIn( provider, mRasterViewPort ) )
+      warpMethod = provider->zoomedInResamplingMethod();
+    if ( warpMethod != QgsRasterDataProvider::ResamplingMethod::Nearest )
+    {
+      // Resample once, in the source space, while reprojecting every cell exactly,
+      // rather than resampling in the provider and then reprojecting with nearest neighbour lookups
+      projector->setPrecision( QgsRasterProjector::Warp );
+      projector->setWarpResamplingMethod( warpMethod );
+      provider->enableProviderResampling( false );
+      restoreProviderResampling = true;
+    }
     // Force provider resampling if reprojection is needed
-    if ( ( mPipe->provider()->providerCapabilities() & QgsRasterDataProvider::ProviderHintCanPerformProviderResampling ) &&
-         mRasterViewPort->mSrcCRS != mRasterViewPort->mDestCRS &&
-         oldResamplingState != QgsRasterPipe::ResamplingStage::Provider )
+    else if ( ( provider->providerCapabilities() & QgsRasterDataProvider::ProviderHintCanPerformProviderResampling ) &&
+              reprojecting &&
+              oldResamplingState != QgsRasterPipe::ResamplingStage::Provider )
     {
       restoreOldResamplingStage = true;
       mPipe->setResamplingStage( QgsRasterPipe::ResamplingStage::Provider );
@@ -336,12 +387,33 @@ bool QgsRasterLayerRenderer::render()
   // Drawer to pipe?
   QgsRasterIterator iterator( mPipe->last() );
   QgsRasterDrawer drawer( &iterator, renderContext()->dpiTarget() );
+
+  // local files are rendered in row strips on all cores
+  if ( mParallelRendering )
+  {
+    drawer.setParallelRendering( true );
+
+    // the hillshade renderer reads neighboring cells, so smaller tiles would show seams
+    const QgsRasterRenderer *rasterRenderer = mPipe->renderer();
+    if ( !rasterRenderer || rasterRenderer->type() != QLatin1String( "hillshade" ) )
+    {
+      const int threadCount = std::max( 1, QThreadPool::globalInstance()->maxThreadCount() );
+      const int stripRows = std::max( PARALLEL_RENDER_MIN_TILE_ROWS, static_cast< int >( std::ceil( static_cast< double >( mRasterViewPort->mHeight ) / threadCount ) ) );
+      iterator.setMaximumTileHeight( std::min( iterator.maximumTileHeight(), stripRows ) );
+    }
+  }
+
   drawer.draw( renderContext()->painter(), mRasterViewPort, &renderContext()->mapToPixel(), mFeedback );
 
   if ( restoreOldResamplingStage )
   {
     mPipe->setResamplingStage( oldResamplingState );
   }
+  if ( restoreProviderResampling )
+  {
+    mPipe->provider()->enableProviderResampling( true );
+    projector->setPrecision( oldPrecision );
+  }
 
   const QStringList errors = mFeedback->errors();
   for ( const QString &error : errors )
@@ -85,6 +85,9 @@ class CORE_EXPORT QgsRasterLayerRenderer : public QgsMapLayerRenderer
 
     QgsRasterDataProvider::Capability mProviderCapabilities;
 
+    //! TRUE if the provider can be read concurrently, so the layer is rendered in parallel strips
+    bool mParallelRendering = false;
+
     //! feedback class for cancellation and preview generation
     QgsRasterLayerRendererFeedback *mFeedback = nullptr;
 
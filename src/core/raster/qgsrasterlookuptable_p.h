@@ -0,0 +1,247 @@
+/***************************************************************************
+    qgsrasterlookuptable_p.h  -  Per value lookup tables for raster renderers
+    -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSRASTERLOOKUPTABLE_P_H
+#define QGSRASTERLOOKUPTABLE_P_H
+
+#define SIP_NO_FILE
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the QGIS API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+
+#include "qgsrasterblock.h"
+
+#include <QColor>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+///@cond PRIVATE
+
+/**
+ * Maps the cells of an integer raster block to the entries of a table covering
+ * the range of values of the block.
+ *
+ * Renderers whose output color only depends on the cell value compute the color of
+ * each entry once, and then copy colors from the table instead of calling shaders and
+ * contrast enhancements for every cell.
+ *
+ * The table is only valid if the block holds integer values, and if their range is
+ * smaller than both MAXIMUM_SIZE and the number of cells of the block, so that filling
+ * the table is never more expensive than computing every cell.
+ */
+class QgsRasterLookupTable
+{
+  public:
+
+    //! Maximum number of entries of a table
+    static constexpr qint64 MAXIMUM_SIZE = 1 << 16;
+
+    /**
+     * Constructor for QgsRasterLookupTable over the values of \a block, which must
+     * exist for the lifetime of the table.
+     */
+    explicit QgsRasterLookupTable( QgsRasterBlock *block )
+      : mBlock( block )
+    {
+      if ( !block || block->isEmpty() )
+        return;
+
+      mCount = static_cast< qgssize >( block->width() ) * block->height();
+      mData = block->bits();
+      mCheckBitmap = !block->hasNoDataValue() && block->hasNoData();
+      const double noDataValue = block->noDataValue();
+      mHasNoDataValue = block->hasNoDataValue() && std::isfinite( noDataValue ) && std::floor( noDataValue ) == noDataValue
+                        && std::fabs( noDataValue ) < static_cast< double >( std::numeric_limits< qint64 >::max() );
+      if ( mHasNoDataValue )
+        mNoDataValue = static_cast< qint64 >( noDataValue );
+
+      switch ( block->dataType() )
+      {
+        case Qgis::DataType::Byte:
+          initialize< quint8 >();
+          break;
+        case Qgis::DataType::UInt16:
+          initialize< quint16 >();
+          break;
+        case Qgis::DataType::Int16:
+          initialize< qint16 >();
+          break;
+        case Qgis::DataType::UInt32:
+          initialize< quint32 >();
+          break;
+        case Qgis::DataType::Int32:
+          initialize< qint32 >();
+          break;
+        default:
+          break;
+      }
+    }
+
+    //! Returns TRUE if the values of the block can be looked up in a table
+    bool isValid() const { return mSize > 0; }
+
+    //! Returns the number of entries of the table
+    int size() const { return static_cast< int >( mSize ); }
+
+    //! Returns the cell value of the entry \a index
+    double value( int index ) const { return static_cast< double >( mMinimum + index ); }
+
+    //! Returns the table entry of the cell \a i, or -1 if the cell is nodata
+    int index( qgssize i ) const
+    {
+      qint64 v = 0;
+      switch ( mBlock->dataType() )
+      {
+        case Qgis::DataType::Byte:
+          v = reinterpret_cast< const quint8 * >( mData )[i];
+          break;
+        case Qgis::DataType::UInt16:
+          v = reinterpret_cast< const quint16 * >( mData )[i];
+          break;
+        case Qgis::DataType::Int16:
+          v = reinterpret_cast< const qint16 * >( mData )[i];
+          break;
+        case Qgis::DataType::UInt32:
+          v = reinterpret_cast< const quint32 * >( mData )[i];
+          break;
+        case Qgis::DataType::Int32:
+          v = reinterpret_cast< const qint32 * >( mData )[i];
+          break;
+        default:
+          return -1;
+      }
+      if ( ( mHasNoDataValue && v == mNoDataValue ) || ( mCheckBitmap && mBlock->isNoData( i ) ) )
+        return -1;
+      return static_cast< int >( v - mMinimum );
+    }
+
+    /**
+     * Writes the color of the entry of each cell from \a colors, which has size() entries,
+     * to \a output, or \a noDataColor for nodata cells.
+     */
+    void mapColors( const std::vector< QRgb > &colors, QRgb noDataColor, QRgb *output ) const
+    {
+      const QRgb *colorData = colors.data();
+      mapCells( [colorData]( qint64 index ) { return colorData[ index ]; }, noDataColor, output );
+    }
+
+    /**
+     * Writes the table entry of each cell to \a output, or -1 for nodata cells.
+     *
+     * This is the same as calling index() for every cell, without testing the data type per cell.
+     */
+    void mapIndices( int *output ) const
+    {
+      mapCells( []( qint64 index ) { return static_cast< int >( index ); }, -1, output );
+    }
+
+  private:
+
+    template< typename T > void initialize()
+    {
+      const T *data = reinterpret_cast< const T * >( mData );
+      qint64 minimum = std::numeric_limits< qint64 >::max();
+      qint64 maximum = std::numeric_limits< qint64 >::min();
+      for ( qgssize i = 0; i < mCount; ++i )
+      {
+        const qint64 v = data[i];
+        if ( mHasNoDataValue && v == mNoDataValue )
+          continue;
+        minimum = std::min( minimum, v );
+        maximum = std::max( maximum, v );
+      }
+
+      // only nodata cells
+      if ( minimum > maximum )
+        minimum = maximum = 0;
+
+      const qint64 size = maximum - minimum + 1;
+      if ( size > MAXIMUM_SIZE || static_cast< qgssize >( size ) > mCount )
+        return;
+
+      mMinimum = minimum;
+      mSize = size;
+    }
+
+    template< typename Entry, typename Output > void mapCells( Entry entry, Output noData, Output *output ) const
+    {
+      switch ( mBlock->dataType() )
+      {
+        case Qgis::DataType::Byte:
+          mapTypedCells< quint8 >( entry, noData, output );
+          break;
+        case Qgis::DataType::UInt16:
+          mapTypedCells< quint16 >( entry, noData, output );
+          break;
+        case Qgis::DataType::Int16:
+          mapTypedCells< qint16 >( entry, noData, output );
+          break;
+        case Qgis::DataType::UInt32:
+          mapTypedCells< quint32 >( entry, noData, output );
+          break;
+        case Qgis::DataType::Int32:
+          mapTypedCells< qint32 >( entry, noData, output );
+          break;
+        default:
+          break;
+      }
+    }
+
+    template< typename T, typename Entry, typename Output > void mapTypedCells( Entry entry, Output noData, Output *output ) const
+    {
+      // separate loops without branches on the nodata handling, which the compiler can vectorize
+      const T *data = reinterpret_cast< const T * >( mData );
+      if ( mCheckBitmap )
+      {
+        for ( qgssize i = 0; i < mCount; ++i )
+          output[i] = mBlock->isNoData( i ) ? noData : entry( data[i] - mMinimum );
+      }
+      else if ( mHasNoDataValue )
+      {
+        for ( qgssize i = 0; i < mCount; ++i )
+        {
+          const qint64 v = data[i];
+          output[i] = v == mNoDataValue ? noData : entry( v - mMinimum );
+        }
+      }
+      else
+      {
+        for ( qgssize i = 0; i < mCount; ++i )
+          output[i] = entry( data[i] - mMinimum );
+      }
+    }
+
+    QgsRasterBlock *mBlock = nullptr;
+    const char *mData = nullptr;
+    qgssize mCount = 0;
+    bool mCheckBitmap = false;
+    bool mHasNoDataValue = false;
+    qint64 mNoDataValue = 0;
+    qint64 mMinimum = 0;
+    qint64 mSize = 0;
+};
+
+///@endcond
+
+#endif // QGSRASTERLOOKUPTABLE_P_H
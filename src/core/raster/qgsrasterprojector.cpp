@@ -21,6 +21,10 @@
 #include "qgsrasterprojector.h"
 #include "qgscoordinatetransform.h"
 #include "qgsexception.h"
+#include "qgsgdalutils.h"
+
+#include <gdalwarper.h>
+#include <cpl_string.h>
 
 Q_NOWARN_DEPRECATED_PUSH // because of deprecated members
 QgsRasterProjector::QgsRasterProjector()
@@ -45,6 +49,8 @@ QgsRasterProjector *QgsRasterProjector::clone() const
   Q_NOWARN_DEPRECATED_POP
 
   projector->mPrecision = mPrecision;
+  projector->mWarpResamplingMethod = mWarpResamplingMethod;
+  projector->mWarpThreadCount = mWarpThreadCount;
   return projector;
 }
 
@@ -769,6 +775,8 @@ QString QgsRasterProjector::precisionLabel( Precision precision )
       return tr( "Approximate" );
     case Exact:
       return tr( "Exact" );
+    case Warp:
+      return tr( "Exact with Resampling" );
   }
   return QStringLiteral( "Unknown" );
 }
@@ -797,7 +805,14 @@ QgsRasterBlock *QgsRasterProjector::block( int bandNo, QgsRectangle  const &exte
       QgsCoordinateTransform( mDestCRS, mSrcCRS, mDestDatumTransform, mSrcDatumTransform ) : QgsCoordinateTransform( mDestCRS, mSrcCRS, mTransformContext ) ;
   Q_NOWARN_DEPRECATED_POP
 
-  ProjectorData pd( extent, width, height, mInput, inverseCt, mPrecision, feedback );
+  if ( mPrecision == Warp )
+  {
+    if ( QgsRasterBlock *block = warpBlock( bandNo, extent, width, height, inverseCt, feedback ) )
+      return block;
+    QgsDebugMsgLevel( QStringLiteral( "Cannot warp block, reprojecting it with exact precision" ), 2 );
+  }
+
+  ProjectorData pd( extent, width, height, mInput, inverseCt, mPrecision == Warp ? Exact : mPrecision, feedback );
 
   if ( feedback && feedback->isCanceled() )
     return new QgsRasterBlock();
@@ -889,6 +904,244 @@ QgsRasterBlock *QgsRasterProjector::block( int bandNo, QgsRectangle  const &exte
   return outputBlock.release();
 }
 
+/// @cond PRIVATE
+
+//! Source cells added around the source extent of warped blocks, so that the largest (Lanczos) kernel is complete at the edges
+constexpr int WARP_SOURCE_BORDER_CELLS = 3;
+
+static GDALDataType warpGdalDataType( Qgis::DataType dataType )
+{
+  switch ( dataType )
+  {
+    case Qgis::DataType::Byte:
+    case Qgis::DataType::ARGB32:
+    case Qgis::DataType::ARGB32_Premultiplied:
+      return GDT_Byte;
+    case Qgis::DataType::UInt16:
+      return GDT_UInt16;
+    case Qgis::DataType::Int16:
+      return GDT_Int16;
+    case Qgis::DataType::UInt32:
+      return GDT_UInt32;
+    case Qgis::DataType::Int32:
+      return GDT_Int32;
+    case Qgis::DataType::Float32:
+      return GDT_Float32;
+    case Qgis::DataType::Float64:
+      return GDT_Float64;
+    case Qgis::DataType::CInt16:
+    case Qgis::DataType::CInt32:
+    case Qgis::DataType::CFloat32:
+    case Qgis::DataType::CFloat64:
+    case Qgis::DataType::UnknownDataType:
+      break;
+  }
+  return GDT_Unknown;
+}
+
+static GDALResampleAlg warpResampleAlg( QgsRasterDataProvider::ResamplingMethod method )
+{
+  switch ( method )
+  {
+    case QgsRasterDataProvider::ResamplingMethod::Nearest:
+      return GRA_NearestNeighbour;
+    case QgsRasterDataProvider::ResamplingMethod::Bilinear:
+      return GRA_Bilinear;
+    case QgsRasterDataProvider::ResamplingMethod::Cubic:
+      return GRA_Cubic;
+    case QgsRasterDataProvider::ResamplingMethod::CubicSpline:
+      return GRA_CubicSpline;
+    case QgsRasterDataProvider::ResamplingMethod::Lanczos:
+      return GRA_Lanczos;
+    case QgsRasterDataProvider::ResamplingMethod::Average:
+      return GRA_Average;
+    case QgsRasterDataProvider::ResamplingMethod::Mode:
+      return GRA_Mode;
+    case QgsRasterDataProvider::ResamplingMethod::Gauss:
+      // the warper has no Gauss kernel, the B-spline is the closest smoothing one
+      return GRA_CubicSpline;
+  }
+  return GRA_NearestNeighbour;
+}
+
+/**
+ * Wraps the cells of \a block, and the optional \a mask, in a MEM dataset without copying them.
+ * Images are split in one Byte band per color component.
+ */
+static gdal::dataset_unique_ptr warpMemoryDataset( QgsRasterBlock *block, QByteArray *mask, const QgsRectangle &extent, const QgsCoordinateReferenceSystem &crs )
+{
+  gdal::dataset_unique_ptr ds = QgsGdalUtils::createMultiBandMemoryDataset( GDT_Byte, 0, extent, block->width(), block->height(), crs );
+  if ( !ds )
+    return ds;
+
+  const bool isImage = !QgsRasterBlock::typeIsNumeric( block->dataType() );
+  const int pixelSize = QgsRasterBlock::typeSize( block->dataType() );
+  const GDALDataType gdalType = warpGdalDataType( block->dataType() );
+  const qulonglong bits = reinterpret_cast< qulonglong >( block->bits() );
+  for ( int component = 0; component < ( isImage ? 4 : 1 ); ++component )
+  {
+    char **papszOptions = QgsGdalUtils::papszFromStringList( QStringList()
+                          << QStringLiteral( "PIXELOFFSET=%1" ).arg( pixelSize )
+                          << QStringLiteral( "LINEOFFSET=%1" ).arg( static_cast< qlonglong >( pixelSize ) * block->width() )
+                          << QStringLiteral( "DATAPOINTER=%1" ).arg( bits + component ) );
+    GDALAddBand( ds.get(), gdalType, papszOptions );
+    CSLDestroy( papszOptions );
+  }
+
+  if ( block->hasNoDataValue() )
+    GDALSetRasterNoDataValue( GDALGetRasterBand( ds.get(), 1 ), block->noDataValue() );
+
+  if ( mask )
+  {
+    char **papszOptions = QgsGdalUtils::papszFromStringList( QStringList()
+                          << QStringLiteral( "DATAPOINTER=%1" ).arg( reinterpret_cast< qulonglong >( mask->data() ) ) );
+    GDALAddBand( ds.get(), GDT_Byte, papszOptions );
+    CSLDestroy( papszOptions );
+  }
+  return ds;
+}
+
+static int CPL_STDCALL warpProgress( double, const char *, void *feedback )
+{
+  return !static_cast< QgsRasterBlockFeedback * >( feedback )->isCanceled();
+}
+
+/// @endcond
+
+QgsRasterBlock *QgsRasterProjector::warpBlock( int bandNo, const QgsRectangle &extent, int width, int height, const QgsCoordinateTransform &inverseCt, QgsRasterBlockFeedback *feedback )
+{
+  if ( warpGdalDataType( mInput->dataType( bandNo ) ) == GDT_Unknown )
+    return nullptr;
+
+  // the source extent and size are bounded by the destination resolution, as with the other precisions,
+  // but are read once and resampled by the warper rather than looked up cell by cell
+  ProjectorData pd( extent, width, height, mInput, inverseCt, Approximate, feedback );
+  if ( feedback && feedback->isCanceled() )
+    return new QgsRasterBlock();
+  if ( pd.srcRows() <= 0 || pd.srcCols() <= 0 )
+    return new QgsRasterBlock();
+
+  const double srcXRes = pd.srcExtent().width() / pd.srcCols();
+  const double srcYRes = pd.srcExtent().height() / pd.srcRows();
+  const QgsRectangle srcExtent( pd.srcExtent().xMinimum() - WARP_SOURCE_BORDER_CELLS * srcXRes,
+                                pd.srcExtent().yMinimum() - WARP_SOURCE_BORDER_CELLS * srcYRes,
+                                pd.srcExtent().xMaximum() + WARP_SOURCE_BORDER_CELLS * srcXRes,
+                                pd.srcExtent().yMaximum() + WARP_SOURCE_BORDER_CELLS * srcYRes );
+  const int srcCols = pd.srcCols() + 2 * WARP_SOURCE_BORDER_CELLS;
+  const int srcRows = pd.srcRows() + 2 * WARP_SOURCE_BORDER_CELLS;
+
+  std::unique_ptr< QgsRasterBlock > inputBlock( mInput->block( bandNo, srcExtent, srcCols, srcRows, feedback ) );
+  if ( !inputBlock || inputBlock->isEmpty() )
+  {
+    QgsDebugMsg( QStringLiteral( "No raster data!" ) );
+    return new QgsRasterBlock();
+  }
+
+  std::unique_ptr< QgsRasterBlock > outputBlock = std::make_unique< QgsRasterBlock >( inputBlock->dataType(), width, height );
+  if ( inputBlock->hasNoDataValue() )
+    outputBlock->setNoDataValue( inputBlock->noDataValue() );
+  if ( !outputBlock->isValid() )
+  {
+    QgsDebugMsg( QStringLiteral( "Cannot create block" ) );
+    return outputBlock.release();
+  }
+
+  // Numeric blocks without a nodata value may still have nodata cells, held in a bitmap, and the
+  // destination cells outside the source must be nodata too: both are passed to the warper as alpha bands.
+  // Transparent image cells are nodata already.
+  const bool isImage = !QgsRasterBlock::typeIsNumeric( inputBlock->dataType() );
+  const bool useMask = !isImage && !inputBlock->hasNoDataValue();
+  QByteArray srcMask;
+  QByteArray dstMask;
+  if ( useMask )
+  {
+    const qgssize srcCount = static_cast< qgssize >( srcCols ) * srcRows;
+    srcMask.fill( static_cast< char >( 255 ), static_cast< int >( srcCount ) );
+    if ( inputBlock->hasNoData() )
+    {
+      for ( qgssize i = 0; i < srcCount; ++i )
+      {
+        if ( inputBlock->isNoData( i ) )
+          srcMask[ static_cast< int >( i ) ] = 0;
+      }
+    }
+    dstMask.fill( 0, width * height );
+  }
+
+  gdal::dataset_unique_ptr srcDS = warpMemoryDataset( inputBlock.get(), useMask ? &srcMask : nullptr, srcExtent, mSrcCRS );
+  gdal::dataset_unique_ptr dstDS = warpMemoryDataset( outputBlock.get(), useMask ? &dstMask : nullptr, extent, mDestCRS );
+  if ( !srcDS || !dstDS )
+    return nullptr;
+
+  const int bandCount = isImage ? 4 : 1;
+  gdal::warp_options_unique_ptr psWarpOptions( GDALCreateWarpOptions() );
+  psWarpOptions->hSrcDS = srcDS.get();
+  psWarpOptions->hDstDS = dstDS.get();
+  psWarpOptions->nBandCount = bandCount;
+  psWarpOptions->panSrcBands = reinterpret_cast< int * >( CPLMalloc( sizeof( int ) * bandCount ) );
+  psWarpOptions->panDstBands = reinterpret_cast< int * >( CPLMalloc( sizeof( int ) * bandCount ) );
+  for ( int i = 0; i < bandCount; ++i )
+  {
+    psWarpOptions->panSrcBands[i] = i + 1;
+    psWarpOptions->panDstBands[i] = i + 1;
+  }
+  if ( useMask )
+  {
+    psWarpOptions->nSrcAlphaBand = bandCount + 1;
+    psWarpOptions->nDstAlphaBand = bandCount + 1;
+  }
+  if ( inputBlock->hasNoDataValue() )
+  {
+    psWarpOptions->padfSrcNoDataReal = reinterpret_cast< double * >( CPLMalloc( sizeof( double ) ) );
+    psWarpOptions->padfDstNoDataReal = reinterpret_cast< double * >( CPLMalloc( sizeof( double ) ) );
+    psWarpOptions->padfSrcNoDataReal[0] = inputBlock->noDataValue();
+    psWarpOptions->padfDstNoDataReal[0] = inputBlock->noDataValue();
+  }
+  psWarpOptions->eResampleAlg = warpResampleAlg( mWarpResamplingMethod );
+  psWarpOptions->papszWarpOptions = CSLSetNameValue( psWarpOptions->papszWarpOptions, "INIT_DEST", inputBlock->hasNoDataValue() ? "NO_DATA" : "0" );
+  psWarpOptions->papszWarpOptions = CSLSetNameValue( psWarpOptions->papszWarpOptions, "NUM_THREADS",
+                                    mWarpThreadCount > 0 ? QByteArray::number( mWarpThreadCount ).constData() : "ALL_CPUS" );
+  if ( feedback )
+  {
+    psWarpOptions->pfnProgress = warpProgress;
+    psWarpOptions->pProgressArg = feedback;
+  }
+
+  // every destination cell is transformed exactly, with the coordinate operation of the transform context
+  char **papszTransformerOptions = nullptr;
+  const QString coordinateOperation = mTransformContext.calculateCoordinateOperation( mSrcCRS, mDestCRS );
+  if ( !coordinateOperation.isEmpty() )
+    papszTransformerOptions = CSLSetNameValue( papszTransformerOptions, "COORDINATE_OPERATION", coordinateOperation.toUtf8().constData() );
+  psWarpOptions->pTransformerArg = GDALCreateGenImgProjTransformer2( srcDS.get(), dstDS.get(), papszTransformerOptions );
+  CSLDestroy( papszTransformerOptions );
+  if ( !psWarpOptions->pTransformerArg )
+    return nullptr;
+  psWarpOptions->pfnTransformer = GDALGenImgProjTransform;
+
+  GDALWarpOperation operation;
+  CPLErr err = operation.Initialize( psWarpOptions.get() );
+  if ( err == CE_None )
+    err = operation.ChunkAndWarpMulti( 0, 0, width, height );
+  GDALDestroyGenImgProjTransformer( psWarpOptions->pTransformerArg );
+
+  if ( feedback && feedback->isCanceled() )
+    return new QgsRasterBlock();
+  if ( err != CE_None )
+    return nullptr;
+
+  if ( useMask )
+  {
+    const qgssize dstCount = static_cast< qgssize >( width ) * height;
+    for ( qgssize i = 0; i < dstCount; ++i )
+    {
+      if ( dstMask.at( static_cast< int >( i ) ) == 0 )
+        outputBlock->setIsNoData( i );
+    }
+  }
+
+  return outputBlock.release();
+}
+
 bool QgsRasterProjector::destExtentSize( const QgsRectangle &srcExtent, int srcXSize, int srcYSize,
     QgsRectangle &destExtent, int &destXSize, int &destYSize )
 {
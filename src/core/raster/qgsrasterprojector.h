@@ -32,6 +32,7 @@
 #include "qgscoordinatereferencesystem.h"
 #include "qgscoordinatetransform.h"
 #include "qgsrasterinterface.h"
+#include "qgsrasterdataprovider.h"
 
 #include <cmath>
 
@@ -58,6 +59,7 @@ class CORE_EXPORT QgsRasterProjector : public QgsRasterInterface
     {
       Approximate = 0, //!< Approximate (default), fast but possibly inaccurate
       Exact = 1,   //!< Exact, precise but slow
+      Warp = 2, //!< Exact, with the source cells resampled by GDAL's multithreaded warp kernel (since QGIS 3.20)
     };
     Q_ENUM( Precision )
 
@@ -94,6 +96,39 @@ class CORE_EXPORT QgsRasterProjector : public QgsRasterInterface
     // Translated precision mode, for use in ComboBox etc.
     static QString precisionLabel( Precision precision );
 
+    /**
+     * Returns the resampling method used to compute the destination cells with the Warp precision.
+     * \see setWarpResamplingMethod()
+     * \since QGIS 3.20
+     */
+    QgsRasterDataProvider::ResamplingMethod warpResamplingMethod() const { return mWarpResamplingMethod; }
+
+    /**
+     * Sets the resampling \a method used to compute the destination cells with the Warp precision.
+     *
+     * The source cells are read at about the destination resolution, so this is meant for
+     * zoomed in rendering. Zoomed out, averaging methods would only see already decimated cells.
+     *
+     * \see warpResamplingMethod()
+     * \since QGIS 3.20
+     */
+    void setWarpResamplingMethod( QgsRasterDataProvider::ResamplingMethod method ) { mWarpResamplingMethod = method; }
+
+    /**
+     * Returns the number of threads used by the warp kernel of the Warp precision, 0 meaning all CPUs.
+     * \see setWarpThreadCount()
+     * \since QGIS 3.20
+     */
+    int warpThreadCount() const { return mWarpThreadCount; }
+
+    /**
+     * Sets the number of threads used by the warp kernel of the Warp precision. The default \a count
+     * of 0 uses all CPUs, callers which already request blocks from several threads should use 1.
+     * \see warpThreadCount()
+     * \since QGIS 3.20
+     */
+    void setWarpThreadCount( int count ) { mWarpThreadCount = count; }
+
     QgsRasterBlock *block( int bandNo, const QgsRectangle &extent, int width, int height, QgsRasterBlockFeedback *feedback = nullptr ) override SIP_FACTORY;
 
     //! Calculate destination extent and size from source extent and size
@@ -107,6 +142,12 @@ class CORE_EXPORT QgsRasterProjector : public QgsRasterInterface
 
   private:
 
+    /**
+     * Reprojects the block with GDAL's warp kernel. Returns NULLPTR if the warp cannot
+     * be set up, in which case the block must be reprojected with the Exact precision.
+     */
+    QgsRasterBlock *warpBlock( int bandNo, const QgsRectangle &extent, int width, int height, const QgsCoordinateTransform &inverseCt, QgsRasterBlockFeedback *feedback );
+
     //! Source CRS
     QgsCoordinateReferenceSystem mSrcCRS;
 
@@ -122,6 +163,12 @@ class CORE_EXPORT QgsRasterProjector : public QgsRasterInterface
     //! Requested precision
     Precision mPrecision = Approximate;
 
+    //! Resampling method of the Warp precision
+    QgsRasterDataProvider::ResamplingMethod mWarpResamplingMethod = QgsRasterDataProvider::ResamplingMethod::Nearest;
+
+    //! Number of threads of the warp kernel, 0 for all CPUs
+    int mWarpThreadCount = 0;
+
     QgsCoordinateTransformContext mTransformContext;
 
 };
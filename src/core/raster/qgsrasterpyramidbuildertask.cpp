@@ -0,0 +1,93 @@
+/***************************************************************************
+                          qgsrasterpyramidbuildertask.cpp
+                          -------------------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsrasterpyramidbuildertask.h"
+#include "qgsrasterdataprovider.h"
+#include "qgsproviderregistry.h"
+#include "qgslogger.h"
+
+#include <algorithm>
+
+QgsRasterPyramidBuilderTask::QgsRasterPyramidBuilderTask( const QString &providerKey, const QString &uri,
+    const QList<QgsRasterPyramid> &pyramids,
+    const QString &resamplingMethod,
+    QgsRaster::RasterPyramidsFormat format,
+    const QStringList &configOptions )
+  : QgsTask( tr( "Building pyramids for %1" ).arg( uri ), QgsTask::CanCancel )
+  , mProviderKey( providerKey )
+  , mUri( uri )
+  , mPyramids( pyramids )
+  , mResamplingMethod( resamplingMethod )
+  , mFormat( format )
+  , mConfigOptions( configOptions )
+  , mFeedback( new QgsRasterBlockFeedback() )
+{
+}
+
+QgsRasterPyramidBuilderTask::~QgsRasterPyramidBuilderTask() = default;
+
+void QgsRasterPyramidBuilderTask::cancel()
+{
+  mFeedback->cancel();
+  QgsTask::cancel();
+}
+
+bool QgsRasterPyramidBuilderTask::run()
+{
+  connect( mFeedback.get(), &QgsRasterBlockFeedback::progressChanged, this, &QgsRasterPyramidBuilderTask::setProgress );
+
+  // a provider of our own, so that the layers using the source are not locked while building
+  const QgsDataProvider::ProviderOptions providerOptions;
+  std::unique_ptr< QgsRasterDataProvider > provider( qobject_cast< QgsRasterDataProvider * >(
+        QgsProviderRegistry::instance()->createProvider( mProviderKey, mUri, providerOptions ) ) );
+  if ( !provider || !provider->isValid() )
+  {
+    mError = QStringLiteral( "ERROR_PROVIDER" );
+    return false;
+  }
+
+  QList< QgsRasterPyramid > pyramids = mPyramids;
+  if ( pyramids.isEmpty() )
+  {
+    pyramids = provider->buildPyramidList( mOverviewLevels );
+    for ( QgsRasterPyramid &pyramid : pyramids )
+      pyramid.setBuild( true );
+  }
+
+  // compute the overview levels on all cores, unless the caller asked otherwise
+  QStringList configOptions = mConfigOptions;
+  const bool hasThreadOption = std::any_of( configOptions.constBegin(), configOptions.constEnd(), []( const QString & option )
+  {
+    return option.startsWith( QLatin1String( "GDAL_NUM_THREADS=" ), Qt::CaseInsensitive );
+  } );
+  if ( !hasThreadOption )
+    configOptions << QStringLiteral( "GDAL_NUM_THREADS=ALL_CPUS" );
+
+  mError = provider->buildPyramids( pyramids, mResamplingMethod, mFormat, configOptions, mFeedback.get() );
+  if ( mError.isNull() && mFeedback->isCanceled() )
+    mError = QStringLiteral( "CANCELED" );
+
+  QgsDebugMsgLevel( QStringLiteral( "Pyramids of %1 built: %2" ).arg( mUri, mError.isNull() ? QStringLiteral( "OK" ) : mError ), 2 );
+  return mError.isNull();
+}
+
+void QgsRasterPyramidBuilderTask::finished( bool result )
+{
+  if ( result )
+    emit pyramidsBuilt( mUri );
+  else
+    emit errorOccurred( mError.isEmpty() ? QStringLiteral( "CANCELED" ) : mError );
+}
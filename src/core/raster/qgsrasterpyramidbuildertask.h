@@ -0,0 +1,114 @@
+/***************************************************************************
+                          qgsrasterpyramidbuildertask.h
+                          -----------------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSRASTERPYRAMIDBUILDERTASK_H
+#define QGSRASTERPYRAMIDBUILDERTASK_H
+
+#include "qgis_core.h"
+#include "qgstaskmanager.h"
+#include "qgsraster.h"
+#include "qgsrasterpyramid.h"
+#include "qgsrasterinterface.h"
+
+#include <memory>
+
+/**
+ * \class QgsRasterPyramidBuilderTask
+ * \ingroup core
+ * \brief QgsTask task which builds the pyramid overviews of a raster data source as a
+ * background task, without blocking the layers which display it.
+ *
+ * The task opens its own data provider for the source, so the overview levels are written
+ * while layers keep reading the raster. The levels of each overview are computed in
+ * parallel chunks on all the available cores, when supported by the provider.
+ *
+ * \note Overviews are computed in parallel by the GDAL provider only with GDAL 3.2 or later,
+ * which added the GDAL_NUM_THREADS option to overview building. Older versions build the
+ * levels on a single thread.
+ *
+ * \see QgsRasterDataProvider::buildPyramids()
+ * \since QGIS 3.20
+ */
+class CORE_EXPORT QgsRasterPyramidBuilderTask : public QgsTask
+{
+    Q_OBJECT
+
+  public:
+
+    /**
+     * Constructor for QgsRasterPyramidBuilderTask, building the overviews of the source
+     * with the given \a uri opened by the \a providerKey data provider.
+     *
+     * The levels of \a pyramids flagged for building are built. If \a pyramids is empty,
+     * all the levels returned by QgsRasterDataProvider::buildPyramidList() are built.
+     *
+     * The \a resamplingMethod, \a format and \a configOptions are passed to
+     * QgsRasterDataProvider::buildPyramids().
+     */
+    QgsRasterPyramidBuilderTask( const QString &providerKey, const QString &uri,
+                                 const QList< QgsRasterPyramid > &pyramids = QList< QgsRasterPyramid >(),
+                                 const QString &resamplingMethod = QStringLiteral( "NEAREST" ),
+                                 QgsRaster::RasterPyramidsFormat format = QgsRaster::PyramidsGTiff,
+                                 const QStringList &configOptions = QStringList() );
+
+    ~QgsRasterPyramidBuilderTask() override;
+
+    /**
+     * Sets the overview \a levels to build, as decimation factors, when no pyramids
+     * were given to the constructor. If empty, the default levels of the provider are built.
+     *
+     * \see QgsRasterDataProvider::buildPyramidList()
+     */
+    void setOverviewLevels( const QList< int > &levels ) { mOverviewLevels = levels; }
+
+    void cancel() override;
+
+  signals:
+
+    /**
+     * Emitted when the overviews of the source with the given \a uri are successfully built.
+     * Layers reading the source should reload their data to use them.
+     */
+    void pyramidsBuilt( const QString &uri );
+
+    /**
+     * Emitted when the overviews could not be built, or if the task is canceled. The \a error
+     * is the value returned by QgsRasterDataProvider::buildPyramids(), or "ERROR_PROVIDER" if
+     * the source could not be opened.
+     */
+    void errorOccurred( const QString &error );
+
+  protected:
+
+    bool run() override;
+    void finished( bool result ) override;
+
+  private:
+
+    QString mProviderKey;
+    QString mUri;
+    QList< QgsRasterPyramid > mPyramids;
+    QList< int > mOverviewLevels;
+    QString mResamplingMethod;
+    QgsRaster::RasterPyramidsFormat mFormat = QgsRaster::PyramidsGTiff;
+    QStringList mConfigOptions;
+
+    std::unique_ptr< QgsRasterBlockFeedback > mFeedback;
+
+    QString mError;
+};
+
+#endif // QGSRASTERPYRAMIDBUILDERTASK_H
@@ -0,0 +1,159 @@
+/***************************************************************************
+    qgsrasterstatisticsaccumulator.cpp  -  Single pass raster band statistics
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#include "qgsrasterstatisticsaccumulator.h"
+#include "qgsrasterbandstats.h"
+#include "qgsrasterblock.h"
+#include "qgsrasterhistogram.h"
+
+#include <QtConcurrentMap>
+
+//! Minimum number of cells processed by a single task of QgsRasterStatisticsAccumulator::addBlock()
+constexpr qgssize STATISTICS_CHUNK_CELLS = 1 << 16;
+
+void QgsRasterStatisticsAccumulator::setHistogram( double minimum, double maximum, int binCount, bool includeOutOfRange )
+{
+  if ( binCount <= 0 )
+  {
+    mHistogram.clear();
+    return;
+  }
+
+  // To avoid rounding errors, as in QgsRasterInterface::histogram()
+  const double interval = ( maximum - minimum ) / binCount;
+  mHistogramMinimum = minimum - 0.1 * interval;
+  const double histogramMaximum = maximum + 0.1 * interval;
+  mBinSize = ( histogramMaximum - mHistogramMinimum ) / binCount;
+  mIncludeOutOfRange = includeOutOfRange;
+  mHistogram.assign( static_cast< std::size_t >( binCount ), 0 );
+  mHistogramCount = 0;
+}
+
+void QgsRasterStatisticsAccumulator::addBlock( const QgsRasterBlock *block )
+{
+  if ( !block || block->isEmpty() )
+    return;
+
+  const int width = block->width();
+  const int height = block->height();
+  const int chunkRows = static_cast< int >( std::max< qgssize >( 1, STATISTICS_CHUNK_CELLS / std::max( width, 1 ) ) );
+  if ( chunkRows >= height )
+  {
+    addRows( block, 0, height );
+    return;
+  }
+
+  // every chunk of rows gets an empty accumulator with the same histogram setup
+  QgsRasterStatisticsAccumulator empty;
+  empty.mHistogram.assign( mHistogram.size(), 0 );
+  empty.mHistogramMinimum = mHistogramMinimum;
+  empty.mBinSize = mBinSize;
+  empty.mIncludeOutOfRange = mIncludeOutOfRange;
+
+  struct Chunk
+  {
+    int startRow = 0;
+    int rowCount = 0;
+    QgsRasterStatisticsAccumulator accumulator;
+  };
+  std::vector< Chunk > chunks;
+  for ( int row = 0; row < height; row += chunkRows )
+    chunks.push_back( { row, std::min( chunkRows, height - row ), empty } );
+
+  QtConcurrent::blockingMap( chunks, [block]( Chunk & chunk )
+  {
+    chunk.accumulator.addRows( block, chunk.startRow, chunk.rowCount );
+  } );
+
+  // merge in a fixed order, so that results do not depend on scheduling
+  for ( const Chunk &chunk : chunks )
+    merge( chunk.accumulator );
+}
+
+void QgsRasterStatisticsAccumulator::addRows( const QgsRasterBlock *block, int startRow, int rowCount )
+{
+  if ( !block || block->isEmpty() )
+    return;
+
+  const qgssize begin = static_cast< qgssize >( startRow ) * block->width();
+  const qgssize end = begin + static_cast< qgssize >( rowCount ) * block->width();
+  bool isNoData = false;
+  for ( qgssize i = begin; i < end; ++i )
+  {
+    const double value = block->valueAndNoData( i, isNoData );
+    if ( isNoData )
+      continue;
+
+    addValue( value );
+  }
+}
+
+void QgsRasterStatisticsAccumulator::merge( const QgsRasterStatisticsAccumulator &other )
+{
+  mCount += other.mCount;
+  mSum += other.mSum;
+  mMinimum = std::min( mMinimum, other.mMinimum );
+  mMaximum = std::max( mMaximum, other.mMaximum );
+
+  // combine the means and sums of squares (Chan et al.)
+  if ( other.mFiniteCount > 0 )
+  {
+    const double count = static_cast< double >( mFiniteCount );
+    const double otherCount = static_cast< double >( other.mFiniteCount );
+    const double total = count + otherCount;
+    const double delta = other.mMean - mMean;
+    mMean += delta * otherCount / total;
+    mSumOfSquares += other.mSumOfSquares + delta * delta * count * otherCount / total;
+    mFiniteCount += other.mFiniteCount;
+  }
+
+  if ( mHistogram.size() == other.mHistogram.size() )
+  {
+    for ( std::size_t i = 0; i < mHistogram.size(); ++i )
+      mHistogram[i] += other.mHistogram[i];
+    mHistogramCount += other.mHistogramCount;
+  }
+}
+
+void QgsRasterStatisticsAccumulator::updateStatistics( QgsRasterBandStats &statistics ) const
+{
+  statistics.elementCount = mCount;
+  statistics.sum = mSum;
+  if ( mFiniteCount > 0 )
+  {
+    statistics.minimumValue = mMinimum;
+    statistics.maximumValue = mMaximum;
+  }
+  statistics.range = statistics.maximumValue - statistics.minimumValue;
+  statistics.mean = mSum / mCount;
+  statistics.sumOfSquares = mSumOfSquares;
+
+  // stdDev may differ from GDAL stats, because GDAL is using naive single pass
+  // algorithm which is more error prone (because of rounding errors)
+  // Divide result by sample size - 1 and get square root to get stdev. Infinite values
+  // are not part of the sum of squares, so they are not part of the sample size either
+  statistics.stdDev = std::sqrt( mSumOfSquares / ( static_cast< double >( mFiniteCount ) - 1 ) );
+  statistics.statsGathered = QgsRasterBandStats::All;
+}
+
+void QgsRasterStatisticsAccumulator::updateHistogram( QgsRasterHistogram &histogram ) const
+{
+  histogram.histogramVector.resize( static_cast< int >( mHistogram.size() ) );
+  for ( std::size_t i = 0; i < mHistogram.size(); ++i )
+    histogram.histogramVector[ static_cast< int >( i ) ] = static_cast< int >( mHistogram[i] );
+  histogram.nonNullCount = static_cast< int >( mHistogramCount );
+  histogram.valid = true;
+}
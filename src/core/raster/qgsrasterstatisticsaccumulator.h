@@ -0,0 +1,174 @@
+/***************************************************************************
+    qgsrasterstatisticsaccumulator.h  -  Single pass raster band statistics
+                             -------------------
+    begin                : October, 2026
+    copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************/
+
+/***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+
+#ifndef QGSRASTERSTATISTICSACCUMULATOR_H
+#define QGSRASTERSTATISTICSACCUMULATOR_H
+
+#include "qgis_core.h"
+#include "qgis_sip.h"
+#include "qgis.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#define SIP_NO_FILE
+
+class QgsRasterBlock;
+class QgsRasterBandStats;
+class QgsRasterHistogram;
+
+/**
+ * \ingroup core
+ * \class QgsRasterStatisticsAccumulator
+ * \brief Accumulates band statistics and, optionally, a histogram from raster blocks in a single pass.
+ *
+ * Values are gathered with Welford's algorithm, and accumulators for separate parts of a
+ * raster can be merged, so that large blocks are reduced concurrently by addBlock().
+ *
+ * The results match those of the generic QgsRasterInterface::bandStatistics() and
+ * QgsRasterInterface::histogram() implementations: nodata values are skipped, and infinite
+ * values contribute to the element count and sum only.
+ *
+ * \note Not available in Python bindings
+ * \since QGIS 3.20
+ */
+class CORE_EXPORT QgsRasterStatisticsAccumulator
+{
+  public:
+
+    /**
+     * Constructor for QgsRasterStatisticsAccumulator, which collects statistics only.
+     */
+    QgsRasterStatisticsAccumulator() = default;
+
+    /**
+     * Sets up a histogram of \a binCount bins between \a minimum and \a maximum to be
+     * collected along with the statistics. Like QgsRasterInterface::histogram() the range is
+     * widened by a tenth of a bin on both sides, to avoid rounding errors at its limits.
+     *
+     * If \a includeOutOfRange is TRUE, values outside the range are counted in the first or last bin.
+     *
+     * This must be called before any value is added.
+     */
+    void setHistogram( double minimum, double maximum, int binCount, bool includeOutOfRange = false );
+
+    /**
+     * Returns TRUE if a histogram is collected.
+     */
+    bool hasHistogram() const { return !mHistogram.empty(); }
+
+    /**
+     * Adds a single \a value, which must not be nodata.
+     */
+    void addValue( double value )
+    {
+      mSum += value;
+      mCount++;
+
+      if ( !mHistogram.empty() && !std::isnan( value ) )
+        addToHistogram( value );
+
+      if ( !std::isfinite( value ) )
+        return;
+
+      if ( value < mMinimum )
+        mMinimum = value;
+      if ( value > mMaximum )
+        mMaximum = value;
+
+      // single pass stdev
+      mFiniteCount++;
+      const double delta = value - mMean;
+      mMean += delta / static_cast< double >( mFiniteCount );
+      mSumOfSquares += delta * ( value - mMean );
+    }
+
+    /**
+     * Adds all values from \a block which are not nodata. Large blocks are split into
+     * row ranges which are processed concurrently.
+     */
+    void addBlock( const QgsRasterBlock *block );
+
+    /**
+     * Adds the values which are not nodata from \a rowCount rows of \a block, starting at \a startRow.
+     */
+    void addRows( const QgsRasterBlock *block, int startRow, int rowCount );
+
+    /**
+     * Merges the values gathered by \a other into this accumulator. Both must collect
+     * the same histogram, if any.
+     */
+    void merge( const QgsRasterStatisticsAccumulator &other );
+
+    /**
+     * Returns the number of values added, excluding nodata.
+     */
+    qgssize count() const { return mCount; }
+
+    /**
+     * Stores the gathered statistics in \a statistics, marking all of them as gathered.
+     */
+    void updateStatistics( QgsRasterBandStats &statistics ) const;
+
+    /**
+     * Stores the gathered histogram counts in \a histogram and marks it as valid.
+     * The histogram parameters of \a histogram must match those passed to setHistogram().
+     */
+    void updateHistogram( QgsRasterHistogram &histogram ) const;
+
+  private:
+
+    void addToHistogram( double value )
+    {
+      const double bin = std::floor( ( value - mHistogramMinimum ) / mBinSize );
+      const int lastBin = static_cast< int >( mHistogram.size() ) - 1;
+      int index = 0;
+      if ( bin < 0 )
+      {
+        if ( !mIncludeOutOfRange )
+          return;
+      }
+      else if ( bin > lastBin )
+      {
+        if ( !mIncludeOutOfRange )
+          return;
+        index = lastBin;
+      }
+      else
+      {
+        index = static_cast< int >( bin );
+      }
+      mHistogram[ static_cast< std::size_t >( index ) ]++;
+      mHistogramCount++;
+    }
+
+    qgssize mCount = 0;
+    qgssize mFiniteCount = 0;
+    double mSum = 0;
+    double mMinimum = std::numeric_limits< double >::max();
+    double mMaximum = -std::numeric_limits< double >::max();
+    double mMean = 0;
+    double mSumOfSquares = 0;
+
+    std::vector< qgssize > mHistogram;
+    qgssize mHistogramCount = 0;
+    double mHistogramMinimum = 0;
+    double mBinSize = 1;
+    bool mIncludeOutOfRange = false;
+};
+
+#endif // QGSRASTERSTATISTICSACCUMULATOR_H
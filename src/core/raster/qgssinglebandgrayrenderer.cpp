@@ -23,6 +23,7 @@
 #include "qgsreadwritecontext.h"
 #include "qgscolorramp.h"
 #include "qgssymbol.h"
+#include "qgsrasterlookuptable_p.h"
 
 #include <QDomDocument>
 #include <QDomElement>
@@ -130,17 +131,10 @@ QgsRasterBlock *QgsSingleBandGrayRenderer::block( int bandNo, const QgsRectangle
   }
 
   const QRgb myDefaultColor = renderColorForNodataPixel();
-  bool isNoData = false;
-  for ( qgssize i = 0; i < ( qgssize )width * height; i++ )
-  {
-    double grayVal = inputBlock->valueAndNoData( i, isNoData );
-
-    if ( isNoData )
-    {
-      outputBlock->setColor( i, myDefaultColor );
-      continue;
-    }
 
+  // color of a valid cell, with the value of the alpha band if there is one
+  const auto cellColor = [this, myDefaultColor]( double grayVal, double alphaVal ) -> QRgb
+  {
     double currentAlpha = mOpacity;
     if ( mRasterTransparency )
     {
@@ -148,15 +142,14 @@ QgsRasterBlock *QgsSingleBandGrayRenderer::block( int bandNo, const QgsRectangle
     }
     if ( mAlphaBand > 0 )
     {
-      currentAlpha *= alphaBlock->value( i ) / 255.0;
+      currentAlpha *= alphaVal / 255.0;
     }
 
     if ( mContrastEnhancement )
     {
       if ( !mContrastEnhancement->isValueInDisplayableRange( grayVal ) )
       {
-        outputBlock->setColor( i, myDefaultColor );
-        continue;
+        return myDefaultColor;
       }
       grayVal = mContrastEnhancement->enhanceContrast( grayVal );
     }
@@ -168,12 +161,38 @@ QgsRasterBlock *QgsSingleBandGrayRenderer::block( int bandNo, const QgsRectangle
 
     if ( qgsDoubleNear( currentAlpha, 1.0 ) )
     {
-      outputBlock->setColor( i, qRgba( grayVal, grayVal, grayVal, 255 ) );
+      return qRgba( grayVal, grayVal, grayVal, 255 );
     }
-    else
+    return qRgba( currentAlpha * grayVal, currentAlpha * grayVal, currentAlpha * grayVal, currentAlpha * 255 );
+  };
+
+  // without an alpha band the color only depends on the value, so integer data
+  // can be enhanced once per distinct value
+  if ( mAlphaBand <= 0 )
+  {
+    const QgsRasterLookupTable lookupTable( inputBlock.get() );
+    if ( lookupTable.isValid() )
     {
-      outputBlock->setColor( i, qRgba( currentAlpha * grayVal, currentAlpha * grayVal, currentAlpha * grayVal, currentAlpha * 255 ) );
+      std::vector< QRgb > colors( static_cast< std::size_t >( lookupTable.size() ) );
+      for ( int index = 0; index < lookupTable.size(); ++index )
+        colors[ static_cast< std::size_t >( index ) ] = cellColor( lookupTable.value( index ), 0 );
+      lookupTable.mapColors( colors, myDefaultColor, outputBlock->colorData() );
+      return outputBlock.release();
+    }
+  }
+
+  bool isNoData = false;
+  for ( qgssize i = 0; i < ( qgssize )width * height; i++ )
+  {
+    double grayVal = inputBlock->valueAndNoData( i, isNoData );
+
+    if ( isNoData )
+    {
+      outputBlock->setColor( i, myDefaultColor );
+      continue;
     }
+
+    outputBlock->setColor( i, cellColor( grayVal, mAlphaBand > 0 ? alphaBlock->value( i ) : 0 ) );
   }
 
   return outputBlock.release();
@@ -23,6 +23,7 @@
 #include "qgsrasterviewport.h"
 #include "qgsstyleentityvisitor.h"
 #include "qgscolorramplegendnode.h"
+#include "qgsrasterlookuptable_p.h"
 
 #include <QDomDocument>
 #include <QDomElement>
@@ -235,22 +236,13 @@ QgsRasterBlock *QgsSingleBandPseudoColorRenderer::block( int bandNo, QgsRectangl
   QRgb *outputBlockData = outputBlock->colorData();
   const QgsRasterShaderFunction *fcn = mShader->rasterShaderFunction();
 
-  qgssize count = ( qgssize )width * height;
-  bool isNoData = false;
-  for ( qgssize i = 0; i < count; i++ )
+  // color of a valid cell, with the value of the alpha band if there is one
+  const auto cellColor = [this, fcn, myDefaultColor, hasTransparency]( double val, double alphaVal ) -> QRgb
   {
-    double val = inputBlock->valueAndNoData( i, isNoData );
-    if ( isNoData )
-    {
-      outputBlockData[i] = myDefaultColor;
-      continue;
-    }
-
     int red, green, blue, alpha;
     if ( !fcn->shade( val, &red, &green, &blue, &alpha ) )
     {
-      outputBlockData[i] = myDefaultColor;
-      continue;
+      return myDefaultColor;
     }
 
     if ( alpha < 255 )
@@ -263,25 +255,52 @@ QgsRasterBlock *QgsSingleBandPseudoColorRenderer::block( int bandNo, QgsRectangl
 
     if ( !hasTransparency )
     {
-      outputBlockData[i] = qRgba( red, green, blue, alpha );
+      return qRgba( red, green, blue, alpha );
     }
-    else
+
+    //opacity
+    double currentOpacity = mOpacity;
+    if ( mRasterTransparency )
     {
-      //opacity
-      double currentOpacity = mOpacity;
-      if ( mRasterTransparency )
-      {
-        currentOpacity = mRasterTransparency->alphaValue( val, mOpacity * 255 ) / 255.0;
-      }
-      if ( mAlphaBand > 0 )
-      {
-        currentOpacity *= alphaBlock->value( i ) / 255.0;
-      }
+      currentOpacity = mRasterTransparency->alphaValue( val, mOpacity * 255 ) / 255.0;
+    }
+    if ( mAlphaBand > 0 )
+    {
+      currentOpacity *= alphaVal / 255.0;
+    }
+
+    return qRgba( currentOpacity * red, currentOpacity * green, currentOpacity * blue, currentOpacity * alpha );
+  };
 
-      outputBlockData[i] = qRgba( currentOpacity * red, currentOpacity * green, currentOpacity * blue, currentOpacity * alpha );
+  // without an alpha band the color only depends on the value, so integer data
+  // can be shaded once per distinct value
+  if ( mAlphaBand <= 0 )
+  {
+    const QgsRasterLookupTable lookupTable( inputBlock.get() );
+    if ( lookupTable.isValid() )
+    {
+      std::vector< QRgb > colors( static_cast< std::size_t >( lookupTable.size() ) );
+      for ( int index = 0; index < lookupTable.size(); ++index )
+        colors[ static_cast< std::size_t >( index ) ] = cellColor( lookupTable.value( index ), 0 );
+      lookupTable.mapColors( colors, myDefaultColor, outputBlockData );
+      return outputBlock.release();
     }
   }
 
+  qgssize count = ( qgssize )width * height;
+  bool isNoData = false;
+  for ( qgssize i = 0; i < count; i++ )
+  {
+    double val = inputBlock->valueAndNoData( i, isNoData );
+    if ( isNoData )
+    {
+      outputBlockData[i] = myDefaultColor;
+      continue;
+    }
+
+    outputBlockData[i] = cellColor( val, mAlphaBand > 0 ? alphaBlock->value( i ) : 0 );
+  }
+
   return outputBlock.release();
 }
 
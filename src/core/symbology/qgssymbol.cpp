@@ -55,6 +55,7 @@
 #include "qgsmarkersymbol.h"
 #include "qgslinesymbol.h"
 #include "qgsfillsymbol.h"
+#include "qgscoordinatetransformgrid.h"
 
 QgsPropertiesDefinition QgsSymbol::sPropertyDefinitions;
 
@@ -107,7 +108,10 @@ QPolygonF QgsSymbol::_getLineString( QgsRenderContext &context, const QgsCurve &
   {
     try
     {
-      ct.transformPolygon( pts );
+      if ( const QgsCoordinateTransformGrid *grid = context.coordinateTransformGrid() )
+        grid->transformPolygon( pts );
+      else
+        ct.transformPolygon( pts );
     }
     catch ( QgsCsException & )
     {
@@ -132,11 +136,7 @@ QPolygonF QgsSymbol::_getLineString( QgsRenderContext &context, const QgsCurve &
     pts = QgsClipper::clippedLine( pts, clipRect );
   }
 
-  QPointF *ptr = pts.data();
-  for ( int i = 0; i < pts.size(); ++i, ++ptr )
-  {
-    mtp.transformInPlace( ptr->rx(), ptr->ry() );
-  }
+  mtp.transformInPlace( pts );
 
   return pts;
 }
@@ -175,7 +175,10 @@ QPolygonF QgsSymbol::_getPolygonRing( QgsRenderContext &context, const QgsCurve
   {
     try
     {
-      ct.transformPolygon( poly );
+      if ( const QgsCoordinateTransformGrid *grid = context.coordinateTransformGrid() )
+        grid->transformPolygon( poly );
+      else
+        ct.transformPolygon( poly );
     }
     catch ( QgsCsException & )
     {
@@ -200,11 +203,7 @@ QPolygonF QgsSymbol::_getPolygonRing( QgsRenderContext &context, const QgsCurve
     QgsClipper::trimPolygon( poly, clipRect );
   }
 
-  QPointF *ptr = poly.data();
-  for ( int i = 0; i < poly.size(); ++i, ++ptr )
-  {
-    mtp.transformInPlace( ptr->rx(), ptr->ry() );
-  }
+  mtp.transformInPlace( poly );
 
   if ( !poly.empty() && !poly.isClosed() )
     poly << poly.at( 0 );
@@ -41,6 +41,7 @@
 #include "qgsvectorlayertemporalproperties.h"
 #include "qgsmapclippingutils.h"
 #include "qgsfeaturerenderergenerator.h"
+#include "qgscoordinatetransformgrid.h"
 
 #include <QPicture>
 #include <QTimer>
@@ -221,6 +222,23 @@ bool QgsVectorLayerRenderer::render()
     mElapsedTimer.start();
   }
 
+  QgsRenderContext &context = *renderContext();
+  const QgsCoordinateTransform ct = context.coordinateTransform();
+  if ( context.testFlag( QgsRenderContext::ApproximateCoordinateTransforms )
+       && !context.testFlag( QgsRenderContext::ApplyClipAfterReprojection )
+       && ct.isValid() && !ct.isShortCircuited() )
+  {
+    // cover the same buffered extent which symbols clip geometries to, and keep
+    // interpolated vertices within a quarter of a pixel of their exact position
+    const QgsRectangle e = context.extent();
+    const QgsRectangle gridExtent( e.xMinimum() - e.width() / 10, e.yMinimum() - e.height() / 10,
+                                   e.xMaximum() + e.width() / 10, e.yMaximum() + e.height() / 10 );
+    const double maxError = 0.25 * context.mapToPixel().mapUnitsPerPixel();
+    std::shared_ptr< const QgsCoordinateTransformGrid > grid = std::make_shared< QgsCoordinateTransformGrid >( ct, gridExtent, maxError );
+    if ( grid->isValid() )
+      context.setCoordinateTransformGrid( grid );
+  }
+
   bool res = true;
   for ( const std::unique_ptr< QgsFeatureRenderer > &renderer : mRenderers )
   {
@@ -45,6 +45,7 @@
 #include "qgsrasterlayer.h"
 #include "qgsrasterlayerproperties.h"
 #include "qgsrasterpyramid.h"
+#include "qgsrasterpyramidbuildertask.h"
 #include "qgsrasterrange.h"
 #include "qgsrasterrenderer.h"
 #include "qgsrasterrendererregistry.h"
@@ -1134,9 +1135,6 @@ void QgsRasterLayerProperties::buttonBuildPyramids_clicked()
 {
   QgsRasterDataProvider *provider = mRasterLayer->dataProvider();
 
-  std::unique_ptr< QgsRasterBlockFeedback > feedback( new QgsRasterBlockFeedback() );
-
-  connect( feedback.get(), &QgsRasterBlockFeedback::progressChanged, mPyramidProgress, &QProgressBar::setValue );
   //
   // Go through the list marking any files that are selected in the listview
   // as true so that we can generate pyramids for them.
@@ -1156,22 +1154,37 @@ void QgsRasterLayerProperties::buttonBuildPyramids_clicked()
   mySettings.setValue( prefix + "resampling", resamplingMethod );
 
   //
-  // Ask raster layer to build the pyramids
+  // Build the pyramids in a background task, so that the layer can still be used meanwhile
   //
+  QgsRasterPyramidBuilderTask *task = new QgsRasterPyramidBuilderTask( provider->name(), provider->dataSourceUri(),
+      myPyramidList, resamplingMethod,
+      ( QgsRaster::RasterPyramidsFormat ) cbxPyramidsFormat->currentIndex() );
 
-  // let the user know we're going to possibly be taking a while
-  QApplication::setOverrideCursor( Qt::WaitCursor );
-  QString res = provider->buildPyramids(
-                  myPyramidList,
-                  resamplingMethod,
-                  ( QgsRaster::RasterPyramidsFormat ) cbxPyramidsFormat->currentIndex(),
-                  QStringList(),
-                  feedback.get() );
-  QApplication::restoreOverrideCursor();
-  mPyramidProgress->setValue( 0 );
-  buttonBuildPyramids->setEnabled( false );
-  if ( !res.isNull() )
+  connect( task, &QgsTask::progressChanged, mPyramidProgress, [this]( double progress )
+  {
+    mPyramidProgress->setValue( static_cast< int >( progress ) );
+  } );
+
+  // reload the layer first, so that it reads the new overviews even if the dialog is closed
+  QgsRasterLayer *layer = mRasterLayer;
+  connect( task, &QgsRasterPyramidBuilderTask::pyramidsBuilt, layer, [layer]
+  {
+    layer->reload();
+    layer->triggerRepaint();
+  } );
+
+  connect( task, &QgsRasterPyramidBuilderTask::pyramidsBuilt, this, [this]
   {
+    mPyramidProgress->setValue( 0 );
+    populatePyramidList();
+
+    //populate the metadata tab's text browser widget with gdal metadata info
+    updateInformationContent();
+  } );
+
+  connect( task, &QgsRasterPyramidBuilderTask::errorOccurred, this, [this]( const QString & res )
+  {
+    mPyramidProgress->setValue( 0 );
     if ( res == QLatin1String( "CANCELED" ) )
     {
       // user canceled
@@ -1203,19 +1216,25 @@ void QgsRasterLayerProperties::buttonBuildPyramids_clicked()
                             tr( "Building pyramid overviews is not supported on this type of raster." ) );
     }
 
-  }
+    // Need to rebuild list as some or all pyramids may have failed to build
+    populatePyramidList();
+  } );
 
+  buttonBuildPyramids->setEnabled( false );
+  QgsApplication::taskManager()->addTask( task );
+}
+
+void QgsRasterLayerProperties::populatePyramidList()
+{
   //
   // repopulate the pyramids list
   //
   lbxPyramidResolutions->clear();
-  // Need to rebuild list as some or all pyramids may have failed to build
-  myPyramidList = provider->buildPyramidList();
+  const QList< QgsRasterPyramid > myPyramidList = mRasterLayer->dataProvider()->buildPyramidList();
   QIcon myPyramidPixmap( QgsApplication::getThemeIcon( "/mIconPyramid.svg" ) );
   QIcon myNoPyramidPixmap( QgsApplication::getThemeIcon( "/mIconNoPyramid.svg" ) );
 
-  QList< QgsRasterPyramid >::iterator myRasterPyramidIterator;
-  for ( const QgsRasterPyramid &pyramid : std::as_const( myPyramidList ) )
+  for ( const QgsRasterPyramid &pyramid : myPyramidList )
   {
     if ( pyramid.getExists() )
     {
@@ -1230,13 +1249,6 @@ void QgsRasterLayerProperties::buttonBuildPyramids_clicked()
                                       QString::number( pyramid.getYDim() ) ) );
     }
   }
-  //update the legend pixmap
-  // pixmapLegend->setPixmap( mRasterLayer->legendAsPixmap() );
-  // pixmapLegend->setScaledContents( true );
-  // pixmapLegend->repaint();
-
-  //populate the metadata tab's text browser widget with gdal metadata info
-  updateInformationContent();
 }
 
 void QgsRasterLayerProperties::urlClicked( const QUrl &url )
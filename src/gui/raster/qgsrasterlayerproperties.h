@@ -228,6 +228,9 @@ class GUI_EXPORT QgsRasterLayerProperties : public QgsOptionsDialogBase, private
      */
     void updateInformationContent();
 
+    //! Repopulates the pyramids list from the overviews of the layer's data provider
+    void populatePyramidList();
+
     void setupTransparencyTable( int nBands );
 
     //! \brief Clear the current transparency table and populate the table with the correct types for current drawing mode and data type
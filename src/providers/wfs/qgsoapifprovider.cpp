@@ -612,6 +612,18 @@ void QgsOapifFeatureDownloaderImpl::createProgressDialog()
   CONNECT_PROGRESS_DIALOG( QgsOapifFeatureDownloaderImpl );
 }
 
+struct QgsOapifFeatureDownloaderImpl::PendingItemsRequest
+{
+  PendingItemsRequest( const QgsDataSourceUri &uri, const QString &url )
+    : request( uri, url )
+  {}
+
+  QgsOapifItemsRequest request;
+
+  //! Whether gotResponse() has been emitted
+  bool finished = false;
+};
+
 void QgsOapifFeatureDownloaderImpl::run( bool serializeFeatures, int maxFeatures )
 {
   QEventLoop loop;
@@ -692,6 +704,24 @@ void QgsOapifFeatureDownloaderImpl::run( bool serializeFeatures, int maxFeatures
 
   url = mShared->appendExtraQueryParameters( url );
 
+  // Pages are chained through opaque "next" links, so they cannot be fetched
+  // out of order. But as soon as a page has been parsed and we know the URL of
+  // the next one, we issue its request so that it downloads while the features
+  // of the current page are converted and serialized into the cache.
+  std::unique_ptr< PendingItemsRequest > nextRequest;
+  const auto issueRequest = [this, &loop]( const QString & requestUrl )
+  {
+    std::unique_ptr< PendingItemsRequest > pending = std::make_unique< PendingItemsRequest >( mShared->mURI.uri(), requestUrl );
+    PendingItemsRequest *pendingPtr = pending.get();
+    connect( &pending->request, &QgsOapifItemsRequest::gotResponse, &loop, [pendingPtr, &loop]
+    {
+      pendingPtr->finished = true;
+      loop.quit();
+    } );
+    pending->request.request( false /* synchronous*/, true /* forceRefresh */ );
+    return pending;
+  };
+
   while ( !url.isEmpty() )
   {
 
@@ -700,16 +730,16 @@ void QgsOapifFeatureDownloaderImpl::run( bool serializeFeatures, int maxFeatures
       break;
     }
 
-    QgsOapifItemsRequest itemsRequest( mShared->mURI.uri(), url );
-    connect( &itemsRequest, &QgsOapifItemsRequest::gotResponse, &loop, &QEventLoop::quit );
-    itemsRequest.request( false /* synchronous*/, true /* forceRefresh */ );
-    loop.exec( QEventLoop::ExcludeUserInputEvents );
+    std::unique_ptr< PendingItemsRequest > currentRequest = nextRequest ? std::move( nextRequest ) : issueRequest( url );
+    if ( !currentRequest->finished && !mStop )
+      loop.exec( QEventLoop::ExcludeUserInputEvents );
     if ( mStop )
     {
       interrupted = true;
       success = false;
       break;
     }
+    const QgsOapifItemsRequest &itemsRequest = currentRequest->request;
     if ( itemsRequest.errorCode() != QgsBaseNetworkRequest::NoError )
     {
       errorMessage = itemsRequest.errorMessage();
@@ -723,6 +753,12 @@ void QgsOapifFeatureDownloaderImpl::run( bool serializeFeatures, int maxFeatures
     url = itemsRequest.nextUrl();
     url = mShared->appendExtraQueryParameters( url );
 
+    if ( !url.isEmpty() && mShared->mPageSize > 0 &&
+         ( maxTotalFeatures <= 0 || totalDownloadedFeatureCount + static_cast< qint64 >( itemsRequest.features().size() ) < maxTotalFeatures ) )
+    {
+      nextRequest = issueRequest( url );
+    }
+
     // Consider if we should display a progress dialog
     // We can only do that if we know how many features will be downloaded
     if ( mNumberMatched < 0 && !mTimer && useProgressDialog && itemsRequest.numberMatched() > 0 )
@@ -230,6 +230,13 @@ class QgsOapifFeatureDownloaderImpl final: public QObject, public QgsFeatureDown
 
   private:
 
+    /**
+     * An items request, possibly still in flight. Pages are chained through their next links,
+     * so only the page following the one being processed is prefetched. Features are still
+     * converted and cached as they were before, a page at a time.
+     */
+    struct PendingItemsRequest;
+
     //! Mutable data shared between provider, feature sources and downloader.
     QgsOapifSharedData *mShared = nullptr;
 
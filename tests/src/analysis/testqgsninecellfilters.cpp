@@ -22,12 +22,16 @@
 #include "qgstotalcurvaturefilter.h"
 #include "qgsapplication.h"
 #include "qgssettings.h"
+#include "qgsogrutils.h"
 
 #ifdef HAVE_OPENCL
 #include "qgsopenclutils.h"
 #endif
 
 #include <QDir>
+#include <QThread>
+
+#include <set>
 
 // If true regenerate raster reference images
 const bool REGENERATE_REFERENCES = false;
@@ -47,6 +51,8 @@ class TestNineCellFilters : public QObject
     void testAspect();
     void testRuggedness();
     void testTotalCurvature();
+    void testMatchesWindowCalculation();
+    void testSerialWithoutConcurrentRows();
 #ifdef HAVE_OPENCL
     void testHillshadeCl();
     void testSlopeCl();
@@ -215,6 +221,81 @@ void TestNineCellFilters::testTotalCurvature()
   _testAlg<QgsTotalCurvatureFilter>( QStringLiteral( "totalcurvature" ) );
 }
 
+void TestNineCellFilters::testMatchesWindowCalculation()
+{
+#ifdef HAVE_OPENCL
+  QgsOpenClUtils::setEnabled( false );
+#endif
+  // the raster is processed in blocks of rows on several threads, every cell must still
+  // get exactly the value of its own 3x3 window, including on the rows next to block boundaries
+  const QString tmpFile( tempFile( QStringLiteral( "slope_windows" ) ) );
+  QgsSlopeFilter filter( SRC_FILE, tmpFile, QStringLiteral( "GTiff" ) );
+  QCOMPARE( filter.processRaster(), 0 );
+
+  gdal::dataset_unique_ptr input( GDALOpen( SRC_FILE.toUtf8().constData(), GA_ReadOnly ) );
+  gdal::dataset_unique_ptr output( GDALOpen( tmpFile.toUtf8().constData(), GA_ReadOnly ) );
+  QVERIFY( input );
+  QVERIFY( output );
+  const int xSize = GDALGetRasterXSize( input.get() );
+  const int ySize = GDALGetRasterYSize( input.get() );
+  QVERIFY( ySize > 128 );
+
+  // input with a border of nodata values
+  const float nodata = static_cast< float >( filter.inputNodataValue() );
+  std::vector< float > in( static_cast< std::size_t >( xSize + 2 ) * ( ySize + 2 ), nodata );
+  for ( int y = 0; y < ySize; ++y )
+  {
+    QCOMPARE( GDALRasterIO( GDALGetRasterBand( input.get(), 1 ), GF_Read, 0, y, xSize, 1, &in[( y + 1 ) * ( xSize + 2 ) + 1], xSize, 1, GDT_Float32, 0, 0 ), CE_None );
+  }
+  std::vector< float > out( static_cast< std::size_t >( xSize ) * ySize );
+  QCOMPARE( GDALRasterIO( GDALGetRasterBand( output.get(), 1 ), GF_Read, 0, 0, xSize, ySize, out.data(), xSize, ySize, GDT_Float32, 0, 0 ), CE_None );
+
+  for ( int y = 0; y < ySize; ++y )
+  {
+    float *row1 = &in[ static_cast< std::size_t >( y ) * ( xSize + 2 ) ];
+    float *row2 = row1 + xSize + 2;
+    float *row3 = row2 + xSize + 2;
+    for ( int x = 0; x < xSize; ++x )
+    {
+      const float expected = filter.processNineCellWindow( &row1[x], &row1[x + 1], &row1[x + 2],
+                             &row2[x], &row2[x + 1], &row2[x + 2],
+                             &row3[x], &row3[x + 1], &row3[x + 2] );
+      QCOMPARE( out[ static_cast< std::size_t >( y ) * xSize + x ], expected );
+    }
+  }
+}
+
+//! Filter which does not opt in to concurrent rows, and whose window calculation is not thread safe
+class TestSerialFilter : public QgsNineCellFilter
+{
+  public:
+    using QgsNineCellFilter::QgsNineCellFilter;
+
+    float processNineCellWindow( float *, float *, float *, float *, float *x22, float *, float *, float *, float * ) override
+    {
+      threads.insert( QThread::currentThread() );
+      ++count;
+      return *x22;
+    }
+
+    std::set< QThread * > threads;
+    long long count = 0;
+};
+
+void TestNineCellFilters::testSerialWithoutConcurrentRows()
+{
+#ifdef HAVE_OPENCL
+  QgsOpenClUtils::setEnabled( false );
+#endif
+  const QString tmpFile( tempFile( QStringLiteral( "serial" ) ) );
+  TestSerialFilter filter( SRC_FILE, tmpFile, QStringLiteral( "GTiff" ) );
+  QCOMPARE( filter.processRaster(), 0 );
+
+  gdal::dataset_unique_ptr input( GDALOpen( SRC_FILE.toUtf8().constData(), GA_ReadOnly ) );
+  QVERIFY( input );
+  QCOMPARE( filter.count, static_cast< long long >( GDALGetRasterXSize( input.get() ) ) * GDALGetRasterYSize( input.get() ) );
+  QCOMPARE( filter.threads.size(), static_cast< std::size_t >( 1 ) );
+}
 
 QGSTEST_MAIN( TestNineCellFilters )
 
@@ -61,6 +61,10 @@
 #include "qgsmarkersymbol.h"
 #include "qgsfillsymbol.h"
 
+#include "qgsspatialindex.h"
+
+#include <QThreadPool>
+
 class TestQgsProcessingAlgs: public QObject
 {
     Q_OBJECT
@@ -183,6 +187,10 @@ class TestQgsProcessingAlgs: public QObject
     void fileDownloader();
 
     void rasterize();
+    void burnVectorToRaster();
+
+    void overlayDeterministic();
+    void overlayPersistentIndex();
 
   private:
 
@@ -6633,6 +6641,242 @@ void TestQgsProcessingAlgs::rasterize()
   QVERIFY( checker.compareImages( "rasterize", 500 ) );
 }
 
+void TestQgsProcessingAlgs::burnVectorToRaster()
+{
+  std::unique_ptr< QgsProcessingAlgorithm > alg( QgsApplication::processingRegistry()->createAlgorithmById( QStringLiteral( "native:burnvectortoraster" ) ) );
+  QVERIFY( alg != nullptr );
+
+  // memory layers only accept features of their own geometry type
+  auto createLayer = []( const QString &geometryType, const QStringList &wkts, const QList< double > &values ) -> std::unique_ptr< QgsVectorLayer >
+  {
+    std::unique_ptr< QgsVectorLayer > layer = std::make_unique< QgsVectorLayer >( QStringLiteral( "%1?crs=EPSG:3857&field=value:double" ).arg( geometryType ), QStringLiteral( "burn" ), QStringLiteral( "memory" ) );
+    QgsFeatureList features;
+    for ( int i = 0; i < wkts.size(); ++i )
+    {
+      QgsFeature feature( layer->fields() );
+      feature.setGeometry( QgsGeometry::fromWkt( wkts.at( i ) ) );
+      feature.setAttribute( 0, values.at( i ) );
+      features << feature;
+    }
+    if ( !layer->isValid() || !layer->dataProvider()->addFeatures( features ) )
+      return nullptr;
+    return layer;
+  };
+
+  std::unique_ptr< QgsVectorLayer > polygons = createLayer( QStringLiteral( "Polygon" ), QStringList() << QStringLiteral( "Polygon ((0 0, 4 0, 4 4, 0 4, 0 0))" )
+      << QStringLiteral( "Polygon ((2 2, 6 2, 6 6, 2 6, 2 2))" ), QList< double >() << 5 << 3 );
+  QVERIFY( polygons );
+  std::unique_ptr< QgsVectorLayer > lines = createLayer( QStringLiteral( "LineString" ), QStringList() << QStringLiteral( "LineString (0.5 7.5, 7.5 7.5)" ), QList< double >() << 10 );
+  QVERIFY( lines );
+  std::unique_ptr< QgsVectorLayer > points = createLayer( QStringLiteral( "Point" ), QStringList() << QStringLiteral( "Point (9.5 9.5)" ), QList< double >() << 7 );
+  QVERIFY( points );
+
+  QVariantMap parameters;
+  parameters.insert( QStringLiteral( "FIELD" ), QStringLiteral( "value" ) );
+  parameters.insert( QStringLiteral( "EXTENT" ), QStringLiteral( "0,10,0,10 [EPSG:3857]" ) );
+  parameters.insert( QStringLiteral( "PIXEL_SIZE" ), 1 );
+  parameters.insert( QStringLiteral( "NODATA" ), -1 );
+  parameters.insert( QStringLiteral( "OUTPUT" ), QgsProcessing::TEMPORARY_OUTPUT );
+
+  std::unique_ptr< QgsProcessingContext > context = std::make_unique< QgsProcessingContext >();
+  QgsProcessingFeedback feedback;
+  bool ok = false;
+
+  auto burn = [&]( QgsVectorLayer * layer, int mergeRule ) -> std::unique_ptr< QgsRasterBlock >
+  {
+    parameters.insert( QStringLiteral( "INPUT" ), QVariant::fromValue( layer ) );
+    parameters.insert( QStringLiteral( "MERGE_RULE" ), mergeRule );
+    const QVariantMap results = alg->run( parameters, *context, &feedback, &ok );
+    if ( !ok )
+      return nullptr;
+    QgsRasterLayer output( results.value( QStringLiteral( "OUTPUT" ) ).toString(), QStringLiteral( "output" ), QStringLiteral( "gdal" ) );
+    if ( !output.isValid() || output.width() != 10 || output.height() != 10 )
+      return nullptr;
+    return std::unique_ptr< QgsRasterBlock >( output.dataProvider()->block( 1, output.extent(), 10, 10 ) );
+  };
+
+  // maximum
+  std::unique_ptr< QgsRasterBlock > block = burn( polygons.get(), 2 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 9, 0 ), 5.0 );
+  QCOMPARE( block->value( 6, 2 ), 5.0 );
+  QCOMPARE( block->value( 4, 5 ), 3.0 );
+  QVERIFY( block->isNoData( 9, 9 ) );
+  QVERIFY( block->isNoData( 3, 5 ) );
+
+  // sum
+  block = burn( polygons.get(), 3 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 6, 2 ), 8.0 );
+  QCOMPARE( block->value( 7, 3 ), 8.0 );
+  QCOMPARE( block->value( 8, 3 ), 5.0 );
+
+  // last feature
+  block = burn( polygons.get(), 0 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 6, 2 ), 3.0 );
+  QCOMPARE( block->value( 9, 0 ), 5.0 );
+
+  // lines burn every cell they cross
+  block = burn( lines.get(), 0 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 2, 0 ), 10.0 );
+  QCOMPARE( block->value( 2, 7 ), 10.0 );
+  QVERIFY( block->isNoData( 2, 8 ) );
+  QVERIFY( block->isNoData( 3, 0 ) );
+
+  // points burn the cell containing them
+  block = burn( points.get(), 0 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 0, 9 ), 7.0 );
+  QVERIFY( block->isNoData( 0, 8 ) );
+  QVERIFY( block->isNoData( 1, 9 ) );
+
+  // all touched, with a fixed value
+  parameters.insert( QStringLiteral( "FIELD" ), QVariant() );
+  parameters.insert( QStringLiteral( "BURN" ), 2 );
+  parameters.insert( QStringLiteral( "ALL_TOUCHED" ), true );
+  block = burn( polygons.get(), 3 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 9, 0 ), 2.0 );
+  QCOMPARE( block->value( 6, 2 ), 4.0 );
+  // crossed by the boundary of the first polygon, without containing its center
+  QCOMPARE( block->value( 6, 4 ), 4.0 );
+  QVERIFY( block->isNoData( 3, 7 ) );
+
+  // the nodata value must be representable in the output data type
+  parameters.insert( QStringLiteral( "OUTPUT_TYPE" ), 0 );
+  parameters.insert( QStringLiteral( "NODATA" ), -9999 );
+  QVERIFY( !burn( polygons.get(), 3 ) );
+  QVERIFY( !ok );
+  parameters.insert( QStringLiteral( "NODATA" ), 0.5 );
+  QVERIFY( !burn( polygons.get(), 3 ) );
+  QVERIFY( !ok );
+  parameters.insert( QStringLiteral( "NODATA" ), 255 );
+  block = burn( polygons.get(), 3 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 6, 2 ), 4.0 );
+  QVERIFY( block->isNoData( 3, 7 ) );
+
+  // values weighted by the covered fraction of the cells
+  parameters.insert( QStringLiteral( "OUTPUT_TYPE" ), 5 );
+  parameters.insert( QStringLiteral( "NODATA" ), -1 );
+  parameters.insert( QStringLiteral( "FIELD" ), QStringLiteral( "value" ) );
+  parameters.insert( QStringLiteral( "ALL_TOUCHED" ), false );
+  parameters.insert( QStringLiteral( "COVERAGE_FRACTION" ), true );
+  std::unique_ptr< QgsVectorLayer > offset = createLayer( QStringLiteral( "Polygon" ), QStringList() << QStringLiteral( "Polygon ((0.5 0.5, 1.5 0.5, 1.5 1.5, 0.5 1.5, 0.5 0.5))" )
+      << QStringLiteral( "Polygon ((5 5, 9 5, 9 9, 5 9, 5 5),(6 6, 6.5 6, 6.5 7, 6 7, 6 6))" ), QList< double >() << 4 << 8 );
+  QVERIFY( offset );
+  block = burn( offset.get(), 3 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 9, 0 ), 1.0 );
+  QCOMPARE( block->value( 9, 1 ), 1.0 );
+  QCOMPARE( block->value( 8, 0 ), 1.0 );
+  QCOMPARE( block->value( 8, 1 ), 1.0 );
+  QVERIFY( block->isNoData( 7, 0 ) );
+  QVERIFY( block->isNoData( 9, 2 ) );
+  QCOMPARE( block->value( 2, 7 ), 8.0 );
+  // half of the cell is in the hole
+  QCOMPARE( block->value( 3, 6 ), 4.0 );
+  QVERIFY( block->isNoData( 0, 5 ) );
+
+  // fully covered cells burn their whole value, cells only touched by the boundary are not burned
+  block = burn( polygons.get(), 3 );
+  QVERIFY( block );
+  QCOMPARE( block->value( 9, 0 ), 5.0 );
+  QCOMPARE( block->value( 6, 2 ), 8.0 );
+  QVERIFY( block->isNoData( 5, 0 ) );
+}
+
+void TestQgsProcessingAlgs::overlayDeterministic()
+{
+  // more features in A than are overlaid in a single batch, each overlapping several features of B
+  std::unique_ptr< QgsVectorLayer > layerA = std::make_unique< QgsVectorLayer >( QStringLiteral( "Polygon?crs=EPSG:3857&field=a:integer" ), QStringLiteral( "a" ), QStringLiteral( "memory" ) );
+  std::unique_ptr< QgsVectorLayer > layerB = std::make_unique< QgsVectorLayer >( QStringLiteral( "Polygon?crs=EPSG:3857&field=b:integer" ), QStringLiteral( "b" ), QStringLiteral( "memory" ) );
+  QVERIFY( layerA->isValid() );
+  QVERIFY( layerB->isValid() );
+
+  QgsFeatureList featuresA;
+  for ( int row = 0; row < 40; ++row )
+  {
+    for ( int col = 0; col < 40; ++col )
+    {
+      QgsFeature feature( layerA->fields() );
+      feature.setGeometry( QgsGeometry::fromRect( QgsRectangle( col, row, col + 1, row + 1 ) ) );
+      feature.setAttribute( 0, row * 40 + col );
+      featuresA << feature;
+    }
+  }
+  QVERIFY( layerA->dataProvider()->addFeatures( featuresA ) );
+
+  QgsFeatureList featuresB;
+  for ( int row = 0; row < 14; ++row )
+  {
+    for ( int col = 0; col < 14; ++col )
+    {
+      if ( ( row + col ) % 5 == 0 )
+        continue;
+
+      QgsFeature feature( layerB->fields() );
+      feature.setGeometry( QgsGeometry::fromRect( QgsRectangle( col * 3 - 0.5, row * 3 - 0.5, col * 3 + 2.8, row * 3 + 2.8 ) ) );
+      feature.setAttribute( 0, row * 14 + col );
+      featuresB << feature;
+    }
+  }
+  QVERIFY( layerB->dataProvider()->addFeatures( featuresB ) );
+
+  auto runOverlay = [&]( const QString & algorithmId, int maxThreads ) -> QStringList
+  {
+    std::unique_ptr< QgsProcessingAlgorithm > alg( QgsApplication::processingRegistry()->createAlgorithmById( algorithmId ) );
+    if ( !alg )
+      return QStringList();
+
+    QVariantMap parameters;
+    parameters.insert( QStringLiteral( "INPUT" ), QVariant::fromValue( layerA.get() ) );
+    parameters.insert( QStringLiteral( "OVERLAY" ), QVariant::fromValue( layerB.get() ) );
+    parameters.insert( QStringLiteral( "OUTPUT" ), QStringLiteral( "memory:" ) );
+
+    const int previousMaxThreads = QThreadPool::globalInstance()->maxThreadCount();
+    QThreadPool::globalInstance()->setMaxThreadCount( maxThreads );
+
+    std::unique_ptr< QgsProcessingContext > context = std::make_unique< QgsProcessingContext >();
+    QgsProcessingFeedback feedback;
+    bool ok = false;
+    const QVariantMap results = alg->run( parameters, *context, &feedback, &ok );
+    QThreadPool::globalInstance()->setMaxThreadCount( previousMaxThreads );
+    if ( !ok )
+      return QStringList();
+
+    QStringList output;
+    QgsVectorLayer *outputLayer = qobject_cast< QgsVectorLayer * >( context->getMapLayer( results.value( QStringLiteral( "OUTPUT" ) ).toString() ) );
+    if ( !outputLayer )
+      return QStringList();
+
+    QgsFeatureIterator it = outputLayer->getFeatures();
+    QgsFeature feature;
+    while ( it.nextFeature( feature ) )
+    {
+      QStringList attributes;
+      for ( const QVariant &value : feature.attributes() )
+        attributes << value.toString();
+      output << QStringLiteral( "%1 %2" ).arg( attributes.join( ',' ), feature.geometry().asWkt( 6 ) );
+    }
+    return output;
+  };
+
+  const QStringList algorithms = QStringList() << QStringLiteral( "native:intersection" ) << QStringLiteral( "native:difference" );
+  for ( const QString &algorithmId : algorithms )
+  {
+    const QStringList serial = runOverlay( algorithmId, 1 );
+    QVERIFY( !serial.isEmpty() );
+    for ( int i = 0; i < 3; ++i )
+    {
+      const QStringList parallel = runOverlay( algorithmId, 8 );
+      QCOMPARE( parallel, serial );
+    }
+  }
+}
+
 void TestQgsProcessingAlgs::exportMeshTimeSeries()
 {
   std::unique_ptr< QgsProcessingAlgorithm > alg( QgsApplication::processingRegistry()->createAlgorithmById( QStringLiteral( "native:meshexporttimeseries" ) ) );
@@ -6776,5 +7020,74 @@ bool TestQgsProcessingAlgs::imageCheck( const QString &testName, const QString &
   return equal;
 }
 
+void TestQgsProcessingAlgs::overlayPersistentIndex()
+{
+  QTemporaryDir dir;
+  const QString overlayPath = dir.filePath( QStringLiteral( "overlay.geojson" ) );
+  const QString indexPath = QgsSpatialIndex::indexPathForSource( overlayPath );
+
+  auto writeOverlay = [&overlayPath]( int count ) -> bool
+  {
+    QFile file( overlayPath );
+    if ( !file.open( QIODevice::WriteOnly | QIODevice::Truncate ) )
+      return false;
+    QStringList features;
+    for ( int i = 0; i < count; ++i )
+    {
+      features << QStringLiteral( "{\"type\":\"Feature\",\"properties\":{\"b\":%1},\"geometry\":{\"type\":\"Polygon\",\"coordinates\":[[[%2,0],[%3,0],[%3,1],[%2,1],[%2,0]]]}}" )
+                  .arg( i ).arg( i * 2 ).arg( i * 2 + 1.5 );
+    }
+    file.write( QStringLiteral( "{\"type\":\"FeatureCollection\",\"features\":[%1]}" ).arg( features.join( ',' ) ).toUtf8() );
+    return true;
+  };
+
+  std::unique_ptr< QgsVectorLayer > layerA = std::make_unique< QgsVectorLayer >( QStringLiteral( "Polygon?crs=EPSG:4326&field=a:integer" ), QStringLiteral( "a" ), QStringLiteral( "memory" ) );
+  QVERIFY( layerA->isValid() );
+  QgsFeature feature( layerA->fields() );
+  feature.setAttributes( QgsAttributes() << 1 );
+  feature.setGeometry( QgsGeometry::fromWkt( QStringLiteral( "Polygon ((0 0, 10 0, 10 0.5, 0 0.5, 0 0))" ) ) );
+  QVERIFY( layerA->dataProvider()->addFeature( feature ) );
+
+  auto intersect = [&]() -> long
+  {
+    std::unique_ptr< QgsVectorLayer > layerB = std::make_unique< QgsVectorLayer >( overlayPath, QStringLiteral( "b" ), QStringLiteral( "ogr" ) );
+    if ( !layerB->isValid() )
+      return -1;
+
+    std::unique_ptr< QgsProcessingAlgorithm > alg( QgsApplication::processingRegistry()->createAlgorithmById( QStringLiteral( "native:intersection" ) ) );
+    QVariantMap parameters;
+    parameters.insert( QStringLiteral( "INPUT" ), QVariant::fromValue( layerA.get() ) );
+    parameters.insert( QStringLiteral( "OVERLAY" ), QVariant::fromValue( layerB.get() ) );
+    parameters.insert( QStringLiteral( "OUTPUT" ), QStringLiteral( "memory:" ) );
+
+    std::unique_ptr< QgsProcessingContext > context = std::make_unique< QgsProcessingContext >();
+    QgsProcessingFeedback feedback;
+    bool ok = false;
+    const QVariantMap results = alg->run( parameters, *context, &feedback, &ok );
+    if ( !ok )
+      return -1;
+    QgsVectorLayer *outputLayer = qobject_cast< QgsVectorLayer * >( context->getMapLayer( results.value( QStringLiteral( "OUTPUT" ) ).toString() ) );
+    return outputLayer ? outputLayer->featureCount() : -1;
+  };
+
+  // the first run saves the index of the overlay file
+  QVERIFY( writeOverlay( 3 ) );
+  QCOMPARE( intersect(), 3L );
+  QVERIFY( QFileInfo::exists( indexPath ) );
+
+  // later runs load it instead of writing it again
+  QFile index( indexPath );
+  QVERIFY( index.open( QIODevice::ReadWrite ) );
+  const QDateTime indexModified = QDateTime::fromSecsSinceEpoch( QDateTime::currentSecsSinceEpoch() - 3600 );
+  QVERIFY( index.setFileTime( indexModified, QFileDevice::FileModificationTime ) );
+  index.close();
+  QCOMPARE( intersect(), 3L );
+  QCOMPARE( QFileInfo( indexPath ).lastModified(), indexModified );
+
+  QgsSpatialIndex saved;
+  QVERIFY( saved.readFromFile( indexPath, overlayPath ) );
+  QCOMPARE( saved.intersects( QgsRectangle( 0, 0, 10, 1 ) ).size(), 3 );
+}
+
 QGSTEST_MAIN( TestQgsProcessingAlgs )
 #include "testqgsprocessingalgs.moc"
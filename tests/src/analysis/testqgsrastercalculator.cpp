@@ -57,6 +57,7 @@ class TestQgsRasterCalculator : public QObject
 
     void calcWithLayers();
     void calcWithReprojectedLayers();
+    void calcInBlocks();
 
     void errors();
     void toString();
@@ -544,6 +545,79 @@ void TestQgsRasterCalculator::calcWithReprojectedLayers()
   delete block;
 }
 
+void TestQgsRasterCalculator::calcInBlocks()
+{
+  // an output large enough to be calculated in several blocks must match the
+  // row by row evaluation of the node tree
+  QgsRasterCalculatorEntry entry1;
+  entry1.bandNumber = 1;
+  entry1.raster = mpLandsatRasterLayer;
+  entry1.ref = QStringLiteral( "landsat@1" );
+
+  QgsRasterCalculatorEntry entry2;
+  entry2.bandNumber = 2;
+  entry2.raster = mpLandsatRasterLayer;
+  entry2.ref = QStringLiteral( "landsat@2" );
+
+  QVector<QgsRasterCalculatorEntry> entries;
+  entries << entry1 << entry2;
+
+  const QgsRectangle extent = mpLandsatRasterLayer->extent();
+  // two blocks, which split the 200 source rows evenly
+  const int columns = 1024;
+  const int rows = 2048;
+
+  QTemporaryFile tmpFile;
+  tmpFile.open(); // fileName is not available until open
+  QString tmpName = tmpFile.fileName();
+  tmpFile.close();
+
+  // includes divisions by zero and square roots of negative values, which give nodata
+  const QString formula = QStringLiteral( "( \"landsat@1\" - \"landsat@2\" ) / ( \"landsat@1\" + \"landsat@2\" - 265 ) + sqrt( \"landsat@2\" - 139 ) * log10( \"landsat@1\" ) + min( \"landsat@1\", 124.5 )" );
+  QgsRasterCalculator rc( formula,
+                          tmpName,
+                          QStringLiteral( "GTiff" ),
+                          extent, mpLandsatRasterLayer->crs(), columns, rows, entries,
+                          QgsProject::instance()->transformContext() );
+  QCOMPARE( static_cast< int >( rc.processCalculation() ), 0 );
+
+  QString error;
+  std::unique_ptr< QgsRasterCalcNode > calcNode( QgsRasterCalcNode::parseRasterCalcString( formula, error ) );
+  QVERIFY( calcNode );
+  std::unique_ptr< QgsRasterBlock > band1( mpLandsatRasterLayer->dataProvider()->block( 1, extent, columns, rows ) );
+  std::unique_ptr< QgsRasterBlock > band2( mpLandsatRasterLayer->dataProvider()->block( 2, extent, columns, rows ) );
+  QMap<QString, QgsRasterBlock *> rasterData;
+  rasterData.insert( QStringLiteral( "landsat@1" ), band1.get() );
+  rasterData.insert( QStringLiteral( "landsat@2" ), band2.get() );
+
+  std::unique_ptr< QgsRasterLayer > result = std::make_unique< QgsRasterLayer >( tmpName, QStringLiteral( "result" ) );
+  QCOMPARE( result->width(), columns );
+  QCOMPARE( result->height(), rows );
+  std::unique_ptr< QgsRasterBlock > block( result->dataProvider()->block( 1, extent, columns, rows ) );
+
+  int noDataCount = 0;
+  for ( int row = 0; row < rows; ++row )
+  {
+    QgsRasterMatrix expected( columns, 1, nullptr, -FLT_MAX );
+    QVERIFY( calcNode->calculate( rasterData, expected, row ) );
+    for ( int col = 0; col < columns; ++col )
+    {
+      const double expectedValue = expected.data()[col];
+      if ( expectedValue == expected.nodataValue() )
+      {
+        QVERIFY( block->isNoData( row, col ) );
+        noDataCount++;
+      }
+      else
+      {
+        QCOMPARE( block->value( row, col ), static_cast< double >( static_cast< float >( expectedValue ) ) );
+      }
+    }
+  }
+  QVERIFY( noDataCount > 0 );
+  QVERIFY( noDataCount < columns * rows );
+}
+
 void TestQgsRasterCalculator::findNodes()
 {
 
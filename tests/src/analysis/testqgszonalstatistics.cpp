@@ -23,6 +23,11 @@
 #include "qgszonalstatistics.h"
 #include "qgsproject.h"
 #include "qgsvectorlayerutils.h"
+#include "qgsrasterblock.h"
+#include "qgsrasterdataprovider.h"
+#include "qgsrasterfilewriter.h"
+
+#include <QTemporaryFile>
 
 /**
  * \ingroup UnitTests
@@ -42,6 +47,9 @@ class TestQgsZonalStatistics : public QObject
     void testReprojection();
     void testNoData();
     void testSmallPolygons();
+    void testManyGeometries();
+    void testExactCoverage();
+    void testMultipleTiles();
     void testShortName();
 
   private:
@@ -344,6 +352,171 @@ void TestQgsZonalStatistics::testSmallPolygons()
   QGSCOMPARENEAR( f.attribute( "nmean" ).toDouble(), 864.285638, 0.001 );
 }
 
+void TestQgsZonalStatistics::testManyGeometries()
+{
+  const QString myTestDataPath = QStringLiteral( TEST_DATA_DIR ) + "/zonalstatistics/";
+  std::unique_ptr< QgsRasterLayer > rasterLayer = std::make_unique< QgsRasterLayer >( myTestDataPath + "raster.tif", QStringLiteral( "raster" ), QStringLiteral( "gdal" ) );
+  QVERIFY( rasterLayer->isValid() );
+  QgsRasterDataProvider *provider = rasterLayer->dataProvider();
+  const QgsRectangle extent = provider->extent();
+  const double cellSizeX = rasterLayer->rasterUnitsPerPixelX();
+  const double cellSizeY = rasterLayer->rasterUnitsPerPixelY();
+
+  // zones of various sizes, some smaller than a pixel, overlapping each other and the raster edges
+  QVector< QgsGeometry > geometries;
+  for ( int i = 0; i < 60; ++i )
+  {
+    const double x = extent.xMinimum() - cellSizeX + ( extent.width() + cellSizeX ) * ( ( i * 37 ) % 100 ) / 100.0;
+    const double y = extent.yMinimum() - cellSizeY + ( extent.height() + cellSizeY ) * ( ( i * 61 ) % 100 ) / 100.0;
+    const double width = cellSizeX * ( 0.3 + ( i % 5 ) * 1.7 );
+    const double height = cellSizeY * ( 0.4 + ( i % 7 ) * 1.3 );
+    if ( i % 3 == 0 )
+    {
+      geometries << QgsGeometry::fromPolygonXY( QgsPolygonXY() << ( QgsPolylineXY() << QgsPointXY( x, y ) << QgsPointXY( x + width, y )
+                    << QgsPointXY( x, y + height ) << QgsPointXY( x, y ) ) );
+    }
+    else
+    {
+      geometries << QgsGeometry::fromRect( QgsRectangle( x, y, x + width, y + height ) );
+    }
+  }
+  const QgsRectangle center = extent.buffered( -extent.width() / 4 );
+  geometries << QgsGeometry::fromRect( center ).difference( QgsGeometry::fromRect( center.buffered( -center.width() / 4 ) ) );
+  geometries << QgsGeometry::fromRect( QgsRectangle( extent.xMinimum(), extent.yMinimum(), extent.xMinimum() + 3 * cellSizeX, extent.yMinimum() + 2 * cellSizeY ) )
+             .combine( QgsGeometry::fromRect( QgsRectangle( extent.xMaximum() - 2 * cellSizeX, extent.yMaximum() - 3 * cellSizeY, extent.xMaximum(), extent.yMaximum() ) ) );
+  geometries << QgsGeometry();
+  geometries << QgsGeometry::fromRect( QgsRectangle( extent.xMaximum() + 1, extent.yMaximum() + 1, extent.xMaximum() + 2, extent.yMaximum() + 2 ) );
+
+  const QList< QMap<QgsZonalStatistics::Statistic, QVariant> > results = QgsZonalStatistics::calculateStatistics( provider, geometries, cellSizeX, cellSizeY, 1, QgsZonalStatistics::All );
+  QCOMPARE( results.size(), geometries.size() );
+  for ( int i = 0; i < geometries.size(); ++i )
+  {
+    // a single sweep must give the same results as calculating each zone separately
+    const QMap<QgsZonalStatistics::Statistic, QVariant> expected = QgsZonalStatistics::calculateStatistics( provider, geometries.at( i ), cellSizeX, cellSizeY, 1, QgsZonalStatistics::All );
+    QCOMPARE( results.at( i ).keys(), expected.keys() );
+    for ( auto it = expected.constBegin(); it != expected.constEnd(); ++it )
+    {
+      QGSCOMPARENEAR( results.at( i ).value( it.key() ).toDouble(), it.value().toDouble(), 0.000001 );
+    }
+  }
+  QVERIFY( results.at( geometries.size() - 1 ).isEmpty() );
+  QVERIFY( results.at( geometries.size() - 2 ).isEmpty() );
+}
+
+void TestQgsZonalStatistics::testExactCoverage()
+{
+  const QString myTestDataPath = QStringLiteral( TEST_DATA_DIR ) + "/zonalstatistics/";
+  std::unique_ptr< QgsRasterLayer > rasterLayer = std::make_unique< QgsRasterLayer >( myTestDataPath + "raster.tif", QStringLiteral( "raster" ), QStringLiteral( "gdal" ) );
+  QVERIFY( rasterLayer->isValid() );
+  QgsRasterDataProvider *provider = rasterLayer->dataProvider();
+  const QgsRectangle extent = provider->extent();
+  const double cellSizeX = rasterLayer->rasterUnitsPerPixelX();
+  const double cellSizeY = rasterLayer->rasterUnitsPerPixelY();
+
+  // two full pixel rows and columns, plus a quarter of a third column
+  const double left = extent.xMinimum() + 2 * cellSizeX;
+  const double top = extent.yMaximum() - 2 * cellSizeY;
+  const QgsGeometry zone = QgsGeometry::fromRect( QgsRectangle( left, top - 2 * cellSizeY, left + 2.25 * cellSizeX, top ) );
+
+  std::unique_ptr< QgsRasterBlock > block( provider->block( 1, QgsRectangle( left, top - 2 * cellSizeY, left + 3 * cellSizeX, top ), 3, 2 ) );
+  double expectedCount = 0;
+  double expectedSum = 0;
+  double expectedCenterCount = 0;
+  for ( int row = 0; row < 2; ++row )
+  {
+    for ( int column = 0; column < 3; ++column )
+    {
+      bool isNoData = false;
+      const double value = block->valueAndNoData( row, column, isNoData );
+      if ( isNoData )
+        continue;
+      const double weight = column == 2 ? 0.25 : 1.0;
+      expectedCount += weight;
+      expectedSum += value * weight;
+      if ( column < 2 )
+        expectedCenterCount++;
+    }
+  }
+
+  const QList< QMap<QgsZonalStatistics::Statistic, QVariant> > results = QgsZonalStatistics::calculateStatistics( provider, QVector< QgsGeometry >() << zone, cellSizeX, cellSizeY, 1,
+      QgsZonalStatistics::Count | QgsZonalStatistics::Sum, true );
+  QCOMPARE( results.size(), 1 );
+  QGSCOMPARENEAR( results.at( 0 ).value( QgsZonalStatistics::Count ).toDouble(), expectedCount, 0.000001 );
+  QGSCOMPARENEAR( results.at( 0 ).value( QgsZonalStatistics::Sum ).toDouble(), expectedSum, 0.0001 );
+
+  // by default the third column does not count, as its centers are outside the zone
+  const QMap<QgsZonalStatistics::Statistic, QVariant> centers = QgsZonalStatistics::calculateStatistics( provider, QVector< QgsGeometry >() << zone, cellSizeX, cellSizeY, 1,
+      QgsZonalStatistics::Count, false ).at( 0 );
+  QCOMPARE( centers.value( QgsZonalStatistics::Count ).toDouble(), expectedCenterCount );
+}
+
+void TestQgsZonalStatistics::testMultipleTiles()
+{
+  // a raster spanning 3 x 2 tiles of the sweep, which uses 512 x 512 cell tiles
+  const int nCols = 1100;
+  const int nRows = 700;
+  const QgsRectangle extent( 0, 0, nCols, nRows );
+
+  QTemporaryFile tmpFile( QDir::tempPath() + QStringLiteral( "/zonal_tiles_XXXXXX.tif" ) );
+  tmpFile.open();
+  tmpFile.close();
+
+  QgsRasterFileWriter writer( tmpFile.fileName() );
+  writer.setOutputProviderKey( QStringLiteral( "gdal" ) );
+  writer.setOutputFormat( QStringLiteral( "GTiff" ) );
+  std::unique_ptr< QgsRasterDataProvider > dp( writer.createOneBandRaster( Qgis::DataType::Int16, nCols, nRows, extent, QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:3857" ) ) ) );
+  QVERIFY( dp->isValid() );
+  dp->setNoDataValue( 1, -1 );
+  std::unique_ptr< QgsRasterBlock > block( dp->block( 1, extent, nCols, nRows ) );
+  if ( !dp->isEditable() )
+  {
+    QVERIFY( dp->setEditable( true ) );
+  }
+  for ( int row = 0; row < nRows; row++ )
+  {
+    for ( int col = 0; col < nCols; col++ )
+    {
+      // a band of nodata across the first tile boundary
+      const bool isNoData = col >= 510 && col < 515 && row < 100;
+      block->setValue( row, col, isNoData ? -1 : ( row * 31 + col * 17 ) % 97 );
+    }
+  }
+  QVERIFY( dp->writeBlock( block.get(), 1 ) );
+  QVERIFY( dp->setEditable( false ) );
+  dp.reset();
+
+  std::unique_ptr< QgsRasterLayer > rasterLayer = std::make_unique< QgsRasterLayer >( tmpFile.fileName(), QStringLiteral( "raster" ), QStringLiteral( "gdal" ) );
+  QVERIFY( rasterLayer->isValid() );
+  QgsRasterDataProvider *provider = rasterLayer->dataProvider();
+
+  // zones crossing the tile boundaries at columns 512 and 1024 and row 512 (y = 188)
+  QVector< QgsGeometry > geometries;
+  geometries << QgsGeometry::fromRect( QgsRectangle( 500, 180, 531, 196 ) );
+  geometries << QgsGeometry::fromRect( QgsRectangle( 505, 0, 520, 700 ) );
+  geometries << QgsGeometry::fromRect( QgsRectangle( 1000.5, 100.5, 1100, 300.5 ) );
+  geometries << QgsGeometry::fromRect( QgsRectangle( 0, 0, 1100, 700 ) );
+  geometries << QgsGeometry::fromRect( QgsRectangle( 300, 50, 900, 450 ) ).difference( QgsGeometry::fromRect( QgsRectangle( 480, 150, 560, 250 ) ) );
+  geometries << QgsGeometry::fromPolygonXY( QgsPolygonXY() << ( QgsPolylineXY() << QgsPointXY( 100, 100 ) << QgsPointXY( 1050, 150 )
+                << QgsPointXY( 600, 650 ) << QgsPointXY( 100, 100 ) ) );
+
+  const QList< QMap<QgsZonalStatistics::Statistic, QVariant> > results = QgsZonalStatistics::calculateStatistics( provider, geometries, 1, 1, 1, QgsZonalStatistics::All );
+  QCOMPARE( results.size(), geometries.size() );
+  for ( int i = 0; i < geometries.size(); ++i )
+  {
+    const QMap<QgsZonalStatistics::Statistic, QVariant> expected = QgsZonalStatistics::calculateStatistics( provider, geometries.at( i ), 1, 1, 1, QgsZonalStatistics::All );
+    QCOMPARE( results.at( i ).keys(), expected.keys() );
+    for ( auto it = expected.constBegin(); it != expected.constEnd(); ++it )
+    {
+      QGSCOMPARENEAR( results.at( i ).value( it.key() ).toDouble(), it.value().toDouble(), 0.000001 );
+    }
+  }
+
+  // cells are counted once, even where a zone spans several tiles
+  QCOMPARE( results.at( 0 ).value( QgsZonalStatistics::Count ).toDouble(), 31.0 * 16.0 );
+  QCOMPARE( results.at( 1 ).value( QgsZonalStatistics::Count ).toDouble(), 15.0 * 700.0 - 5.0 * 100.0 );
+  QCOMPARE( results.at( 3 ).value( QgsZonalStatistics::Count ).toDouble(), 1100.0 * 700.0 - 5.0 * 100.0 );
+}
+
 void TestQgsZonalStatistics::testShortName()
 {
   QCOMPARE( QgsZonalStatistics::shortName( QgsZonalStatistics::Count ), QStringLiteral( "count" ) );
@@ -0,0 +1,224 @@
+/***************************************************************************
+     testqgscoordinatekernels.cpp
+     ----------------------------
+    Date                 : October 2026
+    Copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include "qgstest.h"
+#include <QObject>
+#include <QPolygonF>
+#include <QTransform>
+
+#include "qgscoordinatekernels_p.h"
+#include "qgslinestring.h"
+#include "qgsmaptopixel.h"
+#include "qgspolygon.h"
+
+#include <cmath>
+
+class TestQgsCoordinateKernels : public QObject
+{
+    Q_OBJECT
+
+  private:
+
+    static QVector< double > values( int count, double offset )
+    {
+      QVector< double > res;
+      res.reserve( count );
+      for ( int i = 0; i < count; ++i )
+        res << std::sin( i * 0.37 + offset ) * 100 + i;
+      return res;
+    }
+
+  private slots:
+    void bounds_data();
+    void bounds();
+    void length_data();
+    void length();
+    void crossProductSum_data();
+    void crossProductSum();
+    void affineTransform_data();
+    void affineTransform();
+    void lineString();
+    void mapToPixel();
+
+    void benchmarkBoundingBox();
+    void benchmarkLength();
+    void benchmarkTransform();
+    void benchmarkMapToPixel();
+};
+
+// odd and even counts, to cover both the vectorized loops and their remainders
+
+void TestQgsCoordinateKernels::bounds_data()
+{
+  QTest::addColumn< int >( "count" );
+  for ( int count : { 1, 2, 3, 4, 7, 100, 101 } )
+    QTest::newRow( QString::number( count ).toLatin1() ) << count;
+}
+
+void TestQgsCoordinateKernels::bounds()
+{
+  QFETCH( int, count );
+  const QVector< double > x = values( count, 0 );
+  const QVector< double > y = values( count, 1 );
+
+  double xMin, yMin, xMax, yMax;
+  QgsCoordinateKernels::bounds( x.constData(), y.constData(), count, xMin, yMin, xMax, yMax );
+  QCOMPARE( xMin, *std::min_element( x.begin(), x.end() ) );
+  QCOMPARE( xMax, *std::max_element( x.begin(), x.end() ) );
+  QCOMPARE( yMin, *std::min_element( y.begin(), y.end() ) );
+  QCOMPARE( yMax, *std::max_element( y.begin(), y.end() ) );
+}
+
+void TestQgsCoordinateKernels::length_data()
+{
+  bounds_data();
+}
+
+void TestQgsCoordinateKernels::length()
+{
+  QFETCH( int, count );
+  const QVector< double > x = values( count, 0 );
+  const QVector< double > y = values( count, 1 );
+
+  double expected = 0;
+  for ( int i = 1; i < count; ++i )
+    expected += std::sqrt( ( x[i] - x[i - 1] ) * ( x[i] - x[i - 1] ) + ( y[i] - y[i - 1] ) * ( y[i] - y[i - 1] ) );
+  QGSCOMPARENEAR( QgsCoordinateKernels::length( x.constData(), y.constData(), count ), expected, 1e-8 );
+}
+
+void TestQgsCoordinateKernels::crossProductSum_data()
+{
+  bounds_data();
+}
+
+void TestQgsCoordinateKernels::crossProductSum()
+{
+  QFETCH( int, count );
+  const QVector< double > x = values( count, 0 );
+  const QVector< double > y = values( count, 1 );
+
+  double expected = 0;
+  for ( int i = 0; i + 1 < count; ++i )
+    expected += x[i] * y[i + 1] - y[i] * x[i + 1];
+  QGSCOMPARENEAR( QgsCoordinateKernels::crossProductSum( x.constData(), y.constData(), count ), expected, 1e-6 );
+}
+
+void TestQgsCoordinateKernels::affineTransform_data()
+{
+  bounds_data();
+}
+
+void TestQgsCoordinateKernels::affineTransform()
+{
+  QFETCH( int, count );
+  QVector< double > x = values( count, 0 );
+  QVector< double > y = values( count, 1 );
+  const QVector< double > originalX = x;
+  const QVector< double > originalY = y;
+
+  const QTransform t = QTransform::fromTranslate( 5, -3 ).rotate( 30 ).scale( 2, 0.5 );
+  QgsCoordinateKernels::affineTransform( t, x.data(), y.data(), count );
+
+  QPolygonF interleaved;
+  for ( int i = 0; i < count; ++i )
+    interleaved << QPointF( originalX[i], originalY[i] );
+  QgsCoordinateKernels::affineTransformInterleaved( t, reinterpret_cast< double * >( interleaved.data() ), count );
+
+  for ( int i = 0; i < count; ++i )
+  {
+    const QPointF expected = t.map( QPointF( originalX[i], originalY[i] ) );
+    QGSCOMPARENEAR( x[i], expected.x(), 1e-9 );
+    QGSCOMPARENEAR( y[i], expected.y(), 1e-9 );
+    QGSCOMPARENEAR( interleaved[i].x(), expected.x(), 1e-9 );
+    QGSCOMPARENEAR( interleaved[i].y(), expected.y(), 1e-9 );
+  }
+}
+
+void TestQgsCoordinateKernels::lineString()
+{
+  QgsLineString line( QVector< double >() << 0 << 4 << 4 << 0 << 0, QVector< double >() << 0 << 0 << 3 << 3 << 0 );
+  QCOMPARE( line.boundingBox(), QgsRectangle( 0, 0, 4, 3 ) );
+  QCOMPARE( line.length(), 14.0 );
+
+  QgsPolygon polygon( line.clone() );
+  QCOMPARE( polygon.area(), 12.0 );
+
+  line.transform( QTransform::fromScale( 2, 3 ).translate( 1, 1 ) );
+  QCOMPARE( line.asWkt(), QStringLiteral( "LineString (2 3, 10 3, 10 12, 2 12, 2 3)" ) );
+  QCOMPARE( line.boundingBox(), QgsRectangle( 2, 3, 10, 12 ) );
+}
+
+void TestQgsCoordinateKernels::mapToPixel()
+{
+  const QgsMapToPixel mtp( 2, 50, 50, 100, 80, 30 );
+  QPolygonF polygon;
+  for ( int i = 0; i < 11; ++i )
+    polygon << QPointF( i * 3.5, 100 - i * 2.0 );
+
+  QPolygonF transformed = polygon;
+  mtp.transformInPlace( transformed );
+  QCOMPARE( transformed.size(), polygon.size() );
+  for ( int i = 0; i < polygon.size(); ++i )
+  {
+    const QgsPointXY expected = mtp.transform( polygon[i].x(), polygon[i].y() );
+    QGSCOMPARENEAR( transformed[i].x(), expected.x(), 1e-9 );
+    QGSCOMPARENEAR( transformed[i].y(), expected.y(), 1e-9 );
+  }
+}
+
+void TestQgsCoordinateKernels::benchmarkBoundingBox()
+{
+  const QVector< double > x = values( 100000, 0 );
+  const QVector< double > y = values( 100000, 1 );
+  double xMin, yMin, xMax, yMax;
+  QBENCHMARK
+  {
+    QgsCoordinateKernels::bounds( x.constData(), y.constData(), x.size(), xMin, yMin, xMax, yMax );
+  }
+}
+
+void TestQgsCoordinateKernels::benchmarkLength()
+{
+  const QVector< double > x = values( 100000, 0 );
+  const QVector< double > y = values( 100000, 1 );
+  QBENCHMARK
+  {
+    QgsCoordinateKernels::length( x.constData(), y.constData(), x.size() );
+  }
+}
+
+void TestQgsCoordinateKernels::benchmarkTransform()
+{
+  QVector< double > x = values( 100000, 0 );
+  QVector< double > y = values( 100000, 1 );
+  const QTransform t = QTransform::fromTranslate( 5, -3 ).rotate( 30 );
+  QBENCHMARK
+  {
+    QgsCoordinateKernels::affineTransform( t, x.data(), y.data(), x.size() );
+  }
+}
+
+void TestQgsCoordinateKernels::benchmarkMapToPixel()
+{
+  const QgsMapToPixel mtp( 2, 50, 50, 100, 80, 30 );
+  QPolygonF polygon;
+  for ( int i = 0; i < 100000; ++i )
+    polygon << QPointF( i * 0.5, std::sin( i * 0.1 ) * 100 );
+  QBENCHMARK
+  {
+    mtp.transformInPlace( polygon );
+  }
+}
+
+QGSTEST_MAIN( TestQgsCoordinateKernels )
+#include "testqgscoordinatekernels.moc"
@@ -17,7 +17,9 @@
 #include "qgscoordinatetransform.h"
 #include "qgsapplication.h"
 #include "qgsrectangle.h"
+#include "qgsgeometry.h"
 #include "qgscoordinatetransformcontext.h"
+#include "qgscoordinatetransformgrid.h"
 #include "qgsproject.h"
 #include <QObject>
 #include "qgstest.h"
@@ -32,6 +34,9 @@ class TestQgsCoordinateTransform: public QObject
     void initTestCase();
     void cleanupTestCase();
     void transformBoundingBox();
+    void transformGeometries();
+    void transformGeometriesFallback();
+    void transformGrid();
     void copy();
     void assignment();
     void isValid();
@@ -560,6 +565,147 @@ void TestQgsCoordinateTransform::transformBoundingBox()
   QVERIFY( errorObtained );
 }
 
+void TestQgsCoordinateTransform::transformGeometries()
+{
+  QgsCoordinateTransform tr( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:4326" ) ), QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:3857" ) ), QgsProject::instance() );
+
+  QVector< QgsGeometry > geometries;
+  geometries << QgsGeometry::fromWkt( QStringLiteral( "Point (10 50)" ) )
+             << QgsGeometry()
+             << QgsGeometry::fromWkt( QStringLiteral( "MultiPolygon (((0 0, 10 0, 10 10, 0 10, 0 0),(2 2, 4 2, 4 4, 2 2)),((20 20, 30 20, 30 30, 20 20)))" ) )
+             << QgsGeometry::fromWkt( QStringLiteral( "LineStringZM (1 2 3 4, 5 6 7 8)" ) )
+             << QgsGeometry::fromWkt( QStringLiteral( "CircularString (0 0, 1 1, 2 0)" ) )
+             << QgsGeometry::fromWkt( QStringLiteral( "MultiPoint ((1 1),(0 90))" ) );
+  const QVector< QgsGeometry > original = geometries;
+
+  const QList< int > failed = tr.transformGeometries( geometries );
+  QCOMPARE( failed, QList< int >() << 5 );
+
+  for ( int i = 0; i < original.size(); ++i )
+  {
+    if ( i == 5 )
+    {
+      // left untouched
+      QCOMPARE( geometries.at( i ).asWkt(), original.at( i ).asWkt() );
+      continue;
+    }
+
+    QgsGeometry expected = original.at( i );
+    expected.transform( tr );
+    QCOMPARE( geometries.at( i ).asWkt( 3 ), expected.asWkt( 3 ) );
+  }
+  QCOMPARE( geometries.at( 0 ).asWkt( 0 ), QStringLiteral( "Point (1113195 6446276)" ) );
+  QVERIFY( geometries.at( 1 ).isNull() );
+  // z values are only transformed on request, m values never
+  QCOMPARE( geometries.at( 3 ).constGet()->vertexAt( QgsVertexId( 0, 0, 1 ) ).z(), 7.0 );
+  QCOMPARE( geometries.at( 3 ).constGet()->vertexAt( QgsVertexId( 0, 0, 1 ) ).m(), 8.0 );
+
+  // the original geometries were not modified
+  QCOMPARE( original.at( 0 ).asWkt(), QStringLiteral( "Point (10 50)" ) );
+}
+
+void TestQgsCoordinateTransform::transformGrid()
+{
+  QgsCoordinateTransform tr( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:4326" ) ), QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:3857" ) ), QgsProject::instance() );
+  const QgsRectangle extent( 0, 40, 20, 60 );
+
+  // invalid transform or extent
+  QVERIFY( !QgsCoordinateTransformGrid( QgsCoordinateTransform(), extent, 10 ).isValid() );
+  QVERIFY( !QgsCoordinateTransformGrid( tr, QgsRectangle(), 10 ).isValid() );
+  // cannot reach the error bound within the maximum number of cells
+  QVERIFY( !QgsCoordinateTransformGrid( tr, extent, 0.000001, 4 ).isValid() );
+
+  const double maxError = 100;
+  QgsCoordinateTransformGrid grid( tr, extent, maxError );
+  QVERIFY( grid.isValid() );
+  QVERIFY( grid.cellCount() >= 2 );
+
+  // a tighter bound needs a finer grid
+  QgsCoordinateTransformGrid fineGrid( tr, extent, 10 );
+  QVERIFY( fineGrid.isValid() );
+  QVERIFY( fineGrid.cellCount() > grid.cellCount() );
+
+  QPolygonF polygon;
+  for ( int i = 0; i <= 50; ++i )
+  {
+    // includes points on the grid boundary and points outside the grid, which are transformed exactly
+    polygon << QPointF( -2 + i * 0.49, 38 + i * 0.47 );
+  }
+  QPolygonF expected = polygon;
+  tr.transformPolygon( expected );
+
+  QPolygonF approximate = polygon;
+  grid.transformPolygon( approximate );
+  QCOMPARE( approximate.size(), expected.size() );
+  for ( int i = 0; i < expected.size(); ++i )
+  {
+    QGSCOMPARENEAR( approximate.at( i ).x(), expected.at( i ).x(), maxError );
+    QGSCOMPARENEAR( approximate.at( i ).y(), expected.at( i ).y(), maxError );
+    if ( !extent.contains( QgsPointXY( polygon.at( i ) ) ) )
+    {
+      QCOMPARE( approximate.at( i ).x(), expected.at( i ).x() );
+      QCOMPARE( approximate.at( i ).y(), expected.at( i ).y() );
+    }
+  }
+
+  double x = 10;
+  double y = 50;
+  grid.transformInPlace( x, y );
+  QGSCOMPARENEAR( x, 1113195, maxError );
+  QGSCOMPARENEAR( y, 6446276, maxError );
+
+  // the error is bounded along the top and right edges of the grid too
+  for ( int i = 0; i <= 40; ++i )
+  {
+    const QgsPointXY edgePoints[2] { QgsPointXY( i * 0.5, 60 ), QgsPointXY( 20, 40 + i * 0.5 ) };
+    for ( const QgsPointXY &point : edgePoints )
+    {
+      const QgsPointXY exact = tr.transform( point );
+      x = point.x();
+      y = point.y();
+      grid.transformInPlace( x, y );
+      QGSCOMPARENEAR( x, exact.x(), maxError );
+      QGSCOMPARENEAR( y, exact.y(), maxError );
+    }
+  }
+}
+
+void TestQgsCoordinateTransform::transformGeometriesFallback()
+{
+  // an operation which cannot transform points on the far side of the globe
+  QgsCoordinateTransformContext context;
+  context.addCoordinateOperation( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:4326" ) ), QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:3857" ) ),
+                                  QStringLiteral( "+proj=pipeline +step +proj=unitconvert +xy_in=deg +xy_out=rad +step +proj=ortho +lat_0=0 +lon_0=0 +ellps=WGS84" ), true );
+  QgsCoordinateTransform tr( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:4326" ) ), QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:3857" ) ), context );
+  QVERIFY( tr.isValid() );
+
+  QVector< QgsGeometry > geometries;
+  geometries << QgsGeometry::fromWkt( QStringLiteral( "Point (10 50)" ) )
+             << QgsGeometry::fromWkt( QStringLiteral( "LineString (0 0, 120 10)" ) )
+             << QgsGeometry::fromWkt( QStringLiteral( "LineString (-10 -10, 20 30)" ) );
+  const QVector< QgsGeometry > original = geometries;
+
+  const QList< int > failed = tr.transformGeometries( geometries );
+  QVERIFY( failed.isEmpty() );
+
+  // every geometry matches its own transform, so the failing line only used the fallback operation for itself
+  for ( int i = 0; i < original.size(); ++i )
+  {
+    QgsGeometry expected = original.at( i );
+    QCOMPARE( expected.transform( tr ), QgsGeometry::Success );
+    QCOMPARE( geometries.at( i ).asWkt( 0 ), expected.asWkt( 0 ) );
+  }
+
+  // the valid geometries were transformed with the orthographic operation, not the fallback
+  const QgsPointXY point = geometries.at( 0 ).asPoint();
+  QVERIFY( point.x() < 800000 );
+  QVERIFY( point.y() < 5000000 );
+  const QgsPolylineXY line = geometries.at( 2 ).asPolyline();
+  QVERIFY( line.at( 1 ).y() < 3400000 );
+  // while the failing line was transformed with the fallback operation
+  QGSCOMPARENEAR( geometries.at( 1 ).asPolyline().at( 1 ).x(), 13358339, 1 );
+}
+
 void TestQgsCoordinateTransform::transformLKS()
 {
   QgsCoordinateReferenceSystem LKS92 = QgsCoordinateReferenceSystem::fromEpsgId( 3059 );
@@ -22,6 +22,8 @@
 #include <QApplication>
 #include <QFileInfo>
 #include <QDir>
+#include <QDateTime>
+#include <QTemporaryDir>
 
 //qgis includes...
 #include <qgis.h>
@@ -30,6 +32,7 @@
 #include <qgsrasterdataprovider.h>
 #include <qgsrectangle.h>
 #include "qgspoint.h"
+#include "qgsgdalblockcache.h"
 
 /**
  * \ingroup UnitTests
@@ -60,6 +63,10 @@ class TestQgsGdalProvider : public QObject
     void interactionBetweenRasterChangeAndCache(); // test that updading a raster invalidates the GDAL dataset cache (#20104)
     void scale0(); //test when data has scale 0 (#20493)
     void transformCoordinates();
+    void blockCache();
+    void blockCacheInvalidatedByWrite();
+    void blockCacheFileReplaced();
+    void concurrentReadingCapability();
 
   private:
     QString mTestDataDir;
@@ -412,5 +419,196 @@ void TestQgsGdalProvider::transformCoordinates()
 
 }
 
+void TestQgsGdalProvider::blockCache()
+{
+  QgsGdalBlockCache cache;
+  QVERIFY( !cache.isEnabled() );
+
+  QgsGdalBlockCache::Key key;
+  key.dataset = QStringLiteral( "/tmp/a.tif" );
+  key.band = 1;
+  key.extent = QgsRectangle( 0, 0, 10, 10 );
+  key.width = 2;
+  key.height = 2;
+
+  const char data[4] = { 1, 2, 3, 4 };
+  char res[4] = { 0, 0, 0, 0 };
+
+  // disabled cache never stores anything
+  cache.insert( key, data, 4 );
+  QVERIFY( !cache.fetch( key, res, 4 ) );
+
+  cache.setMaxSize( 1024 * 1024 );
+  QVERIFY( cache.isEnabled() );
+  cache.insert( key, data, 4 );
+  QCOMPARE( cache.hitCount(), 0LL );
+  QVERIFY( cache.fetch( key, res, 4 ) );
+  QCOMPARE( cache.hitCount(), 1LL );
+  QCOMPARE( res[0], static_cast< char >( 1 ) );
+  QCOMPARE( res[3], static_cast< char >( 4 ) );
+
+  // size mismatch
+  QVERIFY( !cache.fetch( key, res, 8 ) );
+  QCOMPARE( cache.hitCount(), 1LL );
+
+  // any key difference is a miss
+  QgsGdalBlockCache::Key otherKey = key;
+  otherKey.band = 2;
+  QVERIFY( !cache.fetch( otherKey, res, 4 ) );
+  otherKey = key;
+  otherKey.extent = QgsRectangle( 0, 0, 10, 11 );
+  QVERIFY( !cache.fetch( otherKey, res, 4 ) );
+  otherKey = key;
+  otherKey.options = QStringLiteral( "x" );
+  QVERIFY( !cache.fetch( otherKey, res, 4 ) );
+
+  // invalidation is per dataset
+  otherKey = key;
+  otherKey.dataset = QStringLiteral( "/tmp/a.tif.ovr" );
+  cache.insert( otherKey, data, 4 );
+  cache.invalidate( key.dataset );
+  QVERIFY( !cache.fetch( key, res, 4 ) );
+  QVERIFY( cache.fetch( otherKey, res, 4 ) );
+
+  cache.clear();
+  QVERIFY( !cache.fetch( otherKey, res, 4 ) );
+}
+
+void TestQgsGdalProvider::blockCacheInvalidatedByWrite()
+{
+  const qint64 prevSize = QgsGdalBlockCache::instance()->maxSize();
+  QgsGdalBlockCache::instance()->setMaxSize( 1024 * 1024 );
+
+  double geoTransform[6] = { 0, 2, 0, 0, 0, -2};
+  QgsCoordinateReferenceSystem crs;
+  QTemporaryDir dir;
+  const QString filename = dir.filePath( QStringLiteral( "temp_block_cache.tif" ) );
+
+  // Create a all-0 dataset
+  QgsRasterDataProvider *provider = QgsRasterDataProvider::create(
+                                      QStringLiteral( "gdal" ), filename, "GTiff", 1, Qgis::DataType::Byte, 2, 2, geoTransform, crs );
+  delete provider;
+
+  provider = dynamic_cast< QgsRasterDataProvider * >(
+               QgsProviderRegistry::instance()->createProvider(
+                 QStringLiteral( "gdal" ), filename, QgsDataProvider::ProviderOptions() ) );
+  QVERIFY( provider );
+
+  const QgsRectangle extent( 0, -4, 4, 0 );
+  std::unique_ptr< QgsRasterBlock > block( provider->block( 1, extent, 2, 2 ) );
+  QCOMPARE( block->value( 0, 0 ), 0.0 );
+  // second read is served from the cache
+  const qint64 hits = QgsGdalBlockCache::instance()->hitCount();
+  block.reset( provider->block( 1, extent, 2, 2 ) );
+  QCOMPARE( block->value( 0, 0 ), 0.0 );
+  QCOMPARE( QgsGdalBlockCache::instance()->hitCount(), hits + 1 );
+
+  provider->setEditable( true );
+  QgsRasterBlock writeBlock( Qgis::DataType::Byte, 1, 1 );
+  writeBlock.setValue( 0, 0, 255 );
+  provider->writeBlock( &writeBlock, 1, 0, 0 );
+  provider->setEditable( false );
+
+  // stale cached blocks must not be returned
+  block.reset( provider->block( 1, extent, 2, 2 ) );
+  QCOMPARE( block->value( 0, 0 ), 255.0 );
+  QCOMPARE( block->value( 1, 1 ), 0.0 );
+
+  provider->remove();
+  delete provider;
+
+  // datasets which are not plain files have no signature to detect changes, so are never cached
+  const QString memFilename = QStringLiteral( "/vsimem/temp_block_cache.tif" );
+  delete QgsRasterDataProvider::create( QStringLiteral( "gdal" ), memFilename, "GTiff", 1, Qgis::DataType::Byte, 2, 2, geoTransform, crs );
+  provider = dynamic_cast< QgsRasterDataProvider * >(
+               QgsProviderRegistry::instance()->createProvider(
+                 QStringLiteral( "gdal" ), memFilename, QgsDataProvider::ProviderOptions() ) );
+  QVERIFY( provider );
+  block.reset( provider->block( 1, extent, 2, 2 ) );
+  const qint64 memHits = QgsGdalBlockCache::instance()->hitCount();
+  block.reset( provider->block( 1, extent, 2, 2 ) );
+  QCOMPARE( QgsGdalBlockCache::instance()->hitCount(), memHits );
+  provider->remove();
+  delete provider;
+
+  QgsGdalBlockCache::instance()->setMaxSize( prevSize );
+}
+
+void TestQgsGdalProvider::blockCacheFileReplaced()
+{
+  const qint64 prevSize = QgsGdalBlockCache::instance()->maxSize();
+  QgsGdalBlockCache::instance()->setMaxSize( 1024 * 1024 );
+
+  double geoTransform[6] = { 0, 2, 0, 0, 0, -2};
+  QgsCoordinateReferenceSystem crs;
+  QTemporaryDir dir;
+  const QString filename = dir.filePath( QStringLiteral( "replaced.tif" ) );
+  const QgsRectangle extent( 0, -4, 4, 0 );
+
+  auto createRaster = [&]( int value )
+  {
+    std::unique_ptr< QgsRasterDataProvider > provider( QgsRasterDataProvider::create(
+          QStringLiteral( "gdal" ), filename, "GTiff", 1, Qgis::DataType::Byte, 2, 2, geoTransform, crs ) );
+    QVERIFY( provider );
+    provider->setEditable( true );
+    QgsRasterBlock writeBlock( Qgis::DataType::Byte, 1, 1 );
+    writeBlock.setValue( 0, 0, value );
+    provider->writeBlock( &writeBlock, 1, 0, 0 );
+    provider->setEditable( false );
+  };
+
+  auto readValue = [&]() -> double
+  {
+    std::unique_ptr< QgsRasterDataProvider > provider( dynamic_cast< QgsRasterDataProvider * >(
+          QgsProviderRegistry::instance()->createProvider( QStringLiteral( "gdal" ), filename, QgsDataProvider::ProviderOptions() ) ) );
+    if ( !provider )
+      return -1;
+    std::unique_ptr< QgsRasterBlock > block( provider->block( 1, extent, 2, 2 ) );
+    return block->value( 0, 0 );
+  };
+
+  createRaster( 10 );
+  const QDateTime firstModified = QFileInfo( filename ).lastModified();
+  QCOMPARE( readValue(), 10.0 );
+  const qint64 hits = QgsGdalBlockCache::instance()->hitCount();
+  QCOMPARE( readValue(), 10.0 );
+  QCOMPARE( QgsGdalBlockCache::instance()->hitCount(), hits + 1 );
+
+  // overwrite the file with a different content of the same size, as done by an external tool
+  createRaster( 20 );
+  QFile file( filename );
+  QVERIFY( file.open( QIODevice::ReadWrite ) );
+  QVERIFY( file.setFileTime( firstModified.addSecs( 10 ), QFileDevice::FileModificationTime ) );
+  file.close();
+
+  // the blocks cached for the previous version of the file must not be returned
+  QCOMPARE( readValue(), 20.0 );
+  QCOMPARE( QgsGdalBlockCache::instance()->hitCount(), hits + 1 );
+
+  QgsGdalBlockCache::instance()->setMaxSize( prevSize );
+}
+
+void TestQgsGdalProvider::concurrentReadingCapability()
+{
+  // local files can be rendered in parallel strips
+  QString raster = QStringLiteral( TEST_DATA_DIR ) + "/raster/band1_byte_ct_epsg4326.tif";
+  std::unique_ptr< QgsRasterDataProvider > provider( dynamic_cast< QgsRasterDataProvider * >(
+        QgsProviderRegistry::instance()->createProvider( QStringLiteral( "gdal" ), raster, QgsDataProvider::ProviderOptions() ) ) );
+  QVERIFY( provider );
+  QVERIFY( provider->providerCapabilities().testFlag( QgsRasterDataProvider::ProviderHintConcurrentReading ) );
+  std::unique_ptr< QgsRasterDataProvider > clone( provider->clone() );
+  QVERIFY( clone->providerCapabilities().testFlag( QgsRasterDataProvider::ProviderHintConcurrentReading ) );
+
+  // datasets which are not plain files are not
+  double geoTransform[6] = { 0, 2, 0, 0, 0, -2};
+  const QString filename = QStringLiteral( "/vsimem/temp_concurrent_reading.tif" );
+  provider.reset( QgsRasterDataProvider::create( QStringLiteral( "gdal" ), filename, "GTiff", 1, Qgis::DataType::Byte, 2, 2, geoTransform, QgsCoordinateReferenceSystem() ) );
+  provider.reset( dynamic_cast< QgsRasterDataProvider * >(
+                    QgsProviderRegistry::instance()->createProvider( QStringLiteral( "gdal" ), filename, QgsDataProvider::ProviderOptions() ) ) );
+  QVERIFY( provider );
+  QVERIFY( !provider->providerCapabilities().testFlag( QgsRasterDataProvider::ProviderHintConcurrentReading ) );
+  provider->remove();
+}
+
 QGSTEST_MAIN( TestQgsGdalProvider )
 #include "testqgsgdalprovider.moc"
@@ -41,6 +41,7 @@ class TestQgsGdalUtils: public QObject
     void testResampleSingleBandRaster();
     void testImageToDataset();
     void testResampleImageToImage();
+    void testIsRemotePath();
 
   private:
 
@@ -268,6 +269,18 @@ void TestQgsGdalUtils::testResampleImageToImage()
   QCOMPARE( qAlpha( res.pixel( 40, 40 ) ), 255 );
 }
 
+void TestQgsGdalUtils::testIsRemotePath()
+{
+  QVERIFY( !QgsGdalUtils::isRemotePath( QString() ) );
+  QVERIFY( !QgsGdalUtils::isRemotePath( QStringLiteral( "/home/me/dem.tif" ) ) );
+  QVERIFY( !QgsGdalUtils::isRemotePath( QStringLiteral( "/vsizip//home/me/dem.zip/dem.tif" ) ) );
+  QVERIFY( !QgsGdalUtils::isRemotePath( QStringLiteral( "/vsimem/dem.tif" ) ) );
+  QVERIFY( QgsGdalUtils::isRemotePath( QStringLiteral( "/vsicurl/https://example.com/dem.tif" ) ) );
+  QVERIFY( QgsGdalUtils::isRemotePath( QStringLiteral( "/vsis3/bucket/dem.tif" ) ) );
+  QVERIFY( QgsGdalUtils::isRemotePath( QStringLiteral( "/vsizip//vsicurl/https://example.com/dem.zip/dem.tif" ) ) );
+  QVERIFY( QgsGdalUtils::isRemotePath( QStringLiteral( "https://example.com/dem.tif" ) ) );
+}
+
 double TestQgsGdalUtils::identify( GDALDatasetH dataset, int band, int px, int py )
 {
   GDALRasterBandH hBand = GDALGetRasterBand( dataset, band );
@@ -670,6 +670,21 @@ void TestQgsGeometry::geos()
   res = QgsGeometry( QgsGeos::fromGeos( asGeos.get() ) );
   QCOMPARE( res.asWkt(), QStringLiteral( "MultiPolygon (((0 0, 0 1, 1 1, 0 0)),((10 0, 10 1, 11 1, 10 0)))" ) );
 
+  // coordinate sequences with z values, precision and closing of rings
+  QgsLineString lineZ( QVector< QgsPoint >() << QgsPoint( 0.12, 1.26, 2.51 ) << QgsPoint( 3.33, 4.47, 5.5 ) << QgsPoint( 6, 7, 8 ) );
+  asGeos = QgsGeos::asGeos( &lineZ );
+  res = QgsGeometry( QgsGeos::fromGeos( asGeos.get() ) );
+  QCOMPARE( res.asWkt( 3 ), QStringLiteral( "LineStringZ (0.12 1.26 2.51, 3.33 4.47 5.5, 6 7 8)" ) );
+  asGeos = QgsGeos::asGeos( &lineZ, 0.1 );
+  res = QgsGeometry( QgsGeos::fromGeos( asGeos.get() ) );
+  QCOMPARE( res.asWkt( 3 ), QStringLiteral( "LineStringZ (0.1 1.3 2.5, 3.3 4.5 5.5, 6 7 8)" ) );
+
+  std::unique_ptr< QgsPolygon > unclosedPolygon = std::make_unique< QgsPolygon >();
+  unclosedPolygon->setExteriorRing( new QgsLineString( QVector< QgsPoint >() << QgsPoint( 0.12, 0.14 ) << QgsPoint( 0, 1 ) << QgsPoint( 1, 1 ) ) );
+  asGeos = QgsGeos::asGeos( unclosedPolygon.get(), 0.1 );
+  res = QgsGeometry( QgsGeos::fromGeos( asGeos.get() ) );
+  QCOMPARE( res.asWkt( 3 ), QStringLiteral( "Polygon ((0.1 0.1, 0 1, 1 1, 0.1 0.1))" ) );
+
   // Empty geometry
   QgsPoint point;
   asGeos = QgsGeos::asGeos( &point );
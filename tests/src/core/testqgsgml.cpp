@@ -67,6 +67,7 @@ class TestQgsGML : public QObject
     void testPolygonGML3();
     void testPolygonGML3_srsDimension_on_Polygon();
     void testPolygonGML3_srsDimension_on_posList();
+    void testPosListExtraSpaces();
     void testMultiLineStringGML3();
     void testMultiPolygonGML3();
     void testPointGML3_2();
@@ -723,6 +724,30 @@ void TestQgsGML::testPolygonGML3_srsDimension_on_posList()
   delete features[0].first;
 }
 
+void TestQgsGML::testPosListExtraSpaces()
+{
+  QgsFields fields;
+  QgsGmlStreamingParser gmlParser( QStringLiteral( "mytypename" ), QStringLiteral( "mygeom" ), fields );
+  QCOMPARE( gmlParser.processData( QByteArray( "<myns:FeatureCollection "
+                                   "xmlns:myns='http://myns' "
+                                   "xmlns:gml='http://www.opengis.net/gml'>"
+                                   "<gml:featureMember>"
+                                   "<myns:mytypename fid='mytypename.1'>"
+                                   "<myns:mygeom>"
+                                   "<gml:LineString srsName='EPSG:27700'>"
+                                   "<gml:posList>  0.5 1.25   2e1 3  \n4 -5.5 </gml:posList>"
+                                   "</gml:LineString>"
+                                   "</myns:mygeom>"
+                                   "</myns:mytypename>"
+                                   "</gml:featureMember>"
+                                   "</myns:FeatureCollection>" ), true ), true );
+  QVector<QgsGmlStreamingParser::QgsGmlFeaturePtrGmlIdPair> features = gmlParser.getAndStealReadyFeatures();
+  QCOMPARE( features.size(), 1 );
+  QVERIFY( features[0].first->hasGeometry() );
+  QCOMPARE( features[0].first->geometry().asWkt(), QStringLiteral( "LineString (0.5 1.25, 20 3, 4 -5.5)" ) );
+  delete features[0].first;
+}
+
 void TestQgsGML::testMultiLineStringGML3()
 {
   QgsFields fields;
@@ -0,0 +1,196 @@
+/***************************************************************************
+     testqgsmosaicrasterprovider.cpp
+     -------------------------------
+    Date                 : October 2026
+    Copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include "qgstest.h"
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "qgsapplication.h"
+#include "qgsproviderregistry.h"
+#include "qgsrasterblock.h"
+#include "qgsrasterdataprovider.h"
+#include "qgsrasterlayer.h"
+
+class TestQgsMosaicRasterProvider : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void encodeDecodeUri();
+    void mosaic();
+    void failedSource();
+
+  private:
+    //! Writes a 4x4 ASCII grid with its lower left corner at \a x, 0, filled with \a value except for the \a noData cells
+    QString writeGrid( const QString &name, double x, int value, const QList< int > &noData );
+
+    QTemporaryDir mDir;
+};
+
+void TestQgsMosaicRasterProvider::initTestCase()
+{
+  QgsApplication::init();
+  QgsApplication::initQgis();
+}
+
+void TestQgsMosaicRasterProvider::cleanupTestCase()
+{
+  QgsApplication::exitQgis();
+}
+
+QString TestQgsMosaicRasterProvider::writeGrid( const QString &name, double x, int value, const QList< int > &noData )
+{
+  const QString path = mDir.filePath( name );
+  QFile file( path );
+  if ( !file.open( QIODevice::WriteOnly | QIODevice::Text ) )
+    return QString();
+
+  QTextStream stream( &file );
+  stream << "ncols 4\nnrows 4\nxllcorner " << x << "\nyllcorner 0\ncellsize 1\nNODATA_value -9999\n";
+  for ( int row = 0; row < 4; ++row )
+  {
+    for ( int col = 0; col < 4; ++col )
+      stream << ( noData.contains( row * 4 + col ) ? -9999 : value ) << ' ';
+    stream << '\n';
+  }
+  return path;
+}
+
+void TestQgsMosaicRasterProvider::encodeDecodeUri()
+{
+  QgsProviderMetadata *metadata = QgsProviderRegistry::instance()->providerMetadata( QStringLiteral( "mosaic" ) );
+  QVERIFY( metadata );
+
+  QVariantMap first;
+  first.insert( QStringLiteral( "provider" ), QStringLiteral( "gdal" ) );
+  first.insert( QStringLiteral( "uri" ), QStringLiteral( "/data/a&b=c.tif" ) );
+  QVariantMap second;
+  second.insert( QStringLiteral( "provider" ), QStringLiteral( "wms" ) );
+  second.insert( QStringLiteral( "uri" ), QStringLiteral( "url=http://example.com/wms?x=1&layers=a" ) );
+  second.insert( QStringLiteral( "extent" ), QVariant::fromValue( QgsRectangle( 1, 2, 3, 4 ) ) );
+
+  QVariantMap parts;
+  parts.insert( QStringLiteral( "sources" ), QVariantList() << first << second );
+  parts.insert( QStringLiteral( "crs" ), QStringLiteral( "EPSG:3857" ) );
+  parts.insert( QStringLiteral( "resolutionX" ), 0.5 );
+  parts.insert( QStringLiteral( "resolutionY" ), 0.25 );
+
+  const QVariantMap decoded = metadata->decodeUri( metadata->encodeUri( parts ) );
+  const QVariantList sources = decoded.value( QStringLiteral( "sources" ) ).toList();
+  QCOMPARE( sources.size(), 2 );
+  QCOMPARE( sources.at( 0 ).toMap().value( QStringLiteral( "uri" ) ).toString(), QStringLiteral( "/data/a&b=c.tif" ) );
+  QCOMPARE( sources.at( 1 ).toMap().value( QStringLiteral( "provider" ) ).toString(), QStringLiteral( "wms" ) );
+  QCOMPARE( sources.at( 1 ).toMap().value( QStringLiteral( "uri" ) ).toString(), QStringLiteral( "url=http://example.com/wms?x=1&layers=a" ) );
+  QCOMPARE( sources.at( 1 ).toMap().value( QStringLiteral( "extent" ) ).value< QgsRectangle >(), QgsRectangle( 1, 2, 3, 4 ) );
+  QCOMPARE( decoded.value( QStringLiteral( "crs" ) ).toString(), QStringLiteral( "EPSG:3857" ) );
+  QCOMPARE( decoded.value( QStringLiteral( "resolutionX" ) ).toDouble(), 0.5 );
+  QCOMPARE( decoded.value( QStringLiteral( "resolutionY" ) ).toDouble(), 0.25 );
+}
+
+void TestQgsMosaicRasterProvider::mosaic()
+{
+  QVERIFY( mDir.isValid() );
+  // "below" covers x 0 to 4, "above" covers x 2 to 6 and has two nodata cells in its top row
+  const QString below = writeGrid( QStringLiteral( "below.asc" ), 0, 1, {} );
+  const QString above = writeGrid( QStringLiteral( "above.asc" ), 2, 2, { 1, 3 } );
+
+  QVariantMap first;
+  first.insert( QStringLiteral( "provider" ), QStringLiteral( "gdal" ) );
+  first.insert( QStringLiteral( "uri" ), below );
+  QVariantMap second;
+  second.insert( QStringLiteral( "provider" ), QStringLiteral( "gdal" ) );
+  second.insert( QStringLiteral( "uri" ), above );
+  QVariantMap parts;
+  parts.insert( QStringLiteral( "sources" ), QVariantList() << first << second );
+  const QString uri = QgsProviderRegistry::instance()->encodeUri( QStringLiteral( "mosaic" ), parts );
+
+  QgsRasterLayer layer( uri, QStringLiteral( "mosaic" ), QStringLiteral( "mosaic" ) );
+  QVERIFY( layer.isValid() );
+  QgsRasterDataProvider *provider = layer.dataProvider();
+  QCOMPARE( provider->extent(), QgsRectangle( 0, 0, 6, 4 ) );
+  QCOMPARE( provider->xSize(), 6 );
+  QCOMPARE( provider->ySize(), 4 );
+  QCOMPARE( provider->bandCount(), 1 );
+
+  std::unique_ptr< QgsRasterBlock > block( provider->block( 1, provider->extent(), 6, 4 ) );
+  QVERIFY( block->isValid() );
+  // the later source is on top
+  QCOMPARE( block->value( 1, 0 ), 1.0 );
+  QCOMPARE( block->value( 1, 2 ), 2.0 );
+  QCOMPARE( block->value( 1, 5 ), 2.0 );
+  // nodata cells of the top source show the source below, if any
+  QCOMPARE( block->value( 0, 3 ), 1.0 );
+  QVERIFY( block->isNoData( 0, 5 ) );
+
+  // cached and cloned providers compose the same block
+  std::unique_ptr< QgsRasterBlock > cached( provider->block( 1, provider->extent(), 6, 4 ) );
+  QCOMPARE( cached->data(), block->data() );
+  QVERIFY( cached->isNoData( 0, 5 ) );
+  std::unique_ptr< QgsRasterDataProvider > clone( provider->clone() );
+  std::unique_ptr< QgsRasterBlock > cloned( clone->block( 1, provider->extent(), 6, 4 ) );
+  QCOMPARE( cloned->data(), block->data() );
+
+  // requests partially outside the mosaic are padded with nodata
+  std::unique_ptr< QgsRasterBlock > padded( provider->block( 1, QgsRectangle( -2, 0, 2, 4 ), 4, 4 ) );
+  QVERIFY( padded->isNoData( 0, 0 ) );
+  QCOMPARE( padded->value( 0, 2 ), 1.0 );
+}
+
+void TestQgsMosaicRasterProvider::failedSource()
+{
+  QVERIFY( mDir.isValid() );
+  const QString below = writeGrid( QStringLiteral( "first.asc" ), 0, 1, {} );
+  const QString late = mDir.filePath( QStringLiteral( "late.asc" ) );
+
+  // the second source does not exist yet, its footprint is given so it is not opened when loading
+  QVariantMap first;
+  first.insert( QStringLiteral( "provider" ), QStringLiteral( "gdal" ) );
+  first.insert( QStringLiteral( "uri" ), below );
+  QVariantMap second;
+  second.insert( QStringLiteral( "provider" ), QStringLiteral( "gdal" ) );
+  second.insert( QStringLiteral( "uri" ), late );
+  second.insert( QStringLiteral( "extent" ), QVariant::fromValue( QgsRectangle( 2, 0, 6, 4 ) ) );
+  QVariantMap parts;
+  parts.insert( QStringLiteral( "sources" ), QVariantList() << first << second );
+  const QString uri = QgsProviderRegistry::instance()->encodeUri( QStringLiteral( "mosaic" ), parts );
+
+  QgsRasterLayer layer( uri, QStringLiteral( "mosaic" ), QStringLiteral( "mosaic" ) );
+  QVERIFY( layer.isValid() );
+  QgsRasterDataProvider *provider = layer.dataProvider();
+  QCOMPARE( provider->extent(), QgsRectangle( 0, 0, 6, 4 ) );
+
+  std::unique_ptr< QgsRasterBlock > block( provider->block( 1, provider->extent(), 6, 4 ) );
+  QVERIFY( block->isValid() );
+  QCOMPARE( block->value( 0, 0 ), 1.0 );
+  QVERIFY( block->isNoData( 0, 5 ) );
+
+  QCOMPARE( writeGrid( QStringLiteral( "late.asc" ), 2, 3, {} ), late );
+
+  // the incomplete block was not cached, so a clone sharing the cache reads the new source
+  std::unique_ptr< QgsRasterDataProvider > clone( provider->clone() );
+  block.reset( clone->block( 1, provider->extent(), 6, 4 ) );
+  QCOMPARE( block->value( 0, 5 ), 3.0 );
+  QCOMPARE( block->value( 0, 0 ), 1.0 );
+
+  // the provider which saw the failure tries again once its data is reloaded
+  provider->reloadData();
+  block.reset( provider->block( 1, provider->extent(), 6, 4 ) );
+  QCOMPARE( block->value( 0, 5 ), 3.0 );
+}
+
+QGSTEST_MAIN( TestQgsMosaicRasterProvider )
+#include "testqgsmosaicrasterprovider.moc"
@@ -0,0 +1,140 @@
+/***************************************************************************
+     testqgsparallelunion.cpp
+     ------------------------
+    Date                 : October 2026
+    Copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include "qgstest.h"
+#include <QObject>
+#include <QString>
+
+#include "qgsapplication.h"
+#include "qgsfeedback.h"
+#include "qgsgeometry.h"
+#include "qgsparallelunion.h"
+
+class TestQgsParallelUnion : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void smallInput();
+    void partitioned();
+    void canceled();
+    void failedPartition();
+};
+
+void TestQgsParallelUnion::initTestCase()
+{
+  QgsApplication::init();
+  QgsApplication::initQgis();
+}
+
+void TestQgsParallelUnion::cleanupTestCase()
+{
+  QgsApplication::exitQgis();
+}
+
+void TestQgsParallelUnion::smallInput()
+{
+  QVector< QgsGeometry > geometries;
+  geometries << QgsGeometry::fromRect( QgsRectangle( 0, 0, 2, 1 ) )
+             << QgsGeometry()
+             << QgsGeometry::fromRect( QgsRectangle( 1, 0, 3, 1 ) );
+
+  QString error;
+  const QgsGeometry result = QgsParallelUnion().unaryUnion( geometries, &error );
+  QVERIFY( error.isEmpty() );
+  QVERIFY( result.equals( QgsGeometry::fromRect( QgsRectangle( 0, 0, 3, 1 ) ) ) );
+}
+
+void TestQgsParallelUnion::partitioned()
+{
+  // a grid of overlapping squares, in an order unrelated to their position
+  QVector< QgsGeometry > geometries;
+  for ( int i = 0; i < 40; ++i )
+  {
+    for ( int j = 0; j < 40; ++j )
+    {
+      const int x = ( i * 17 ) % 40;
+      const int y = ( j * 23 ) % 40;
+      geometries << QgsGeometry::fromRect( QgsRectangle( x, y, x + 1.5, y + 1.5 ) );
+    }
+  }
+  geometries << QgsGeometry();
+
+  QgsParallelUnion unioner( 10 );
+  QCOMPARE( unioner.maxPartitionSize(), 10 );
+  QString error;
+  QgsGeometry result = unioner.unaryUnion( geometries, &error );
+  QVERIFY( error.isEmpty() );
+  QVERIFY( result.isGeosValid() );
+  QGSCOMPARENEAR( result.area(), 40.5 * 40.5, 0.000001 );
+  QVERIFY( result.symDifference( QgsGeometry::unaryUnion( geometries ) ).isEmpty() );
+
+  // disjoint parts stay separate
+  geometries.clear();
+  for ( int i = 0; i < 100; ++i )
+    geometries << QgsGeometry::fromRect( QgsRectangle( i * 2, 0, i * 2 + 1, 1 ) );
+  result = unioner.unaryUnion( geometries, &error );
+  QVERIFY( error.isEmpty() );
+  QCOMPARE( result.constGet()->partCount(), 100 );
+  QGSCOMPARENEAR( result.area(), 100, 0.000001 );
+}
+
+void TestQgsParallelUnion::canceled()
+{
+  QVector< QgsGeometry > geometries;
+  for ( int i = 0; i < 100; ++i )
+    geometries << QgsGeometry::fromRect( QgsRectangle( i, 0, i + 1.5, 1 ) );
+
+  QgsFeedback feedback;
+  feedback.cancel();
+  QgsParallelUnion unioner( 10 );
+  unioner.setFeedback( &feedback );
+  QVERIFY( unioner.unaryUnion( geometries ).isNull() );
+}
+
+void TestQgsParallelUnion::failedPartition()
+{
+  // self-intersecting polygons overlapping valid squares
+  QVector< QgsGeometry > invalid;
+  for ( int i = 0; i < 5; ++i )
+  {
+    invalid << QgsGeometry::fromWkt( QStringLiteral( "Polygon((%1 0, %2 2, %2 0, %1 2, %1 0))" ).arg( i * 2 ).arg( i * 2 + 2 ) )
+            << QgsGeometry::fromRect( QgsRectangle( i * 2 + 0.5, 0.5, i * 2 + 1.5, 1.5 ) );
+  }
+  if ( !QgsGeometry::unaryUnion( invalid ).isNull() )
+    QSKIP( "GEOS unions these invalid polygons, the failure path cannot be reached" );
+
+  QVector< QgsGeometry > geometries;
+  for ( int i = 0; i < 100; ++i )
+    geometries << QgsGeometry::fromRect( QgsRectangle( i, 100, i + 1.5, 101 ) );
+  geometries << invalid;
+
+  QgsParallelUnion unioner( 10 );
+  QString error;
+  const QgsGeometry result = unioner.unaryUnion( geometries, &error );
+  QVERIFY( !error.isEmpty() );
+  QVERIFY( !result.isNull() );
+  // the partitions which could be unioned are not lost
+  QVERIFY( result.area() >= 100.5 );
+
+  // same through the direct path for small inputs
+  error.clear();
+  const QgsGeometry smallResult = QgsParallelUnion( 100 ).unaryUnion( invalid, &error );
+  QVERIFY( !error.isEmpty() );
+  QVERIFY( !smallResult.isNull() );
+}
+
+QGSTEST_MAIN( TestQgsParallelUnion )
+#include "testqgsparallelunion.moc"
@@ -0,0 +1,152 @@
+/***************************************************************************
+     testqgspreparedgeometrycache.cpp
+     --------------------------------
+    Date                 : October 2026
+    Copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include "qgstest.h"
+#include <QObject>
+#include <QString>
+#include <QThread>
+
+#include "qgsapplication.h"
+#include "qgsgeometry.h"
+#include "qgsgeometryengine.h"
+#include "qgspreparedgeometrycache.h"
+
+class TestQgsPreparedGeometryCache : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void cache();
+    void invalidate();
+    void temporaryGeometry();
+    void threads();
+};
+
+void TestQgsPreparedGeometryCache::initTestCase()
+{
+  QgsApplication::init();
+  QgsApplication::initQgis();
+}
+
+void TestQgsPreparedGeometryCache::cleanupTestCase()
+{
+  QgsApplication::exitQgis();
+}
+
+void TestQgsPreparedGeometryCache::cache()
+{
+  QgsPreparedGeometryCache cache;
+  const QgsGeometry polygon = QgsGeometry::fromWkt( QStringLiteral( "Polygon ((0 0, 10 0, 10 10, 0 10, 0 0))" ) );
+  const QgsGeometry inside = QgsGeometry::fromWkt( QStringLiteral( "Point (5 5)" ) );
+  const QgsGeometry outside = QgsGeometry::fromWkt( QStringLiteral( "Point (15 5)" ) );
+
+  std::shared_ptr< QgsGeometryEngine > engine = cache.engine( QStringLiteral( "layer" ), 1, polygon );
+  QVERIFY( engine );
+  QVERIFY( engine->intersects( inside.constGet() ) );
+  QVERIFY( !engine->intersects( outside.constGet() ) );
+
+  // same feature, same engine
+  QCOMPARE( cache.engine( QStringLiteral( "layer" ), 1, polygon ).get(), engine.get() );
+  // different feature, source or precision
+  QVERIFY( cache.engine( QStringLiteral( "layer" ), 2, polygon ).get() != engine.get() );
+  QVERIFY( cache.engine( QStringLiteral( "other" ), 1, polygon ).get() != engine.get() );
+  QVERIFY( cache.engine( QStringLiteral( "layer" ), 1, polygon, 0.01 ).get() != engine.get() );
+
+  // evicted engines stay valid
+  cache.setMaxEntriesPerThread( 1 );
+  QCOMPARE( cache.maxEntriesPerThread(), 1 );
+  cache.engine( QStringLiteral( "layer" ), 3, polygon );
+  QVERIFY( cache.engine( QStringLiteral( "layer" ), 1, polygon ).get() != engine.get() );
+  QVERIFY( engine->intersects( inside.constGet() ) );
+}
+
+void TestQgsPreparedGeometryCache::invalidate()
+{
+  QgsPreparedGeometryCache cache;
+  const QgsGeometry polygon = QgsGeometry::fromWkt( QStringLiteral( "Polygon ((0 0, 10 0, 10 10, 0 10, 0 0))" ) );
+  const QgsGeometry moved = QgsGeometry::fromWkt( QStringLiteral( "Polygon ((20 0, 30 0, 30 10, 20 10, 20 0))" ) );
+  const QgsGeometry point = QgsGeometry::fromWkt( QStringLiteral( "Point (25 5)" ) );
+
+  std::shared_ptr< QgsGeometryEngine > engine1 = cache.engine( QStringLiteral( "layer" ), 1, polygon );
+  std::shared_ptr< QgsGeometryEngine > engine2 = cache.engine( QStringLiteral( "layer" ), 2, polygon );
+  std::shared_ptr< QgsGeometryEngine > engine3 = cache.engine( QStringLiteral( "other" ), 1, polygon );
+
+  // the cache can't know the geometry changed until it is told so
+  QVERIFY( !cache.engine( QStringLiteral( "layer" ), 1, moved )->intersects( point.constGet() ) );
+  cache.invalidate( QStringLiteral( "layer" ), 1 );
+  QVERIFY( cache.engine( QStringLiteral( "layer" ), 1, moved )->intersects( point.constGet() ) );
+  QCOMPARE( cache.engine( QStringLiteral( "layer" ), 2, polygon ).get(), engine2.get() );
+  QCOMPARE( cache.engine( QStringLiteral( "other" ), 1, polygon ).get(), engine3.get() );
+
+  cache.invalidate( QStringLiteral( "layer" ) );
+  QVERIFY( cache.engine( QStringLiteral( "layer" ), 2, polygon ).get() != engine2.get() );
+  QCOMPARE( cache.engine( QStringLiteral( "other" ), 1, polygon ).get(), engine3.get() );
+
+  cache.clear();
+  QVERIFY( cache.engine( QStringLiteral( "other" ), 1, polygon ).get() != engine3.get() );
+}
+
+void TestQgsPreparedGeometryCache::temporaryGeometry()
+{
+  QgsPreparedGeometryCache cache;
+  const QgsGeometry inside = QgsGeometry::fromWkt( QStringLiteral( "Point (5 5)" ) );
+
+  // the cache keeps its own copy of the geometry, callers can pass temporaries
+  std::shared_ptr< QgsGeometryEngine > engine = cache.engine( QStringLiteral( "layer" ), 1, QgsGeometry::fromWkt( QStringLiteral( "Polygon ((0 0, 10 0, 10 10, 0 10, 0 0))" ) ) );
+  QVERIFY( engine->intersects( inside.constGet() ) );
+  QCOMPARE( cache.engine( QStringLiteral( "layer" ), 1, QgsGeometry() ).get(), engine.get() );
+  QVERIFY( cache.engine( QStringLiteral( "layer" ), 1, QgsGeometry() )->intersects( inside.constGet() ) );
+
+  // and modifying the geometry passed to the cache does not affect the engine
+  QgsGeometry polygon = QgsGeometry::fromWkt( QStringLiteral( "Polygon ((0 0, 10 0, 10 10, 0 10, 0 0))" ) );
+  std::shared_ptr< QgsGeometryEngine > engine2 = cache.engine( QStringLiteral( "layer" ), 2, polygon );
+  polygon.translate( 100, 0 );
+  QVERIFY( engine2->intersects( inside.constGet() ) );
+
+  // evicted engines keep their geometry
+  cache.clear();
+  QVERIFY( engine->intersects( inside.constGet() ) );
+  QVERIFY( engine2->intersects( inside.constGet() ) );
+}
+
+void TestQgsPreparedGeometryCache::threads()
+{
+  QgsPreparedGeometryCache cache;
+  const QgsGeometry polygon = QgsGeometry::fromWkt( QStringLiteral( "Polygon ((0 0, 10 0, 10 10, 0 10, 0 0))" ) );
+  std::shared_ptr< QgsGeometryEngine > mainEngine = cache.engine( QStringLiteral( "layer" ), 1, polygon );
+
+  std::shared_ptr< QgsGeometryEngine > threadEngine;
+  std::shared_ptr< QgsGeometryEngine > threadEngine2;
+  QThread *thread = QThread::create( [&]
+  {
+    threadEngine = cache.engine( QStringLiteral( "layer" ), 1, polygon );
+    threadEngine2 = cache.engine( QStringLiteral( "layer" ), 1, polygon );
+  } );
+  thread->start();
+  thread->wait();
+  delete thread;
+
+  // each thread gets its own engine, which is reused within that thread
+  QVERIFY( threadEngine );
+  QVERIFY( threadEngine.get() != mainEngine.get() );
+  QCOMPARE( threadEngine2.get(), threadEngine.get() );
+  // the cache of a finished thread is released, while the engines handed out stay valid
+  QCOMPARE( threadEngine.use_count(), 2L );
+  QVERIFY( threadEngine->intersects( QgsGeometry::fromWkt( QStringLiteral( "Point (5 5)" ) ).constGet() ) );
+  QCOMPARE( cache.engine( QStringLiteral( "layer" ), 1, polygon ).get(), mainEngine.get() );
+}
+
+QGSTEST_MAIN( TestQgsPreparedGeometryCache )
+#include "testqgspreparedgeometrycache.moc"
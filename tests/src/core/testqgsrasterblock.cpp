@@ -20,6 +20,7 @@
 
 #include "qgsrasterlayer.h"
 #include "qgsrasterdataprovider.h"
+#include "qgsrasterlookuptable_p.h"
 
 /**
  * \ingroup UnitTests
@@ -39,6 +40,7 @@ class TestQgsRasterBlock : public QObject
 
     void testBasic();
     void testWrite();
+    void testLookupTable();
 
   private:
 
@@ -242,6 +244,43 @@ void TestQgsRasterBlock::testWrite()
   delete block;
 }
 
+void TestQgsRasterBlock::testLookupTable()
+{
+  QgsRasterBlock block( Qgis::DataType::Int16, 4, 2 );
+  block.setNoDataValue( -9999 );
+  const QList< int > values { 10, 12, -9999, 11, 10, 13, 12, 11 };
+  for ( int i = 0; i < values.size(); ++i )
+    block.setValue( static_cast< qgssize >( i ), values.at( i ) );
+
+  // the nodata value is not part of the table
+  const QgsRasterLookupTable table( &block );
+  QVERIFY( table.isValid() );
+  QCOMPARE( table.size(), 4 );
+  QCOMPARE( table.value( 0 ), 10.0 );
+  QCOMPARE( table.index( 1 ), 2 );
+  QCOMPARE( table.index( 2 ), -1 );
+
+  const std::vector< QRgb > colors { qRgb( 1, 0, 0 ), qRgb( 2, 0, 0 ), qRgb( 3, 0, 0 ), qRgb( 4, 0, 0 ) };
+  std::vector< QRgb > output( 8 );
+  table.mapColors( colors, qRgba( 0, 0, 0, 0 ), output.data() );
+  QCOMPARE( output[0], qRgb( 1, 0, 0 ) );
+  QCOMPARE( output[2], qRgba( 0, 0, 0, 0 ) );
+  QCOMPARE( output[5], qRgb( 4, 0, 0 ) );
+
+  std::vector< int > indices( 8 );
+  table.mapIndices( indices.data() );
+  for ( qgssize i = 0; i < 8; ++i )
+    QCOMPARE( indices[i], table.index( i ) );
+
+  // a table wider than the block is not worth filling
+  block.setValue( 0, 0, 20000 );
+  QVERIFY( !QgsRasterLookupTable( &block ).isValid() );
+
+  // nor is a table for floating point values
+  QgsRasterBlock floatBlock( Qgis::DataType::Float32, 4, 2 );
+  QVERIFY( !QgsRasterLookupTable( &floatBlock ).isValid() );
+}
+
 QGSTEST_MAIN( TestQgsRasterBlock )
 
 #include "testqgsrasterblock.moc"
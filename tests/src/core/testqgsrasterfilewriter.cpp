@@ -23,8 +23,10 @@
 #include <QTime>
 #include <QDesktopServices>
 #include <QTemporaryFile>
+#include <QSignalSpy>
 
 #include "cpl_conv.h"
+#include <gdal.h>
 
 //qgis includes...
 #include <qgsrasterchecker.h>
@@ -33,6 +35,9 @@
 #include <qgsrasterfilewriter.h>
 #include <qgsrasternuller.h>
 #include "qgsrasterprojector.h"
+#include "qgsrasterpyramidbuildertask.h"
+#include "qgsogrutils.h"
+#include "qgstaskmanager.h"
 #include <qgsapplication.h>
 
 /**
@@ -52,6 +57,8 @@ class TestQgsRasterFileWriter: public QObject
     void testCreateOneBandRaster();
     void testCreateMultiBandRaster();
     void testVrtCreation();
+    void testCogCreation();
+    void testPyramidBuilderTask();
   private:
     bool writeTest( const QString &rasterName );
     void log( const QString &msg );
@@ -325,6 +332,73 @@ void TestQgsRasterFileWriter::testVrtCreation()
   QGSCOMPARENEAR( yminVrt, yminOriginal, srcRasterLayer->rasterUnitsPerPixelY() / 4 );
 }
 
+void TestQgsRasterFileWriter::testCogCreation()
+{
+#if GDAL_VERSION_NUM < GDAL_COMPUTE_VERSION(3,1,0)
+  QSKIP( "This test requires the COG driver of GDAL 3.1", SkipAll );
+#endif
+  QString srcFileName = mTestDataDir + QStringLiteral( "ALLINGES_RGF93_CC46_1_1.tif" );
+  QgsRasterLayer srcRasterLayer( srcFileName, QStringLiteral( "src" ) );
+  QVERIFY( srcRasterLayer.isValid() );
+
+  QTemporaryDir dir;
+  const QString cogFileName = dir.filePath( QStringLiteral( "cog.tif" ) );
+  QgsRasterFileWriter writer( cogFileName );
+  writer.setOutputFormat( QStringLiteral( "COG" ) );
+  writer.setCreateOptions( QStringList() << QStringLiteral( "COMPRESS=DEFLATE" ) );
+
+  QgsRasterPipe pipe;
+  pipe.set( srcRasterLayer.dataProvider()->clone() );
+  QgsRasterBlockFeedback feedback;
+  QCOMPARE( writer.writeRaster( &pipe, srcRasterLayer.width(), srcRasterLayer.height(), srcRasterLayer.extent(), srcRasterLayer.crs(), srcRasterLayer.transformContext(), &feedback ), QgsRasterFileWriter::NoError );
+  QCOMPARE( writer.outputUrl(), cogFileName );
+  QCOMPARE( writer.outputFormat(), QStringLiteral( "COG" ) );
+  QGSCOMPARENEAR( feedback.progress(), 100.0, 0.001 );
+
+  // the temporary GeoTIFF is removed
+  QVERIFY( !QFile::exists( cogFileName + QStringLiteral( ".tmp.tif" ) ) );
+
+  gdal::dataset_unique_ptr ds( GDALOpen( cogFileName.toUtf8().constData(), GA_ReadOnly ) );
+  QVERIFY( ds );
+  QCOMPARE( QString( GDALGetMetadataItem( ds.get(), "LAYOUT", "IMAGE_STRUCTURE" ) ), QStringLiteral( "COG" ) );
+  QCOMPARE( GDALGetRasterXSize( ds.get() ), srcRasterLayer.width() );
+  QCOMPARE( GDALGetRasterYSize( ds.get() ), srcRasterLayer.height() );
+  QVERIFY( GDALGetOverviewCount( GDALGetRasterBand( ds.get(), 1 ) ) > 0 );
+}
+
+void TestQgsRasterFileWriter::testPyramidBuilderTask()
+{
+  QString srcFileName = mTestDataDir + QStringLiteral( "ALLINGES_RGF93_CC46_1_1.tif" );
+  QTemporaryDir dir;
+  const QString fileName = dir.filePath( QStringLiteral( "pyramids.tif" ) );
+  QVERIFY( QFile::copy( srcFileName, fileName ) );
+
+  QgsRasterLayer layer( fileName, QStringLiteral( "pyramids" ) );
+  QVERIFY( layer.isValid() );
+  QVERIFY( !layer.dataProvider()->hasPyramids() );
+
+  QgsRasterPyramidBuilderTask *task = new QgsRasterPyramidBuilderTask( QStringLiteral( "gdal" ), fileName );
+  QSignalSpy builtSpy( task, &QgsRasterPyramidBuilderTask::pyramidsBuilt );
+  QgsApplication::taskManager()->addTask( task );
+  QVERIFY( builtSpy.wait( 60000 ) );
+  QCOMPARE( builtSpy.at( 0 ).at( 0 ).toString(), fileName );
+
+  // all levels are built as an external overview file
+  QVERIFY( QFile::exists( fileName + QStringLiteral( ".ovr" ) ) );
+  QgsRasterLayer reloaded( fileName, QStringLiteral( "pyramids" ) );
+  const QList< QgsRasterPyramid > pyramids = reloaded.dataProvider()->buildPyramidList();
+  QVERIFY( !pyramids.isEmpty() );
+  for ( const QgsRasterPyramid &pyramid : pyramids )
+    QVERIFY( pyramid.getExists() );
+
+  // unreadable sources are reported
+  task = new QgsRasterPyramidBuilderTask( QStringLiteral( "gdal" ), dir.filePath( QStringLiteral( "missing.tif" ) ) );
+  QSignalSpy errorSpy( task, &QgsRasterPyramidBuilderTask::errorOccurred );
+  QgsApplication::taskManager()->addTask( task );
+  QVERIFY( errorSpy.wait( 60000 ) );
+  QCOMPARE( errorSpy.at( 0 ).at( 0 ).toString(), QStringLiteral( "ERROR_PROVIDER" ) );
+}
+
 void TestQgsRasterFileWriter::log( const QString &msg )
 {
   mReport += msg + "<br>";
@@ -21,6 +21,11 @@
 #include "qgsrasterlayer.h"
 #include "qgsrasterdataprovider.h"
 #include "qgsrasteriterator.h"
+#include "qgsrasterdrawer.h"
+#include "qgsrasterpipe.h"
+#include "qgsrasterviewport.h"
+#include "qgsmaptopixel.h"
+#include <QPainter>
 
 /**
  * \ingroup UnitTests
@@ -40,6 +45,7 @@ class TestQgsRasterIterator : public QObject
 
     void testBasic();
     void testNoBlock();
+    void testParallelDraw();
 
   private:
 
@@ -353,6 +359,39 @@ void TestQgsRasterIterator::testNoBlock()
   QVERIFY( !it.next( 1, nCols, nRows, topLeftCol, topLeftRow, blockExtent ) );
 }
 
+void TestQgsRasterIterator::testParallelDraw()
+{
+  QgsRasterViewPort viewPort;
+  viewPort.mTopLeftPoint = QgsPointXY( 0, 0 );
+  viewPort.mBottomRightPoint = QgsPointXY( 300, 200 );
+  viewPort.mWidth = 300;
+  viewPort.mHeight = 200;
+  viewPort.mDrawnExtent = mpRasterLayer->extent();
+  const QgsMapToPixel mapToPixel;
+
+  auto drawImage = [&]( bool parallel )
+  {
+    QImage image( 300, 200, QImage::Format_ARGB32_Premultiplied );
+    image.fill( Qt::transparent );
+    QPainter painter( &image );
+    QgsRasterIterator iterator( mpRasterLayer->pipe()->last() );
+    iterator.setMaximumTileWidth( 64 );
+    iterator.setMaximumTileHeight( 48 );
+    QgsRasterDrawer drawer( &iterator );
+    drawer.setParallelRendering( parallel );
+    drawer.draw( &painter, &viewPort, &mapToPixel );
+    painter.end();
+    return image;
+  };
+
+  // tiles rendered on cloned pipes are painted at the same place as sequentially rendered ones
+  const QImage sequential = drawImage( false );
+  const QImage parallel = drawImage( true );
+  QImage empty( 300, 200, QImage::Format_ARGB32_Premultiplied );
+  empty.fill( Qt::transparent );
+  QVERIFY( sequential != empty );
+  QCOMPARE( parallel, sequential );
+}
 
 QGSTEST_MAIN( TestQgsRasterIterator )
 
@@ -0,0 +1,118 @@
+/***************************************************************************
+     testqgsrasterprojector.cpp
+     --------------------------
+    Date                 : October 2026
+    Copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include "qgstest.h"
+#include <QObject>
+#include <QString>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include "qgsapplication.h"
+#include "qgscoordinatetransformcontext.h"
+#include "qgsrasterblock.h"
+#include "qgsrasterdataprovider.h"
+#include "qgsrasterlayer.h"
+#include "qgsrasterprojector.h"
+
+class TestQgsRasterProjector : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void clone();
+    void warp();
+
+  private:
+    QTemporaryDir mDir;
+};
+
+void TestQgsRasterProjector::initTestCase()
+{
+  QgsApplication::init();
+  QgsApplication::initQgis();
+}
+
+void TestQgsRasterProjector::cleanupTestCase()
+{
+  QgsApplication::exitQgis();
+}
+
+void TestQgsRasterProjector::clone()
+{
+  QgsRasterProjector projector;
+  projector.setPrecision( QgsRasterProjector::Warp );
+  projector.setWarpResamplingMethod( QgsRasterDataProvider::ResamplingMethod::Cubic );
+  projector.setWarpThreadCount( 1 );
+  std::unique_ptr< QgsRasterProjector > cloned( projector.clone() );
+  QCOMPARE( cloned->precision(), QgsRasterProjector::Warp );
+  QCOMPARE( cloned->warpResamplingMethod(), QgsRasterDataProvider::ResamplingMethod::Cubic );
+  QCOMPARE( cloned->warpThreadCount(), 1 );
+}
+
+void TestQgsRasterProjector::warp()
+{
+  // 10x10 degrees grid whose values are ten times the column index
+  QVERIFY( mDir.isValid() );
+  const QString path = mDir.filePath( QStringLiteral( "columns.asc" ) );
+  {
+    QFile file( path );
+    QVERIFY( file.open( QIODevice::WriteOnly | QIODevice::Text ) );
+    QTextStream stream( &file );
+    stream << "ncols 10\nnrows 10\nxllcorner 0\nyllcorner 40\ncellsize 1\nNODATA_value -9999\n";
+    for ( int row = 0; row < 10; ++row )
+    {
+      for ( int col = 0; col < 10; ++col )
+        stream << col * 10 << ' ';
+      stream << '\n';
+    }
+  }
+  QgsRasterLayer layer( path, QStringLiteral( "columns" ), QStringLiteral( "gdal" ) );
+  QVERIFY( layer.isValid() );
+
+  // the destination extent overlaps the grid, cell 15, 15 is at about 5.17 degrees east
+  const QgsRectangle extent( -200000, 4800000, 1300000, 6500000 );
+  const int size = 30;
+
+  QgsRasterProjector projector;
+  projector.setInput( layer.dataProvider() );
+  projector.setCrs( QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:4326" ) ), QgsCoordinateReferenceSystem( QStringLiteral( "EPSG:3857" ) ), QgsCoordinateTransformContext() );
+
+  projector.setPrecision( QgsRasterProjector::Exact );
+  std::unique_ptr< QgsRasterBlock > exact( projector.block( 1, extent, size, size ) );
+  QVERIFY( exact->isValid() );
+
+  // nearest neighbour warping matches the exact precision
+  projector.setPrecision( QgsRasterProjector::Warp );
+  std::unique_ptr< QgsRasterBlock > nearest( projector.block( 1, extent, size, size ) );
+  QVERIFY( nearest->isValid() );
+  QCOMPARE( nearest->width(), size );
+  QCOMPARE( nearest->height(), size );
+  QCOMPARE( nearest->value( 15, 15 ), 50.0 );
+  QCOMPARE( nearest->value( 15, 15 ), exact->value( 15, 15 ) );
+  // cells outside the grid are nodata
+  QVERIFY( exact->isNoData( 0, 0 ) );
+  QVERIFY( nearest->isNoData( 0, 0 ) );
+
+  // bilinear warping interpolates between source columns
+  projector.setWarpResamplingMethod( QgsRasterDataProvider::ResamplingMethod::Bilinear );
+  std::unique_ptr< QgsRasterBlock > bilinear( projector.block( 1, extent, size, size ) );
+  QVERIFY( bilinear->isValid() );
+  QVERIFY( bilinear->value( 15, 15 ) > 40.0 );
+  QVERIFY( bilinear->value( 15, 15 ) < 50.0 );
+  QVERIFY( bilinear->isNoData( 0, 0 ) );
+}
+
+QGSTEST_MAIN( TestQgsRasterProjector )
+#include "testqgsrasterprojector.moc"
@@ -0,0 +1,179 @@
+/***************************************************************************
+     testqgsrasterstatisticsaccumulator.cpp
+     --------------------------------------
+    Date                 : October 2026
+    Copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include "qgstest.h"
+#include <QObject>
+#include <QString>
+
+#include "qgsapplication.h"
+#include "qgsrasterbandstats.h"
+#include "qgsrasterblock.h"
+#include "qgsrasterdataprovider.h"
+#include "qgsrasterhistogram.h"
+#include "qgsrasterlayer.h"
+#include "qgsrasterstatisticsaccumulator.h"
+
+class TestQgsRasterStatisticsAccumulator : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void values();
+    void histogram();
+    void parallelBlock();
+    void statisticsWithHistogram();
+};
+
+void TestQgsRasterStatisticsAccumulator::initTestCase()
+{
+  QgsApplication::init();
+  QgsApplication::initQgis();
+}
+
+void TestQgsRasterStatisticsAccumulator::cleanupTestCase()
+{
+  QgsApplication::exitQgis();
+}
+
+void TestQgsRasterStatisticsAccumulator::values()
+{
+  QgsRasterStatisticsAccumulator accumulator;
+  for ( double value : { 4.0, 2.0, 8.0, 6.0 } )
+    accumulator.addValue( value );
+  // infinite values only count towards the sum and element count
+  accumulator.addValue( std::numeric_limits< double >::infinity() );
+
+  QgsRasterBandStats stats;
+  accumulator.updateStatistics( stats );
+  QCOMPARE( stats.elementCount, static_cast< qgssize >( 5 ) );
+  QCOMPARE( stats.minimumValue, 2.0 );
+  QCOMPARE( stats.maximumValue, 8.0 );
+  QCOMPARE( stats.range, 6.0 );
+  QVERIFY( std::isinf( stats.sum ) );
+  QCOMPARE( stats.sumOfSquares, 20.0 );
+  // sample standard deviation of the four finite values
+  QGSCOMPARENEAR( stats.stdDev, std::sqrt( 20.0 / 3 ), 1e-9 );
+  QCOMPARE( stats.statsGathered, static_cast< int >( QgsRasterBandStats::All ) );
+
+  // merging two halves gives the same result as adding all values to one accumulator
+  QgsRasterStatisticsAccumulator first;
+  QgsRasterStatisticsAccumulator second;
+  QgsRasterStatisticsAccumulator all;
+  for ( int i = 0; i < 100; ++i )
+  {
+    const double value = std::sin( i ) * 100 + i;
+    ( i < 37 ? first : second ).addValue( value );
+    all.addValue( value );
+  }
+  first.merge( second );
+  QgsRasterBandStats merged;
+  first.updateStatistics( merged );
+  QgsRasterBandStats expected;
+  all.updateStatistics( expected );
+  QCOMPARE( merged.elementCount, expected.elementCount );
+  QCOMPARE( merged.minimumValue, expected.minimumValue );
+  QCOMPARE( merged.maximumValue, expected.maximumValue );
+  QGSCOMPARENEAR( merged.mean, expected.mean, 1e-9 );
+  QGSCOMPARENEAR( merged.stdDev, expected.stdDev, 1e-9 );
+}
+
+void TestQgsRasterStatisticsAccumulator::histogram()
+{
+  QgsRasterStatisticsAccumulator accumulator;
+  accumulator.setHistogram( 0, 10, 5 );
+  QVERIFY( accumulator.hasHistogram() );
+  for ( double value : { 0.0, 1.0, 2.0, 3.0, 9.9, 10.0, -5.0, 15.0 } )
+    accumulator.addValue( value );
+
+  QgsRasterHistogram histogram;
+  accumulator.updateHistogram( histogram );
+  QVERIFY( histogram.valid );
+  QCOMPARE( histogram.histogramVector, QgsRasterHistogram::HistogramVector( { 2, 2, 0, 0, 2 } ) );
+  QCOMPARE( histogram.nonNullCount, 6 );
+
+  QgsRasterStatisticsAccumulator outOfRange;
+  outOfRange.setHistogram( 0, 10, 5, true );
+  for ( double value : { 0.0, 1.0, 2.0, 3.0, 9.9, 10.0, -5.0, 15.0 } )
+    outOfRange.addValue( value );
+  outOfRange.updateHistogram( histogram );
+  QCOMPARE( histogram.histogramVector, QgsRasterHistogram::HistogramVector( { 3, 2, 0, 0, 3 } ) );
+  QCOMPARE( histogram.nonNullCount, 8 );
+}
+
+void TestQgsRasterStatisticsAccumulator::parallelBlock()
+{
+  // large enough to be split into several concurrently processed chunks
+  const int width = 600;
+  const int height = 400;
+  QgsRasterBlock block( Qgis::DataType::Float32, width, height );
+  block.setNoDataValue( -1 );
+  for ( int row = 0; row < height; ++row )
+  {
+    for ( int col = 0; col < width; ++col )
+    {
+      block.setValue( row, col, ( row * 7 + col * 13 ) % 101 == 0 ? -1 : std::fmod( row * 0.37 + col * 1.91, 50.0 ) );
+    }
+  }
+
+  QgsRasterStatisticsAccumulator parallel;
+  parallel.setHistogram( 0, 50, 20 );
+  parallel.addBlock( &block );
+
+  QgsRasterStatisticsAccumulator sequential;
+  sequential.setHistogram( 0, 50, 20 );
+  sequential.addRows( &block, 0, height );
+
+  QCOMPARE( parallel.count(), sequential.count() );
+  QVERIFY( parallel.count() < static_cast< qgssize >( width ) * height );
+
+  QgsRasterBandStats parallelStats;
+  parallel.updateStatistics( parallelStats );
+  QgsRasterBandStats sequentialStats;
+  sequential.updateStatistics( sequentialStats );
+  QCOMPARE( parallelStats.minimumValue, sequentialStats.minimumValue );
+  QCOMPARE( parallelStats.maximumValue, sequentialStats.maximumValue );
+  QGSCOMPARENEAR( parallelStats.mean, sequentialStats.mean, 1e-9 );
+  QGSCOMPARENEAR( parallelStats.stdDev, sequentialStats.stdDev, 1e-9 );
+
+  QgsRasterHistogram parallelHistogram;
+  parallel.updateHistogram( parallelHistogram );
+  QgsRasterHistogram sequentialHistogram;
+  sequential.updateHistogram( sequentialHistogram );
+  QCOMPARE( parallelHistogram.histogramVector, sequentialHistogram.histogramVector );
+}
+
+void TestQgsRasterStatisticsAccumulator::statisticsWithHistogram()
+{
+  // custom nodata values force the generic statistics, which collect the
+  // default histogram of byte bands in the same pass
+  QgsRasterLayer layer( QStringLiteral( TEST_DATA_DIR ) + "/raster/band1_byte_ct_epsg4326.tif", QStringLiteral( "byte" ) );
+  QVERIFY( layer.isValid() );
+  QgsRasterDataProvider *provider = layer.dataProvider();
+  provider->setUserNoDataValue( 1, QgsRasterRangeList() << QgsRasterRange( 0, 0 ) );
+
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  QVERIFY( !provider->hasHistogram( 1, 0, nan, nan ) );
+  const QgsRasterBandStats stats = provider->bandStatistics( 1, QgsRasterBandStats::All );
+  QVERIFY( stats.elementCount > 0 );
+  QVERIFY( provider->hasHistogram( 1, 0, nan, nan ) );
+
+  const QgsRasterHistogram histogram = provider->histogram( 1, 0, nan, nan );
+  QCOMPARE( histogram.binCount, 256 );
+  QCOMPARE( static_cast< qgssize >( histogram.nonNullCount ), stats.elementCount );
+  QCOMPARE( histogram.histogramVector.at( 0 ), 0 );
+}
+
+QGSTEST_MAIN( TestQgsRasterStatisticsAccumulator )
+#include "testqgsrasterstatisticsaccumulator.moc"
@@ -16,6 +16,7 @@
 #include "qgstest.h"
 #include <QObject>
 #include <QString>
+#include <QTemporaryDir>
 
 #include <qgsapplication.h>
 #include "qgsfeatureiterator.h"
@@ -427,6 +428,171 @@ class TestQgsSpatialIndex : public QObject
       QCOMPARE( i2.nearestNeighbor( g, 2, 0.2 ), QList< QgsFeatureId >() );
     }
 
+    void testStaticPackedTree()
+    {
+      std::unique_ptr< QgsVectorLayer > vl = std::make_unique< QgsVectorLayer >( QStringLiteral( "LineString" ), QStringLiteral( "x" ), QStringLiteral( "memory" ) );
+      QgsFeatureList flist;
+      int fid = 0;
+      for ( int x = 0; x < 50; ++x )
+      {
+        for ( int y = 0; y < 50; ++y )
+        {
+          QgsFeature f( fid++ );
+          f.setGeometry( std::make_unique< QgsLineString >( QgsPoint( x, y ), QgsPoint( x + 0.5, y - 0.5 ) ) );
+          flist << f;
+        }
+      }
+      vl->dataProvider()->addFeatures( flist );
+
+      QgsSpatialIndex dynamicIndex( *vl );
+      QgsSpatialIndex packedIndex( *vl, nullptr, QgsSpatialIndex::FlagStaticPackedTree );
+
+      const QList< QgsRectangle > rects = QList< QgsRectangle >() << QgsRectangle( 4.9, 4.9, 5.1, 5.1 )
+                                          << QgsRectangle( -10, -10, 100, 100 )
+                                          << QgsRectangle( 10.2, 3.7, 20.1, 12.6 )
+                                          << QgsRectangle( 60, 60, 70, 70 );
+      for ( const QgsRectangle &rect : rects )
+      {
+        QList<QgsFeatureId> resDynamic = dynamicIndex.intersects( rect );
+        QList<QgsFeatureId> resPacked = packedIndex.intersects( rect );
+        std::sort( resDynamic.begin(), resDynamic.end() );
+        std::sort( resPacked.begin(), resPacked.end() );
+        QCOMPARE( resPacked, resDynamic );
+      }
+      QCOMPARE( packedIndex.intersects( QgsRectangle( -10, -10, 100, 100 ) ).size(), 2500 );
+
+      // static index cannot be modified
+      QgsFeature f = vl->getFeature( 1 );
+      QVERIFY( !packedIndex.addFeature( f ) );
+      QVERIFY( !packedIndex.deleteFeature( f ) );
+      QCOMPARE( packedIndex.intersects( f.geometry().boundingBox() ).count( 1 ), 1 );
+
+      // copies share the same tree
+      QgsSpatialIndex copy( packedIndex );
+      QCOMPARE( copy.intersects( QgsRectangle( 4.9, 4.9, 5.1, 5.1 ) ).size(), packedIndex.intersects( QgsRectangle( 4.9, 4.9, 5.1, 5.1 ) ).size() );
+
+      // empty index
+      QgsSpatialIndex empty( QgsFeatureIterator(), nullptr, QgsSpatialIndex::FlagStaticPackedTree );
+      QVERIFY( empty.intersects( QgsRectangle( -10, -10, 100, 100 ) ).isEmpty() );
+      QVERIFY( empty.nearestNeighbor( QgsPointXY( 1, 1 ), 3 ).isEmpty() );
+    }
+
+    void testStaticPackedTreeNearestNeighbour()
+    {
+      std::unique_ptr< QgsVectorLayer > vl = std::make_unique< QgsVectorLayer >( QStringLiteral( "LineString" ), QStringLiteral( "x" ), QStringLiteral( "memory" ) );
+      QgsFeature f1( 1 );
+      f1.setGeometry( QgsGeometry::fromWkt( QStringLiteral( "LineString(1 1, 3 1, 3 3)" ) ) );
+      QgsFeature f2( 2 );
+      f2.setGeometry( QgsGeometry::fromWkt( QStringLiteral( "LineString(0 1, 0 3)" ) ) );
+      QgsFeature f3( 3 );
+      f3.setGeometry( QgsGeometry::fromWkt( QStringLiteral( "LineString(0 4, 1 5, 3 3)" ) ) );
+      QgsFeatureList flist = QgsFeatureList() << f1 << f2 << f3;
+      vl->dataProvider()->addFeatures( flist );
+      QCOMPARE( vl->featureCount(), 3L );
+
+      QgsSpatialIndex i( *vl, nullptr, QgsSpatialIndex::FlagStaticPackedTree );
+      QgsSpatialIndex i2( *vl, nullptr, QgsSpatialIndex::FlagStaticPackedTree | QgsSpatialIndex::FlagStoreFeatureGeometries );
+
+      QCOMPARE( i2.geometry( 1 ).asWkt(), QStringLiteral( "LineString (1 1, 3 1, 3 3)" ) );
+      QVERIFY( i.geometry( 1 ).isNull() );
+
+      // bounding box only
+      QCOMPARE( i.nearestNeighbor( QgsPointXY( 1, 2.9 ), 1 ), QList< QgsFeatureId >() << 1 );
+      QCOMPARE( i.nearestNeighbor( QgsPointXY( 1, 2.9 ), 2 ), QList< QgsFeatureId >() << 1 << 3 );
+      // exact
+      QCOMPARE( i2.nearestNeighbor( QgsPointXY( 1, 2.9 ), 1 ), QList< QgsFeatureId >() << 2 );
+      QCOMPARE( i2.nearestNeighbor( QgsPointXY( 1, 2.9 ), 2 ), QList< QgsFeatureId >() << 2 << 3 );
+
+      // with maximum distance
+      QCOMPARE( i2.nearestNeighbor( QgsPointXY( 1, 2.9 ), 1, 0.5 ), QList< QgsFeatureId >() );
+      QCOMPARE( i2.nearestNeighbor( QgsPointXY( 1, 2.9 ), 2, 1.1 ), QList< QgsFeatureId >() << 2 );
+      QCOMPARE( i2.nearestNeighbor( QgsPointXY( 1, 2.9 ), 2, 2 ), QList< QgsFeatureId >() << 2 << 3 );
+
+      // using geometries as input, with equidistant features
+      QgsGeometry g = QgsGeometry::fromWkt( QStringLiteral( "MultiPoint (1.5 2.5, 3 4.5)" ) );
+      QCOMPARE( i2.nearestNeighbor( g, 1 ), QList< QgsFeatureId >() << 3 );
+      QList< QgsFeatureId > res = i2.nearestNeighbor( g, 2 );
+      QCOMPARE( res.size(), 3 );
+      QCOMPARE( res.at( 0 ), 3LL );
+      QVERIFY( res.contains( 1 ) );
+      QVERIFY( res.contains( 2 ) );
+      QCOMPARE( i2.nearestNeighbor( g, 2, 0.2 ), QList< QgsFeatureId >() );
+    }
+
+    void testPersistentIndex()
+    {
+      std::unique_ptr< QgsVectorLayer > vl = std::make_unique< QgsVectorLayer >( QStringLiteral( "LineString" ), QStringLiteral( "x" ), QStringLiteral( "memory" ) );
+      QgsFeatureList flist;
+      for ( int x = 0; x < 30; ++x )
+      {
+        for ( int y = 0; y < 30; ++y )
+        {
+          QgsFeature f;
+          f.setGeometry( std::make_unique< QgsLineString >( QgsPoint( x, y ), QgsPoint( x + 0.5, y - 0.5 ) ) );
+          flist << f;
+        }
+      }
+      vl->dataProvider()->addFeatures( flist );
+
+      QTemporaryDir dir;
+      const QString sourcePath = dir.filePath( QStringLiteral( "source.csv" ) );
+      {
+        QFile source( sourcePath );
+        QVERIFY( source.open( QIODevice::WriteOnly ) );
+        source.write( "x,y\n" );
+      }
+      const QString indexPath = QgsSpatialIndex::indexPathForSource( sourcePath );
+      QCOMPARE( indexPath, dir.filePath( QStringLiteral( "source.csv.qgsidx" ) ) );
+
+      // only packed indexes can be written
+      QgsSpatialIndex dynamicIndex( *vl );
+      QVERIFY( !dynamicIndex.writeToFile( indexPath, sourcePath ) );
+
+      QgsSpatialIndex packedIndex( *vl, nullptr, QgsSpatialIndex::FlagStaticPackedTree );
+      QVERIFY( packedIndex.writeToFile( indexPath, sourcePath ) );
+
+      QgsSpatialIndex restored;
+      QVERIFY( !restored.readFromFile( dir.filePath( QStringLiteral( "missing.qgsidx" ) ) ) );
+      QVERIFY( !restored.readFromFile( sourcePath ) );
+      QVERIFY( restored.readFromFile( indexPath, sourcePath ) );
+
+      const QList< QgsRectangle > rects = QList< QgsRectangle >() << QgsRectangle( 4.9, 4.9, 5.1, 5.1 )
+                                          << QgsRectangle( -10, -10, 100, 100 )
+                                          << QgsRectangle( 10.2, 3.7, 20.1, 12.6 );
+      for ( const QgsRectangle &rect : rects )
+      {
+        QList<QgsFeatureId> resPacked = packedIndex.intersects( rect );
+        QList<QgsFeatureId> resRestored = restored.intersects( rect );
+        std::sort( resPacked.begin(), resPacked.end() );
+        std::sort( resRestored.begin(), resRestored.end() );
+        QCOMPARE( resRestored, resPacked );
+      }
+      QCOMPARE( restored.nearestNeighbor( QgsPointXY( 10.2, 20.1 ), 1 ), packedIndex.nearestNeighbor( QgsPointXY( 10.2, 20.1 ), 1 ) );
+
+      // restored index is static
+      QgsFeature f = vl->getFeature( 1 );
+      QVERIFY( !restored.addFeature( f ) );
+
+      // and can be written again
+      const QString copyPath = dir.filePath( QStringLiteral( "copy.qgsidx" ) );
+      QVERIFY( restored.writeToFile( copyPath ) );
+      QgsSpatialIndex restoredCopy;
+      QVERIFY( restoredCopy.readFromFile( copyPath ) );
+      QCOMPARE( restoredCopy.intersects( QgsRectangle( -10, -10, 100, 100 ) ).size(), 900 );
+
+      // modifying the source invalidates the index
+      {
+        QFile source( sourcePath );
+        QVERIFY( source.open( QIODevice::Append ) );
+        source.write( "1,2\n" );
+      }
+      QgsSpatialIndex stale;
+      QVERIFY( !stale.readFromFile( indexPath, sourcePath ) );
+      QVERIFY( stale.intersects( QgsRectangle( -10, -10, 100, 100 ) ).isEmpty() );
+      // unless the source isn't checked
+      QVERIFY( stale.readFromFile( indexPath ) );
+    }
+
 };
 
 QGSTEST_MAIN( TestQgsSpatialIndex )
@@ -0,0 +1,127 @@
+/***************************************************************************
+     testqgswkbgeometry.cpp
+     ----------------------
+    Date                 : October 2026
+    Copyright            : (C) 2026 by the QGIS Development Team
+ ***************************************************************************
+ *                                                                         *
+ *   This program is free software; you can redistribute it and/or modify  *
+ *   it under the terms of the GNU General Public License as published by  *
+ *   the Free Software Foundation; either version 2 of the License, or     *
+ *   (at your option) any later version.                                   *
+ *                                                                         *
+ ***************************************************************************/
+#include "qgstest.h"
+#include <QObject>
+#include <QString>
+
+#include "qgsapplication.h"
+#include "qgsgeometry.h"
+#include "qgswkbgeometry.h"
+
+class TestQgsWkbGeometry : public QObject
+{
+    Q_OBJECT
+
+  private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void nullGeometry();
+    void boundingBox_data();
+    void boundingBox();
+    void invalidWkb();
+    void geometry();
+};
+
+void TestQgsWkbGeometry::initTestCase()
+{
+  QgsApplication::init();
+  QgsApplication::initQgis();
+}
+
+void TestQgsWkbGeometry::cleanupTestCase()
+{
+  QgsApplication::exitQgis();
+}
+
+void TestQgsWkbGeometry::nullGeometry()
+{
+  const QgsWkbGeometry geom;
+  QVERIFY( geom.isNull() );
+  QCOMPARE( geom.wkbType(), QgsWkbTypes::Unknown );
+  QVERIFY( geom.boundingBox().isNull() );
+  QVERIFY( !geom.boundingBoxIntersects( QgsRectangle( -1, -1, 1, 1 ) ) );
+  QVERIFY( geom.geometry().isNull() );
+  QVERIFY( QgsWkbGeometry::fromGeometry( QgsGeometry() ).isNull() );
+}
+
+void TestQgsWkbGeometry::boundingBox_data()
+{
+  QTest::addColumn<QString>( "wkt" );
+
+  QTest::newRow( "point" ) << QStringLiteral( "Point (1 2)" );
+  QTest::newRow( "point zm" ) << QStringLiteral( "PointZM (1 2 3 4)" );
+  QTest::newRow( "linestring z" ) << QStringLiteral( "LineStringZ (1 2 3, -4 5 6, 7 -8 9)" );
+  QTest::newRow( "polygon" ) << QStringLiteral( "Polygon ((0 0, 10 0, 10 10, 0 10, 0 0),(2 2, 4 2, 4 4, 2 2))" );
+  QTest::newRow( "multipolygon m" ) << QStringLiteral( "MultiPolygonM (((0 0 1, 1 0 1, 1 1 1, 0 0 1)),((5 5 1, 6 5 1, 6 7 1, 5 5 1)))" );
+  QTest::newRow( "collection" ) << QStringLiteral( "GeometryCollection (Point (-5 3), LineString (1 1, 2 20))" );
+  QTest::newRow( "circular string" ) << QStringLiteral( "CircularString (0 0, 1 1, 2 0)" );
+  QTest::newRow( "collection with curve" ) << QStringLiteral( "GeometryCollection (Point (5 3), CircularString (0 0, 1 1, 2 0))" );
+}
+
+void TestQgsWkbGeometry::boundingBox()
+{
+  QFETCH( QString, wkt );
+
+  const QgsGeometry expected = QgsGeometry::fromWkt( wkt );
+  const QgsWkbGeometry geom( expected.asWkb() );
+  QVERIFY( !geom.isNull() );
+  QCOMPARE( geom.wkbType(), expected.wkbType() );
+  QCOMPARE( geom.boundingBox(), expected.boundingBox() );
+
+  const QgsRectangle bounds = expected.boundingBox();
+  QVERIFY( geom.boundingBoxIntersects( bounds ) );
+  QVERIFY( !geom.boundingBoxIntersects( QgsRectangle( bounds.xMaximum() + 1, bounds.yMaximum() + 1, bounds.xMaximum() + 2, bounds.yMaximum() + 2 ) ) );
+
+  // only curved geometries need to be materialized
+  QCOMPARE( geom.isMaterialized(), QgsWkbTypes::isCurvedType( expected.wkbType() ) || wkt.contains( QLatin1String( "CircularString" ) ) );
+}
+
+void TestQgsWkbGeometry::invalidWkb()
+{
+  QByteArray wkb = QgsGeometry::fromWkt( QStringLiteral( "LineString (1 2, 3 4, 5 6)" ) ).asWkb();
+  wkb.chop( 10 );
+  const QgsWkbGeometry geom( wkb );
+  QCOMPARE( geom.wkbType(), QgsWkbTypes::LineString );
+  QVERIFY( geom.boundingBox().isNull() );
+  QVERIFY( !geom.boundingBoxIntersects( QgsRectangle( 0, 0, 10, 10 ) ) );
+  QVERIFY( geom.geometry().isNull() );
+
+  // empty geometries intersect nothing
+  const QgsWkbGeometry empty( QgsGeometry::fromWkt( QStringLiteral( "MultiPolygon EMPTY" ) ).asWkb() );
+  QVERIFY( !empty.isNull() );
+  QVERIFY( empty.boundingBox().isNull() );
+  QVERIFY( !empty.boundingBoxIntersects( QgsRectangle( -1, -1, 1, 1 ) ) );
+}
+
+void TestQgsWkbGeometry::geometry()
+{
+  const QgsGeometry source = QgsGeometry::fromWkt( QStringLiteral( "MultiLineStringZ ((1 2 3, 4 5 6),(7 8 9, 10 11 12))" ) );
+  const QgsWkbGeometry geom( source.asWkb() );
+  QVERIFY( !geom.isMaterialized() );
+  QCOMPARE( geom.geometry().asWkt(), source.asWkt() );
+  QVERIFY( geom.isMaterialized() );
+
+  // copies share the WKB
+  const QgsWkbGeometry copy = geom;
+  QCOMPARE( copy.wkb(), source.asWkb() );
+  QCOMPARE( copy.geometry().asWkt(), source.asWkt() );
+
+  const QgsWkbGeometry fromGeometry = QgsWkbGeometry::fromGeometry( source );
+  QVERIFY( fromGeometry.isMaterialized() );
+  QCOMPARE( fromGeometry.wkb(), source.asWkb() );
+  QCOMPARE( fromGeometry.boundingBox(), source.boundingBox() );
+}
+
+QGSTEST_MAIN( TestQgsWkbGeometry )
+#include "testqgswkbgeometry.moc"
@@ -36,7 +36,9 @@ from qgis.core import (
     QgsExpressionContextUtils,
     QgsExpressionContext,
     QgsCoordinateReferenceSystem,
-    QgsBox3d
+    QgsBox3d,
+    QgsNetworkAccessManager,
+    QgsNetworkRequestParameters
 )
 from qgis.testing import (start_app,
                           unittest
@@ -250,6 +252,69 @@ class TestPyQgsOapifProvider(unittest.TestCase, ProviderTestCase):
         values = [f['pk'] for f in vl.getFeatures()]
         self.assertEqual(values, [1, 2, 4])
 
+    def testFeaturePagingPrefetch(self):
+
+        endpoint = self.__class__.basetestpath + '/fake_qgis_http_endpoint_testFeaturePagingPrefetch'
+        create_landing_page_api_collection(endpoint)
+
+        def feature(pk):
+            return {"type": "Feature", "id": "feat.%d" % pk, "properties": {"pk": pk, "cnt": pk * 100},
+                    "geometry": {"type": "Point", "coordinates": [-70 + pk * 0.1, 70]}}
+
+        def write_page(path, pks, next_page):
+            page = {
+                "type": "FeatureCollection",
+                "features": [feature(pk) for pk in pks]
+            }
+            if next_page:
+                page["links"] = [{"href": "http://" + endpoint + next_page, "rel": "next"}]
+            with open(sanitize(endpoint, path + ACCEPT_ITEMS), 'wb') as f:
+                f.write(json.dumps(page).encode('UTF-8'))
+
+        # first items
+        write_page('/collections/mycollection/items?limit=10&', [1], None)
+
+        # the next page is requested while the features of the current one are processed,
+        # features must still come out in page order
+        write_page('/collections/mycollection/items?limit=1000&', [1, 2], '/page2')
+        write_page('/page2?', [3, 4], '/page3')
+        write_page('/page3?', [5], '/page4')
+        write_page('/page4?', [6, 7], None)
+
+        vl = QgsVectorLayer("url='http://" + endpoint + "' typename='mycollection'", 'test', 'OAPIF')
+        self.assertTrue(vl.isValid())
+
+        values = [f['pk'] for f in vl.getFeatures()]
+        self.assertEqual(values, [1, 2, 3, 4, 5, 6, 7])
+
+        values = [f['pk'] for f in vl.getFeatures()]
+        self.assertEqual(values, [1, 2, 3, 4, 5, 6, 7])
+
+        # no page is prefetched once the feature limit is reached: the page after
+        # the second one exists, but must not be requested
+        write_page('/collections/mycollection/items?limit=3&', [1, 2], '/limited_page2')
+        write_page('/limited_page2?', [3], '/limited_page3')
+        write_page('/limited_page3?', [4], None)
+
+        requested_urls = []
+
+        def on_request(params):
+            requested_urls.append(params.request().url().toString())
+
+        # requests made by the downloader thread are forwarded to the main thread instance
+        QgsNetworkAccessManager.instance().requestAboutToBeCreated[QgsNetworkRequestParameters].connect(on_request)
+
+        vl = QgsVectorLayer("url='http://" + endpoint + "' typename='mycollection' maxNumFeatures='3'", 'test', 'OAPIF')
+        self.assertTrue(vl.isValid())
+
+        values = [f['pk'] for f in vl.getFeatures()]
+        self.assertEqual(values, [1, 2, 3])
+
+        QCoreApplication.processEvents()
+        QgsNetworkAccessManager.instance().requestAboutToBeCreated[QgsNetworkRequestParameters].disconnect(on_request)
+        self.assertTrue([url for url in requested_urls if 'limited_page2' in url])
+        self.assertFalse([url for url in requested_urls if 'limited_page3' in url])
+
     def testBbox(self):
 
         endpoint = self.__class__.basetestpath + '/fake_qgis_http_endpoint_testBbox'